@@ -3,6 +3,7 @@
 #include "../../common/ConfigReader.h"
 #include "../../common/PacketStruct.h"
 #include "../World.h"
+#include "../PacketBroadcast.h"
 #include "ChatChannel.h"
 
 extern ConfigReader configReader;
@@ -55,6 +56,12 @@ bool ChatChannel::JoinChannel(const shared_ptr<Client>& client) {
   clients.push_back(client->GetCharacterID());
 
   //loop through everyone else in the channel and send the "other" player join packet
+  PacketBroadcast broadcast("WS_ChatChannelUpdate", [&](PacketStruct* packet) {
+    packet->setDataByName("action", CHAT_CHANNEL_OTHER_JOIN);
+    packet->setDataByName("channel_name", name);
+    packet->setDataByName("player_name", client->GetPlayer()->GetName());
+  });
+
   for (itr = clients.begin(); itr != clients.end(); itr++) {
     if (client->GetCharacterID() == *itr)
       continue;
@@ -62,14 +69,7 @@ bool ChatChannel::JoinChannel(const shared_ptr<Client>& client) {
     if ((to_client = zone_list.GetClientByCharID(*itr)) == NULL)
       continue;
 
-    if ((packet_struct = configReader.getStruct("WS_ChatChannelUpdate", to_client->GetVersion())) == NULL)
-      continue;
-
-    packet_struct->setDataByName("action", CHAT_CHANNEL_OTHER_JOIN);
-    packet_struct->setDataByName("channel_name", name);
-    packet_struct->setDataByName("player_name", client->GetPlayer()->GetName());
-    to_client->QueuePacket(packet_struct->serialize());
-    safe_delete(packet_struct);
+    broadcast.Send(to_client);
   }
 
   return true;
@@ -101,18 +101,17 @@ bool ChatChannel::LeaveChannel(const shared_ptr<Client>& client) {
     safe_delete(packet_struct);
 
     //send the leave packet to all other clients in the channel
+    PacketBroadcast broadcast("WS_ChatChannelUpdate", [&](PacketStruct* packet) {
+      packet->setDataByName("action", CHAT_CHANNEL_OTHER_LEAVE);
+      packet->setDataByName("channel_name", name);
+      packet->setDataByName("player_name", client->GetPlayer()->GetName());
+    });
+
     for (itr = clients.begin(); itr != clients.end(); itr++) {
       if ((to_client = zone_list.GetClientByCharID(*itr)) == NULL)
         continue;
 
-      if ((packet_struct = configReader.getStruct("WS_ChatChannelUpdate", to_client->GetVersion())) == NULL)
-        continue;
-
-      packet_struct->setDataByName("action", CHAT_CHANNEL_OTHER_LEAVE);
-      packet_struct->setDataByName("channel_name", name);
-      packet_struct->setDataByName("player_name", client->GetPlayer()->GetName());
-      to_client->QueuePacket(packet_struct->serialize());
-      safe_delete(packet_struct);
+      broadcast.Send(to_client);
     }
   }
 
@@ -121,35 +120,35 @@ bool ChatChannel::LeaveChannel(const shared_ptr<Client>& client) {
 
 bool ChatChannel::TellChannel(const shared_ptr<Client>& client, const char* message, const char* name2) {
   vector<int32>::iterator itr;
-  PacketStruct* packet_struct;
   shared_ptr<Client> to_client;
 
-  for (itr = clients.begin(); itr != clients.end(); itr++) {
-    if ((to_client = zone_list.GetClientByCharID(*itr)) == NULL)
-      continue;
-    if ((packet_struct = configReader.getStruct("WS_HearChat", to_client->GetVersion())) == NULL)
-      continue;
-
-    packet_struct->setDataByName("unknown", 0);
-    packet_struct->setDataByName("from_spawn_id", 0xFFFFFFFF);
-    packet_struct->setDataByName("to_spawn_id", 0xFFFFFFFF);
+  // only the recipient's name differs, the rest is serialized once per client version
+  PacketBroadcast broadcast("WS_HearChat", [&](PacketStruct* packet) {
+    packet->setDataByName("unknown", 0);
+    packet->setDataByName("from_spawn_id", 0xFFFFFFFF);
+    packet->setDataByName("to_spawn_id", 0xFFFFFFFF);
 
     if (client)
-      packet_struct->setDataByName("from", client->GetPlayer()->GetName());
+      packet->setDataByName("from", client->GetPlayer()->GetName());
     else
-      packet_struct->setDataByName("from", name2);
+      packet->setDataByName("from", name2);
+
+    packet->setDataByName("channel", 34);
+    packet->setDataByName("language", 0);
+    packet->setDataByName("message", message);
+    packet->setDataByName("channel_name", name);
+    packet->setDataByName("show_bubble", 1);
+    packet->setDataByName("understood", 1);
+    packet->setDataByName("unknown4", 0);
+  }, {"to"}, [](PacketStruct* packet, const shared_ptr<Client>& to_client) {
+    packet->setDataByName("to", to_client->GetPlayer()->GetName());
+  });
 
-    packet_struct->setDataByName("to", to_client->GetPlayer()->GetName());
-    packet_struct->setDataByName("channel", 34);
-    packet_struct->setDataByName("language", 0);
-    packet_struct->setDataByName("message", message);
-    packet_struct->setDataByName("channel_name", name);
-    packet_struct->setDataByName("show_bubble", 1);
-    packet_struct->setDataByName("understood", 1);
-    packet_struct->setDataByName("unknown4", 0);
+  for (itr = clients.begin(); itr != clients.end(); itr++) {
+    if ((to_client = zone_list.GetClientByCharID(*itr)) == NULL)
+      continue;
 
-    to_client->QueuePacket(packet_struct->serialize());
-    safe_delete(packet_struct);
+    broadcast.Send(to_client);
   }
 
   return true;
@@ -200,10 +200,11 @@ void WorldDatabase::LoadPlayerCollectionItems(Player* player, Collection* collec
     LogWrite(COLLECTION__ERROR, 0, "Collect", "Error Loading Character Collection Items, Query: %s, Error: %s", query.GetQuery(), query.GetError());
 }
 
-void WorldDatabase::SavePlayerCollections(const shared_ptr<Client>& client) {
+void WorldDatabase::SavePlayerCollections(const shared_ptr<Client>& client, QueryBatch& batch) {
   map<int32, Collection*>* collections;
   map<int32, Collection*>::iterator itr;
   Collection* collection;
+  vector<int32> saved;
 
   assert(client);
 
@@ -211,27 +212,34 @@ void WorldDatabase::SavePlayerCollections(const shared_ptr<Client>& client) {
   for (itr = collections->begin(); itr != collections->end(); itr++) {
     collection = itr->second;
     if (collection->GetSaveNeeded()) {
-      SavePlayerCollection(client, collection);
-      SavePlayerCollectionItems(client, collection);
+      SavePlayerCollection(client, collection, batch);
+      SavePlayerCollectionItems(client, collection, batch);
       collection->SetSaveNeeded(false);
+      saved.push_back(itr->first);
     }
   }
-}
 
-void WorldDatabase::SavePlayerCollection(const shared_ptr<Client>& client, Collection* collection) {
-  Query query;
+  if (!saved.empty()) {
+    batch.OnFailure([collections, saved]() {
+      for (int32 id : saved) {
+        map<int32, Collection*>::iterator itr = collections->find(id);
+        if (itr != collections->end())
+          itr->second->SetSaveNeeded(true);
+      }
+    });
+  }
+}
 
+void WorldDatabase::SavePlayerCollection(const shared_ptr<Client>& client, Collection* collection, QueryBatch& batch) {
   assert(client);
   assert(collection);
 
-  query.RunQuery2(Q_UPDATE, "INSERT INTO `character_collections` (`char_id`,`collection_id`,`completed`)\n"
-                            "VALUES (%u,%u,0)\n"
-                            "ON DUPLICATE KEY UPDATE `completed`=%i",
-                  client->GetPlayer()->GetCharacterID(), collection->GetID(),
-                  collection->GetCompleted() ? 1 : 0);
+  batch.AddRow("`character_collections`", "`char_id`,`collection_id`,`completed`", "`completed`=VALUES(`completed`)", "%u,%u,%i",
+               client->GetPlayer()->GetCharacterID(), collection->GetID(),
+               collection->GetCompleted() ? 1 : 0);
 }
 
-void WorldDatabase::SavePlayerCollectionItems(const shared_ptr<Client>& client, Collection* collection) {
+void WorldDatabase::SavePlayerCollectionItems(const shared_ptr<Client>& client, Collection* collection, QueryBatch& batch) {
   vector<struct CollectionItem*>* collection_items;
   vector<struct CollectionItem*>::iterator itr;
   struct CollectionItem* collection_item;
@@ -243,18 +251,16 @@ void WorldDatabase::SavePlayerCollectionItems(const shared_ptr<Client>& client,
   for (itr = collection_items->begin(); itr != collection_items->end(); itr++) {
     collection_item = *itr;
     if (collection_item->found > 0)
-      SavePlayerCollectionItem(client, collection, collection_item->item);
+      SavePlayerCollectionItem(client, collection, collection_item->item, batch);
   }
 }
 
-void WorldDatabase::SavePlayerCollectionItem(const shared_ptr<Client>& client, Collection* collection, int32 item_id) {
-  Query query;
-
+void WorldDatabase::SavePlayerCollectionItem(const shared_ptr<Client>& client, Collection* collection, int32 item_id, QueryBatch& batch) {
   assert(client);
   assert(collection);
   //assert(item);
 
-  query.RunQuery2(Q_INSERT, "INSERT IGNORE INTO `character_collection_items` (`char_id`,`collection_id`,`collection_item_id`)\n"
-                            "VALUES (%u,%u,%u)",
-                  client->GetPlayer()->GetCharacterID(), collection->GetID(), item_id);
+  // an already saved item is left as is, like INSERT IGNORE did
+  batch.AddRow("`character_collection_items`", "`char_id`,`collection_id`,`collection_item_id`", "`collection_item_id`=`collection_item_id`", "%u,%u,%u",
+               client->GetPlayer()->GetCharacterID(), collection->GetID(), item_id);
 }
@@ -1066,20 +1066,72 @@ void Entity::AddHate(Entity* attacker, sint32 hate, bool unprovoked) {
   }
 
   // If a players pet and protect self is off
-  if (!unprovoked && IsPet() && static_cast<NPC*>(this)->GetOwner() && static_cast<NPC*>(this)->GetOwner()->IsPlayer() && !(static_cast<Player*>(static_cast<NPC*>(this)->GetOwner())->GetInfoStruct()->pet_behavior & 2)) {
+  bool passive_pet = IsPet() && static_cast<NPC*>(this)->GetOwner() && static_cast<NPC*>(this)->GetOwner()->IsPlayer() && !(static_cast<Player*>(static_cast<NPC*>(this)->GetOwner())->GetInfoStruct()->pet_behavior & 2);
+  if (!unprovoked && passive_pet) {
     return;
   }
 
+  // Gather everyone that gets hate from this attack first so the hate table is only locked once
+  vector<HateChange> hates;
+  hates.push_back({attacker, hate, unprovoked});
+
+  // A passive pet only takes the unprovoked hate itself
+  if (!passive_pet) {
+    GetSharedHate(attacker, hate, hates);
+
+    // If player and player has a pet and protect master is set add hate to the pet,
+    // only once per attack since the pet would otherwise keep sharing with itself
+    if (IsPlayer() && HasPet() && static_cast<Player*>(this)->GetInfoStruct()->pet_behavior & 1) {
+      Entity* pets[] = { static_cast<Player*>(this)->GetPet(), static_cast<Player*>(this)->GetCharmedPet() };
+
+      for (Entity* pet : pets) {
+        if (pet && pet->Alive()) {
+          hates.push_back({pet, 1, false});
+          GetSharedHate(pet, 1, hates);
+        }
+      }
+    }
+  }
+
   if (IsNPC()) {
     auto npc = static_cast<NPC*>(this);
 
-    npc->Brain()->AddHate(attacker, hate, unprovoked);
+    npc->Brain()->AddHate(hates);
 
     if (!unprovoked && npc->Brain()->GetEncounterSize() == 0) {
       npc->Brain()->AddToEncounter(attacker);
     }
   }
 
+  // If this spawn has a spawn group then add the attackers to the hate list of the other
+  // group members if not already in their list
+  if (HasSpawnGroup()) {
+    vector<Spawn*>* group = GetSpawnGroup();
+
+    for (const auto& spawn : *group) {
+      if (spawn->IsNPC()) {
+        NPC* npc = static_cast<NPC*>(spawn);
+        vector<HateChange> group_hates;
+
+        for (const auto& change : hates) {
+          if (npc->Brain()->GetHate(change.entity) == 0) {
+            group_hates.push_back({change.entity, 1, change.unprovoked});
+          }
+        }
+
+        if (group_hates.size() > 0) {
+          npc->Brain()->AddHate(group_hates);
+        }
+      }
+    }
+
+    safe_delete(group);
+  }
+}
+
+void Entity::GetSharedHate(Entity* attacker, sint32 hate, vector<HateChange>& hates) {
+  vector<pair<Entity*, sint32>> shares;
+
   if (attacker->GetThreatTransfer() && hate > 0) {
     Spawn* transfer_target = GetZone()->GetSpawnByID(attacker->GetThreatTransfer()->Target);
 
@@ -1087,42 +1139,22 @@ void Entity::AddHate(Entity* attacker, sint32 hate, bool unprovoked) {
       sint32 transfered_hate = hate * (attacker->GetThreatTransfer()->Amount / 100);
       hate -= transfered_hate;
 
-      this->AddHate(static_cast<Entity*>(transfer_target), transfered_hate);
+      shares.push_back(make_pair(static_cast<Entity*>(transfer_target), transfered_hate));
     }
   }
 
   // If pet is adding hate add some to the pets owner as well
   if (attacker->IsNPC() && static_cast<NPC*>(attacker)->IsPet()) {
-    AddHate(static_cast<NPC*>(attacker)->GetOwner(), hate * 0.1);
-  }
-
-  // If player and player has a pet and protect master is set add hate to the pet
-  if (IsPlayer() && HasPet() && static_cast<Player*>(this)->GetInfoStruct()->pet_behavior & 1) {
-    if (static_cast<Player*>(this)->GetPet()) {
-      AddHate(static_cast<Player*>(this)->GetPet(), 1);
-    }
-
-    if (static_cast<Player*>(this)->GetCharmedPet()) {
-      AddHate(static_cast<Player*>(this)->GetCharmedPet(), 1);
-    }
+    shares.push_back(make_pair(static_cast<NPC*>(attacker)->GetOwner(), (sint32)(hate * 0.1)));
   }
 
-  // If this spawn has a spawn group then add the attacker to the hate list of the other
-  // group members if not already in their list
-  if (HasSpawnGroup()) {
-    vector<Spawn*>* group = GetSpawnGroup();
-
-    for (const auto& spawn : *group) {
-      if (spawn->IsNPC()) {
-        NPC* npc = static_cast<NPC*>(spawn);
-
-        if (npc->Brain()->GetHate(attacker) == 0) {
-          npc->Brain()->AddHate(attacker, 1, unprovoked);
-        }
-      }
+  for (const auto& share : shares) {
+    if (!share.first || !share.first->Alive()) {
+      continue;
     }
 
-    safe_delete(group);
+    hates.push_back({share.first, share.second, false});
+    GetSharedHate(share.first, share.second, hates);
   }
 }
 
@@ -367,6 +367,7 @@ bool Commands::SetSpawnCommand(const shared_ptr<Client>& client, Spawn* target,
     case SPAWN_SET_VALUE_X: {
       sprintf(tmp, "%f", target->GetX());
       target->SetX(atof(value), send_update);
+      target->UpdateGridCell();
       break;
     }
     case SPAWN_SET_VALUE_Y: {
@@ -377,6 +378,7 @@ bool Commands::SetSpawnCommand(const shared_ptr<Client>& client, Spawn* target,
     case SPAWN_SET_VALUE_Z: {
       sprintf(tmp, "%f", target->GetZ());
       target->SetZ(atof(value), send_update);
+      target->UpdateGridCell();
       break;
     }
     case SPAWN_SET_VALUE_HEADING: {
@@ -608,6 +610,7 @@ bool Commands::SetSpawnCommand(const shared_ptr<Client>& client, Spawn* target,
     case SPAWN_SET_VALUE_X: {
       target->SetX(atof(value), send_update);
       target->SetSpawnOrigX(target->GetX());
+      target->UpdateGridCell();
       break;
     }
     case SPAWN_SET_VALUE_Y: {
@@ -618,6 +621,7 @@ bool Commands::SetSpawnCommand(const shared_ptr<Client>& client, Spawn* target,
     case SPAWN_SET_VALUE_Z: {
       target->SetZ(atof(value), send_update);
       target->SetSpawnOrigZ(target->GetZ());
+      target->UpdateGridCell();
       break;
     }
     case SPAWN_SET_VALUE_HEADING: {
@@ -1033,9 +1037,8 @@ void Commands::Process(int32 index, EQ2_16BitString* command_parms, const shared
   }
   case COMMAND_RELOAD_GROUNDSPAWNS: {
     client->SimpleMessage(CHANNEL_COLOR_YELLOW, "Reloading Groundspawn Entries...");
-    client->GetCurrentZone()->DeleteGroundSpawnItems();
-    client->GetCurrentZone()->LoadGroundSpawnEntries();
-    client->SimpleMessage(CHANNEL_COLOR_YELLOW, "Done!");
+    // the entries are part of the zone data other instances are reading, they come back with a fresh copy of it
+    client->GetCurrentZone()->ReloadSpawns();
     break;
   }
 
@@ -1050,9 +1053,8 @@ void Commands::Process(int32 index, EQ2_16BitString* command_parms, const shared
   }
   case COMMAND_RELOAD_ENTITYCOMMANDS: {
     client->SimpleMessage(CHANNEL_COLOR_YELLOW, "Reloading Entity Commands...");
-    client->GetCurrentZone()->ClearEntityCommands();
-    database.LoadEntityCommands(client->GetCurrentZone());
-    client->SimpleMessage(CHANNEL_COLOR_YELLOW, "Done!");
+    // same as the groundspawns, spawns point at the commands of the zone data they were loaded with
+    client->GetCurrentZone()->ReloadSpawns();
     break;
   }
   case COMMAND_RELOAD_FACTIONS: {
@@ -1074,6 +1076,12 @@ void Commands::Process(int32 index, EQ2_16BitString* command_parms, const shared
     client->SimpleMessage(CHANNEL_COLOR_YELLOW, "Done!");
     break;
   }
+  case COMMAND_RELOAD_RULES: {
+    client->SimpleMessage(CHANNEL_COLOR_YELLOW, "Reloading Rules...");
+    database.ReloadRuleSets();
+    client->SimpleMessage(CHANNEL_COLOR_YELLOW, "Done!");
+    break;
+  }
   case COMMAND_RELOAD_LOCATIONS: {
     client->SimpleMessage(CHANNEL_COLOR_YELLOW, "Reloading Locations...");
     client->GetPlayer()->GetZone()->RemoveLocationGrids();
@@ -2629,9 +2637,38 @@ void Commands::Process(int32 index, EQ2_16BitString* command_parms, const shared
       }
 
       client->SimpleMessage(CHANNEL_COLOR_YELLOW, "You will no longer receive LUA error messages.");
+    } else if (sep && sep->arg[0][0] && strcmp(sep->arg[0], "profile") == 0 && lua_interface) {
+      LuaProfiler* profiler = lua_interface->GetProfiler();
+
+      if (strcmp(sep->arg[1], "start") == 0) {
+        profiler->SetEnabled(true);
+        client->SimpleMessage(CHANNEL_COLOR_YELLOW, "LUA profiling started.");
+      } else if (strcmp(sep->arg[1], "stop") == 0) {
+        profiler->SetEnabled(false);
+        client->SimpleMessage(CHANNEL_COLOR_YELLOW, "LUA profiling stopped.");
+      } else if (strcmp(sep->arg[1], "reset") == 0) {
+        profiler->Reset();
+        client->SimpleMessage(CHANNEL_COLOR_YELLOW, "LUA profile cleared.");
+      } else if (strcmp(sep->arg[1], "slow") == 0 && sep->IsNumber(2)) {
+        profiler->SetSlowCallThreshold(atoul(sep->arg[2]));
+        client->Message(CHANNEL_COLOR_YELLOW, "LUA calls taking %ums or longer will be logged (0 = off).", profiler->GetSlowCallThreshold());
+      } else if (strcmp(sep->arg[1], "dump") == 0) {
+        if (profiler->WriteReport("lua_profile.txt"))
+          client->SimpleMessage(CHANNEL_COLOR_YELLOW, "LUA profile written to lua_profile.txt.");
+        else
+          client->SimpleMessage(CHANNEL_COLOR_YELLOW, "Unable to write lua_profile.txt.");
+      } else {
+        vector<string> lines;
+        profiler->GetReport(lines, sep->IsNumber(1) ? atoul(sep->arg[1]) : 10);
+        client->Message(CHANNEL_COLOR_YELLOW, "LUA profile (%s), script times include the bindings they call:", profiler->IsEnabled() ? "running" : "stopped");
+        for (const string& line : lines)
+          client->Message(CHANNEL_COLOR_YELLOW, "%s", line.c_str());
+      }
     } else {
       client->SimpleMessage(CHANNEL_COLOR_YELLOW, "Syntax: /luadebug {start | stop}");
       client->SimpleMessage(CHANNEL_COLOR_YELLOW, "This will allow you to receive lua debug messages normally seen only in the console.");
+      client->SimpleMessage(CHANNEL_COLOR_YELLOW, "Syntax: /luadebug profile {start | stop | reset | dump | slow [ms] | [count]}");
+      client->SimpleMessage(CHANNEL_COLOR_YELLOW, "Times the LUA scripts and bindings, /luadebug profile shows the functions with the most total time.");
     }
     break;
   }
@@ -911,5 +911,6 @@ private:
 #define COMMAND_KNOCKBACK 2008
 #define COMMAND_HEAL 2009
 #define COMMAND_DEBUG 2010
+#define COMMAND_RELOAD_RULES 2011 // INSERT INTO `commands`(`id`,`type`,`command`,`subcommand`,`handler`,`required_status`) VALUES ( NULL,'1','reload','rules','2011','100');
 
 #endif
@@ -57,7 +57,7 @@ void ProcessConsoleInput(const char* cmdInput) {
       {&ConsoleGuildCommand, "guild", "[params]", ""},
       {&ConsolePlayerCommand, "player", "[params]", ""},
       {&ConsoleZoneCommand, "zone", "[command][value]", "command = help to get help"},
-      {&ConsoleWorldCommand, "world", "[params]", ""},
+      {&ConsoleWorldCommand, "world", "[saves]", "Show world statistics"},
       {&ConsoleGetMOTDCommand, "getmotd", "", "Display current MOTD"},
       {&ConsoleSetMOTDCommand, "setmotd", "[new motd]", "Sets a new MOTD"},
 
@@ -65,6 +65,7 @@ void ProcessConsoleInput(const char* cmdInput) {
       {&ConsoleWhoCommand, "who", "{zone id | player}", "Shows who is online globally, or in a given zone."},
       {&ConsoleReloadCommand, "reload", "[all | [type]]", "Reload main systems."},
       {&ConsoleRulesCommand, "rules", "{zone} {id}", "Show Global Ruleset (or Zone ruleset {optional})"},
+      {&ConsoleMutexCommand, "mutex", "{reset}", "Show lock wait times per mutex (or clear them {optional})"},
       {&ConsoleShutdownCommand, "shutdown", "[delay]", "Gracefully shutdown world in [delay] sesconds."},
       {&ConsoleCancelShutdownCommand, "cancel", "", "Cancel shutdown command."},
       {&ConsoleExitCommand, "exit", "", "Brutally kills the world without mercy."},
@@ -208,7 +209,27 @@ bool ConsoleWorldCommand(Seperator* sep) {
   if (strlen(sep->arg[1]) == 0)
     return false;
 
-  return true;
+  if (!strcasecmp(sep->arg[1], "saves")) {
+    CharacterSaveStats stats = database.GetCharacterSaveStats();
+
+    printf("> Character saves...\n");
+    printf("====================================================\n");
+    printf("| %30s | %15s |\n", "Param", "Value");
+    printf("====================================================\n");
+    printf("| %30s | %15u |\n", "saves", stats.saves);
+    printf("| %30s | %15u |\n", "skipped (no changes)", stats.skipped);
+    printf("| %30s | %15u |\n", "failed", stats.failed);
+    printf("| %30s | %15u |\n", "rows", stats.rows);
+    printf("| %30s | %15u |\n", "statements", stats.statements);
+    printf("| %30s | %15.2f |\n", "avg rows / save", stats.saves > 0 ? (float)stats.rows / stats.saves : 0.0f);
+    printf("| %30s | %15.2f |\n", "avg ms / save", stats.saves > 0 ? (float)stats.total_ms / stats.saves : 0.0f);
+    printf("| %30s | %15u |\n", "max ms", stats.max_ms);
+    printf("| %30s | %15u |\n", "queued db work", database.GetQueuedWorkCount());
+    printf("====================================================\n");
+    return true;
+  }
+
+  return false;
 }
 
 bool ConsoleZoneCommand(Seperator* sep) {
@@ -451,6 +472,18 @@ bool ConsoleRulesCommand(Seperator* sep) {
   return true;
 }
 
+bool ConsoleMutexCommand(Seperator* sep) {
+  if (!strcasecmp(sep->arg[1], "reset")) {
+    Mutex::ResetWaitStats();
+    printf("Mutex wait times cleared.\n");
+    return true;
+  } else if (strlen(sep->arg[1]) > 0)
+    return false;
+
+  Mutex::PrintWaitStats();
+  return true;
+}
+
 bool ConsoleTestCommand(Seperator* sep) {
   // devs put whatever test code in here
   printf("Testing Server Guild Rules values:\n");
@@ -55,6 +55,7 @@ bool ConsoleShutdownCommand(Seperator* sep);
 bool ConsoleCancelShutdownCommand(Seperator* sep);
 bool ConsoleExitCommand(Seperator* sep);
 bool ConsoleRulesCommand(Seperator* sep);
+bool ConsoleMutexCommand(Seperator* sep);
 bool ConsoleTestCommand(Seperator* sep);
 
 #endif
\ No newline at end of file
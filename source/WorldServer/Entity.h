@@ -312,6 +312,13 @@ struct ThreatTransfer {
   shared_ptr<LuaSpell> Spell;
 };
 
+// Hate waiting to be added to a brain's hate table
+struct HateChange {
+  Entity* entity;
+  sint32 hate;
+  bool unprovoked;
+};
+
 #define DET_TYPE_ALL 0
 #define DET_TYPE_TRAUMA 1
 #define DET_TYPE_ARCANE 2
@@ -560,6 +567,8 @@ public:
   bool DamageSpawn(Entity* victim, int8 type, int8 damage_type, int32 low_damage, int32 high_damage, const char* spell_name, int8 crit_mod = 0, bool is_tick = false, bool no_damage_calcs = false);
   bool HealSpawn(Spawn* target, string heal_type, int32 low_heal, int32 high_heal, const char* spell_name, int8 crit_mod = 0, bool is_tick = false, bool perform_calcs = true);
   void AddHate(Entity* attacker, sint32 hate, bool unprovoked = false);
+  // Adds the hate that attacker passes on to others (threat transfer, pet owners)
+  void GetSharedHate(Entity* attacker, sint32 hate, vector<HateChange>& hates);
   bool CheckInterruptSpell(Entity* attacker);
   void KillSpawn(Spawn* dead, int8 damage_type = 0, int16 kill_blow_type = 0);
   void SetAttackDelay(bool primary = false, bool ranged = false);
@@ -37,567 +37,416 @@ extern MasterRecipeList master_recipe_list;
 extern ConfigReader configReader;
 extern LuaInterface* lua_interface;
 
+// Fields of the item examine structs, set for every item sent to a client
+static const PacketField field_wield_type("wield_type");
+static const PacketField field_damage_low1("damage_low1");
+static const PacketField field_damage_high1("damage_high1");
+static const PacketField field_damage_low2("damage_low2");
+static const PacketField field_damage_high2("damage_high2");
+static const PacketField field_damage_low3("damage_low3");
+static const PacketField field_damage_high3("damage_high3");
+static const PacketField field_damage_type("damage_type");
+static const PacketField field_delay("delay");
+static const PacketField field_rating("rating");
+static const PacketField field_range_low("range_low");
+static const PacketField field_range_high("range_high");
+static const PacketField field_mitigation_low("mitigation_low");
+static const PacketField field_mitigation_high("mitigation_high");
+static const PacketField field_num_slots("num_slots");
+static const PacketField field_num_empty("num_empty");
+static const PacketField field_weight_reduction("weight_reduction");
+static const PacketField field_item_score("item_score");
+static const PacketField field_unknown5("unknown5");
+static const PacketField field_unknown6("unknown6");
+static const PacketField field_food_type("food_type");
+static const PacketField field_level("level");
+static const PacketField field_duration("duration");
+static const PacketField field_unknown2("unknown2");
+static const PacketField field_scribed("scribed");
+static const PacketField field_unknown26("unknown26");
+static const PacketField field_cast("cast");
+static const PacketField field_recovery("recovery");
+static const PacketField field_recast("recast");
+static const PacketField field_display_slot_optional("display_slot_optional");
+static const PacketField field_display_cast_time("display_cast_time");
+static const PacketField field_display_bauble_type("display_bauble_type");
+static const PacketField field_effect_radius("effect_radius");
+static const PacketField field_max_aoe_targets("max_aoe_targets");
+static const PacketField field_display_until_cancelled("display_until_cancelled");
+static const PacketField field_range("range");
+static const PacketField field_damage_modifier("damage_modifier");
+static const PacketField field_hit_bonus("hit_bonus");
+static const PacketField field_status_rent_reduction("status_rent_reduction");
+static const PacketField field_coin_rent_reduction("coin_rent_reduction");
+static const PacketField field_house_only("house_only");
+static const PacketField field_language("language");
+static const PacketField field_item_type("item_type");
+static const PacketField field_uses("uses");
+static const PacketField field_item_types("item_types");
+static const PacketField field_slot_type("slot_type");
+static const PacketField field_footer_set_name("footer_set_name");
+static const PacketField field_allowed_types("allowed_types");
+static const PacketField field_broker_commission("broker_commission");
+static const PacketField field_fence_commission("fence_commission");
+
 MasterItemList::~MasterItemList() {
   RemoveAll();
 }
 
-vector<Item*>* MasterItemList::GetItems(string name, int32 itype, int32 ltype, int32 btype, int64 minprice, int64 maxprice, int8 minskill, int8 maxskill, string seller, string adornment, int8 mintier, int8 maxtier, int16 minlevel, int16 maxlevel, sint8 itemclass) {
-  vector<Item*>* ret = new vector<Item*>;
+// Broker stat filters and the item stat each one looks for. HEALTH and POWER have always matched on STR.
+static const int32 broker_stat_types[][2] = {
+  { ITEM_BROKER_STAT_TYPE_DEF, ITEM_STAT_DEFLECTIONCHANCE },
+  { ITEM_BROKER_STAT_TYPE_STR, ITEM_STAT_STR },
+  { ITEM_BROKER_STAT_TYPE_STA, ITEM_STAT_STA },
+  { ITEM_BROKER_STAT_TYPE_AGI, ITEM_STAT_AGI },
+  { ITEM_BROKER_STAT_TYPE_WIS, ITEM_STAT_WIS },
+  { ITEM_BROKER_STAT_TYPE_INT, ITEM_STAT_INT },
+  { ITEM_BROKER_STAT_TYPE_HEALTH, ITEM_STAT_STR },
+  { ITEM_BROKER_STAT_TYPE_POWER, ITEM_STAT_STR },
+  { ITEM_BROKER_STAT_TYPE_HEAT, ITEM_STAT_VS_ELEMENTAL },
+  { ITEM_BROKER_STAT_TYPE_COLD, ITEM_STAT_VS_COLD },
+  { ITEM_BROKER_STAT_TYPE_MAGIC, ITEM_STAT_VS_ARCANE },
+  { ITEM_BROKER_STAT_TYPE_MENTAL, ITEM_STAT_VS_MENTAL },
+  { ITEM_BROKER_STAT_TYPE_DIVINE, ITEM_STAT_VS_DIVINE },
+  { ITEM_BROKER_STAT_TYPE_POISON, ITEM_STAT_VS_NOXIOUS },
+  { ITEM_BROKER_STAT_TYPE_DISEASE, ITEM_STAT_VS_DISEASE },
+  { ITEM_BROKER_STAT_TYPE_CRUSH, ITEM_STAT_DMG_CRUSH },
+  { ITEM_BROKER_STAT_TYPE_SLASH, ITEM_STAT_DMG_SLASH },
+  { ITEM_BROKER_STAT_TYPE_PIERCE, ITEM_STAT_DMG_PIERCE }
+};
+
+static int32 GetBrokerTypes(Item* item) {
+  int32 types = 0;
+  if (item->IsAdornment())
+    types |= ITEM_BROKER_TYPE_ADORNMENT;
+  if (item->IsAmmo())
+    types |= ITEM_BROKER_TYPE_AMMO;
+  if (item->CheckFlag(ATTUNEABLE))
+    types |= ITEM_BROKER_TYPE_ATTUNEABLE;
+  if (item->IsBag())
+    types |= ITEM_BROKER_TYPE_BAG;
+  if (item->IsBauble())
+    types |= ITEM_BROKER_TYPE_BAUBLE;
+  if (item->IsBook())
+    types |= ITEM_BROKER_TYPE_BOOK;
+  if (item->IsChainArmor())
+    types |= ITEM_BROKER_TYPE_CHAINARMOR;
+  if (item->IsCloak())
+    types |= ITEM_BROKER_TYPE_CLOAK;
+  if (item->IsClothArmor())
+    types |= ITEM_BROKER_TYPE_CLOTHARMOR;
+  if (item->IsCollectable())
+    types |= ITEM_BROKER_TYPE_COLLECTABLE;
+  if (item->IsCrushWeapon())
+    types |= ITEM_BROKER_TYPE_CRUSHWEAPON;
+  if (item->IsFoodDrink())
+    types |= ITEM_BROKER_TYPE_DRINK;
+  if (item->IsFoodFood())
+    types |= ITEM_BROKER_TYPE_FOOD;
+  if (item->IsHouseItem())
+    types |= ITEM_BROKER_TYPE_HOUSEITEM;
+  if (item->IsJewelry())
+    types |= ITEM_BROKER_TYPE_JEWELRY;
+  if (item->IsLeatherArmor())
+    types |= ITEM_BROKER_TYPE_LEATHERARMOR;
+  if (item->CheckFlag(LORE))
+    types |= ITEM_BROKER_TYPE_LORE;
+  if (item->IsMisc())
+    types |= ITEM_BROKER_TYPE_MISC;
+  if (item->IsPierceWeapon())
+    types |= ITEM_BROKER_TYPE_PIERCEWEAPON;
+  if (item->IsPlateArmor())
+    types |= ITEM_BROKER_TYPE_PLATEARMOR;
+  if (item->IsPoison())
+    types |= ITEM_BROKER_TYPE_POISON;
+  if (item->IsPotion())
+    types |= ITEM_BROKER_TYPE_POTION;
+  if (item->IsRecipeBook())
+    types |= ITEM_BROKER_TYPE_RECIPEBOOK;
+  if (item->IsSalesDisplay())
+    types |= ITEM_BROKER_TYPE_SALESDISPLAY;
+  if (item->IsShield())
+    types |= ITEM_BROKER_TYPE_SHIELD;
+  if (item->IsSlashWeapon())
+    types |= ITEM_BROKER_TYPE_SLASHWEAPON;
+  if (item->IsSpellScroll())
+    types |= ITEM_BROKER_TYPE_SPELLSCROLL;
+  if (item->IsTinkered())
+    types |= ITEM_BROKER_TYPE_TINKERED;
+  if (item->IsTradeskill())
+    types |= ITEM_BROKER_TYPE_TRADESKILL;
+  return types;
+}
+
+static int32 GetBrokerSlots(Item* item) {
+  int32 slots = 0;
+  if (item->HasSlot(EQ2_AMMO_SLOT))
+    slots |= ITEM_BROKER_SLOT_AMMO;
+  if (item->HasSlot(EQ2_CHARM_SLOT_1, EQ2_CHARM_SLOT_2))
+    slots |= ITEM_BROKER_SLOT_CHARM;
+  if (item->HasSlot(EQ2_CHEST_SLOT))
+    slots |= ITEM_BROKER_SLOT_CHEST;
+  if (item->HasSlot(EQ2_CLOAK_SLOT))
+    slots |= ITEM_BROKER_SLOT_CLOAK;
+  if (item->HasSlot(EQ2_DRINK_SLOT))
+    slots |= ITEM_BROKER_SLOT_DRINK;
+  if (item->HasSlot(EQ2_EARS_SLOT_1, EQ2_EARS_SLOT_2))
+    slots |= ITEM_BROKER_SLOT_EARS;
+  if (item->HasSlot(EQ2_FEET_SLOT))
+    slots |= ITEM_BROKER_SLOT_FEET;
+  if (item->HasSlot(EQ2_FOOD_SLOT))
+    slots |= ITEM_BROKER_SLOT_FOOD;
+  if (item->HasSlot(EQ2_FOREARMS_SLOT))
+    slots |= ITEM_BROKER_SLOT_FOREARMS;
+  if (item->HasSlot(EQ2_HANDS_SLOT))
+    slots |= ITEM_BROKER_SLOT_HANDS;
+  if (item->HasSlot(EQ2_HEAD_SLOT))
+    slots |= ITEM_BROKER_SLOT_HEAD;
+  if (item->HasSlot(EQ2_LEGS_SLOT))
+    slots |= ITEM_BROKER_SLOT_LEGS;
+  if (item->HasSlot(EQ2_NECK_SLOT))
+    slots |= ITEM_BROKER_SLOT_NECK;
+  if (item->HasSlot(EQ2_PRIMARY_SLOT)) {
+    slots |= ITEM_BROKER_SLOT_PRIMARY;
+    if (item->IsWeapon() && item->weapon_info->wield_type == ITEM_WIELD_TYPE_TWO_HAND)
+      slots |= ITEM_BROKER_SLOT_PRIMARY_2H;
+  }
+  if (item->HasSlot(EQ2_RANGE_SLOT))
+    slots |= ITEM_BROKER_SLOT_RANGE_WEAPON;
+  if (item->HasSlot(EQ2_LRING_SLOT, EQ2_RRING_SLOT))
+    slots |= ITEM_BROKER_SLOT_RING;
+  if (item->HasSlot(EQ2_SECONDARY_SLOT))
+    slots |= ITEM_BROKER_SLOT_SECONDARY;
+  if (item->HasSlot(EQ2_SHOULDERS_SLOT))
+    slots |= ITEM_BROKER_SLOT_SHOULDERS;
+  if (item->HasSlot(EQ2_WAIST_SLOT))
+    slots |= ITEM_BROKER_SLOT_WAIST;
+  if (item->HasSlot(EQ2_LWRIST_SLOT, EQ2_RWRIST_SLOT))
+    slots |= ITEM_BROKER_SLOT_WRIST;
+  return slots;
+}
+
+static int32 GetBrokerStats(Item* item) {
+  int32 stats = 0;
+  vector<ItemStat*>::iterator itr;
+  for (itr = item->item_stats.begin(); itr != item->item_stats.end(); itr++) {
+    for (int32 i = 0; i < sizeof(broker_stat_types) / sizeof(broker_stat_types[0]); i++) {
+      if ((*itr)->stat_type_combined == broker_stat_types[i][1])
+        stats |= broker_stat_types[i][0];
+    }
+  }
+  return stats;
+}
+
+static inline int32 GetNameTrigram(const char* name) {
+  return ((int32)(unsigned char)name[0] << 16) | ((int32)(unsigned char)name[1] << 8) | (unsigned char)name[2];
+}
+
+MasterItemList::MasterItemList() {
+  search_index_built = false;
+}
+
+void MasterItemList::BuildSearchIndex() {
+  unique_lock<shared_timed_mutex> lock(search_mutex);
+
+  search_entries.clear();
+  search_by_type.clear();
+  search_by_slot.clear();
+  search_by_stat.clear();
+  search_by_tier.clear();
+  search_by_class.clear();
+  search_by_trigram.clear();
+  search_entries.reserve(items.size());
+
   map<int32, Item*>::iterator iter;
-  Item* item = 0;
-  const char* chkname = 0;
-  //const char* chkseller = 0;
-  //const char* chkadornment = 0;
-  if (name.length() > 0)
-    chkname = name.c_str();
-  //if(seller.length() > 0)
-  //	chkseller = seller.c_str();
-  //if(adornment.length() > 0)
-  //	chkadornment = adornment.c_str();
-  bool should_add = true;
   for (iter = items.begin(); iter != items.end(); iter++) {
-    item = iter->second;
-    if (item) {
-      if (itype != ITEM_BROKER_TYPE_ANY) {
-        should_add = false;
-        switch (itype) {
-        case ITEM_BROKER_TYPE_ADORNMENT: {
-          if (item->IsAdornment())
-            should_add = true;
-          break;
-        }
-        case ITEM_BROKER_TYPE_AMMO: {
-          if (item->IsAmmo())
-            should_add = true;
-          break;
-        }
-        case ITEM_BROKER_TYPE_ATTUNEABLE: {
-          if (item->CheckFlag(ATTUNEABLE))
-            should_add = true;
-          break;
-        }
-        case ITEM_BROKER_TYPE_BAG: {
-          if (item->IsBag())
-            should_add = true;
-          break;
-        }
-        case ITEM_BROKER_TYPE_BAUBLE: {
-          if (item->IsBauble())
-            should_add = true;
-          break;
-        }
-        case ITEM_BROKER_TYPE_BOOK: {
-          if (item->IsBook())
-            should_add = true;
-          break;
-        }
-        case ITEM_BROKER_TYPE_CHAINARMOR: {
-          if (item->IsChainArmor())
-            should_add = true;
-          break;
-        }
-        case ITEM_BROKER_TYPE_CLOAK: {
-          if (item->IsCloak())
-            should_add = true;
-          break;
-        }
-        case ITEM_BROKER_TYPE_CLOTHARMOR: {
-          if (item->IsClothArmor())
-            should_add = true;
-          break;
-        }
-        case ITEM_BROKER_TYPE_COLLECTABLE: {
-          if (item->IsCollectable())
-            should_add = true;
-          break;
-        }
-        case ITEM_BROKER_TYPE_CRUSHWEAPON: {
-          if (item->IsCrushWeapon())
-            should_add = true;
-          break;
-        }
-        case ITEM_BROKER_TYPE_DRINK: {
-          if (item->IsFoodDrink())
-            should_add = true;
-          break;
-        }
-        case ITEM_BROKER_TYPE_FOOD: {
-          if (item->IsFoodFood())
-            should_add = true;
-          break;
-        }
-        case ITEM_BROKER_TYPE_HOUSEITEM: {
-          if (item->IsHouseItem())
-            should_add = true;
-          break;
-        }
-        case ITEM_BROKER_TYPE_JEWELRY: {
-          if (item->IsJewelry())
-            should_add = true;
-          break;
-        }
-        case ITEM_BROKER_TYPE_LEATHERARMOR: {
-          if (item->IsLeatherArmor())
-            should_add = true;
-          break;
-        }
-        case ITEM_BROKER_TYPE_LORE: {
-          if (item->CheckFlag(LORE))
-            should_add = true;
-          break;
-        }
-        case ITEM_BROKER_TYPE_MISC: {
-          if (item->IsMisc())
-            should_add = true;
-          break;
-        }
-        case ITEM_BROKER_TYPE_PIERCEWEAPON: {
-          if (item->IsPierceWeapon())
-            should_add = true;
-          break;
-        }
-        case ITEM_BROKER_TYPE_PLATEARMOR: {
-          if (item->IsPlateArmor())
-            should_add = true;
-          break;
-        }
-        case ITEM_BROKER_TYPE_POISON: {
-          if (item->IsPoison())
-            should_add = true;
-          break;
-        }
-        case ITEM_BROKER_TYPE_POTION: {
-          if (item->IsPotion())
-            should_add = true;
-          break;
-        }
-        case ITEM_BROKER_TYPE_RECIPEBOOK: {
-          if (item->IsRecipeBook())
-            should_add = true;
-          break;
-        }
-        case ITEM_BROKER_TYPE_SALESDISPLAY: {
-          if (item->IsSalesDisplay())
-            should_add = true;
-          break;
-        }
-        case ITEM_BROKER_TYPE_SHIELD: {
-          if (item->IsShield())
-            should_add = true;
-          break;
-        }
-        case ITEM_BROKER_TYPE_SLASHWEAPON: {
-          if (item->IsSlashWeapon())
-            should_add = true;
-          break;
-        }
-        case ITEM_BROKER_TYPE_SPELLSCROLL: {
-          if (item->IsSpellScroll())
-            should_add = true;
-          break;
-        }
-        case ITEM_BROKER_TYPE_TINKERED: {
-          if (item->IsTinkered())
-            should_add = true;
-          break;
-        }
-        case ITEM_BROKER_TYPE_TRADESKILL: {
-          if (item->IsTradeskill())
-            should_add = true;
-          break;
-        }
-        }
-        if (!should_add)
-          continue;
-      }
-      if (ltype != ITEM_BROKER_SLOT_ANY) {
-        should_add = false;
-        switch (ltype) {
-        case ITEM_BROKER_SLOT_AMMO: {
-          should_add = item->HasSlot(EQ2_AMMO_SLOT);
-          break;
-        }
-        case ITEM_BROKER_SLOT_CHARM: {
-          should_add = item->HasSlot(EQ2_CHARM_SLOT_1, EQ2_CHARM_SLOT_2);
-          break;
-        }
-        case ITEM_BROKER_SLOT_CHEST: {
-          should_add = item->HasSlot(EQ2_CHEST_SLOT);
-          break;
-        }
-        case ITEM_BROKER_SLOT_CLOAK: {
-          should_add = item->HasSlot(EQ2_CLOAK_SLOT);
-          break;
-        }
-        case ITEM_BROKER_SLOT_DRINK: {
-          should_add = item->HasSlot(EQ2_DRINK_SLOT);
-          break;
-        }
-        case ITEM_BROKER_SLOT_EARS: {
-          should_add = item->HasSlot(EQ2_EARS_SLOT_1, EQ2_EARS_SLOT_2);
-          break;
-        }
-        case ITEM_BROKER_SLOT_FEET: {
-          should_add = item->HasSlot(EQ2_FEET_SLOT);
-          break;
-        }
-        case ITEM_BROKER_SLOT_FOOD: {
-          should_add = item->HasSlot(EQ2_FOOD_SLOT);
-          break;
-        }
-        case ITEM_BROKER_SLOT_FOREARMS: {
-          should_add = item->HasSlot(EQ2_FOREARMS_SLOT);
-          break;
-        }
-        case ITEM_BROKER_SLOT_HANDS: {
-          should_add = item->HasSlot(EQ2_HANDS_SLOT);
-          break;
-        }
-        case ITEM_BROKER_SLOT_HEAD: {
-          should_add = item->HasSlot(EQ2_HEAD_SLOT);
-          break;
-        }
-        case ITEM_BROKER_SLOT_LEGS: {
-          should_add = item->HasSlot(EQ2_LEGS_SLOT);
-          break;
-        }
-        case ITEM_BROKER_SLOT_NECK: {
-          should_add = item->HasSlot(EQ2_NECK_SLOT);
-          break;
-        }
-        case ITEM_BROKER_SLOT_PRIMARY: {
-          should_add = item->HasSlot(EQ2_PRIMARY_SLOT);
-          break;
-        }
-        case ITEM_BROKER_SLOT_PRIMARY_2H: {
-          should_add = item->HasSlot(EQ2_PRIMARY_SLOT) && item->IsWeapon() && item->weapon_info->wield_type == ITEM_WIELD_TYPE_TWO_HAND;
-          break;
-        }
-        case ITEM_BROKER_SLOT_RANGE_WEAPON: {
-          should_add = item->HasSlot(EQ2_RANGE_SLOT);
-          break;
-        }
-        case ITEM_BROKER_SLOT_RING: {
-          should_add = item->HasSlot(EQ2_LRING_SLOT, EQ2_RRING_SLOT);
-          break;
-        }
-        case ITEM_BROKER_SLOT_SECONDARY: {
-          should_add = item->HasSlot(EQ2_SECONDARY_SLOT);
-          break;
-        }
-        case ITEM_BROKER_SLOT_SHOULDERS: {
-          should_add = item->HasSlot(EQ2_SHOULDERS_SLOT);
-          break;
-        }
-        case ITEM_BROKER_SLOT_WAIST: {
-          should_add = item->HasSlot(EQ2_WAIST_SLOT);
-          break;
-        }
-        case ITEM_BROKER_SLOT_WRIST: {
-          should_add = item->HasSlot(EQ2_LWRIST_SLOT, EQ2_RWRIST_SLOT);
-          break;
-        }
-        }
-        if (!should_add)
-          continue;
-      }
+    Item* item = iter->second;
+    if (!item)
+      continue;
+
+    ItemSearchEntry entry;
+    entry.item = item;
+    entry.types = GetBrokerTypes(item);
+    entry.slots = GetBrokerSlots(item);
+    entry.stats = GetBrokerStats(item);
+    entry.no_stats = (item->item_stats.size() == 0);
+    entry.classes = item->generic_info.adventure_classes | item->generic_info.tradeskill_classes;
+    entry.recommended_level = item->details.recommended_level;
+    entry.adventure_level = item->generic_info.adventure_default_level;
+    entry.tradeskill_level = item->generic_info.tradeskill_default_level;
+    entry.tier = item->details.tier;
+    entry.skill_min = item->generic_info.skill_min;
+
+    int32 pos = search_entries.size();
+    search_entries.push_back(entry);
+
+    for (int32 bit = 1; bit != 0; bit <<= 1) {
+      if (entry.types & bit)
+        search_by_type[bit].push_back(pos);
+      if (entry.slots & bit)
+        search_by_slot[bit].push_back(pos);
+      if (entry.stats & bit)
+        search_by_stat[bit].push_back(pos);
+    }
+    if (entry.no_stats)
+      search_by_stat[ITEM_BROKER_STAT_TYPE_NONE].push_back(pos);
+    search_by_tier[entry.tier].push_back(pos);
+    for (sint8 itemclass = 1; itemclass < 64; itemclass++) {
+      if (entry.classes & (((int64)2) << (itemclass - 1)))
+        search_by_class[itemclass].push_back(pos);
+    }
+
+    // a name can hold the same trigram more than once, only list the item once for it
+    const string& name = item->lowername;
+    for (int32 i = 0; i + 3 <= name.length(); i++) {
+      vector<int32>& list = search_by_trigram[GetNameTrigram(name.c_str() + i)];
+      if (list.size() == 0 || list.back() != pos)
+        list.push_back(pos);
+    }
+  }
+
+  search_index_built = true;
+  LogWrite(ITEM__DEBUG, 0, "Items", "Built broker search index for %u items (%u name trigrams)", search_entries.size(), search_by_trigram.size());
+}
+
+bool MasterItemList::MatchesSearch(const ItemSearchEntry& entry, const ItemSearchCriteria& criteria) {
+  if (criteria.itype != ITEM_BROKER_TYPE_ANY && !(entry.types & criteria.itype))
+    return false;
+  if (criteria.ltype != ITEM_BROKER_SLOT_ANY && !(entry.slots & criteria.ltype))
+    return false;
+  if (criteria.btype != 0xFFFFFFFF) {
+    if (criteria.btype == ITEM_BROKER_STAT_TYPE_NONE) {
+      if (!entry.no_stats)
+        return false;
+    } else if (!(entry.stats & criteria.btype))
+      return false;
+  }
+  if (criteria.itemclass > 0 && !(entry.classes & (((int64)2) << (criteria.itemclass - 1))))
+    return false;
+  if (criteria.name.length() > 0 && entry.item->lowername.find(criteria.name) == string::npos)
+    return false;
 
-      if (btype != 0xFFFFFFFF) {
-        vector<ItemStat*>::iterator itr;
-        bool stat_found = false;
-        should_add = false;
-        switch (btype) {
-        case ITEM_BROKER_STAT_TYPE_NONE: {
-          if (item->item_stats.size() == 0)
-            should_add = true;
-          break;
-        }
-        case ITEM_BROKER_STAT_TYPE_DEF: {
-          for (itr = item->item_stats.begin(); itr != item->item_stats.end() && !stat_found; itr++) {
-            if ((*itr)->stat_type_combined == ITEM_STAT_DEFLECTIONCHANCE) {
-              stat_found = true;
-              break;
-            }
-          }
-          if (stat_found)
-            should_add = true;
-          break;
-        }
-        case ITEM_BROKER_STAT_TYPE_STR: {
-          for (itr = item->item_stats.begin(); itr != item->item_stats.end() && !stat_found; itr++) {
-            if ((*itr)->stat_type_combined == ITEM_STAT_STR) {
-              stat_found = true;
-              break;
-            }
-          }
-          if (stat_found)
-            should_add = true;
-          break;
-        }
-        case ITEM_BROKER_STAT_TYPE_STA: {
-          for (itr = item->item_stats.begin(); itr != item->item_stats.end() && !stat_found; itr++) {
-            if ((*itr)->stat_type_combined == ITEM_STAT_STA) {
-              stat_found = true;
-              break;
-            }
-          }
-          if (stat_found)
-            should_add = true;
-          break;
-        }
-        case ITEM_BROKER_STAT_TYPE_AGI: {
-          for (itr = item->item_stats.begin(); itr != item->item_stats.end() && !stat_found; itr++) {
-            if ((*itr)->stat_type_combined == ITEM_STAT_AGI) {
-              stat_found = true;
-              break;
-            }
-          }
-          if (stat_found)
-            should_add = true;
-          break;
-        }
-        case ITEM_BROKER_STAT_TYPE_WIS: {
-          for (itr = item->item_stats.begin(); itr != item->item_stats.end() && !stat_found; itr++) {
-            if ((*itr)->stat_type_combined == ITEM_STAT_WIS) {
-              stat_found = true;
-              break;
-            }
-          }
-          if (stat_found)
-            should_add = true;
-          break;
-        }
-        case ITEM_BROKER_STAT_TYPE_INT: {
-          for (itr = item->item_stats.begin(); itr != item->item_stats.end() && !stat_found; itr++) {
-            if ((*itr)->stat_type_combined == ITEM_STAT_INT) {
-              stat_found = true;
-              break;
-            }
-          }
-          if (stat_found)
-            should_add = true;
-          break;
-        }
-        case ITEM_BROKER_STAT_TYPE_HEALTH: {
-          for (itr = item->item_stats.begin(); itr != item->item_stats.end() && !stat_found; itr++) {
-            if ((*itr)->stat_type_combined == ITEM_STAT_STR) {
-              stat_found = true;
-              break;
-            }
-          }
-          if (stat_found)
-            should_add = true;
-          break;
-        }
-        case ITEM_BROKER_STAT_TYPE_POWER: {
-          for (itr = item->item_stats.begin(); itr != item->item_stats.end() && !stat_found; itr++) {
-            if ((*itr)->stat_type_combined == ITEM_STAT_STR) {
-              stat_found = true;
-              break;
-            }
-          }
-          if (stat_found)
-            should_add = true;
-          break;
-        }
-        case ITEM_BROKER_STAT_TYPE_HEAT: {
-          for (itr = item->item_stats.begin(); itr != item->item_stats.end() && !stat_found; itr++) {
-            if ((*itr)->stat_type_combined == ITEM_STAT_VS_ELEMENTAL) {
-              stat_found = true;
-              break;
-            }
-          }
-          if (stat_found)
-            should_add = true;
-          break;
-        }
-        case ITEM_BROKER_STAT_TYPE_COLD: {
-          for (itr = item->item_stats.begin(); itr != item->item_stats.end() && !stat_found; itr++) {
-            if ((*itr)->stat_type_combined == ITEM_STAT_VS_COLD) {
-              stat_found = true;
-              break;
-            }
-          }
-          if (stat_found)
-            should_add = true;
-          break;
-        }
-        case ITEM_BROKER_STAT_TYPE_MAGIC: {
-          for (itr = item->item_stats.begin(); itr != item->item_stats.end() && !stat_found; itr++) {
-            if ((*itr)->stat_type_combined == ITEM_STAT_VS_ARCANE) {
-              stat_found = true;
-              break;
-            }
-          }
-          if (stat_found)
-            should_add = true;
-          break;
-        }
-        case ITEM_BROKER_STAT_TYPE_MENTAL: {
-          for (itr = item->item_stats.begin(); itr != item->item_stats.end() && !stat_found; itr++) {
-            if ((*itr)->stat_type_combined == ITEM_STAT_VS_MENTAL) {
-              stat_found = true;
-              break;
-            }
-          }
-          if (stat_found)
-            should_add = true;
-          break;
-        }
-        case ITEM_BROKER_STAT_TYPE_DIVINE: {
-          for (itr = item->item_stats.begin(); itr != item->item_stats.end() && !stat_found; itr++) {
-            if ((*itr)->stat_type_combined == ITEM_STAT_VS_DIVINE) {
-              stat_found = true;
-              break;
-            }
-          }
-          if (stat_found)
-            should_add = true;
-          break;
-        }
-        case ITEM_BROKER_STAT_TYPE_POISON: {
-          for (itr = item->item_stats.begin(); itr != item->item_stats.end() && !stat_found; itr++) {
-            if ((*itr)->stat_type_combined == ITEM_STAT_VS_NOXIOUS) {
-              stat_found = true;
-              break;
-            }
-          }
-          if (stat_found)
-            should_add = true;
-          break;
-        }
-        case ITEM_BROKER_STAT_TYPE_DISEASE: {
-          for (itr = item->item_stats.begin(); itr != item->item_stats.end() && !stat_found; itr++) {
-            if ((*itr)->stat_type_combined == ITEM_STAT_VS_DISEASE) {
-              stat_found = true;
-              break;
-            }
-          }
-          if (stat_found)
-            should_add = true;
-          break;
-        }
-        case ITEM_BROKER_STAT_TYPE_CRUSH: {
-          for (itr = item->item_stats.begin(); itr != item->item_stats.end() && !stat_found; itr++) {
-            if ((*itr)->stat_type_combined == ITEM_STAT_DMG_CRUSH) {
-              stat_found = true;
-              break;
-            }
-          }
-          if (stat_found)
-            should_add = true;
-          break;
-        }
-        case ITEM_BROKER_STAT_TYPE_SLASH: {
-          for (itr = item->item_stats.begin(); itr != item->item_stats.end() && !stat_found; itr++) {
-            if ((*itr)->stat_type_combined == ITEM_STAT_DMG_SLASH) {
-              stat_found = true;
-              break;
-            }
-          }
-          if (stat_found)
-            should_add = true;
-          break;
-        }
-        case ITEM_BROKER_STAT_TYPE_PIERCE: {
-          for (itr = item->item_stats.begin(); itr != item->item_stats.end() && !stat_found; itr++) {
-            if ((*itr)->stat_type_combined == ITEM_STAT_DMG_PIERCE) {
-              stat_found = true;
-              break;
-            }
-          }
-          if (stat_found)
-            should_add = true;
-          break;
-        }
-        case ITEM_BROKER_STAT_TYPE_CRITICAL: {
-          /*for (itr = item->item_stats.begin(); itr != item->item_stats.end() && !stat_found; itr++) {
-							if ((*itr)->stat_type_combined == ITEM_STAT_STR) {
-								stat_found = true;
-								break;
-							}
-						}
-						if (stat_found)
-							should_add = true;*/
-          LogWrite(ITEM__DEBUG, 0, "Item", "Scatman debugging :).  This needs to be updated when fully support the new expansion");
-          break;
-        }
-        case ITEM_BROKER_STAT_TYPE_DBL_ATTACK: {
-          /*for (itr = item->item_stats.begin(); itr != item->item_stats.end() && !stat_found; itr++) {
-							if ((*itr)->stat_type_combined == ITEM_STAT_STR) {
-								stat_found = true;
-								break;
-							}
-						}
-						if (stat_found)
-							should_add = true;*/
-          LogWrite(ITEM__DEBUG, 0, "Item", "Scatman debugging :).  This needs to be updated when fully support the new expansion");
-          break;
-        }
-        case ITEM_BROKER_STAT_TYPE_ABILITY_MOD: {
-          /*for (itr = item->item_stats.begin(); itr != item->item_stats.end() && !stat_found; itr++) {
-							if ((*itr)->stat_type_combined == ITEM_STAT_STR) {
-								stat_found = true;
-								break;
-							}
-						}
-						if (stat_found)
-							should_add = true;*/
-          LogWrite(ITEM__DEBUG, 0, "Item", "Scatman debugging :).  This needs to be updated when fully support the new expansion");
-          break;
-        }
-        case ITEM_BROKER_STAT_TYPE_POTENCY: {
-          /*for (itr = item->item_stats.begin(); itr != item->item_stats.end() && !stat_found; itr++) {
-							if ((*itr)->stat_type_combined == ITEM_STAT_STR) {
-								stat_found = true;
-								break;
-							}
-						}
-						if (stat_found)
-							should_add = true;*/
-          LogWrite(ITEM__DEBUG, 0, "Item", "Scatman debugging :).  This needs to be updated when fully support the new expansion");
-          break;
-        }
-        default: {
-          LogWrite(ITEM__ERROR, 0, "Item", "Unknown item broker stat type %u", btype);
-          LogWrite(ITEM__DEBUG, 0, "Item", "If you have a client before the new expansion this may be the reason.  Please be patient while we update items to support the new client.", btype);
-          break;
-        }
-        }
-        if (!should_add)
-          continue;
-      }
+  int16 minlevel = criteria.minlevel;
+  int16 maxlevel = criteria.maxlevel;
+  if (entry.adventure_level == 0 && entry.tradeskill_level == 0 && minlevel > 0 && maxlevel > 0) {
+    if (entry.recommended_level < minlevel || entry.recommended_level > maxlevel)
+      return false;
+  } else {
+    if (minlevel > 0 && ((entry.adventure_level == 0 && entry.tradeskill_level == 0) || (entry.adventure_level > 0 && entry.adventure_level < minlevel) || (entry.tradeskill_level > 0 && entry.tradeskill_level < minlevel)))
+      return false;
+    if (maxlevel > 0 && ((entry.adventure_level > 0 && entry.adventure_level > maxlevel) || (entry.tradeskill_level > 0 && entry.tradeskill_level > maxlevel)))
+      return false;
+  }
 
-      if (itemclass > 0) {
-        int64 tmpVal = ((int64)2) << (itemclass - 1);
-        should_add = (item->generic_info.adventure_classes & tmpVal);
-        if (!should_add && !(item->generic_info.tradeskill_classes & tmpVal))
-          continue;
-      }
-      if (chkname && item->lowername.find(chkname) >= 0xFFFFFFFF)
-        continue;
-      if (item->generic_info.adventure_default_level == 0 && item->generic_info.tradeskill_default_level == 0 && minlevel > 0 && maxlevel > 0) {
-        if (item->details.recommended_level < minlevel)
-          continue;
-        if (item->details.recommended_level > maxlevel)
-          continue;
-      } else {
-        if (minlevel > 0 && ((item->generic_info.adventure_default_level == 0 && item->generic_info.tradeskill_default_level == 0) || (item->generic_info.adventure_default_level > 0 && item->generic_info.adventure_default_level < minlevel) || (item->generic_info.tradeskill_default_level > 0 && item->generic_info.tradeskill_default_level < minlevel)))
-          continue;
-        if (maxlevel > 0 && ((item->generic_info.adventure_default_level > 0 && item->generic_info.adventure_default_level > maxlevel) || (item->generic_info.tradeskill_default_level > 0 && item->generic_info.tradeskill_default_level > maxlevel)))
-          continue;
+  if (criteria.mintier > 0 && entry.tier < criteria.mintier)
+    return false;
+  if (criteria.maxtier > 0 && entry.tier > criteria.maxtier)
+    return false;
+  if (criteria.minskill > 0 && entry.skill_min < criteria.minskill)
+    return false;
+  if (criteria.maxskill > 0 && entry.skill_min > criteria.maxskill)
+    return false;
+  return true;
+}
+
+int32 MasterItemList::SearchItems(const ItemSearchCriteria& criteria, vector<Item*>* results, int32 offset, int32 limit) {
+  shared_lock<shared_timed_mutex> lock(search_mutex);
+  while (!search_index_built) {
+    lock.unlock();
+    BuildSearchIndex();
+    lock.lock();
+  }
+
+  if (criteria.btype != 0xFFFFFFFF && criteria.btype != ITEM_BROKER_STAT_TYPE_NONE) {
+    bool known = false;
+    for (int32 i = 0; i < sizeof(broker_stat_types) / sizeof(broker_stat_types[0]); i++) {
+      if (broker_stat_types[i][0] == criteria.btype)
+        known = true;
+    }
+    if (!known) {
+      if (criteria.btype == ITEM_BROKER_STAT_TYPE_CRITICAL || criteria.btype == ITEM_BROKER_STAT_TYPE_DBL_ATTACK || criteria.btype == ITEM_BROKER_STAT_TYPE_ABILITY_MOD || criteria.btype == ITEM_BROKER_STAT_TYPE_POTENCY)
+        LogWrite(ITEM__DEBUG, 0, "Item", "Scatman debugging :).  This needs to be updated when fully support the new expansion");
+      else {
+        LogWrite(ITEM__ERROR, 0, "Item", "Unknown item broker stat type %u", criteria.btype);
+        LogWrite(ITEM__DEBUG, 0, "Item", "If you have a client before the new expansion this may be the reason.  Please be patient while we update items to support the new client.");
       }
-      if (mintier > 0 && item->details.tier < mintier)
-        continue;
-      if (maxtier > 0 && item->details.tier > maxtier)
-        continue;
-      if (minskill > 0 && item->generic_info.skill_min < minskill)
-        continue;
-      if (maxskill > 0 && item->generic_info.skill_min > maxskill)
-        continue;
-      ret->push_back(item);
+      return 0;
     }
   }
+
+  // Walk the shortest posting list that every match has to be in, MatchesSearch checks the rest.
+  // Type, slot and stat filters only ever matched a single flag, so a combined value finds no list.
+  const vector<int32>* candidates = 0;
+  bool no_matches = false;
+  auto use_list = [&](const vector<int32>* list) {
+    if (!list)
+      no_matches = true;
+    else if (!candidates || list->size() < candidates->size())
+      candidates = list;
+  };
+
+  if (criteria.itype != ITEM_BROKER_TYPE_ANY) {
+    map<int32, vector<int32>>::iterator itr = search_by_type.find(criteria.itype);
+    use_list(itr != search_by_type.end() ? &itr->second : 0);
+  }
+  if (criteria.ltype != ITEM_BROKER_SLOT_ANY) {
+    map<int32, vector<int32>>::iterator itr = search_by_slot.find(criteria.ltype);
+    use_list(itr != search_by_slot.end() ? &itr->second : 0);
+  }
+  if (criteria.btype != 0xFFFFFFFF) {
+    map<int32, vector<int32>>::iterator itr = search_by_stat.find(criteria.btype);
+    use_list(itr != search_by_stat.end() ? &itr->second : 0);
+  }
+  if (criteria.mintier > 0 && criteria.mintier == criteria.maxtier) {
+    map<int8, vector<int32>>::iterator itr = search_by_tier.find(criteria.mintier);
+    use_list(itr != search_by_tier.end() ? &itr->second : 0);
+  }
+  if (criteria.itemclass > 0) {
+    map<sint8, vector<int32>>::iterator itr = search_by_class.find(criteria.itemclass);
+    use_list(itr != search_by_class.end() ? &itr->second : 0);
+  }
+  // names shorter than a trigram fall back to the other lists or a full scan
+  for (int32 i = 0; i + 3 <= criteria.name.length() && !no_matches; i++) {
+    unordered_map<int32, vector<int32>>::iterator itr = search_by_trigram.find(GetNameTrigram(criteria.name.c_str() + i));
+    use_list(itr != search_by_trigram.end() ? &itr->second : 0);
+  }
+
+  if (no_matches)
+    return 0;
+
+  int32 total = 0;
+  int32 count = candidates ? candidates->size() : search_entries.size();
+  for (int32 i = 0; i < count; i++) {
+    const ItemSearchEntry& entry = search_entries[candidates ? (*candidates)[i] : i];
+    if (!MatchesSearch(entry, criteria))
+      continue;
+    if (results && total >= offset && (limit == 0 || total - offset < limit))
+      results->push_back(entry.item);
+    total++;
+  }
+  return total;
+}
+
+vector<Item*>* MasterItemList::GetItems(string name, int32 itype, int32 ltype, int32 btype, int64 minprice, int64 maxprice, int8 minskill, int8 maxskill, string seller, string adornment, int8 mintier, int8 maxtier, int16 minlevel, int16 maxlevel, sint8 itemclass) {
+  ItemSearchCriteria criteria;
+  criteria.name = name;
+  criteria.itype = itype;
+  criteria.ltype = ltype;
+  criteria.btype = btype;
+  criteria.minprice = minprice;
+  criteria.maxprice = maxprice;
+  criteria.minskill = minskill;
+  criteria.maxskill = maxskill;
+  criteria.seller = seller;
+  criteria.adornment = adornment;
+  criteria.mintier = mintier;
+  criteria.maxtier = maxtier;
+  criteria.minlevel = minlevel;
+  criteria.maxlevel = maxlevel;
+  criteria.itemclass = itemclass;
+
+  vector<Item*>* ret = new vector<Item*>;
+  SearchItems(criteria, ret);
   return ret;
 }
 
@@ -699,6 +548,17 @@ ItemStatsValues* MasterItemList::CalculateItemBonuses(Item* item, Entity* entity
 }
 
 void MasterItemList::RemoveAll() {
+  unique_lock<shared_timed_mutex> lock(search_mutex);
+  search_index_built = false;
+  search_entries.clear();
+  search_by_type.clear();
+  search_by_slot.clear();
+  search_by_stat.clear();
+  search_by_tier.clear();
+  search_by_class.clear();
+  search_by_trigram.clear();
+  lock.unlock();
+
   map<int32, Item*>::iterator iter;
   for (iter = items.begin(); iter != items.end(); iter++) {
     safe_delete(iter->second);
@@ -710,6 +570,9 @@ void MasterItemList::RemoveAll() {
 
 void MasterItemList::AddItem(Item* item) {
   items[item->details.item_id] = item;
+  // rebuilt by LoadItemList or by the next search
+  unique_lock<shared_timed_mutex> lock(search_mutex);
+  search_index_built = false;
 }
 
 Item::Item() {
@@ -1708,39 +1571,39 @@ void Item::serialize(PacketStruct* packet, bool show_name, Player* player, int16
     switch (generic_info.item_type) {
     case ITEM_TYPE_WEAPON: {
       if (weapon_info) {
-        packet->setDataByName("wield_type", weapon_info->wield_type);
-        packet->setDataByName("damage_low1", weapon_info->damage_low1);
-        packet->setDataByName("damage_high1", weapon_info->damage_high1);
-        packet->setDataByName("damage_low2", weapon_info->damage_low2);
-        packet->setDataByName("damage_high2", weapon_info->damage_high2);
-        packet->setDataByName("damage_low3", weapon_info->damage_low3);
-        packet->setDataByName("damage_high3", weapon_info->damage_high3);
-        packet->setDataByName("damage_type", weapon_type);
-        packet->setDataByName("delay", weapon_info->delay);
-        packet->setDataByName("rating", weapon_info->rating);
+        packet->setDataByName(field_wield_type, weapon_info->wield_type);
+        packet->setDataByName(field_damage_low1, weapon_info->damage_low1);
+        packet->setDataByName(field_damage_high1, weapon_info->damage_high1);
+        packet->setDataByName(field_damage_low2, weapon_info->damage_low2);
+        packet->setDataByName(field_damage_high2, weapon_info->damage_high2);
+        packet->setDataByName(field_damage_low3, weapon_info->damage_low3);
+        packet->setDataByName(field_damage_high3, weapon_info->damage_high3);
+        packet->setDataByName(field_damage_type, weapon_type);
+        packet->setDataByName(field_delay, weapon_info->delay);
+        packet->setDataByName(field_rating, weapon_info->rating);
       }
       break;
     }
     case ITEM_TYPE_RANGED: {
       if (ranged_info) {
-        packet->setDataByName("damage_low1", ranged_info->weapon_info.damage_low1);
-        packet->setDataByName("damage_high1", ranged_info->weapon_info.damage_high1);
-        packet->setDataByName("damage_low2", ranged_info->weapon_info.damage_low2);
-        packet->setDataByName("damage_high2", ranged_info->weapon_info.damage_high2);
-        packet->setDataByName("damage_low3", ranged_info->weapon_info.damage_low3);
-        packet->setDataByName("damage_high3", ranged_info->weapon_info.damage_high3);
-        packet->setDataByName("delay", ranged_info->weapon_info.delay);
-        packet->setDataByName("range_low", ranged_info->range_low);
-        packet->setDataByName("range_high", ranged_info->range_high);
-        packet->setDataByName("rating", ranged_info->weapon_info.rating);
+        packet->setDataByName(field_damage_low1, ranged_info->weapon_info.damage_low1);
+        packet->setDataByName(field_damage_high1, ranged_info->weapon_info.damage_high1);
+        packet->setDataByName(field_damage_low2, ranged_info->weapon_info.damage_low2);
+        packet->setDataByName(field_damage_high2, ranged_info->weapon_info.damage_high2);
+        packet->setDataByName(field_damage_low3, ranged_info->weapon_info.damage_low3);
+        packet->setDataByName(field_damage_high3, ranged_info->weapon_info.damage_high3);
+        packet->setDataByName(field_delay, ranged_info->weapon_info.delay);
+        packet->setDataByName(field_range_low, ranged_info->range_low);
+        packet->setDataByName(field_range_high, ranged_info->range_high);
+        packet->setDataByName(field_rating, ranged_info->weapon_info.rating);
       }
       break;
     }
     case ITEM_TYPE_SHIELD:
     case ITEM_TYPE_ARMOR: {
       if (armor_info) {
-        packet->setDataByName("mitigation_low", armor_info->mitigation_low);
-        packet->setDataByName("mitigation_high", armor_info->mitigation_high);
+        packet->setDataByName(field_mitigation_low, armor_info->mitigation_low);
+        packet->setDataByName(field_mitigation_high, armor_info->mitigation_high);
       }
       break;
     }
@@ -1771,12 +1634,12 @@ void Item::serialize(PacketStruct* packet, bool show_name, Player* player, int16
             safe_delete(bag_items);
           }
         }
-        packet->setDataByName("num_slots", bag_info->num_slots);
-        packet->setDataByName("num_empty", free_slots);
-        packet->setDataByName("weight_reduction", bag_info->weight_reduction);
-        packet->setDataByName("item_score", 2);
-        //packet->setDataByName("unknown5", 0x1e50a86f);
-        //packet->setDataByName("unknown6", 0x2c17f61d);
+        packet->setDataByName(field_num_slots, bag_info->num_slots);
+        packet->setDataByName(field_num_empty, free_slots);
+        packet->setDataByName(field_weight_reduction, bag_info->weight_reduction);
+        packet->setDataByName(field_item_score, 2);
+        //packet->setDataByName(field_unknown5, 0x1e50a86f);
+        //packet->setDataByName(field_unknown6, 0x2c17f61d);
         //1 armorer
         //2 weaponsmith
         //4 tailor
@@ -1795,9 +1658,9 @@ void Item::serialize(PacketStruct* packet, bool show_name, Player* player, int16
     }
     case ITEM_TYPE_FOOD: {
       if (food_info) {
-        packet->setDataByName("food_type", food_info->type);
-        packet->setDataByName("level", food_info->level);
-        packet->setDataByName("duration", food_info->duration);
+        packet->setDataByName(field_food_type, food_info->type);
+        packet->setDataByName(field_level, food_info->level);
+        packet->setDataByName(field_duration, food_info->duration);
       }
       break;
     }
@@ -1808,10 +1671,10 @@ void Item::serialize(PacketStruct* packet, bool show_name, Player* player, int16
         if (spell) {
           if (player) {
             packet->setSubstructDataByName("header_info", "footer_type", 0);
-            packet->setDataByName("unknown2", 1); // teset 63119
+            packet->setDataByName(field_unknown2, 1); // teset 63119
             spell->SetPacketInformation(packet, player->GetZone()->GetClientBySpawn(player));
             if (player->HasSpell(skill_info->spell_id, skill_info->spell_tier))
-              packet->setDataByName("scribed", 1);
+              packet->setDataByName(field_scribed, 1);
             else if (packet->GetVersion() >= 927) {
               if (player->HasSpell(skill_info->spell_id, skill_info->spell_tier, true))
                 packet->setAddToPacketByName("better_version", 1);
@@ -1822,52 +1685,52 @@ void Item::serialize(PacketStruct* packet, bool show_name, Player* player, int16
             spell->SetPacketInformation(packet);
           }
 
-          //packet->setDataByName("unknown26", 0);
+          //packet->setDataByName(field_unknown26, 0);
         }
       }
       break;
     }
     case ITEM_TYPE_BAUBLE: {
       if (bauble_info) {
-        packet->setDataByName("cast", bauble_info->cast);
-        packet->setDataByName("recovery", bauble_info->recovery);
-        packet->setDataByName("duration", bauble_info->duration);
-        packet->setDataByName("recast", bauble_info->recast);
-        packet->setDataByName("display_slot_optional", bauble_info->display_slot_optional);
-        packet->setDataByName("display_cast_time", bauble_info->display_cast_time);
-        packet->setDataByName("display_bauble_type", bauble_info->display_bauble_type);
-        packet->setDataByName("effect_radius", bauble_info->effect_radius);
-        packet->setDataByName("max_aoe_targets", bauble_info->max_aoe_targets);
-        packet->setDataByName("display_until_cancelled", bauble_info->display_until_cancelled);
-        //packet->setDataByName("item_score", 1);
+        packet->setDataByName(field_cast, bauble_info->cast);
+        packet->setDataByName(field_recovery, bauble_info->recovery);
+        packet->setDataByName(field_duration, bauble_info->duration);
+        packet->setDataByName(field_recast, bauble_info->recast);
+        packet->setDataByName(field_display_slot_optional, bauble_info->display_slot_optional);
+        packet->setDataByName(field_display_cast_time, bauble_info->display_cast_time);
+        packet->setDataByName(field_display_bauble_type, bauble_info->display_bauble_type);
+        packet->setDataByName(field_effect_radius, bauble_info->effect_radius);
+        packet->setDataByName(field_max_aoe_targets, bauble_info->max_aoe_targets);
+        packet->setDataByName(field_display_until_cancelled, bauble_info->display_until_cancelled);
+        //packet->setDataByName(field_item_score, 1);
       }
       break;
     }
     case ITEM_TYPE_THROWN: {
       if (thrown_info) {
-        packet->setDataByName("range", thrown_info->range);
-        packet->setDataByName("damage_modifier", thrown_info->damage_modifier);
-        packet->setDataByName("hit_bonus", thrown_info->hit_bonus);
-        packet->setDataByName("damage_type", thrown_info->damage_type);
+        packet->setDataByName(field_range, thrown_info->range);
+        packet->setDataByName(field_damage_modifier, thrown_info->damage_modifier);
+        packet->setDataByName(field_hit_bonus, thrown_info->hit_bonus);
+        packet->setDataByName(field_damage_type, thrown_info->damage_type);
       }
       break;
     }
     case ITEM_TYPE_HOUSE: {
       if (houseitem_info) {
-        packet->setDataByName("status_rent_reduction", houseitem_info->status_rent_reduction);
-        packet->setDataByName("coin_rent_reduction", houseitem_info->coin_rent_reduction);
-        packet->setDataByName("house_only", houseitem_info->house_only);
+        packet->setDataByName(field_status_rent_reduction, houseitem_info->status_rent_reduction);
+        packet->setDataByName(field_coin_rent_reduction, houseitem_info->coin_rent_reduction);
+        packet->setDataByName(field_house_only, houseitem_info->house_only);
       }
       break;
     }
     case ITEM_TYPE_BOOK: {
       if (book_info) {
-        packet->setDataByName("language", book_info->language);
+        packet->setDataByName(field_language, book_info->language);
         packet->setMediumStringByName("author", book_info->author.data.c_str());
         packet->setMediumStringByName("title", book_info->title.data.c_str());
       }
       if (packet->GetVersion() <= 1096)
-        packet->setDataByName("item_type", 13);
+        packet->setDataByName(field_item_type, 13);
 
       break;
     }
@@ -1883,20 +1746,20 @@ void Item::serialize(PacketStruct* packet, bool show_name, Player* player, int16
             packet->setArrayDataByName("recipe_icon", recipe->GetIcon(), i);
           }
         }
-        packet->setDataByName("uses", recipebook_info->uses);
+        packet->setDataByName(field_uses, recipebook_info->uses);
         if (player->GetRecipeBookList()->HasRecipeBook(details.item_id))
-          packet->setDataByName("scribed", 1);
+          packet->setDataByName(field_scribed, 1);
         else
-          packet->setDataByName("scribed", 0);
+          packet->setDataByName(field_scribed, 0);
       }
       break;
     }
     case ITEM_TYPE_ADORNMENT: {
       //Adornements
-      packet->setDataByName("item_types", adornment_info->item_types);
-      packet->setDataByName("duration", adornment_info->duration); // need to calcualte for remaining duration
-      packet->setDataByName("slot_type", adornment_info->slot_type);
-      packet->setDataByName("footer_set_name", "test footer set name");
+      packet->setDataByName(field_item_types, adornment_info->item_types);
+      packet->setDataByName(field_duration, adornment_info->duration); // need to calcualte for remaining duration
+      packet->setDataByName(field_slot_type, adornment_info->slot_type);
+      packet->setDataByName(field_footer_set_name, "test footer set name");
       packet->setArrayLengthByName("footer_set_bonus_list_count", 1);        // list of the bonus items
       packet->setArrayDataByName("footer_set_bonus_items_needed", 2, 0);     //this is nember of items needed for granteing that  stat //name,value,array
       packet->setSubArrayLengthByName("footer_set_bonus_stats_count", 2, 0); //name,value,array,subarray
@@ -1908,10 +1771,10 @@ void Item::serialize(PacketStruct* packet, bool show_name, Player* player, int16
     case ITEM_TYPE_HOUSE_CONTAINER: {
       //House Containers
       if (housecontainer_info) {
-        packet->setDataByName("allowed_types", housecontainer_info->allowed_types);
-        packet->setDataByName("num_slots", housecontainer_info->num_slots);
-        packet->setDataByName("broker_commission", housecontainer_info->broker_commission);
-        packet->setDataByName("fence_commission", housecontainer_info->fence_commission);
+        packet->setDataByName(field_allowed_types, housecontainer_info->allowed_types);
+        packet->setDataByName(field_num_slots, housecontainer_info->num_slots);
+        packet->setDataByName(field_broker_commission, housecontainer_info->broker_commission);
+        packet->setDataByName(field_fence_commission, housecontainer_info->fence_commission);
       }
     }
     }
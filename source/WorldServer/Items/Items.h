@@ -21,6 +21,8 @@ along with EQ2Emulator.  If not, see <http://www.gnu.org/licenses/>.
 #define __EQ2_ITEMS__
 #include <map>
 #include <vector>
+#include <unordered_map>
+#include <shared_mutex>
 #include "../../common/types.h"
 #include "../../common/DataBuffer.h"
 #include "../../common/MiscFunctions.h"
@@ -866,8 +868,40 @@ public:
   void SetSlots(int32 slots);
   bool needs_deletion;
 };
+struct ItemSearchCriteria {
+  string name;
+  int32 itype;
+  int32 ltype;
+  int32 btype;
+  int64 minprice;
+  int64 maxprice;
+  int8 minskill;
+  int8 maxskill;
+  string seller;
+  string adornment;
+  int8 mintier;
+  int8 maxtier;
+  int16 minlevel;
+  int16 maxlevel;
+  sint8 itemclass;
+};
+// Everything a broker search looks at, precomputed per item when the search index is built
+struct ItemSearchEntry {
+  Item* item;
+  int32 types; // ITEM_BROKER_TYPE_* bits
+  int32 slots; // ITEM_BROKER_SLOT_* bits
+  int32 stats; // ITEM_BROKER_STAT_TYPE_* bits
+  bool no_stats;
+  int64 classes; // adventure and tradeskill classes
+  int16 recommended_level;
+  int16 adventure_level;
+  int16 tradeskill_level;
+  int8 tier;
+  int16 skill_min;
+};
 class MasterItemList {
 public:
+  MasterItemList();
   ~MasterItemList();
   map<int32, Item*> items;
 
@@ -877,12 +911,30 @@ public:
   ItemStatsValues* CalculateItemBonuses(Item* desc, Entity* entity = 0, ItemStatsValues* values = 0);
   vector<Item*>* GetItems(string name, int32 itype, int32 ltype, int32 btype, int64 minprice, int64 maxprice, int8 minskill, int8 maxskill, string seller, string adornment, int8 mintier, int8 maxtier, int16 minlevel, int16 maxlevel, sint8 itemclass);
   vector<Item*>* GetItems(map<string, string> criteria);
+  // Adds one page of matches (all of them if limit is 0) to results and returns the total number of matches
+  int32 SearchItems(const ItemSearchCriteria& criteria, vector<Item*>* results, int32 offset = 0, int32 limit = 0);
+  void BuildSearchIndex();
   void AddItem(Item* item);
   bool IsBag(int32 item_id);
   void RemoveAll();
   static int32 NextUniqueID();
   static void ResetUniqueID(int32 new_id);
   static int32 next_unique_id;
+
+private:
+  bool MatchesSearch(const ItemSearchEntry& entry, const ItemSearchCriteria& criteria);
+
+  // Broker search indexes. The lists hold positions in search_entries, which is in item id
+  // order, so every list is sorted and results come back in the same order as items.
+  shared_timed_mutex search_mutex;
+  bool search_index_built;
+  vector<ItemSearchEntry> search_entries;
+  map<int32, vector<int32>> search_by_type;
+  map<int32, vector<int32>> search_by_slot;
+  map<int32, vector<int32>> search_by_stat;
+  map<int8, vector<int32>> search_by_tier;
+  map<sint8, vector<int32>> search_by_class;
+  unordered_map<int32, vector<int32>> search_by_trigram;
 };
 class PlayerItemList {
 public:
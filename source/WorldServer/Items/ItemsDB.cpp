@@ -132,170 +132,285 @@ void WorldDatabase::LoadDataFromRow(MYSQL_ROW row, Item* item) {
   item->details.soe_id = atoi(row[39]);
 }
 
-// handle new database class til all functions are converted
-void WorldDatabase::LoadDataFromRow(DatabaseResult* result, Item* item) {
-  LogWrite(ITEM__DEBUG, 5, "Items", "\tSetting details for item ID: %i", result->GetInt32Str("id"));
-
-  item->details.item_id = result->GetInt32Str("id");
-  int8 size = strlen(result->GetStringStr("name"));
+// Columns of `items` read by LoadDataFromRow(), looked up once per result
+struct ItemColumns {
+  ItemColumns(DatabaseResult& result);
+
+  unsigned int id;
+  unsigned int name;
+  unsigned int icon;
+  unsigned int count;
+  unsigned int tier;
+  unsigned int weight;
+  unsigned int description;
+  unsigned int show_name;
+  unsigned int attuneable;
+  unsigned int artifact;
+  unsigned int lore;
+  unsigned int temporary;
+  unsigned int notrade;
+  unsigned int novalue;
+  unsigned int nozone;
+  unsigned int nodestroy;
+  unsigned int crafted;
+  unsigned int good_only;
+  unsigned int evil_only;
+  unsigned int stacklore;
+  unsigned int lore_equip;
+  unsigned int flags_16384;
+  unsigned int flags_32768;
+  unsigned int ornate;
+  unsigned int heirloom;
+  unsigned int appearance_only;
+  unsigned int unlocked;
+  unsigned int reforged;
+  unsigned int norepair;
+  unsigned int etheral;
+  unsigned int refined;
+  unsigned int flags2_256;
+  unsigned int skill_id_req;
+  unsigned int skill_id_req2;
+  unsigned int skill_min;
+  unsigned int slots;
+  unsigned int sell_price;
+  unsigned int sell_status_amount;
+  unsigned int stack_count;
+  unsigned int collectable;
+  unsigned int offers_quest_id;
+  unsigned int part_of_quest_id;
+  unsigned int recommended_level;
+  unsigned int adventure_default_level;
+  unsigned int max_charges;
+  unsigned int display_charges;
+  unsigned int tradeskill_default_level;
+  unsigned int adventure_classes;
+  unsigned int tradeskill_classes;
+  unsigned int lua_script;
+  unsigned int usable;
+  unsigned int soe_item_id;
+  unsigned int harvest;
+  unsigned int item_type;
+};
+
+ItemColumns::ItemColumns(DatabaseResult& result) {
+  id = result.GetFieldIndex("id");
+  name = result.GetFieldIndex("name");
+  icon = result.GetFieldIndex("icon");
+  count = result.GetFieldIndex("count");
+  tier = result.GetFieldIndex("tier");
+  weight = result.GetFieldIndex("weight");
+  description = result.GetFieldIndex("description");
+  show_name = result.GetFieldIndex("show_name");
+  attuneable = result.GetFieldIndex("attuneable");
+  artifact = result.GetFieldIndex("artifact");
+  lore = result.GetFieldIndex("lore");
+  temporary = result.GetFieldIndex("temporary");
+  notrade = result.GetFieldIndex("notrade");
+  novalue = result.GetFieldIndex("novalue");
+  nozone = result.GetFieldIndex("nozone");
+  nodestroy = result.GetFieldIndex("nodestroy");
+  crafted = result.GetFieldIndex("crafted");
+  good_only = result.GetFieldIndex("good_only");
+  evil_only = result.GetFieldIndex("evil_only");
+  stacklore = result.GetFieldIndex("stacklore");
+  lore_equip = result.GetFieldIndex("lore_equip");
+  flags_16384 = result.GetFieldIndex("flags_16384");
+  flags_32768 = result.GetFieldIndex("flags_32768");
+  ornate = result.GetFieldIndex("ornate");
+  heirloom = result.GetFieldIndex("heirloom");
+  appearance_only = result.GetFieldIndex("appearance_only");
+  unlocked = result.GetFieldIndex("unlocked");
+  reforged = result.GetFieldIndex("reforged");
+  norepair = result.GetFieldIndex("norepair");
+  etheral = result.GetFieldIndex("etheral");
+  refined = result.GetFieldIndex("refined");
+  flags2_256 = result.GetFieldIndex("flags2_256");
+  skill_id_req = result.GetFieldIndex("skill_id_req");
+  skill_id_req2 = result.GetFieldIndex("skill_id_req2");
+  skill_min = result.GetFieldIndex("skill_min");
+  slots = result.GetFieldIndex("slots");
+  sell_price = result.GetFieldIndex("sell_price");
+  sell_status_amount = result.GetFieldIndex("sell_status_amount");
+  stack_count = result.GetFieldIndex("stack_count");
+  collectable = result.GetFieldIndex("collectable");
+  offers_quest_id = result.GetFieldIndex("offers_quest_id");
+  part_of_quest_id = result.GetFieldIndex("part_of_quest_id");
+  recommended_level = result.GetFieldIndex("recommended_level");
+  adventure_default_level = result.GetFieldIndex("adventure_default_level");
+  max_charges = result.GetFieldIndex("max_charges");
+  display_charges = result.GetFieldIndex("display_charges");
+  tradeskill_default_level = result.GetFieldIndex("tradeskill_default_level");
+  adventure_classes = result.GetFieldIndex("adventure_classes");
+  tradeskill_classes = result.GetFieldIndex("tradeskill_classes");
+  lua_script = result.GetFieldIndex("lua_script");
+  usable = result.GetFieldIndex("usable");
+  soe_item_id = result.GetFieldIndex("soe_item_id");
+  harvest = result.GetFieldIndex("harvest");
+  item_type = result.GetFieldIndex("item_type");
+}
 
-  if (size > 63)
-    size = 63;
+void WorldDatabase::LoadDataFromRow(DatabaseResult* result, const ItemColumns& columns, Item* item) {
+  LogWrite(ITEM__DEBUG, 5, "Items", "\tSetting details for item ID: %i", result->GetInt32(columns.id));
 
-  item->name = string(result->GetStringStr("name"));
+  item->details.item_id = result->GetInt32(columns.id);
+  unsigned long length;
+  const char* name = result->GetString(columns.name, &length);
+  item->name = string(name, length);
   item->lowername = ToLower(item->name);
-  item->details.icon = result->GetInt16Str("icon");
-  item->details.count = result->GetInt16Str("count");
-  item->details.tier = result->GetInt8Str("tier");
-  item->generic_info.weight = result->GetInt32Str("weight");
+  item->details.icon = result->GetInt16(columns.icon);
+  item->details.count = result->GetInt16(columns.count);
+  item->details.tier = result->GetInt8(columns.tier);
+  item->generic_info.weight = result->GetInt32(columns.weight);
 
-  if (strlen(result->GetStringStr("description")) > 0)
-    item->description = string(result->GetStringStr("description"));
+  const char* description = result->GetString(columns.description, &length);
+  if (length > 0)
+    item->description = string(description, length);
 
-  item->generic_info.show_name = result->GetInt8Str("show_name");
+  item->generic_info.show_name = result->GetInt8(columns.show_name);
 
-  if (result->GetInt8Str("attuneable") == 1)
+  if (result->GetInt8(columns.attuneable) == 1)
     item->generic_info.item_flags += ATTUNEABLE;
 
-  if (result->GetInt8Str("artifact") == 1)
+  if (result->GetInt8(columns.artifact) == 1)
     item->generic_info.item_flags += ARTIFACT;
 
-  if (result->GetInt8Str("lore") == 1)
+  if (result->GetInt8(columns.lore) == 1)
     item->generic_info.item_flags += LORE;
 
-  if (result->GetInt8Str("temporary") == 1)
+  if (result->GetInt8(columns.temporary) == 1)
     item->generic_info.item_flags += TEMPORARY;
 
-  if (result->GetInt8Str("notrade") == 1)
+  if (result->GetInt8(columns.notrade) == 1)
     item->generic_info.item_flags += NO_TRADE;
 
-  if (result->GetInt8Str("novalue") == 1)
+  if (result->GetInt8(columns.novalue) == 1)
     item->generic_info.item_flags += NO_VALUE;
 
-  if (result->GetInt8Str("nozone") == 1)
+  if (result->GetInt8(columns.nozone) == 1)
     item->generic_info.item_flags += NO_ZONE;
 
-  if (result->GetInt8Str("nodestroy") == 1)
+  if (result->GetInt8(columns.nodestroy) == 1)
     item->generic_info.item_flags += NO_DESTROY;
 
-  if (result->GetInt8Str("crafted") == 1)
+  if (result->GetInt8(columns.crafted) == 1)
     item->generic_info.item_flags += CRAFTED;
 
-  if (result->GetInt8Str("good_only") == 1)
+  if (result->GetInt8(columns.good_only) == 1)
     item->generic_info.item_flags += GOOD_ONLY;
 
-  if (result->GetInt8Str("evil_only") == 1)
+  if (result->GetInt8(columns.evil_only) == 1)
     item->generic_info.item_flags += EVIL_ONLY;
 
-  if (result->GetInt8Str("stacklore") == 1)
+  if (result->GetInt8(columns.stacklore) == 1)
     item->generic_info.item_flags += STACK_LORE; //add this line
 
-  if (result->GetInt8Str("lore_equip") == 1)
+  if (result->GetInt8(columns.lore_equip) == 1)
     item->generic_info.item_flags += LORE_EQUIP; //add this line
 
-  if (result->GetInt8Str("flags_16384") == 1)
+  if (result->GetInt8(columns.flags_16384) == 1)
     item->generic_info.item_flags += FLAGS_16384; //add this line
 
-  if (result->GetInt8Str("flags_32768") == 1)
+  if (result->GetInt8(columns.flags_32768) == 1)
     item->generic_info.item_flags += FLAGS_32768; //add this line
 
-  if (result->GetInt8Str("ornate") == 1)
+  if (result->GetInt8(columns.ornate) == 1)
     item->generic_info.item_flags2 += ORNATE;
 
-  if (result->GetInt8Str("heirloom") == 1)
+  if (result->GetInt8(columns.heirloom) == 1)
     item->generic_info.item_flags2 += HEIRLOOM;
 
-  if (result->GetInt8Str("appearance_only") == 1)
+  if (result->GetInt8(columns.appearance_only) == 1)
     item->generic_info.item_flags2 += APPEARANCE_ONLY;
 
-  if (result->GetInt8Str("unlocked") == 1)
+  if (result->GetInt8(columns.unlocked) == 1)
     item->generic_info.item_flags2 += UNLOCKED;
 
-  if (result->GetInt8Str("reforged") == 1)
+  if (result->GetInt8(columns.reforged) == 1)
     item->generic_info.item_flags2 += REFORGED;
 
-  if (result->GetInt8Str("norepair") == 1)
+  if (result->GetInt8(columns.norepair) == 1)
     item->generic_info.item_flags2 += NO_REPAIR;
 
-  if (result->GetInt8Str("etheral") == 1)
+  if (result->GetInt8(columns.etheral) == 1)
     item->generic_info.item_flags2 += ETHERAL;
 
-  if (result->GetInt8Str("refined") == 1)
+  if (result->GetInt8(columns.refined) == 1)
     item->generic_info.item_flags2 += REFINED;
 
-  if (result->GetInt8Str("flags2_256") == 1)
+  if (result->GetInt8(columns.flags2_256) == 1)
     item->generic_info.item_flags2 += FLAGS2_256;
 
-  if (result->GetInt8Str("flags_16384") == 1)
+  if (result->GetInt8(columns.flags_16384) == 1)
     item->generic_info.item_flags += FLAGS_16384;
 
-  if (result->GetInt8Str("flags_32768") == 1)
+  if (result->GetInt8(columns.flags_32768) == 1)
     item->generic_info.item_flags += FLAGS_32768;
 
-  if (result->GetInt8Str("ornate") == 1)
+  if (result->GetInt8(columns.ornate) == 1)
     item->generic_info.item_flags2 += ORNATE;
 
-  if (result->GetInt8Str("heirloom") == 1)
+  if (result->GetInt8(columns.heirloom) == 1)
     item->generic_info.item_flags2 += HEIRLOOM;
 
-  if (result->GetInt8Str("appearance_only") == 1)
+  if (result->GetInt8(columns.appearance_only) == 1)
     item->generic_info.item_flags2 += APPEARANCE_ONLY;
 
-  if (result->GetInt8Str("unlocked") == 1)
+  if (result->GetInt8(columns.unlocked) == 1)
     item->generic_info.item_flags2 += UNLOCKED;
 
-  if (result->GetInt8Str("reforged") == 1)
+  if (result->GetInt8(columns.reforged) == 1)
     item->generic_info.item_flags2 += REFORGED;
 
-  if (result->GetInt8Str("norepair") == 1)
+  if (result->GetInt8(columns.norepair) == 1)
     item->generic_info.item_flags2 += NO_REPAIR;
 
-  if (result->GetInt8Str("etheral") == 1)
+  if (result->GetInt8(columns.etheral) == 1)
     item->generic_info.item_flags2 += ETHERAL;
 
-  if (result->GetInt8Str("refined") == 1)
+  if (result->GetInt8(columns.refined) == 1)
     item->generic_info.item_flags2 += REFINED;
 
-  if (result->GetInt8Str("flags2_256") == 1)
+  if (result->GetInt8(columns.flags2_256) == 1)
     item->generic_info.item_flags2 += FLAGS2_256;
 
-  if (result->GetInt32Str("skill_id_req") == 0)
+  if (result->GetInt32(columns.skill_id_req) == 0)
     item->generic_info.skill_req1 = 0xFFFFFFFF;
   else
-    item->generic_info.skill_req1 = result->GetInt32Str("skill_id_req");
+    item->generic_info.skill_req1 = result->GetInt32(columns.skill_id_req);
 
-  if (result->GetInt32Str("skill_id_req2") == 0)
+  if (result->GetInt32(columns.skill_id_req2) == 0)
     item->generic_info.skill_req2 = 0xFFFFFFFF;
   else
-    item->generic_info.skill_req2 = result->GetInt32Str("skill_id_req2");
+    item->generic_info.skill_req2 = result->GetInt32(columns.skill_id_req2);
 
-  item->generic_info.skill_min = result->GetInt16Str("skill_min");
+  item->generic_info.skill_min = result->GetInt16(columns.skill_min);
 
-  if (result->GetInt32Str("slots") > 0)
-    item->SetSlots(result->GetInt32Str("slots"));
+  if (result->GetInt32(columns.slots) > 0)
+    item->SetSlots(result->GetInt32(columns.slots));
 
-  item->sell_price = result->GetInt32Str("sell_price");
-  item->sell_status = result->GetInt32Str("sell_status_amount");
-  item->stack_count = result->GetInt8Str("stack_count");
-  item->generic_info.collectable = result->GetInt8Str("collectable");
-  item->generic_info.offers_quest_id = result->GetInt32Str("offers_quest_id");
-  item->generic_info.part_of_quest_id = result->GetInt32Str("part_of_quest_id");
-  item->details.recommended_level = result->GetInt16Str("recommended_level");
-  item->generic_info.adventure_default_level = result->GetInt16Str("adventure_default_level");
-  item->generic_info.max_charges = result->GetInt16Str("max_charges");
-  item->generic_info.display_charges = result->GetInt8Str("display_charges");
-  item->generic_info.tradeskill_default_level = result->GetInt16Str("tradeskill_default_level");
+  item->sell_price = result->GetInt32(columns.sell_price);
+  item->sell_status = result->GetInt32(columns.sell_status_amount);
+  item->stack_count = result->GetInt8(columns.stack_count);
+  item->generic_info.collectable = result->GetInt8(columns.collectable);
+  item->generic_info.offers_quest_id = result->GetInt32(columns.offers_quest_id);
+  item->generic_info.part_of_quest_id = result->GetInt32(columns.part_of_quest_id);
+  item->details.recommended_level = result->GetInt16(columns.recommended_level);
+  item->generic_info.adventure_default_level = result->GetInt16(columns.adventure_default_level);
+  item->generic_info.max_charges = result->GetInt16(columns.max_charges);
+  item->generic_info.display_charges = result->GetInt8(columns.display_charges);
+  item->generic_info.tradeskill_default_level = result->GetInt16(columns.tradeskill_default_level);
 
 #ifdef WIN32
-  item->generic_info.adventure_classes = result->GetInt64Str("adventure_classes");
-  item->generic_info.tradeskill_classes = result->GetInt64Str("tradeskill_classes");
+  item->generic_info.adventure_classes = result->GetInt64(columns.adventure_classes);
+  item->generic_info.tradeskill_classes = result->GetInt64(columns.tradeskill_classes);
 #else
-  item->generic_info.adventure_classes = result->GetInt64Str("adventure_classes");
-  item->generic_info.tradeskill_classes = result->GetInt64Str("tradeskill_classes");
+  item->generic_info.adventure_classes = result->GetInt64(columns.adventure_classes);
+  item->generic_info.tradeskill_classes = result->GetInt64(columns.tradeskill_classes);
 #endif
 
-  if (!result->IsNullStr("lua_script") && strlen(result->GetStringStr("lua_script")) > 0) {
-    item->SetItemScript(string(result->GetStringStr("lua_script")));
+  const char* lua_script = result->GetString(columns.lua_script, &length);
+  if (length > 0) {
+    item->SetItemScript(string(lua_script, length));
     LogWrite(ITEM__DEBUG, 5, "LUA", "--Loading LUA Item Script: '%s'", item->item_script.c_str());
   }
 
@@ -305,10 +420,10 @@ void WorldDatabase::LoadDataFromRow(DatabaseResult* result, Item* item) {
   if (item->details.count == 0)
     item->details.count = 1;
 
-  item->generic_info.usable = result->GetInt8Str("usable");
-  item->details.soe_id = result->GetSInt32Str("soe_item_id");
+  item->generic_info.usable = result->GetInt8(columns.usable);
+  item->details.soe_id = result->GetSInt32(columns.soe_item_id);
 
-  item->generic_info.harvest = result->GetInt8Str("harvest");
+  item->generic_info.harvest = result->GetInt8(columns.harvest);
 }
 
 int32 WorldDatabase::LoadSkillItems() {
@@ -435,23 +550,28 @@ int32 WorldDatabase::LoadBooks() {
   int32 id = 0;
 
   if (database_new.Select(&result, "SELECT item_id, language, author, title FROM item_details_book")) {
+    unsigned int field_item_id = result.GetFieldIndex("item_id");
+    unsigned int field_language = result.GetFieldIndex("language");
+    unsigned int field_author = result.GetFieldIndex("author");
+    unsigned int field_title = result.GetFieldIndex("title");
+
     while (result.Next()) {
-      id = result.GetInt32Str("item_id");
+      id = result.GetInt32(field_item_id);
       Item* item = master_item_list.GetItem(id);
 
       if (item) {
         LogWrite(ITEM__DEBUG, 5, "Items", "\tItem Book for item_id %u", id);
         LogWrite(ITEM__DEBUG, 5, "Items", "\ttype: %i, %i, %s, %s",
                  ITEM_TYPE_BOOK,
-                 result.GetInt8Str("language"),
-                 result.GetStringStr("author"),
-                 result.GetStringStr("title"));
+                 result.GetInt8(field_language),
+                 result.GetString(field_author),
+                 result.GetString(field_title));
 
         item->SetItemType(ITEM_TYPE_BOOK);
-        item->book_info->language = result.GetInt8Str("language");
-        item->book_info->author.data = result.GetStringStr("author");
+        item->book_info->language = result.GetInt8(field_language);
+        item->book_info->author.data = result.GetString(field_author);
         item->book_info->author.size = item->book_info->author.data.length();
-        item->book_info->title.data = result.GetStringStr("title");
+        item->book_info->title.data = result.GetString(field_title);
         item->book_info->title.size = item->book_info->title.data.length();
 
         total++;
@@ -468,14 +588,20 @@ int32 WorldDatabase::LoadItemsets() {
   int32 id = 0;
 
   if (database_new.Select(&result, "SELECT id, itemset_item_id, item_id, item_icon,item_stack_size,item_list_color,language_type FROM item_details_itemset")) {
+    unsigned int field_itemset_item_id = result.GetFieldIndex("itemset_item_id");
+    unsigned int field_item_id = result.GetFieldIndex("item_id");
+    unsigned int field_item_icon = result.GetFieldIndex("item_icon");
+    unsigned int field_item_stack_size = result.GetFieldIndex("item_stack_size");
+    unsigned int field_item_list_color = result.GetFieldIndex("item_list_color");
+
     while (result.Next()) {
-      id = result.GetInt32Str("itemset_item_id");
+      id = result.GetInt32(field_itemset_item_id);
       Item* item = master_item_list.GetItem(id);
 
       if (item) {
         item->SetItemType(ITEM_TYPE_ITEMCRATE);
-        //int32 item_id = result.GetInt32Str("item_id");
-        item->AddSet(result.GetInt32Str("item_id"), 0, result.GetInt16Str("item_icon"), result.GetInt16Str("item_stack_size"), result.GetInt32Str("item_list_color"));
+        //int32 item_id = result.GetInt32(field_item_id);
+        item->AddSet(result.GetInt32(field_item_id), 0, result.GetInt16(field_item_icon), result.GetInt16(field_item_stack_size), result.GetInt32(field_item_list_color));
 
         total++;
       } else
@@ -543,19 +669,25 @@ int32 WorldDatabase::LoadHouseContainers() {
   int32 id = 0;
 
   if (database_new.Select(&result, "SELECT item_id, num_slots, allowed_types, broker_commission, fence_commission FROM item_details_house_container")) {
+    unsigned int field_item_id = result.GetFieldIndex("item_id");
+    unsigned int field_num_slots = result.GetFieldIndex("num_slots");
+    unsigned int field_allowed_types = result.GetFieldIndex("allowed_types");
+    unsigned int field_broker_commission = result.GetFieldIndex("broker_commission");
+    unsigned int field_fence_commission = result.GetFieldIndex("fence_commission");
+
     while (result.Next()) {
-      id = result.GetInt32Str("item_id");
+      id = result.GetInt32(field_item_id);
       Item* item = master_item_list.GetItem(id);
 
       if (item) {
         LogWrite(ITEM__DEBUG, 5, "Items", "\tHouse Container for item_id %u", id);
-        LogWrite(ITEM__DEBUG, 5, "Items", "\tType: %i, '%i', '%u', '%i', '%i'", ITEM_TYPE_RECIPE, result.GetInt8Str("num_slots"), result.GetInt64Str("allowed_types"), result.GetInt8Str("broker_commission"), result.GetInt8Str("fence_commission"));
+        LogWrite(ITEM__DEBUG, 5, "Items", "\tType: %i, '%i', '%u', '%i', '%i'", ITEM_TYPE_RECIPE, result.GetInt8(field_num_slots), result.GetInt64(field_allowed_types), result.GetInt8(field_broker_commission), result.GetInt8(field_fence_commission));
 
         item->SetItemType(ITEM_TYPE_HOUSE_CONTAINER);
-        item->housecontainer_info->num_slots = result.GetInt8Str("num_slots");
-        item->housecontainer_info->allowed_types = result.GetInt64Str("allowed_types");
-        item->housecontainer_info->broker_commission = result.GetInt8Str("broker_commission");
-        item->housecontainer_info->fence_commission = result.GetInt8Str("fence_commission");
+        item->housecontainer_info->num_slots = result.GetInt8(field_num_slots);
+        item->housecontainer_info->allowed_types = result.GetInt64(field_allowed_types);
+        item->housecontainer_info->broker_commission = result.GetInt8(field_broker_commission);
+        item->housecontainer_info->fence_commission = result.GetInt8(field_fence_commission);
 
         total++;
       } else
@@ -869,12 +1001,14 @@ void WorldDatabase::LoadItemList() {
   if (!database_new.Select(&result, "SELECT * FROM items"))
     LogWrite(ITEM__ERROR, 0, "Items", "Cannot load items in %s, line: %i", __FUNCTION__, __LINE__);
   else {
+    ItemColumns columns(result);
+
     while (result.Next()) {
-      item_type = result.GetStringStr("item_type");
-      LogWrite(ITEM__DEBUG, 5, "Items", "\tLoading: %s (ID: %i, Type: %s)...", result.GetStringStr("name"), result.GetInt32Str("id"), item_type.c_str());
+      item_type = result.GetString(columns.item_type);
+      LogWrite(ITEM__DEBUG, 5, "Items", "\tLoading: %s (ID: %i, Type: %s)...", result.GetString(columns.name), result.GetInt32(columns.id), item_type.c_str());
 
       Item* item = new Item;
-      LoadDataFromRow(&result, item);
+      LoadDataFromRow(&result, columns, item);
       master_item_list.AddItem(item);
 
       if (strcmp(item_type.c_str(), "Normal") == 0) {
@@ -914,6 +1048,7 @@ void WorldDatabase::LoadItemList() {
   LogWrite(ITEM__DEBUG, 0, "Items", "Loading Item Level Overrides...");
   LogWrite(ITEM__DEBUG, 0, "Items", "\tLoaded %u Item Level Overrides", LoadItemLevelOverride());
 
+  master_item_list.BuildSearchIndex();
   LogWrite(ITEM__INFO, 0, "Items", "Loaded %u Total Item%s (took %u seconds)", total, (total == 1) ? "" : "s", Timer::GetUnixTimeStamp() - t_now);
 }
 
@@ -934,20 +1069,23 @@ int32 WorldDatabase::LoadNextUniqueItemID() {
   return 0;
 }
 
-void WorldDatabase::SaveItems(const shared_ptr<Client>& client) {
+void WorldDatabase::SaveItems(const shared_ptr<Client>& client, QueryBatch& batch) {
   LogWrite(ITEM__DEBUG, 3, "Items", "Save Items for Player %i", client->GetCharacterID());
 
-  map<int32, Item*>* items = client->GetPlayer()->GetItemList();
+  Player* player = client->GetPlayer();
+  map<int32, Item*>* items = player->GetItemList();
   map<int32, Item*>::iterator item_iter;
   Item* item = 0;
+  set<int32> saved_items;
 
   for (item_iter = items->begin(); item_iter != items->end(); item_iter++) {
     item = item_iter->second;
 
     if (item && item->save_needed) {
       LogWrite(ITEM__DEBUG, 5, "Items", "SaveItems: Acct: %u, Char: %u, Item: %u, NOT-EQUIPPED", client->GetAccountID(), client->GetCharacterID(), item);
-      SaveItem(client->GetAccountID(), client->GetCharacterID(), item, "NOT-EQUIPPED");
+      SaveItem(client->GetAccountID(), client->GetCharacterID(), item, "NOT-EQUIPPED", batch);
       item->save_needed = false;
+      saved_items.insert(item->details.unique_id);
     }
   }
   safe_delete(items);
@@ -958,23 +1096,62 @@ void WorldDatabase::SaveItems(const shared_ptr<Client>& client) {
     item = equipped_list->at(i);
 
     if (item && item->save_needed) {
-      SaveItem(client->GetAccountID(), client->GetCharacterID(), item, "EQUIPPED");
+      SaveItem(client->GetAccountID(), client->GetCharacterID(), item, "EQUIPPED", batch);
       item->save_needed = false;
+      saved_items.insert(item->details.unique_id);
     }
   }
   safe_delete(equipped_list);
 
+  // overflow slots are positional, so they are only rewritten when an item
+  // changed or the order of the overflow list is different from the last save
   vector<Item*>* overflow = client->GetPlayer()->item_list.GetOverflowItemList();
+  vector<int32> overflow_ids;
+  bool overflow_changed = false;
   for (int32 i = 0; i < overflow->size(); i++) {
     item = overflow->at(i);
     if (item) {
-      sint16 slot = item->details.slot_id;
-      item->details.slot_id = i;
-      SaveItem(client->GetAccountID(), client->GetCharacterID(), item, "NOT-EQUIPPED");
-      item->details.slot_id = slot;
+      overflow_ids.push_back(item->details.unique_id);
+      if (item->save_needed)
+        overflow_changed = true;
     }
   }
+
+  vector<int32>& saved_overflow = client->GetSaveState()->overflow_items;
+  if (overflow_changed || overflow_ids != saved_overflow) {
+    for (int32 i = 0; i < overflow->size(); i++) {
+      item = overflow->at(i);
+      if (item) {
+        sint16 slot = item->details.slot_id;
+        item->details.slot_id = i;
+        SaveItem(client->GetAccountID(), client->GetCharacterID(), item, "NOT-EQUIPPED", batch);
+        item->details.slot_id = slot;
+        item->save_needed = false;
+      }
+    }
+    saved_overflow.swap(overflow_ids);
+  }
   safe_delete(overflow);
+
+  // items are looked up again as they may have been destroyed since; the overflow
+  // list is rewritten anyway because a failed save resets the character save state
+  if (!saved_items.empty()) {
+    batch.OnFailure([player, saved_items]() {
+      map<int32, Item*>* items = player->GetItemList();
+      for (auto& kv : *items) {
+        if (kv.second && saved_items.count(kv.second->details.unique_id) > 0)
+          kv.second->save_needed = true;
+      }
+      safe_delete(items);
+
+      vector<Item*>* equipped_list = player->GetEquippedItemList();
+      for (Item* item : *equipped_list) {
+        if (item && saved_items.count(item->details.unique_id) > 0)
+          item->save_needed = true;
+      }
+      safe_delete(equipped_list);
+    });
+  }
 }
 
 void WorldDatabase::SaveItem(int32 account_id, int32 char_id, Item* item, const char* type) {
@@ -986,6 +1163,15 @@ void WorldDatabase::SaveItem(int32 account_id, int32 char_id, Item* item, const
                   getSafeEscapeString(item->creator.c_str()).c_str(), item->adorn0, item->adorn1, item->adorn2, item->generic_info.condition, item->CheckFlag(ATTUNED) ? 1 : 0, item->details.inv_slot_id, item->details.count, item->GetMaxSellValue(), account_id);
 }
 
+void WorldDatabase::SaveItem(int32 account_id, int32 char_id, Item* item, const char* type, QueryBatch& batch) {
+  LogWrite(ITEM__DEBUG, 1, "Items", "Saving ItemID: %u (Type: %s) for account: %u, player: %u", item->details.item_id, type, account_id, char_id);
+
+  batch.AddRow("character_items", "id, type, char_id, slot, item_id, creator,adorn0,adorn1,adorn2, condition_, attuned, bag_id, count, max_sell_value, account_id, login_checksum",
+               "type = VALUES(type), char_id = VALUES(char_id), slot = VALUES(slot), item_id = VALUES(item_id), creator = VALUES(creator), adorn0 = VALUES(adorn0), adorn1 = VALUES(adorn1), adorn2 = VALUES(adorn2), condition_ = VALUES(condition_), attuned = VALUES(attuned), bag_id = VALUES(bag_id), count = VALUES(count), max_sell_value = VALUES(max_sell_value), account_id = VALUES(account_id), login_checksum = VALUES(login_checksum)",
+               "%u, '%s', %u, %i, %u, '%s', %i, %i, %i, %i, %i, %i, %i, %u, %u, 0", item->details.unique_id, type, char_id, item->details.slot_id, item->details.item_id,
+               getSafeEscapeString(item->creator.c_str()).c_str(), item->adorn0, item->adorn1, item->adorn2, item->generic_info.condition, item->CheckFlag(ATTUNED) ? 1 : 0, item->details.inv_slot_id, item->details.count, item->GetMaxSellValue(), account_id);
+}
+
 void WorldDatabase::DeleteItem(int32 char_id, Item* item, const char* type) {
   Query query;
   string delete_item;
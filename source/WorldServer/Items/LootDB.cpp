@@ -35,16 +35,24 @@ void WorldDatabase::LoadLoot(ZoneServer* zone) {
     LogWrite(LOOT__DEBUG, 0, "Loot", "--Loading LootTables...");
     LootTable* table = 0;
     // Load loottable from DB
+    unsigned int field_id = result.GetFieldIndex("id");
+    unsigned int field_name = result.GetFieldIndex("name");
+    unsigned int field_mincoin = result.GetFieldIndex("mincoin");
+    unsigned int field_maxcoin = result.GetFieldIndex("maxcoin");
+    unsigned int field_maxlootitems = result.GetFieldIndex("maxlootitems");
+    unsigned int field_lootdrop_probability = result.GetFieldIndex("lootdrop_probability");
+    unsigned int field_coin_probability = result.GetFieldIndex("coin_probability");
+
     while (result.Next()) {
-      int32 id = result.GetInt32Str("id");
+      int32 id = result.GetInt32(field_id);
 
       table = new LootTable;
-      table->name = result.GetStringStr("name");
-      table->mincoin = result.GetInt32Str("mincoin");
-      table->maxcoin = result.GetInt32Str("maxcoin");
-      table->maxlootitems = result.GetInt16Str("maxlootitems");
-      table->lootdrop_probability = result.GetFloatStr("lootdrop_probability");
-      table->coin_probability = result.GetFloatStr("coin_probability");
+      table->name = result.GetString(field_name);
+      table->mincoin = result.GetInt32(field_mincoin);
+      table->maxcoin = result.GetInt32(field_maxcoin);
+      table->maxlootitems = result.GetInt16(field_maxlootitems);
+      table->lootdrop_probability = result.GetFloat(field_lootdrop_probability);
+      table->coin_probability = result.GetFloat(field_coin_probability);
       zone->AddLootTable(id, table);
 
       LogWrite(LOOT__DEBUG, 5, "Loot", "---Loading LootTable '%s' (id: %u)", table->name.c_str(), id);
@@ -60,13 +68,19 @@ void WorldDatabase::LoadLoot(ZoneServer* zone) {
     LogWrite(LOOT__DEBUG, 0, "Loot", "--Loading LootDrops...");
     LootDrop* drop = 0;
 
+    unsigned int field_loot_table_id = result.GetFieldIndex("loot_table_id");
+    unsigned int field_item_id = result.GetFieldIndex("item_id");
+    unsigned int field_item_charges = result.GetFieldIndex("item_charges");
+    unsigned int field_equip_item = result.GetFieldIndex("equip_item");
+    unsigned int field_probability = result.GetFieldIndex("probability");
+
     while (result.Next()) {
-      int32 id = result.GetInt32Str("loot_table_id");
+      int32 id = result.GetInt32(field_loot_table_id);
       drop = new LootDrop;
-      drop->item_id = result.GetInt32Str("item_id");
-      drop->item_charges = result.GetInt16Str("item_charges");
-      drop->equip_item = (result.GetInt8Str("equip_item") == 1);
-      drop->probability = result.GetFloatStr("probability");
+      drop->item_id = result.GetInt32(field_item_id);
+      drop->item_charges = result.GetInt16(field_item_charges);
+      drop->equip_item = (result.GetInt8(field_equip_item) == 1);
+      drop->probability = result.GetFloat(field_probability);
       zone->AddLootDrop(id, drop);
 
       LogWrite(LOOT__DEBUG, 5, "Loot", "---Loading LootDrop item_id %u (tableID: %u", drop->item_id, id);
@@ -81,9 +95,12 @@ void WorldDatabase::LoadLoot(ZoneServer* zone) {
     count = 0;
     LogWrite(LOOT__DEBUG, 0, "Loot", "--Assigning loot table(s) to spawn(s)...");
 
+    unsigned int field_spawn_id = result.GetFieldIndex("spawn_id");
+    unsigned int field_loottable_id = result.GetFieldIndex("loottable_id");
+
     while (result.Next()) {
-      int32 spawn_id = result.GetInt32Str("spawn_id");
-      int32 table_id = result.GetInt32Str("loottable_id");
+      int32 spawn_id = result.GetInt32(field_spawn_id);
+      int32 table_id = result.GetInt32(field_loottable_id);
       zone->AddSpawnLootList(spawn_id, table_id);
       LogWrite(LOOT__DEBUG, 5, "Loot", "---Adding loot table %u to spawn %u", table_id, spawn_id);
       count++;
@@ -100,22 +117,28 @@ void WorldDatabase::LoadGlobalLoot(ZoneServer* zone) {
   DatabaseResult result;
   int32 count = 0;
   if (database_new.Select(&result, "SELECT type, loot_table, value1, value2, value3, value4 FROM loot_global")) {
+    unsigned int field_type = result.GetFieldIndex("type");
+    unsigned int field_loot_table = result.GetFieldIndex("loot_table");
+    unsigned int field_value1 = result.GetFieldIndex("value1");
+    unsigned int field_value2 = result.GetFieldIndex("value2");
+    unsigned int field_value3 = result.GetFieldIndex("value3");
+
     while (result.Next()) {
-      const char* type = result.GetStringStr("type");
-      int32 table_id = result.GetInt32Str("loot_table");
+      const char* type = result.GetString(field_type);
+      int32 table_id = result.GetInt32(field_loot_table);
       if (strcmp(type, "Level") == 0) {
-        int8 level = result.GetInt8Str("value1");
+        int8 level = result.GetInt8(field_value1);
         zone->AddLevelLootList(level, table_id);
         LogWrite(LOOT__DEBUG, 5, "Loot", "---Loading Level %i loot table (id: %u)", level, table_id);
       } else if (strcmp(type, "Racial") == 0) {
-        int16 race_id = result.GetInt16Str("value1");
+        int16 race_id = result.GetInt16(field_value1);
         zone->AddRacialLootList(race_id, table_id);
         LogWrite(LOOT__DEBUG, 5, "Loot", "---Loading Racial %i loot table (id: %u)", race_id, table_id);
       } else if (strcmp(type, "Zone") == 0) {
         ZoneLoot* loot = new ZoneLoot();
-        int32 zoneID = result.GetInt32Str("value1");
-        loot->minLevel = result.GetInt8Str("value2");
-        loot->maxLevel = result.GetInt8Str("value3");
+        int32 zoneID = result.GetInt32(field_value1);
+        loot->minLevel = result.GetInt8(field_value2);
+        loot->maxLevel = result.GetInt8(field_value3);
 
         if (loot->minLevel > loot->maxLevel)
           loot->maxLevel = loot->minLevel;
@@ -100,7 +100,6 @@ LoginServer::LoginServer(const char* iAddress, int16 iPort) {
   maxPlayers = -1;
   minGameFullStatus = 100;
   update_server_verified = false;
-  last_checked_time = 0;
   UpdateServerPort = 0;
   UpdateServerIP = 0;
   update_server_completed = false;
@@ -162,9 +161,6 @@ void LoginServer::SendImmediateEquipmentUpdatesForChar(int32 char_id) {
 }
 
 bool LoginServer::Process() {
-  if (last_checked_time > Timer::GetCurrentTime2())
-    return true;
-  last_checked_time = Timer::GetCurrentTime2() + 50;
   bool ret = true;
   if (statusupdate_timer->Check()) {
     this->SendStatus();
@@ -394,6 +390,9 @@ bool LoginServer::Process() {
           zar->setFirstLogin(true);
           zone_auth.AddAuth(zar);
           safe_delete_array(characterName);
+
+          // start loading the character's zone while the client connects
+          zone_list.Prewarm(database.GetCharacterCurrentZoneID(utwr->char_id));
         }
       }
       break;
@@ -103,7 +103,6 @@ private:
   deque<uchar*> data_updates_waiting;
   MutexMap<int32, LoginZoneUpdate>* zone_updates;
   MutexMap<int32, LoginEquipmentUpdate>* loginEquip_updates;
-  int32 last_checked_time;
 
   Timer* statusupdate_timer;
 };
@@ -1282,6 +1282,7 @@ int EQ2Emu_lua_SetPosition(lua_State* state) {
     spawn->SetX(x);
     spawn->SetY(y);
     spawn->SetZ(z);
+    spawn->UpdateGridCell();
 
     if (heading != 0)
       spawn->SetHeading(heading);
@@ -3538,8 +3539,8 @@ int EQ2Emu_lua_SummonPet(lua_State* state) {
   if (spawn->IsPlayer()) {
     random_pet_name = string(spawn->GetName());
   } else {
-    int16 rand_index = MakeRandomInt(0, spawn->GetZone()->pet_names.size() - 1);
-    random_pet_name = spawn->GetZone()->pet_names.at(rand_index);
+    int16 rand_index = MakeRandomInt(0, spawn->GetZone()->GetPetNameList()->size() - 1);
+    random_pet_name = spawn->GetZone()->GetPetNameList()->at(rand_index);
   }
 
   pet->SetX(spawn->GetX());
@@ -3654,8 +3655,8 @@ int EQ2Emu_lua_SummonDeityPet(lua_State* state) {
   spawn->GetZone()->AddSpawn(pet);
 
   string random_pet_name;
-  int16 rand_index = MakeRandomInt(0, spawn->GetZone()->pet_names.size() - 1);
-  random_pet_name = spawn->GetZone()->pet_names.at(rand_index);
+  int16 rand_index = MakeRandomInt(0, spawn->GetZone()->GetPetNameList()->size() - 1);
+  random_pet_name = spawn->GetZone()->GetPetNameList()->at(rand_index);
   LogWrite(PET__DEBUG, 0, "Pets", "Randomize Pet Name: '%s' (rand: %i)", random_pet_name.c_str(), rand_index);
 
   pet->SetName(random_pet_name.c_str());
@@ -3741,8 +3742,8 @@ int EQ2Emu_lua_SummonCosmeticPet(lua_State* state) {
   spawn->GetZone()->AddSpawn(pet);
 
   string random_pet_name;
-  int16 rand_index = MakeRandomInt(0, spawn->GetZone()->pet_names.size() - 1);
-  random_pet_name = spawn->GetZone()->pet_names.at(rand_index);
+  int16 rand_index = MakeRandomInt(0, spawn->GetZone()->GetPetNameList()->size() - 1);
+  random_pet_name = spawn->GetZone()->GetPetNameList()->at(rand_index);
   LogWrite(PET__DEBUG, 0, "Pets", "Randomize Pet Name: '%s' (rand: %i)", random_pet_name.c_str(), rand_index);
 
   pet->SetName(random_pet_name.c_str());
@@ -4085,14 +4086,14 @@ int EQ2Emu_lua_SetTempVariable(lua_State* state) {
   Quest* quest = 0;
   string val;
 
-  // Finally we get to grabbing the third param, we will first check to see if it is light user data
+  // Finally we get to grabbing the third param, we will first check to see if it is user data
   // which is custom data types, in this case it can be Spawn, Zone, Item, or Quest.  Conversation and
-  // options window are also light user data be we do not handle those.
-  // We check with lua_islightuserdata(lua_State*, index)
-  if (lua_islightuserdata(state, 3)) {
-    // It is light user data so we will grab the param with lua_touserdata(lua_State*, index)
-    // and convert it to LUAUserData*
-    LUAUserData* data = static_cast<LUAUserData*>(lua_touserdata(state, 3));
+  // options window are also user data be we do not handle those.
+  // We check with lua_isuserdata(lua_State*, index)
+  if (lua_isuserdata(state, 3)) {
+    // It is user data so we will grab the param with GetUserData(lua_State*, index), which
+    // only returns the LUAUserData pushed by the server
+    LUAUserData* data = lua_interface->GetUserData(state, 3);
     // Check to make sure the data we got is valid, if not give an error
     if (!data || !data->IsCorrectlyInitialized()) {
       lua_interface->LogError("LUA SetTempVariable command error while processing %s", lua_tostring(state, -1));
@@ -4118,12 +4119,12 @@ int EQ2Emu_lua_SetTempVariable(lua_State* state) {
       dataType = 4;
     }
   }
-  // Wasn't light user data, check if it is nil(null)
+  // Wasn't user data, check if it is nil(null)
   else if (lua_isnil(state, 3)) {
     // It is nil (null) set the dataType variable, no need to set a pointer in this case
     dataType = 6;
   }
-  // Wasn't light user data or nil (null), must be a string
+  // Wasn't user data or nil (null), must be a string
   else {
     // Set the string and dataType variable
     val = lua_interface->GetStringValue(state, 3);
@@ -5690,8 +5691,8 @@ int EQ2Emu_lua_SummonDumbFirePet(lua_State* state) {
 
   // Get a random pet name
   string random_pet_name;
-  int16 rand_index = MakeRandomInt(0, spawn->GetZone()->pet_names.size() - 1);
-  random_pet_name = spawn->GetZone()->pet_names.at(rand_index);
+  int16 rand_index = MakeRandomInt(0, spawn->GetZone()->GetPetNameList()->size() - 1);
+  random_pet_name = spawn->GetZone()->GetPetNameList()->at(rand_index);
   LogWrite(PET__DEBUG, 0, "Pets", "Randomize Pet Name: '%s' (rand: %i)", random_pet_name.c_str(), rand_index);
 
   // Spawn the pet at the same location as the owner
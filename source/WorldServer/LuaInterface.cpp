@@ -21,6 +21,10 @@
 #include "LuaFunctions.h"
 #include "WorldDatabase.h"
 #include "../common/Log.h"
+#include "Rules/Rules.h"
+
+#include <algorithm>
+#include <new>
 
 #ifndef WIN32
 #include <stdio.h>
@@ -33,6 +37,7 @@
 #endif
 
 extern WorldDatabase database;
+extern RuleManager rule_manager;
 
 LuaInterface::LuaInterface() {
   shutting_down = false;
@@ -42,11 +47,8 @@ LuaInterface::LuaInterface() {
   MSpawnScripts.SetName("LuaInterface::MSpawnScripts");
   MZoneScripts.SetName("LuaInterface::MZoneScripts");
   MQuests.SetName("LuaInterface::MQuests");
-  MLUAUserData.SetName("LuaInterface::MLUAUserData");
-  MLUAMain.SetName("LuaInterface::MLUAMain");
   MItemScripts.SetName("LuaInterface::MItemScripts");
-  user_data_timer = new Timer(20000);
-  user_data_timer->Start();
+  MScriptBytecode.SetName("LuaInterface::MScriptBytecode");
 }
 #ifdef WIN32
 vector<string>* LuaInterface::GetDirectoryListing(const char* directory) {
@@ -103,23 +105,11 @@ vector<string>* LuaInterface::GetDirectoryListing(const char* directory) {
 
 LuaInterface::~LuaInterface() {
   shutting_down = true;
-  MLUAMain.lock();
   DestroySpells();
   DestroySpawnScripts();
   DestroyQuests();
   DestroyItemScripts();
   DestroyZoneScripts();
-  DeleteUserDataPtrs(true);
-  safe_delete(user_data_timer);
-}
-
-void LuaInterface::Process() {
-  if (shutting_down)
-    return;
-  MLUAMain.lock();
-  if (user_data_timer && user_data_timer->Check())
-    DeleteUserDataPtrs(false);
-  MLUAMain.unlock();
 }
 
 void LuaInterface::DestroySpells() {
@@ -129,6 +119,7 @@ void LuaInterface::DestroySpells() {
   }
   spells.clear();
   MSpells.unlock();
+  ClearScriptBytecode();
 }
 
 void LuaInterface::DestroyQuests(bool reload) {
@@ -145,63 +136,45 @@ void LuaInterface::DestroyQuests(bool reload) {
     safe_delete(mutex_itr->second);
   }
   quests_mutex.clear();
+  ClearScriptBytecode();
   if (reload)
     database.LoadQuests();
   MQuests.unlock();
 }
 
 void LuaInterface::DestroyItemScripts() {
-  map<string, map<lua_State*, bool>>::iterator itr;
-  map<lua_State*, bool>::iterator state_itr;
-  Mutex* mutex = 0;
-  MItemScripts.writelock(__FUNCTION__, __LINE__);
-  for (itr = item_scripts.begin(); itr != item_scripts.end(); itr++) {
-    mutex = GetItemScriptMutex(itr->first.c_str());
-    mutex->writelock(__FUNCTION__, __LINE__);
-    for (state_itr = itr->second.begin(); state_itr != itr->second.end(); state_itr++)
-      lua_close(state_itr->first);
-    mutex->releasewritelock(__FUNCTION__, __LINE__);
-    safe_delete(mutex);
-  }
-  item_scripts.clear();
-  item_scripts_mutex.clear();
-  MItemScripts.releasewritelock(__FUNCTION__, __LINE__);
+  DestroyScripts(item_scripts, MItemScripts, item_scripts_mutex);
 }
 
 void LuaInterface::DestroySpawnScripts() {
-  map<string, map<lua_State*, bool>>::iterator itr;
-  map<lua_State*, bool>::iterator state_itr;
-  Mutex* mutex = 0;
-  MSpawnScripts.writelock(__FUNCTION__, __LINE__);
-  for (itr = spawn_scripts.begin(); itr != spawn_scripts.end(); itr++) {
-    mutex = GetSpawnScriptMutex(itr->first.c_str());
-    mutex->writelock(__FUNCTION__, __LINE__);
-    for (state_itr = itr->second.begin(); state_itr != itr->second.end(); state_itr++)
-      lua_close(state_itr->first);
-    mutex->releasewritelock(__FUNCTION__, __LINE__);
-    safe_delete(mutex);
-  }
-  spawn_scripts.clear();
-  spawn_scripts_mutex.clear();
-  MSpawnScripts.releasewritelock(__FUNCTION__, __LINE__);
+  DestroyScripts(spawn_scripts, MSpawnScripts, spawn_scripts_mutex);
 }
 
 void LuaInterface::DestroyZoneScripts() {
-  map<string, map<lua_State*, bool>>::iterator itr;
-  map<lua_State*, bool>::iterator state_itr;
-  Mutex* mutex = 0;
-  MZoneScripts.writelock(__FUNCTION__, __LINE__);
-  for (itr = zone_scripts.begin(); itr != zone_scripts.end(); itr++) {
-    mutex = GetZoneScriptMutex(itr->first.c_str());
-    mutex->writelock(__FUNCTION__, __LINE__);
-    for (state_itr = itr->second.begin(); state_itr != itr->second.end(); state_itr++)
-      lua_close(state_itr->first);
-    mutex->releasewritelock(__FUNCTION__, __LINE__);
-    safe_delete(mutex);
+  DestroyScripts(zone_scripts, MZoneScripts, zone_scripts_mutex);
+}
+
+void LuaInterface::DestroyScripts(LuaScriptPoolList& scripts, Mutex& scripts_mutex, map<string, Mutex*>& script_mutexes) {
+  map<string, Mutex*>::iterator mutex_itr;
+  scripts_mutex.writelock(__FUNCTION__, __LINE__);
+  for (const auto& kv : scripts) {
+    Mutex* mutex = 0;
+    mutex_itr = script_mutexes.find(kv.first);
+    if (mutex_itr != script_mutexes.end())
+      mutex = mutex_itr->second;
+    if (mutex)
+      mutex->writelock(__FUNCTION__, __LINE__);
+    for (lua_State* state : kv.second->states)
+      lua_close(state);
+    if (mutex)
+      mutex->releasewritelock(__FUNCTION__, __LINE__);
   }
-  zone_scripts.clear();
-  zone_scripts_mutex.clear();
-  MZoneScripts.releasewritelock(__FUNCTION__, __LINE__);
+  scripts.clear();
+  for (mutex_itr = script_mutexes.begin(); mutex_itr != script_mutexes.end(); mutex_itr++)
+    safe_delete(mutex_itr->second);
+  script_mutexes.clear();
+  scripts_mutex.releasewritelock(__FUNCTION__, __LINE__);
+  ClearScriptBytecode();
 }
 
 void LuaInterface::ReloadSpells() {
@@ -260,45 +233,15 @@ bool LuaInterface::LoadItemScript(string name) {
 }
 
 bool LuaInterface::LoadItemScript(const char* name) {
-  bool ret = false;
-  if (name) {
-    lua_State* state = LoadLuaFile(name);
-    if (state) {
-      MItemScripts.writelock(__FUNCTION__, __LINE__);
-      item_scripts[name][state] = false;
-      MItemScripts.releasewritelock(__FUNCTION__, __LINE__);
-      ret = true;
-    }
-  }
-  return ret;
+  return name && AddScriptStates(item_scripts, MItemScripts, name, 1, false) != 0;
 }
 
 bool LuaInterface::LoadSpawnScript(const char* name) {
-  bool ret = false;
-  if (name) {
-    lua_State* state = LoadLuaFile(name);
-    if (state) {
-      MSpawnScripts.writelock(__FUNCTION__, __LINE__);
-      spawn_scripts[name][state] = false;
-      MSpawnScripts.releasewritelock(__FUNCTION__, __LINE__);
-      ret = true;
-    }
-  }
-  return ret;
+  return name && AddScriptStates(spawn_scripts, MSpawnScripts, name, 1, false) != 0;
 }
 
 bool LuaInterface::LoadZoneScript(const char* name) {
-  bool ret = false;
-  if (name) {
-    lua_State* state = LoadLuaFile(name);
-    if (state) {
-      MZoneScripts.writelock(__FUNCTION__, __LINE__);
-      zone_scripts[name][state] = false;
-      MZoneScripts.releasewritelock(__FUNCTION__, __LINE__);
-      ret = true;
-    }
-  }
-  return ret;
+  return name && AddScriptStates(zone_scripts, MZoneScripts, name, 1, false) != 0;
 }
 
 void LuaInterface::ProcessErrorMessage(const char* message) {
@@ -362,7 +305,12 @@ void LuaInterface::CallQuestFunction(Quest* quest, const char* function, Spawn*
         SetInt32Value(state, step_id);
         arg_count++;
       }
-      if (lua_pcall(state, arg_count, 0, 0) != 0) {
+      int ret = 0;
+      {
+        LuaProfileScope profile(&profiler, quest->GetName(), function);
+        ret = lua_pcall(state, arg_count, 0, 0);
+      }
+      if (ret != 0) {
         LogError("Error processing quest function '%s': %s ", function, lua_tostring(state, -1));
         lua_pop(state, 1);
         mutex->unlock();
@@ -467,14 +415,20 @@ void LuaInterface::SetCurrentSpell(lua_State* state, shared_ptr<LuaSpell> spell)
   current_spells[state] = spell;
 }
 
-bool LuaInterface::CallSpellProcess(shared_ptr<LuaSpell> spell, int8 num_parameters) {
+bool LuaInterface::CallSpellProcess(shared_ptr<LuaSpell> spell, int8 num_parameters, const char* function) {
   if (shutting_down || !spell || !spell->caster) {
     return false;
   }
 
   SetCurrentSpell(spell->state, spell);
 
-  if (lua_pcall(spell->state, num_parameters, 0, 0) != 0) {
+  int ret = 0;
+  {
+    LuaProfileScope profile(&profiler, spell->file_name.c_str(), function);
+    ret = lua_pcall(spell->state, num_parameters, 0, 0);
+  }
+
+  if (ret != 0) {
     LogError("Error running %s", lua_tostring(spell->state, -1));
 
     lua_pop(spell->state, 1);
@@ -491,17 +445,18 @@ bool LuaInterface::CallSpellProcess(shared_ptr<LuaSpell> spell, int8 num_paramet
 }
 
 void LuaInterface::RemoveSpawnScript(const char* name) {
-  lua_State* state = 0;
   Mutex* mutex = GetSpawnScriptMutex(name);
-  while ((state = GetSpawnScript(name, false))) {
+  MSpawnScripts.writelock(__FUNCTION__, __LINE__);
+  LuaScriptPoolList::iterator itr = spawn_scripts.find(name);
+  if (itr != spawn_scripts.end()) {
     mutex->writelock(__FUNCTION__, __LINE__);
-    lua_close(state);
-    spawn_scripts[name].erase(state);
+    for (lua_State* state : itr->second->states)
+      lua_close(state);
     mutex->releasewritelock(__FUNCTION__, __LINE__);
+    spawn_scripts.erase(itr);
   }
-  MSpawnScripts.writelock(__FUNCTION__, __LINE__);
-  spawn_scripts.erase(name);
   MSpawnScripts.releasewritelock(__FUNCTION__, __LINE__);
+  ClearScriptBytecode(name);
 }
 
 bool LuaInterface::CallItemScript(lua_State* state, int8 num_parameters) {
@@ -551,7 +506,7 @@ lua_State* LuaInterface::LoadLuaFile(const char* name) {
     return 0;
   lua_State* state = luaL_newstate();
   luaL_openlibs(state);
-  if (luaL_dofile(state, name) == 0) {
+  if (LoadScriptChunk(state, name) == 0 && lua_pcall(state, 0, LUA_MULTRET, 0) == 0) {
     RegisterFunctions(state);
     return state;
   } else {
@@ -562,6 +517,46 @@ lua_State* LuaInterface::LoadLuaFile(const char* name) {
   return 0;
 }
 
+static int WriteScriptBytecode(lua_State* state, const void* data, size_t size, void* bytecode) {
+  ((string*)bytecode)->append((const char*)data, size);
+  return 0;
+}
+
+// Pushes the compiled chunk of the file, only the first load of a file runs the parser
+int LuaInterface::LoadScriptChunk(lua_State* state, const char* name) {
+  string chunk_name = string("@") + name;
+  MScriptBytecode.readlock(__FUNCTION__, __LINE__);
+  map<string, string>::iterator itr = script_bytecode.find(name);
+  if (itr != script_bytecode.end()) {
+    int ret = luaL_loadbuffer(state, itr->second.data(), itr->second.size(), chunk_name.c_str());
+    MScriptBytecode.releasereadlock(__FUNCTION__, __LINE__);
+    return ret;
+  }
+  MScriptBytecode.releasereadlock(__FUNCTION__, __LINE__);
+
+  int ret = luaL_loadfile(state, name);
+  if (ret != 0)
+    return ret;
+
+  // keep the debug info so errors still report line numbers
+  string bytecode;
+  if (lua_dump(state, WriteScriptBytecode, &bytecode, 0) == 0) {
+    MScriptBytecode.writelock(__FUNCTION__, __LINE__);
+    script_bytecode[name] = move(bytecode);
+    MScriptBytecode.releasewritelock(__FUNCTION__, __LINE__);
+  }
+  return 0;
+}
+
+void LuaInterface::ClearScriptBytecode(const char* name) {
+  MScriptBytecode.writelock(__FUNCTION__, __LINE__);
+  if (name)
+    script_bytecode.erase(name);
+  else
+    script_bytecode.clear();
+  MScriptBytecode.releasewritelock(__FUNCTION__, __LINE__);
+}
+
 void LuaInterface::RemoveSpell(shared_ptr<LuaSpell> spell, Spawn* spawn, bool call_remove_function) {
   if (shutting_down)
     return;
@@ -569,16 +564,10 @@ void LuaInterface::RemoveSpell(shared_ptr<LuaSpell> spell, Spawn* spawn, bool ca
   if (call_remove_function) {
     lua_getglobal(spell->state, "remove");
 
-    LUASpawnWrapper* spawn_wrapper = new LUASpawnWrapper();
-    spawn_wrapper->spawn = spell->caster;
-    AddUserDataPtr(spawn_wrapper);
-    lua_pushlightuserdata(spell->state, spawn_wrapper);
+    SetSpawnValue(spell->state, spell->caster);
 
     if (spawn) {
-      spawn_wrapper = new LUASpawnWrapper();
-      spawn_wrapper->spawn = spawn;
-      AddUserDataPtr(spawn_wrapper);
-      lua_pushlightuserdata(spell->state, spawn_wrapper);
+      SetSpawnValue(spell->state, spawn);
     } else {
       lua_pushlightuserdata(spell->state, 0);
     }
@@ -602,396 +591,421 @@ void LuaInterface::RemoveSpell(shared_ptr<LuaSpell> spell, Spawn* spawn, bool ca
     }
 
     SetCurrentSpell(spell->state, spell);
+    LuaProfileScope profile(&profiler, spell->file_name.c_str(), "remove");
     lua_pcall(spell->state, data.size() + 2, 0, 0);
     SetCurrentSpell(spell->state, nullptr);
   }
 }
 
 void LuaInterface::RegisterFunctions(lua_State* state) {
-  lua_register(state, "SetHP", EQ2Emu_lua_SetCurrentHP);
-  lua_register(state, "SetMaxHP", EQ2Emu_lua_SetMaxHP);
-  lua_register(state, "SetMaxHPBase", EQ2Emu_lua_SetMaxHPBase);
-  lua_register(state, "SetPower", EQ2Emu_lua_SetCurrentPower);
-  lua_register(state, "SetMaxPower", EQ2Emu_lua_SetMaxPower);
-  lua_register(state, "SetMaxPowerBase", EQ2Emu_lua_SetMaxPowerBase);
-  lua_register(state, "SetPosition", EQ2Emu_lua_SetPosition);
-  lua_register(state, "SetHeading", EQ2Emu_lua_SetHeading);
-  lua_register(state, "SetModelType", EQ2Emu_lua_SetModelType);
-  lua_register(state, "SetAdventureClass", EQ2Emu_lua_SetAdventureClass);
-  lua_register(state, "SetTradeskillClass", EQ2Emu_lua_SetTradeskillClass);
-  lua_register(state, "SetMount", EQ2Emu_lua_SetMount);
-  lua_register(state, "SetMountColor", EQ2Emu_lua_SetMountColor);
-  lua_register(state, "GetMount", EQ2Emu_lua_GetMount);
-  lua_register(state, "GetRace", EQ2Emu_lua_GetRace);
-  lua_register(state, "GetRaceName", EQ2Emu_lua_GetRaceName);
-  lua_register(state, "GetClass", EQ2Emu_lua_GetClass);
-  lua_register(state, "GetClassName", EQ2Emu_lua_GetClassName);
-  lua_register(state, "GetArchetypeName", EQ2Emu_lua_GetArchetypeName);
-  lua_register(state, "SetSpeed", EQ2Emu_lua_SetSpeed);
-  lua_register(state, "ModifyPower", EQ2Emu_lua_ModifyPower);
-  lua_register(state, "ModifyHP", EQ2Emu_lua_ModifyHP);
-
-  lua_register(state, "GetDistance", EQ2Emu_lua_GetDistance);
-  lua_register(state, "GetHeading", EQ2Emu_lua_GetHeading);
-  lua_register(state, "GetLevel", EQ2Emu_lua_GetLevel);
-  lua_register(state, "GetHP", EQ2Emu_lua_GetCurrentHP);
-  lua_register(state, "GetMaxHP", EQ2Emu_lua_GetMaxHP);
-  lua_register(state, "GetMaxHPBase", EQ2Emu_lua_GetMaxHPBase);
-  lua_register(state, "GetMaxPower", EQ2Emu_lua_GetMaxPower);
-  lua_register(state, "GetMaxPowerBase", EQ2Emu_lua_GetMaxPowerBase);
-  lua_register(state, "GetName", EQ2Emu_lua_GetName);
-  lua_register(state, "GetPower", EQ2Emu_lua_GetCurrentPower);
-  lua_register(state, "GetX", EQ2Emu_lua_GetX);
-  lua_register(state, "GetY", EQ2Emu_lua_GetY);
-  lua_register(state, "GetZ", EQ2Emu_lua_GetZ);
-  lua_register(state, "GetSpawnID", EQ2Emu_lua_GetSpawnID);
-  lua_register(state, "GetSpawnGroupID", EQ2Emu_lua_GetSpawnGroupID);
-  lua_register(state, "GetSpawnLocationID", EQ2Emu_lua_GetSpawnLocationID);
-  lua_register(state, "GetSpawnLocationPlacementID", EQ2Emu_lua_GetSpawnLocationPlacementID);
-  lua_register(state, "GetFactionAmount", EQ2Emu_lua_GetFactionAmount);
-  lua_register(state, "GetGender", EQ2Emu_lua_GetGender);
-  lua_register(state, "GetTarget", EQ2Emu_lua_GetTarget);
-  lua_register(state, "HasFreeSlot", EQ2Emu_lua_HasFreeSlot);
-  lua_register(state, "HasItemEquipped", EQ2Emu_lua_HasItemEquipped);
-  lua_register(state, "GetEquippedItemByID", EQ2Emu_lua_GetEquippedItemByID);
-  lua_register(state, "GetEquippedItemBySlot", EQ2Emu_lua_GetEquippedItemBySlot);
-  lua_register(state, "GetItemByID", EQ2Emu_lua_GetItemByID);
-  lua_register(state, "GetItemType", EQ2Emu_lua_GetItemType);
-  lua_register(state, "GetSpellName", EQ2Emu_lua_GetSpellName);
-  lua_register(state, "GetCaster", EQ2Emu_lua_GetCaster);
-  lua_register(state, "SpellWasCured", EQ2Emu_lua_SpellWasCured);
-
-  lua_register(state, "GetModelType", EQ2Emu_lua_GetModelType);
-  lua_register(state, "GetSpeed", EQ2Emu_lua_GetSpeed);
-  lua_register(state, "HasMoved", EQ2Emu_lua_HasMoved);
-  lua_register(state, "SpellDamage", EQ2Emu_lua_SpellDamage);
-  lua_register(state, "CastSpell", EQ2Emu_lua_CastSpell);
-  lua_register(state, "SpellHeal", EQ2Emu_lua_SpellHeal);
-  lua_register(state, "SummonItem", EQ2Emu_lua_SummonItem);
-  lua_register(state, "RemoveItem", EQ2Emu_lua_RemoveItem);
-  lua_register(state, "HasItem", EQ2Emu_lua_HasItem);
-  lua_register(state, "SpawnMob", EQ2Emu_lua_Spawn);
-  lua_register(state, "SummonPet", EQ2Emu_lua_SummonPet);
-  lua_register(state, "AddSpawnAccess", EQ2Emu_lua_AddSpawnAccess);
-  lua_register(state, "GetZone", EQ2Emu_lua_GetZone);
-  lua_register(state, "GetZoneName", EQ2Emu_lua_GetZoneName);
-  lua_register(state, "GetZoneID", EQ2Emu_lua_GetZoneID);
-  lua_register(state, "Zone", EQ2Emu_lua_Zone);
-  lua_register(state, "AddHate", EQ2Emu_lua_AddHate);
-  lua_register(state, "IsAlive", EQ2Emu_lua_IsAlive);
-  lua_register(state, "IsInCombat", EQ2Emu_lua_IsInCombat);
-  lua_register(state, "Attack", EQ2Emu_lua_Attack);
-  lua_register(state, "ApplySpellVisual", EQ2Emu_lua_ApplySpellVisual);
-
-  lua_register(state, "IsPlayer", EQ2Emu_lua_IsPlayer);
-  lua_register(state, "FaceTarget", EQ2Emu_lua_FaceTarget);
-  lua_register(state, "MoveToLocation", EQ2Emu_lua_MoveToLocation);
-  lua_register(state, "Shout", EQ2Emu_lua_Shout);
-  lua_register(state, "Say", EQ2Emu_lua_Say);
-  lua_register(state, "SayOOC", EQ2Emu_lua_SayOOC);
-  lua_register(state, "Emote", EQ2Emu_lua_Emote);
-  lua_register(state, "MovementLoopAddLocation", EQ2Emu_lua_MovementLoopAdd);
-  lua_register(state, "GetCurrentZoneSafeLocation", EQ2Emu_lua_GetCurrentZoneSafeLocation);
-  lua_register(state, "AddTimer", EQ2Emu_lua_AddTimer);
-  lua_register(state, "Harvest", EQ2Emu_lua_Harvest);
-
-  lua_register(state, "AddSpellBonus", EQ2Emu_lua_AddSpellBonus);
-  lua_register(state, "RemoveSpellBonus", EQ2Emu_lua_RemoveSpellBonus);
-  lua_register(state, "AddSkillBonus", EQ2Emu_lua_AddSkillBonus);
-  lua_register(state, "RemoveSkillBonus", EQ2Emu_lua_RemoveSkillBonus);
-  lua_register(state, "AddControlEffect", EQ2Emu_lua_AddControlEffect);
-  lua_register(state, "RemoveControlEffect", EQ2Emu_lua_RemoveControlEffect);
-  lua_register(state, "GetCurrentZoneSafeLocation", EQ2Emu_lua_GetCurrentZoneSafeLocation);
-  lua_register(state, "GetInt", EQ2Emu_lua_GetInt);
-  lua_register(state, "GetWis", EQ2Emu_lua_GetWis);
-  lua_register(state, "GetSta", EQ2Emu_lua_GetSta);
-  lua_register(state, "GetStr", EQ2Emu_lua_GetStr);
-  lua_register(state, "GetAgi", EQ2Emu_lua_GetAgi);
-  lua_register(state, "SetInt", EQ2Emu_lua_SetInt);
-  lua_register(state, "SetWis", EQ2Emu_lua_SetWis);
-  lua_register(state, "SetSta", EQ2Emu_lua_SetSta);
-  lua_register(state, "SetStr", EQ2Emu_lua_SetStr);
-  lua_register(state, "SetAgi", EQ2Emu_lua_SetAgi);
-  lua_register(state, "GetIntBase", EQ2Emu_lua_GetIntBase);
-  lua_register(state, "GetWisBase", EQ2Emu_lua_GetWisBase);
-  lua_register(state, "GetStaBase", EQ2Emu_lua_GetStaBase);
-  lua_register(state, "GetStrBase", EQ2Emu_lua_GetStrBase);
-  lua_register(state, "GetAgiBase", EQ2Emu_lua_GetAgiBase);
-  lua_register(state, "SetIntBase", EQ2Emu_lua_SetIntBase);
-  lua_register(state, "SetWisBase", EQ2Emu_lua_SetWisBase);
-  lua_register(state, "SetStaBase", EQ2Emu_lua_SetStaBase);
-  lua_register(state, "SetStrBase", EQ2Emu_lua_SetStrBase);
-  lua_register(state, "SetAgiBase", EQ2Emu_lua_SetAgiBase);
-  lua_register(state, "GetSpawn", EQ2Emu_lua_GetSpawn);
-  lua_register(state, "GetVariableValue", EQ2Emu_lua_GetVariableValue);
-  lua_register(state, "GetCoinMessage", EQ2Emu_lua_GetCoinMessage);
-  lua_register(state, "GetSpawnByGroupID", EQ2Emu_lua_GetSpawnByGroupID);
-  lua_register(state, "GetSpawnByLocationID", EQ2Emu_lua_GetSpawnByLocationID);
-  lua_register(state, "PlayFlavor", EQ2Emu_lua_PlayFlavor);
-  lua_register(state, "PlaySound", EQ2Emu_lua_PlaySound);
-  lua_register(state, "PlayVoice", EQ2Emu_lua_PlayVoice);
-  lua_register(state, "PlayAnimation", EQ2Emu_lua_PlayAnimation);
-  lua_register(state, "AddLootItem", EQ2Emu_lua_AddLootItem);
-  lua_register(state, "RemoveLootItem", EQ2Emu_lua_RemoveLootItem);
-  lua_register(state, "AddLootCoin", EQ2Emu_lua_AddLootCoin);
-  lua_register(state, "GiveLoot", EQ2Emu_lua_GiveLoot);
-  lua_register(state, "HasPendingLootItem", EQ2Emu_lua_HasPendingLootItem);
-  lua_register(state, "HasPendingLoot", EQ2Emu_lua_HasPendingLoot);
-  lua_register(state, "SetLootCoin", EQ2Emu_lua_SetLootCoin);
-  lua_register(state, "GetLootCoin", EQ2Emu_lua_GetLootCoin);
-  lua_register(state, "SetPlayerProximityFunction", EQ2Emu_lua_SetPlayerProximityFunction);
-  lua_register(state, "SetLocationProximityFunction", EQ2Emu_lua_SetLocationProximityFunction);
-  lua_register(state, "CreateConversation", EQ2Emu_lua_CreateConversation);
-  lua_register(state, "AddConversationOption", EQ2Emu_lua_AddConversationOption);
-  lua_register(state, "StartConversation", EQ2Emu_lua_StartConversation);
-  lua_register(state, "CloseConversation", EQ2Emu_lua_CloseConversation);
-  lua_register(state, "CloseItemConversation", EQ2Emu_lua_CloseItemConversation);
+  // marks the userdata pushed by Set*Value() so foreign userdata can't be mistaken for it
+  luaL_newmetatable(state, LUA_USERDATA_METATABLE);
+  lua_pop(state, 1);
+
+  RegisterFunction(state, "SetHP", EQ2Emu_lua_SetCurrentHP);
+  RegisterFunction(state, "SetMaxHP", EQ2Emu_lua_SetMaxHP);
+  RegisterFunction(state, "SetMaxHPBase", EQ2Emu_lua_SetMaxHPBase);
+  RegisterFunction(state, "SetPower", EQ2Emu_lua_SetCurrentPower);
+  RegisterFunction(state, "SetMaxPower", EQ2Emu_lua_SetMaxPower);
+  RegisterFunction(state, "SetMaxPowerBase", EQ2Emu_lua_SetMaxPowerBase);
+  RegisterFunction(state, "SetPosition", EQ2Emu_lua_SetPosition);
+  RegisterFunction(state, "SetHeading", EQ2Emu_lua_SetHeading);
+  RegisterFunction(state, "SetModelType", EQ2Emu_lua_SetModelType);
+  RegisterFunction(state, "SetAdventureClass", EQ2Emu_lua_SetAdventureClass);
+  RegisterFunction(state, "SetTradeskillClass", EQ2Emu_lua_SetTradeskillClass);
+  RegisterFunction(state, "SetMount", EQ2Emu_lua_SetMount);
+  RegisterFunction(state, "SetMountColor", EQ2Emu_lua_SetMountColor);
+  RegisterFunction(state, "GetMount", EQ2Emu_lua_GetMount);
+  RegisterFunction(state, "GetRace", EQ2Emu_lua_GetRace);
+  RegisterFunction(state, "GetRaceName", EQ2Emu_lua_GetRaceName);
+  RegisterFunction(state, "GetClass", EQ2Emu_lua_GetClass);
+  RegisterFunction(state, "GetClassName", EQ2Emu_lua_GetClassName);
+  RegisterFunction(state, "GetArchetypeName", EQ2Emu_lua_GetArchetypeName);
+  RegisterFunction(state, "SetSpeed", EQ2Emu_lua_SetSpeed);
+  RegisterFunction(state, "ModifyPower", EQ2Emu_lua_ModifyPower);
+  RegisterFunction(state, "ModifyHP", EQ2Emu_lua_ModifyHP);
+
+  RegisterFunction(state, "GetDistance", EQ2Emu_lua_GetDistance);
+  RegisterFunction(state, "GetHeading", EQ2Emu_lua_GetHeading);
+  RegisterFunction(state, "GetLevel", EQ2Emu_lua_GetLevel);
+  RegisterFunction(state, "GetHP", EQ2Emu_lua_GetCurrentHP);
+  RegisterFunction(state, "GetMaxHP", EQ2Emu_lua_GetMaxHP);
+  RegisterFunction(state, "GetMaxHPBase", EQ2Emu_lua_GetMaxHPBase);
+  RegisterFunction(state, "GetMaxPower", EQ2Emu_lua_GetMaxPower);
+  RegisterFunction(state, "GetMaxPowerBase", EQ2Emu_lua_GetMaxPowerBase);
+  RegisterFunction(state, "GetName", EQ2Emu_lua_GetName);
+  RegisterFunction(state, "GetPower", EQ2Emu_lua_GetCurrentPower);
+  RegisterFunction(state, "GetX", EQ2Emu_lua_GetX);
+  RegisterFunction(state, "GetY", EQ2Emu_lua_GetY);
+  RegisterFunction(state, "GetZ", EQ2Emu_lua_GetZ);
+  RegisterFunction(state, "GetSpawnID", EQ2Emu_lua_GetSpawnID);
+  RegisterFunction(state, "GetSpawnGroupID", EQ2Emu_lua_GetSpawnGroupID);
+  RegisterFunction(state, "GetSpawnLocationID", EQ2Emu_lua_GetSpawnLocationID);
+  RegisterFunction(state, "GetSpawnLocationPlacementID", EQ2Emu_lua_GetSpawnLocationPlacementID);
+  RegisterFunction(state, "GetFactionAmount", EQ2Emu_lua_GetFactionAmount);
+  RegisterFunction(state, "GetGender", EQ2Emu_lua_GetGender);
+  RegisterFunction(state, "GetTarget", EQ2Emu_lua_GetTarget);
+  RegisterFunction(state, "HasFreeSlot", EQ2Emu_lua_HasFreeSlot);
+  RegisterFunction(state, "HasItemEquipped", EQ2Emu_lua_HasItemEquipped);
+  RegisterFunction(state, "GetEquippedItemByID", EQ2Emu_lua_GetEquippedItemByID);
+  RegisterFunction(state, "GetEquippedItemBySlot", EQ2Emu_lua_GetEquippedItemBySlot);
+  RegisterFunction(state, "GetItemByID", EQ2Emu_lua_GetItemByID);
+  RegisterFunction(state, "GetItemType", EQ2Emu_lua_GetItemType);
+  RegisterFunction(state, "GetSpellName", EQ2Emu_lua_GetSpellName);
+  RegisterFunction(state, "GetCaster", EQ2Emu_lua_GetCaster);
+  RegisterFunction(state, "SpellWasCured", EQ2Emu_lua_SpellWasCured);
+
+  RegisterFunction(state, "GetModelType", EQ2Emu_lua_GetModelType);
+  RegisterFunction(state, "GetSpeed", EQ2Emu_lua_GetSpeed);
+  RegisterFunction(state, "HasMoved", EQ2Emu_lua_HasMoved);
+  RegisterFunction(state, "SpellDamage", EQ2Emu_lua_SpellDamage);
+  RegisterFunction(state, "CastSpell", EQ2Emu_lua_CastSpell);
+  RegisterFunction(state, "SpellHeal", EQ2Emu_lua_SpellHeal);
+  RegisterFunction(state, "SummonItem", EQ2Emu_lua_SummonItem);
+  RegisterFunction(state, "RemoveItem", EQ2Emu_lua_RemoveItem);
+  RegisterFunction(state, "HasItem", EQ2Emu_lua_HasItem);
+  RegisterFunction(state, "SpawnMob", EQ2Emu_lua_Spawn);
+  RegisterFunction(state, "SummonPet", EQ2Emu_lua_SummonPet);
+  RegisterFunction(state, "AddSpawnAccess", EQ2Emu_lua_AddSpawnAccess);
+  RegisterFunction(state, "GetZone", EQ2Emu_lua_GetZone);
+  RegisterFunction(state, "GetZoneName", EQ2Emu_lua_GetZoneName);
+  RegisterFunction(state, "GetZoneID", EQ2Emu_lua_GetZoneID);
+  RegisterFunction(state, "Zone", EQ2Emu_lua_Zone);
+  RegisterFunction(state, "AddHate", EQ2Emu_lua_AddHate);
+  RegisterFunction(state, "IsAlive", EQ2Emu_lua_IsAlive);
+  RegisterFunction(state, "IsInCombat", EQ2Emu_lua_IsInCombat);
+  RegisterFunction(state, "Attack", EQ2Emu_lua_Attack);
+  RegisterFunction(state, "ApplySpellVisual", EQ2Emu_lua_ApplySpellVisual);
+
+  RegisterFunction(state, "IsPlayer", EQ2Emu_lua_IsPlayer);
+  RegisterFunction(state, "FaceTarget", EQ2Emu_lua_FaceTarget);
+  RegisterFunction(state, "MoveToLocation", EQ2Emu_lua_MoveToLocation);
+  RegisterFunction(state, "Shout", EQ2Emu_lua_Shout);
+  RegisterFunction(state, "Say", EQ2Emu_lua_Say);
+  RegisterFunction(state, "SayOOC", EQ2Emu_lua_SayOOC);
+  RegisterFunction(state, "Emote", EQ2Emu_lua_Emote);
+  RegisterFunction(state, "MovementLoopAddLocation", EQ2Emu_lua_MovementLoopAdd);
+  RegisterFunction(state, "GetCurrentZoneSafeLocation", EQ2Emu_lua_GetCurrentZoneSafeLocation);
+  RegisterFunction(state, "AddTimer", EQ2Emu_lua_AddTimer);
+  RegisterFunction(state, "Harvest", EQ2Emu_lua_Harvest);
+
+  RegisterFunction(state, "AddSpellBonus", EQ2Emu_lua_AddSpellBonus);
+  RegisterFunction(state, "RemoveSpellBonus", EQ2Emu_lua_RemoveSpellBonus);
+  RegisterFunction(state, "AddSkillBonus", EQ2Emu_lua_AddSkillBonus);
+  RegisterFunction(state, "RemoveSkillBonus", EQ2Emu_lua_RemoveSkillBonus);
+  RegisterFunction(state, "AddControlEffect", EQ2Emu_lua_AddControlEffect);
+  RegisterFunction(state, "RemoveControlEffect", EQ2Emu_lua_RemoveControlEffect);
+  RegisterFunction(state, "GetCurrentZoneSafeLocation", EQ2Emu_lua_GetCurrentZoneSafeLocation);
+  RegisterFunction(state, "GetInt", EQ2Emu_lua_GetInt);
+  RegisterFunction(state, "GetWis", EQ2Emu_lua_GetWis);
+  RegisterFunction(state, "GetSta", EQ2Emu_lua_GetSta);
+  RegisterFunction(state, "GetStr", EQ2Emu_lua_GetStr);
+  RegisterFunction(state, "GetAgi", EQ2Emu_lua_GetAgi);
+  RegisterFunction(state, "SetInt", EQ2Emu_lua_SetInt);
+  RegisterFunction(state, "SetWis", EQ2Emu_lua_SetWis);
+  RegisterFunction(state, "SetSta", EQ2Emu_lua_SetSta);
+  RegisterFunction(state, "SetStr", EQ2Emu_lua_SetStr);
+  RegisterFunction(state, "SetAgi", EQ2Emu_lua_SetAgi);
+  RegisterFunction(state, "GetIntBase", EQ2Emu_lua_GetIntBase);
+  RegisterFunction(state, "GetWisBase", EQ2Emu_lua_GetWisBase);
+  RegisterFunction(state, "GetStaBase", EQ2Emu_lua_GetStaBase);
+  RegisterFunction(state, "GetStrBase", EQ2Emu_lua_GetStrBase);
+  RegisterFunction(state, "GetAgiBase", EQ2Emu_lua_GetAgiBase);
+  RegisterFunction(state, "SetIntBase", EQ2Emu_lua_SetIntBase);
+  RegisterFunction(state, "SetWisBase", EQ2Emu_lua_SetWisBase);
+  RegisterFunction(state, "SetStaBase", EQ2Emu_lua_SetStaBase);
+  RegisterFunction(state, "SetStrBase", EQ2Emu_lua_SetStrBase);
+  RegisterFunction(state, "SetAgiBase", EQ2Emu_lua_SetAgiBase);
+  RegisterFunction(state, "GetSpawn", EQ2Emu_lua_GetSpawn);
+  RegisterFunction(state, "GetVariableValue", EQ2Emu_lua_GetVariableValue);
+  RegisterFunction(state, "GetCoinMessage", EQ2Emu_lua_GetCoinMessage);
+  RegisterFunction(state, "GetSpawnByGroupID", EQ2Emu_lua_GetSpawnByGroupID);
+  RegisterFunction(state, "GetSpawnByLocationID", EQ2Emu_lua_GetSpawnByLocationID);
+  RegisterFunction(state, "PlayFlavor", EQ2Emu_lua_PlayFlavor);
+  RegisterFunction(state, "PlaySound", EQ2Emu_lua_PlaySound);
+  RegisterFunction(state, "PlayVoice", EQ2Emu_lua_PlayVoice);
+  RegisterFunction(state, "PlayAnimation", EQ2Emu_lua_PlayAnimation);
+  RegisterFunction(state, "AddLootItem", EQ2Emu_lua_AddLootItem);
+  RegisterFunction(state, "RemoveLootItem", EQ2Emu_lua_RemoveLootItem);
+  RegisterFunction(state, "AddLootCoin", EQ2Emu_lua_AddLootCoin);
+  RegisterFunction(state, "GiveLoot", EQ2Emu_lua_GiveLoot);
+  RegisterFunction(state, "HasPendingLootItem", EQ2Emu_lua_HasPendingLootItem);
+  RegisterFunction(state, "HasPendingLoot", EQ2Emu_lua_HasPendingLoot);
+  RegisterFunction(state, "SetLootCoin", EQ2Emu_lua_SetLootCoin);
+  RegisterFunction(state, "GetLootCoin", EQ2Emu_lua_GetLootCoin);
+  RegisterFunction(state, "SetPlayerProximityFunction", EQ2Emu_lua_SetPlayerProximityFunction);
+  RegisterFunction(state, "SetLocationProximityFunction", EQ2Emu_lua_SetLocationProximityFunction);
+  RegisterFunction(state, "CreateConversation", EQ2Emu_lua_CreateConversation);
+  RegisterFunction(state, "AddConversationOption", EQ2Emu_lua_AddConversationOption);
+  RegisterFunction(state, "StartConversation", EQ2Emu_lua_StartConversation);
+  RegisterFunction(state, "CloseConversation", EQ2Emu_lua_CloseConversation);
+  RegisterFunction(state, "CloseItemConversation", EQ2Emu_lua_CloseItemConversation);
   //lua_register(state, "StartItemConversation", EQ2Emu_lua_StartItemConversation);
-  lua_register(state, "StartDialogConversation", EQ2Emu_lua_StartDialogConversation);
-  lua_register(state, "SpawnSet", EQ2Emu_lua_SpawnSet);
-  lua_register(state, "SpawnSetByDistance", EQ2Emu_lua_SpawnSetByDistance);
-  lua_register(state, "SpawnMove", EQ2Emu_lua_SpawnMove);
-  lua_register(state, "KillSpawn", EQ2Emu_lua_KillSpawn);
-  lua_register(state, "KillSpawnByDistance", EQ2Emu_lua_KillSpawnByDistance);
-  lua_register(state, "Despawn", EQ2Emu_lua_Despawn);
-  lua_register(state, "IsBindAllowed", EQ2Emu_lua_IsBindAllowed);
-  lua_register(state, "IsGateAllowed", EQ2Emu_lua_IsGateAllowed);
-  lua_register(state, "Bind", EQ2Emu_lua_Bind);
-  lua_register(state, "Gate", EQ2Emu_lua_Gate);
-  lua_register(state, "SendMessage", EQ2Emu_lua_SendMessage);
-  lua_register(state, "SendPopUpMessage", EQ2Emu_lua_SendPopUpMessage);
-  lua_register(state, "SetServerControlFlag", EQ2Emu_lua_SetServerControlFlag);
-  lua_register(state, "ToggleTracking", EQ2Emu_lua_ToggleTracking);
-  lua_register(state, "AddPrimaryEntityCommand", EQ2Emu_lua_AddPrimaryEntityCommand);
-  lua_register(state, "AddSpellBookEntry", EQ2Emu_lua_AddSpellBookEntry);
-  lua_register(state, "Interrupt", EQ2Emu_lua_Interrupt);
-  lua_register(state, "Stealth", EQ2Emu_lua_Stealth);
-  lua_register(state, "IsInvis", EQ2Emu_lua_IsInvis);
-  lua_register(state, "IsStealthed", EQ2Emu_lua_IsStealthed);
-  lua_register(state, "AddSpawnIDAccess", EQ2Emu_lua_AddSpawnIDAccess);
-  lua_register(state, "RemoveSpawnIDAccess", EQ2Emu_lua_RemoveSpawnIDAccess);
-  lua_register(state, "HasRecipeBook", EQ2Emu_lua_HasRecipeBook);
-
-  lua_register(state, "SetRequiredQuest", EQ2Emu_lua_SetRequiredQuest);
-  lua_register(state, "SetRequiredHistory", EQ2Emu_lua_SetRequiredHistory);
-  lua_register(state, "SetStepComplete", EQ2Emu_lua_SetStepComplete);
-  lua_register(state, "AddStepProgress", EQ2Emu_lua_AddStepProgress);
-  lua_register(state, "UpdateQuestTaskGroupDescription", EQ2Emu_lua_UpdateQuestTaskGroupDescription);
-  lua_register(state, "GetTaskGroupStep", EQ2Emu_lua_GetTaskGroupStep);
-  lua_register(state, "GetQuestStep", EQ2Emu_lua_GetQuestStep);
-  lua_register(state, "QuestStepIsComplete", EQ2Emu_lua_QuestStepIsComplete);
-  lua_register(state, "RegisterQuest", EQ2Emu_lua_RegisterQuest);
-  lua_register(state, "SetQuestPrereqLevel", EQ2Emu_lua_SetQuestPrereqLevel);
-  lua_register(state, "AddQuestPrereqQuest", EQ2Emu_lua_AddQuestPrereqQuest);
-  lua_register(state, "AddQuestPrereqItem", EQ2Emu_lua_AddQuestPrereqItem);
-  lua_register(state, "AddQuestPrereqFaction", EQ2Emu_lua_AddQuestPrereqFaction);
-  lua_register(state, "AddQuestPrereqRace", EQ2Emu_lua_AddQuestPrereqRace);
-  lua_register(state, "AddQuestPrereqModelType", EQ2Emu_lua_AddQuestPrereqModelType);
-  lua_register(state, "AddQuestPrereqClass", EQ2Emu_lua_AddQuestPrereqClass);
-  lua_register(state, "AddQuestPrereqTradeskillLevel", EQ2Emu_lua_AddQuestPrereqTradeskillLevel);
-  lua_register(state, "AddQuestPrereqTradeskillClass", EQ2Emu_lua_AddQuestPrereqTradeskillClass);
-  lua_register(state, "AddQuestSelectableRewardItem", EQ2Emu_lua_AddQuestSelectableRewardItem);
-  lua_register(state, "AddQuestRewardItem", EQ2Emu_lua_AddQuestRewardItem);
-  lua_register(state, "AddQuestRewardCoin", EQ2Emu_lua_AddQuestRewardCoin);
-  lua_register(state, "AddQuestRewardFaction", EQ2Emu_lua_AddQuestRewardFaction);
-  lua_register(state, "SetQuestRewardStatus", EQ2Emu_lua_SetQuestRewardStatus);
-  lua_register(state, "SetQuestRewardComment", EQ2Emu_lua_SetQuestRewardComment);
-  lua_register(state, "SetQuestRewardExp", EQ2Emu_lua_SetQuestRewardExp);
-  lua_register(state, "AddQuestStepKill", EQ2Emu_lua_AddQuestStepKill);
-  lua_register(state, "AddQuestStep", EQ2Emu_lua_AddQuestStep);
-  lua_register(state, "AddQuestStepChat", EQ2Emu_lua_AddQuestStepChat);
-  lua_register(state, "AddQuestStepObtainItem", EQ2Emu_lua_AddQuestStepObtainItem);
-  lua_register(state, "AddQuestStepLocation", EQ2Emu_lua_AddQuestStepLocation);
-  lua_register(state, "AddQuestStepSpell", EQ2Emu_lua_AddQuestStepSpell);
-  lua_register(state, "AddQuestStepCraft", EQ2Emu_lua_AddQuestStepCraft);
-  lua_register(state, "AddQuestStepHarvest", EQ2Emu_lua_AddQuestStepHarvest);
-  lua_register(state, "AddQuestStepCompleteAction", EQ2Emu_lua_AddQuestStepCompleteAction);
-  lua_register(state, "AddQuestStepProgressAction", EQ2Emu_lua_AddQuestStepProgressAction);
-  lua_register(state, "SetQuestCompleteAction", EQ2Emu_lua_SetQuestCompleteAction);
-  lua_register(state, "GiveQuestReward", EQ2Emu_lua_GiveQuestReward);
-  lua_register(state, "UpdateQuestStepDescription", EQ2Emu_lua_UpdateQuestStepDescription);
-  lua_register(state, "UpdateQuestDescription", EQ2Emu_lua_UpdateQuestDescription);
-  lua_register(state, "UpdateQuestZone", EQ2Emu_lua_UpdateQuestZone);
-  lua_register(state, "SetCompletedDescription", EQ2Emu_lua_SetCompletedDescription);
-  lua_register(state, "OfferQuest", EQ2Emu_lua_OfferQuest);
-  lua_register(state, "ProvidesQuest", EQ2Emu_lua_ProvidesQuest);
-  lua_register(state, "HasQuest", EQ2Emu_lua_HasQuest);
-  lua_register(state, "HasCompletedQuest", EQ2Emu_lua_HasCompletedQuest);
-  lua_register(state, "QuestIsComplete", EQ2Emu_lua_QuestIsComplete);
-  lua_register(state, "QuestReturnNPC", EQ2Emu_lua_QuestReturnNPC);
-  lua_register(state, "GetQuest", EQ2Emu_lua_GetQuest);
-  lua_register(state, "HasCollectionsToHandIn", EQ2Emu_lua_HasCollectionsToHandIn);
-  lua_register(state, "HandInCollections", EQ2Emu_lua_HandInCollections);
-  lua_register(state, "UseWidget", EQ2Emu_lua_UseWidget);
-  lua_register(state, "SetSpellList", EQ2Emu_lua_SetSpellList);
-  lua_register(state, "GetPet", EQ2Emu_lua_GetPet);
-  lua_register(state, "Charm", EQ2Emu_lua_Charm);
-  lua_register(state, "GetGroup", EQ2Emu_lua_GetGroup);
-  lua_register(state, "SetCompleteFlag", EQ2Emu_lua_SetCompleteFlag);
-  lua_register(state, "SetQuestYellow", EQ2Emu_lua_SetQuestYellow);
-  lua_register(state, "CanReceiveQuest", EQ2Emu_lua_CanReceiveQuest);
-  lua_register(state, "AddTransportSpawn", EQ2Emu_lua_AddTransportSpawn);
+  RegisterFunction(state, "StartDialogConversation", EQ2Emu_lua_StartDialogConversation);
+  RegisterFunction(state, "SpawnSet", EQ2Emu_lua_SpawnSet);
+  RegisterFunction(state, "SpawnSetByDistance", EQ2Emu_lua_SpawnSetByDistance);
+  RegisterFunction(state, "SpawnMove", EQ2Emu_lua_SpawnMove);
+  RegisterFunction(state, "KillSpawn", EQ2Emu_lua_KillSpawn);
+  RegisterFunction(state, "KillSpawnByDistance", EQ2Emu_lua_KillSpawnByDistance);
+  RegisterFunction(state, "Despawn", EQ2Emu_lua_Despawn);
+  RegisterFunction(state, "IsBindAllowed", EQ2Emu_lua_IsBindAllowed);
+  RegisterFunction(state, "IsGateAllowed", EQ2Emu_lua_IsGateAllowed);
+  RegisterFunction(state, "Bind", EQ2Emu_lua_Bind);
+  RegisterFunction(state, "Gate", EQ2Emu_lua_Gate);
+  RegisterFunction(state, "SendMessage", EQ2Emu_lua_SendMessage);
+  RegisterFunction(state, "SendPopUpMessage", EQ2Emu_lua_SendPopUpMessage);
+  RegisterFunction(state, "SetServerControlFlag", EQ2Emu_lua_SetServerControlFlag);
+  RegisterFunction(state, "ToggleTracking", EQ2Emu_lua_ToggleTracking);
+  RegisterFunction(state, "AddPrimaryEntityCommand", EQ2Emu_lua_AddPrimaryEntityCommand);
+  RegisterFunction(state, "AddSpellBookEntry", EQ2Emu_lua_AddSpellBookEntry);
+  RegisterFunction(state, "Interrupt", EQ2Emu_lua_Interrupt);
+  RegisterFunction(state, "Stealth", EQ2Emu_lua_Stealth);
+  RegisterFunction(state, "IsInvis", EQ2Emu_lua_IsInvis);
+  RegisterFunction(state, "IsStealthed", EQ2Emu_lua_IsStealthed);
+  RegisterFunction(state, "AddSpawnIDAccess", EQ2Emu_lua_AddSpawnIDAccess);
+  RegisterFunction(state, "RemoveSpawnIDAccess", EQ2Emu_lua_RemoveSpawnIDAccess);
+  RegisterFunction(state, "HasRecipeBook", EQ2Emu_lua_HasRecipeBook);
+
+  RegisterFunction(state, "SetRequiredQuest", EQ2Emu_lua_SetRequiredQuest);
+  RegisterFunction(state, "SetRequiredHistory", EQ2Emu_lua_SetRequiredHistory);
+  RegisterFunction(state, "SetStepComplete", EQ2Emu_lua_SetStepComplete);
+  RegisterFunction(state, "AddStepProgress", EQ2Emu_lua_AddStepProgress);
+  RegisterFunction(state, "UpdateQuestTaskGroupDescription", EQ2Emu_lua_UpdateQuestTaskGroupDescription);
+  RegisterFunction(state, "GetTaskGroupStep", EQ2Emu_lua_GetTaskGroupStep);
+  RegisterFunction(state, "GetQuestStep", EQ2Emu_lua_GetQuestStep);
+  RegisterFunction(state, "QuestStepIsComplete", EQ2Emu_lua_QuestStepIsComplete);
+  RegisterFunction(state, "RegisterQuest", EQ2Emu_lua_RegisterQuest);
+  RegisterFunction(state, "SetQuestPrereqLevel", EQ2Emu_lua_SetQuestPrereqLevel);
+  RegisterFunction(state, "AddQuestPrereqQuest", EQ2Emu_lua_AddQuestPrereqQuest);
+  RegisterFunction(state, "AddQuestPrereqItem", EQ2Emu_lua_AddQuestPrereqItem);
+  RegisterFunction(state, "AddQuestPrereqFaction", EQ2Emu_lua_AddQuestPrereqFaction);
+  RegisterFunction(state, "AddQuestPrereqRace", EQ2Emu_lua_AddQuestPrereqRace);
+  RegisterFunction(state, "AddQuestPrereqModelType", EQ2Emu_lua_AddQuestPrereqModelType);
+  RegisterFunction(state, "AddQuestPrereqClass", EQ2Emu_lua_AddQuestPrereqClass);
+  RegisterFunction(state, "AddQuestPrereqTradeskillLevel", EQ2Emu_lua_AddQuestPrereqTradeskillLevel);
+  RegisterFunction(state, "AddQuestPrereqTradeskillClass", EQ2Emu_lua_AddQuestPrereqTradeskillClass);
+  RegisterFunction(state, "AddQuestSelectableRewardItem", EQ2Emu_lua_AddQuestSelectableRewardItem);
+  RegisterFunction(state, "AddQuestRewardItem", EQ2Emu_lua_AddQuestRewardItem);
+  RegisterFunction(state, "AddQuestRewardCoin", EQ2Emu_lua_AddQuestRewardCoin);
+  RegisterFunction(state, "AddQuestRewardFaction", EQ2Emu_lua_AddQuestRewardFaction);
+  RegisterFunction(state, "SetQuestRewardStatus", EQ2Emu_lua_SetQuestRewardStatus);
+  RegisterFunction(state, "SetQuestRewardComment", EQ2Emu_lua_SetQuestRewardComment);
+  RegisterFunction(state, "SetQuestRewardExp", EQ2Emu_lua_SetQuestRewardExp);
+  RegisterFunction(state, "AddQuestStepKill", EQ2Emu_lua_AddQuestStepKill);
+  RegisterFunction(state, "AddQuestStep", EQ2Emu_lua_AddQuestStep);
+  RegisterFunction(state, "AddQuestStepChat", EQ2Emu_lua_AddQuestStepChat);
+  RegisterFunction(state, "AddQuestStepObtainItem", EQ2Emu_lua_AddQuestStepObtainItem);
+  RegisterFunction(state, "AddQuestStepLocation", EQ2Emu_lua_AddQuestStepLocation);
+  RegisterFunction(state, "AddQuestStepSpell", EQ2Emu_lua_AddQuestStepSpell);
+  RegisterFunction(state, "AddQuestStepCraft", EQ2Emu_lua_AddQuestStepCraft);
+  RegisterFunction(state, "AddQuestStepHarvest", EQ2Emu_lua_AddQuestStepHarvest);
+  RegisterFunction(state, "AddQuestStepCompleteAction", EQ2Emu_lua_AddQuestStepCompleteAction);
+  RegisterFunction(state, "AddQuestStepProgressAction", EQ2Emu_lua_AddQuestStepProgressAction);
+  RegisterFunction(state, "SetQuestCompleteAction", EQ2Emu_lua_SetQuestCompleteAction);
+  RegisterFunction(state, "GiveQuestReward", EQ2Emu_lua_GiveQuestReward);
+  RegisterFunction(state, "UpdateQuestStepDescription", EQ2Emu_lua_UpdateQuestStepDescription);
+  RegisterFunction(state, "UpdateQuestDescription", EQ2Emu_lua_UpdateQuestDescription);
+  RegisterFunction(state, "UpdateQuestZone", EQ2Emu_lua_UpdateQuestZone);
+  RegisterFunction(state, "SetCompletedDescription", EQ2Emu_lua_SetCompletedDescription);
+  RegisterFunction(state, "OfferQuest", EQ2Emu_lua_OfferQuest);
+  RegisterFunction(state, "ProvidesQuest", EQ2Emu_lua_ProvidesQuest);
+  RegisterFunction(state, "HasQuest", EQ2Emu_lua_HasQuest);
+  RegisterFunction(state, "HasCompletedQuest", EQ2Emu_lua_HasCompletedQuest);
+  RegisterFunction(state, "QuestIsComplete", EQ2Emu_lua_QuestIsComplete);
+  RegisterFunction(state, "QuestReturnNPC", EQ2Emu_lua_QuestReturnNPC);
+  RegisterFunction(state, "GetQuest", EQ2Emu_lua_GetQuest);
+  RegisterFunction(state, "HasCollectionsToHandIn", EQ2Emu_lua_HasCollectionsToHandIn);
+  RegisterFunction(state, "HandInCollections", EQ2Emu_lua_HandInCollections);
+  RegisterFunction(state, "UseWidget", EQ2Emu_lua_UseWidget);
+  RegisterFunction(state, "SetSpellList", EQ2Emu_lua_SetSpellList);
+  RegisterFunction(state, "GetPet", EQ2Emu_lua_GetPet);
+  RegisterFunction(state, "Charm", EQ2Emu_lua_Charm);
+  RegisterFunction(state, "GetGroup", EQ2Emu_lua_GetGroup);
+  RegisterFunction(state, "SetCompleteFlag", EQ2Emu_lua_SetCompleteFlag);
+  RegisterFunction(state, "SetQuestYellow", EQ2Emu_lua_SetQuestYellow);
+  RegisterFunction(state, "CanReceiveQuest", EQ2Emu_lua_CanReceiveQuest);
+  RegisterFunction(state, "AddTransportSpawn", EQ2Emu_lua_AddTransportSpawn);
 
   // Option window
-  lua_register(state, "CreateOptionWindow", EQ2Emu_lua_CreateOptionWindow);
-  lua_register(state, "AddOptionWindowOption", EQ2Emu_lua_AddOptionWindowOption);
-  lua_register(state, "SendOptionWindow", EQ2Emu_lua_SendOptionWindow);
-
-  lua_register(state, "GetTradeskillClass", EQ2Emu_lua_GetTradeskillClass);
-  lua_register(state, "GetTradeskillLevel", EQ2Emu_lua_GetTradeskillLevel);
-  lua_register(state, "GetTradeskillClassName", EQ2Emu_lua_GetTradeskillClassName);
-  lua_register(state, "SetTradeskillLevel", EQ2Emu_lua_SetTradeskillLevel);
-
-  lua_register(state, "SummonDeityPet", EQ2Emu_lua_SummonDeityPet);
-  lua_register(state, "SummonCosmeticPet", EQ2Emu_lua_SummonCosmeticPet);
-  lua_register(state, "DismissPet", EQ2Emu_lua_DismissPet);
-
-  lua_register(state, "GetCharmedPet", EQ2Emu_lua_GetCharmedPet);
-  lua_register(state, "GetDeityPet", EQ2Emu_lua_GetDeityPet);
-  lua_register(state, "GetCosmeticPet", EQ2Emu_lua_GetCosmeticPet);
-
-  lua_register(state, "SetQuestFeatherColor", EQ2Emu_lua_SetQuestFeatherColor);
-  lua_register(state, "RemoveSpawnAccess", EQ2Emu_lua_RemoveSpawnAccess);
-  lua_register(state, "SpawnByLocationID", EQ2Emu_lua_SpawnByLocationID);
-  lua_register(state, "CastEntityCommand", EQ2Emu_lua_CastEntityCommand);
-  lua_register(state, "SetLuaBrain", EQ2Emu_lua_SetLuaBrain);
-  lua_register(state, "SetBrainTick", EQ2Emu_lua_SetBrainTick);
-  lua_register(state, "SetFollowTarget", EQ2Emu_lua_SetFollowTarget);
-  lua_register(state, "GetFollowTarget", EQ2Emu_lua_GetFollowTarget);
-  lua_register(state, "ToggleFollow", EQ2Emu_lua_ToggleFollow);
-  lua_register(state, "IsFollowing", EQ2Emu_lua_IsFollowing);
-  lua_register(state, "SetTempVariable", EQ2Emu_lua_SetTempVariable);
-  lua_register(state, "GetTempVariable", EQ2Emu_lua_GetTempVariable);
-  lua_register(state, "GiveQuestItem", EQ2Emu_lua_GiveQuestItem);
-  lua_register(state, "SetQuestRepeatable", EQ2Emu_lua_SetQuestRepeatable);
-
-  lua_register(state, "AddWard", EQ2Emu_lua_AddWard);
-  lua_register(state, "AddToWard", EQ2Emu_lua_AddToWard);
-  lua_register(state, "RemoveWard", EQ2Emu_lua_RemoveWard);
-  lua_register(state, "GetWardAmountLeft", EQ2Emu_lua_GetWardAmountLeft);
-
-  lua_register(state, "AddStoneskin", EQ2Emu_lua_AddStoneskin);
-  lua_register(state, "RemoveStoneskin", EQ2Emu_lua_RemoveStoneskin);
-  lua_register(state, "SetPlayerTriggerCount", EQ2Emu_lua_SetPlayerTriggerCount);
-  lua_register(state, "GetPlayerTriggerCount", EQ2Emu_lua_GetPlayerTriggerCount);
-  lua_register(state, "RemoveTriggerFromPlayer", EQ2Emu_lua_RemoveTriggerFromPlayer);
-
-  lua_register(state, "SetTarget", EQ2Emu_lua_SetTarget);
-  lua_register(state, "IsPet", EQ2Emu_lua_IsPet);
-  lua_register(state, "GetOwner", EQ2Emu_lua_GetOwner);
-  lua_register(state, "SetInCombat", EQ2Emu_lua_SetInCombat);
-  lua_register(state, "CompareSpawns", EQ2Emu_lua_CompareSpawns);
-  lua_register(state, "Runback", EQ2Emu_lua_Runback);
-  lua_register(state, "GetRunbackDistance", EQ2Emu_lua_GetRunbackDistance);
-  lua_register(state, "IsCasting", EQ2Emu_lua_IsCasting);
-  lua_register(state, "IsMezzed", EQ2Emu_lua_IsMezzed);
-  lua_register(state, "IsStunned", EQ2Emu_lua_IsStunned);
-  lua_register(state, "IsMezzedOrStunned", EQ2Emu_lua_IsMezzedOrStunned);
-  lua_register(state, "ProcessSpell", EQ2Emu_lua_ProcessSpell);
-  lua_register(state, "ProcessMelee", EQ2Emu_lua_ProcessMelee);
-  lua_register(state, "HasRecovered", EQ2Emu_lua_HasRecovered);
-  lua_register(state, "GetEncounterSize", EQ2Emu_lua_GetEncounterSize);
-  lua_register(state, "GetMostHated", EQ2Emu_lua_GetMostHated);
-  lua_register(state, "ClearHate", EQ2Emu_lua_ClearHate);
-  lua_register(state, "ClearEncounter", EQ2Emu_lua_ClearEncounter);
-  lua_register(state, "GetEncounter", EQ2Emu_lua_GetEncounter);
-  lua_register(state, "GetHateList", EQ2Emu_lua_GetHateList);
-  lua_register(state, "HasGroup", EQ2Emu_lua_HasGroup);
-  lua_register(state, "HasSpellEffect", EQ2Emu_lua_HasSpellEffect);
-
-  lua_register(state, "SetSuccessTimer", EQ2Emu_lua_SetSuccessTimer);
-  lua_register(state, "SetFailureTimer", EQ2Emu_lua_SetFailureTimer);
-  lua_register(state, "IsGroundSpawn", EQ2Emu_lua_IsGroundSpawn);
-  lua_register(state, "CanHarvest", EQ2Emu_lua_CanHarvest);
-  lua_register(state, "SummonDumbFirePet", EQ2Emu_lua_SummonDumbFirePet);
-
-  lua_register(state, "GetSkillValue", EQ2Emu_lua_GetSkillValue);
-  lua_register(state, "GetSkillMaxValue", EQ2Emu_lua_GetSkillMaxValue);
-  lua_register(state, "GetSkillName", EQ2Emu_lua_GetSkillName);
-  lua_register(state, "SetSkillMaxValue", EQ2Emu_lua_SetSkillMaxValue);
-  lua_register(state, "SetSkillValue", EQ2Emu_lua_SetSkillValue);
-  lua_register(state, "GetSkill", EQ2Emu_lua_GetSkill);
-  lua_register(state, "GetSkillIDByName", EQ2Emu_lua_GetSkillIDByName);
-  lua_register(state, "AddProc", EQ2Emu_lua_AddProc);
-  lua_register(state, "RemoveProc", EQ2Emu_lua_RemoveProc);
-  lua_register(state, "Knockback", EQ2Emu_lua_Knockback);
-
-  lua_register(state, "IsEpic", EQ2Emu_lua_IsEpic);
-  lua_register(state, "IsHeroic", EQ2Emu_lua_IsHeroic);
-  lua_register(state, "ProcDamage", EQ2Emu_lua_ProcDamage);
-  lua_register(state, "ProcHeal", EQ2Emu_lua_ProcHeal);
-  lua_register(state, "LastSpellAttackHit", EQ2Emu_lua_LastSpellAttackHit);
-  lua_register(state, "LastProcHit", EQ2Emu_lua_LastProcHit);
-  lua_register(state, "IsBehind", EQ2Emu_lua_IsBehind);
-  lua_register(state, "IsFlanking", EQ2Emu_lua_IsFlanking);
-  lua_register(state, "AddSpellTimer", EQ2Emu_lua_AddSpellTimer);
-  lua_register(state, "GetItemCount", EQ2Emu_lua_GetItemCount);
-  lua_register(state, "SetItemCount", EQ2Emu_lua_SetItemCount);
-  lua_register(state, "Resurrect", EQ2Emu_lua_Resurrect);
-  lua_register(state, "BreatheUnderwater", EQ2Emu_lua_BreatheUnderwater);
-  lua_register(state, "BlurVision", EQ2Emu_lua_BlurVision);
-  lua_register(state, "SetVision", EQ2Emu_lua_SetVision);
-  lua_register(state, "GetItemSkillReq", EQ2Emu_lua_GetItemSkillReq);
-  lua_register(state, "SetSpeedMultiplier", EQ2Emu_lua_SetSpeeedMultiplier);
-  lua_register(state, "SetIllusion", EQ2Emu_lua_SetIllusion);
-  lua_register(state, "ResetIllusion", EQ2Emu_lua_ResetIllusion);
-  lua_register(state, "AddThreatTransfer", EQ2Emu_lua_AddThreatTransfer);
-  lua_register(state, "RemoveThreatTransfer", EQ2Emu_lua_RemoveThreatTransfer);
-  lua_register(state, "CureByType", EQ2Emu_lua_CureByType);
-  lua_register(state, "CureByControlEffect", EQ2Emu_lua_CureByControlEffect);
-  lua_register(state, "AddSpawnSpellBonus", EQ2Emu_lua_AddSpawnSpellBonus);
-  lua_register(state, "CancelSpell", EQ2Emu_lua_CancelSpell);
-  lua_register(state, "RemoveStealth", EQ2Emu_lua_RemoveStealth);
-  lua_register(state, "RemoveInvis", EQ2Emu_lua_RemoveInvis);
-  lua_register(state, "StartHeroicOpportunity", EQ2Emu_lua_StartHeroicOpportunity);
-  lua_register(state, "CopySpawnAppearance", EQ2Emu_lua_CopySpawnAppearance);
-  lua_register(state, "SetSpellTriggerCount", EQ2Emu_lua_SetSpellTriggerCount);
-  lua_register(state, "GetSpellTriggerCount", EQ2Emu_lua_GetSpellTriggerCount);
-  lua_register(state, "RemoveTriggerFromSpell", EQ2Emu_lua_RemoveTriggerFromSpell);
-  lua_register(state, "AddImmunitySpell", EQ2Emu_lua_AddImmunitySpell);
-  lua_register(state, "RemoveImmunitySpell", EQ2Emu_lua_RemoveImmunitySpell);
-  lua_register(state, "SetSpellSnareValue", EQ2Emu_lua_SetSpellSnareValue);
-  lua_register(state, "CheckRaceType", EQ2Emu_lua_CheckRaceType);
-  lua_register(state, "GetRaceType", EQ2Emu_lua_GetRaceType);
-  lua_register(state, "GetRaceBaseType", EQ2Emu_lua_GetRaceBaseType);
-  lua_register(state, "GetQuestFlags", EQ2Emu_lua_GetQuestFlags);
-  lua_register(state, "SetQuestFlags", EQ2Emu_lua_SetQuestFlags);
-  lua_register(state, "SetQuestTimer", EQ2Emu_lua_SetQuestTimer);
-  lua_register(state, "RemoveQuestStep", EQ2Emu_lua_RemoveQuestStep);
-  lua_register(state, "ResetQuestStep", EQ2Emu_lua_ResetQuestStep);
-  lua_register(state, "SetQuestTimerComplete", EQ2Emu_lua_SetQuestTimerComplete);
-  lua_register(state, "AddQuestStepFailureAction", EQ2Emu_lua_AddQuestStepFailureAction);
-  lua_register(state, "SetStepFailed", EQ2Emu_lua_SetStepFailed);
-  lua_register(state, "GetQuestCompleteCount", EQ2Emu_lua_GetQuestCompleteCount);
-  lua_register(state, "SetServerVariable", EQ2Emu_lua_SetServerVariable);
-  lua_register(state, "GetServerVariable", EQ2Emu_lua_GetServerVariable);
-  lua_register(state, "HasLanguage", EQ2Emu_lua_HasLanguage);
-  lua_register(state, "AddLanguage", EQ2Emu_lua_AddLanguage);
-  lua_register(state, "IsNight", EQ2Emu_lua_IsNight);
-  lua_register(state, "AddMultiFloorLift", EQ2Emu_lua_AddMultiFloorLift);
-  lua_register(state, "StartAutoMount", EQ2Emu_lua_StartAutoMount);
-  lua_register(state, "EndAutoMount", EQ2Emu_lua_EndAutoMount);
-  lua_register(state, "IsOnAutoMount", EQ2Emu_lua_IsOnAutoMount);
-  lua_register(state, "SetPlayerHistory", EQ2Emu_lua_SetPlayerHistory);
-  lua_register(state, "GetPlayerHistory", EQ2Emu_lua_GetPlayerHistory);
-  lua_register(state, "SetGridID", EQ2Emu_lua_SetGridID);
-  lua_register(state, "GetQuestStepProgress", EQ2Emu_lua_GetQuestStepProgress);
-  lua_register(state, "SetPlayerLevel", EQ2Emu_lua_SetPlayerLevel);
-  lua_register(state, "AddCoin", EQ2Emu_lua_AddCoin);
-  lua_register(state, "RemoveCoin", EQ2Emu_lua_RemoveCoin);
-  lua_register(state, "GetPlayersInZone", EQ2Emu_lua_GetPlayersInZone);
-  lua_register(state, "SpawnGroupByID", EQ2Emu_lua_SpawnGroupByID);
-  lua_register(state, "GetWeaponDamageType", EQ2Emu_lua_GetWeaponDamageType);
-  lua_register(state, "PauseMovement", EQ2Emu_lua_PauseMovement);
-  lua_register(state, "ResumeMovement", EQ2Emu_lua_ResumeMovement);
-  lua_register(state, "GetProcPercentageForWeapon", EQ2Emu_lua_GetProcPercentageForWeapon);
-  lua_register(state, "RemoveSpell", EQ2Emu_lua_RemoveSpell);
-  lua_register(state, "DropChest", EQ2Emu_lua_DropChest);
-  lua_register(state, "SendSkillUpdate", EQ2Emu_lua_SendSkillUpdate);
-  lua_register(state, "SetPlayerAlignment", EQ2Emu_lua_SetPlayerAlignment);
-  lua_register(state, "GetLastDamageTaken", EQ2Emu_lua_GetLastDamageTaken);
-  lua_register(state, "GetLastDamageWarded", EQ2Emu_lua_GetLastDamageWarded);
-  lua_register(state, "SetIgnoredByMobs", EQ2Emu_lua_SetIgnoredByMobs);
+  RegisterFunction(state, "CreateOptionWindow", EQ2Emu_lua_CreateOptionWindow);
+  RegisterFunction(state, "AddOptionWindowOption", EQ2Emu_lua_AddOptionWindowOption);
+  RegisterFunction(state, "SendOptionWindow", EQ2Emu_lua_SendOptionWindow);
+
+  RegisterFunction(state, "GetTradeskillClass", EQ2Emu_lua_GetTradeskillClass);
+  RegisterFunction(state, "GetTradeskillLevel", EQ2Emu_lua_GetTradeskillLevel);
+  RegisterFunction(state, "GetTradeskillClassName", EQ2Emu_lua_GetTradeskillClassName);
+  RegisterFunction(state, "SetTradeskillLevel", EQ2Emu_lua_SetTradeskillLevel);
+
+  RegisterFunction(state, "SummonDeityPet", EQ2Emu_lua_SummonDeityPet);
+  RegisterFunction(state, "SummonCosmeticPet", EQ2Emu_lua_SummonCosmeticPet);
+  RegisterFunction(state, "DismissPet", EQ2Emu_lua_DismissPet);
+
+  RegisterFunction(state, "GetCharmedPet", EQ2Emu_lua_GetCharmedPet);
+  RegisterFunction(state, "GetDeityPet", EQ2Emu_lua_GetDeityPet);
+  RegisterFunction(state, "GetCosmeticPet", EQ2Emu_lua_GetCosmeticPet);
+
+  RegisterFunction(state, "SetQuestFeatherColor", EQ2Emu_lua_SetQuestFeatherColor);
+  RegisterFunction(state, "RemoveSpawnAccess", EQ2Emu_lua_RemoveSpawnAccess);
+  RegisterFunction(state, "SpawnByLocationID", EQ2Emu_lua_SpawnByLocationID);
+  RegisterFunction(state, "CastEntityCommand", EQ2Emu_lua_CastEntityCommand);
+  RegisterFunction(state, "SetLuaBrain", EQ2Emu_lua_SetLuaBrain);
+  RegisterFunction(state, "SetBrainTick", EQ2Emu_lua_SetBrainTick);
+  RegisterFunction(state, "SetFollowTarget", EQ2Emu_lua_SetFollowTarget);
+  RegisterFunction(state, "GetFollowTarget", EQ2Emu_lua_GetFollowTarget);
+  RegisterFunction(state, "ToggleFollow", EQ2Emu_lua_ToggleFollow);
+  RegisterFunction(state, "IsFollowing", EQ2Emu_lua_IsFollowing);
+  RegisterFunction(state, "SetTempVariable", EQ2Emu_lua_SetTempVariable);
+  RegisterFunction(state, "GetTempVariable", EQ2Emu_lua_GetTempVariable);
+  RegisterFunction(state, "GiveQuestItem", EQ2Emu_lua_GiveQuestItem);
+  RegisterFunction(state, "SetQuestRepeatable", EQ2Emu_lua_SetQuestRepeatable);
+
+  RegisterFunction(state, "AddWard", EQ2Emu_lua_AddWard);
+  RegisterFunction(state, "AddToWard", EQ2Emu_lua_AddToWard);
+  RegisterFunction(state, "RemoveWard", EQ2Emu_lua_RemoveWard);
+  RegisterFunction(state, "GetWardAmountLeft", EQ2Emu_lua_GetWardAmountLeft);
+
+  RegisterFunction(state, "AddStoneskin", EQ2Emu_lua_AddStoneskin);
+  RegisterFunction(state, "RemoveStoneskin", EQ2Emu_lua_RemoveStoneskin);
+  RegisterFunction(state, "SetPlayerTriggerCount", EQ2Emu_lua_SetPlayerTriggerCount);
+  RegisterFunction(state, "GetPlayerTriggerCount", EQ2Emu_lua_GetPlayerTriggerCount);
+  RegisterFunction(state, "RemoveTriggerFromPlayer", EQ2Emu_lua_RemoveTriggerFromPlayer);
+
+  RegisterFunction(state, "SetTarget", EQ2Emu_lua_SetTarget);
+  RegisterFunction(state, "IsPet", EQ2Emu_lua_IsPet);
+  RegisterFunction(state, "GetOwner", EQ2Emu_lua_GetOwner);
+  RegisterFunction(state, "SetInCombat", EQ2Emu_lua_SetInCombat);
+  RegisterFunction(state, "CompareSpawns", EQ2Emu_lua_CompareSpawns);
+  RegisterFunction(state, "Runback", EQ2Emu_lua_Runback);
+  RegisterFunction(state, "GetRunbackDistance", EQ2Emu_lua_GetRunbackDistance);
+  RegisterFunction(state, "IsCasting", EQ2Emu_lua_IsCasting);
+  RegisterFunction(state, "IsMezzed", EQ2Emu_lua_IsMezzed);
+  RegisterFunction(state, "IsStunned", EQ2Emu_lua_IsStunned);
+  RegisterFunction(state, "IsMezzedOrStunned", EQ2Emu_lua_IsMezzedOrStunned);
+  RegisterFunction(state, "ProcessSpell", EQ2Emu_lua_ProcessSpell);
+  RegisterFunction(state, "ProcessMelee", EQ2Emu_lua_ProcessMelee);
+  RegisterFunction(state, "HasRecovered", EQ2Emu_lua_HasRecovered);
+  RegisterFunction(state, "GetEncounterSize", EQ2Emu_lua_GetEncounterSize);
+  RegisterFunction(state, "GetMostHated", EQ2Emu_lua_GetMostHated);
+  RegisterFunction(state, "ClearHate", EQ2Emu_lua_ClearHate);
+  RegisterFunction(state, "ClearEncounter", EQ2Emu_lua_ClearEncounter);
+  RegisterFunction(state, "GetEncounter", EQ2Emu_lua_GetEncounter);
+  RegisterFunction(state, "GetHateList", EQ2Emu_lua_GetHateList);
+  RegisterFunction(state, "HasGroup", EQ2Emu_lua_HasGroup);
+  RegisterFunction(state, "HasSpellEffect", EQ2Emu_lua_HasSpellEffect);
+
+  RegisterFunction(state, "SetSuccessTimer", EQ2Emu_lua_SetSuccessTimer);
+  RegisterFunction(state, "SetFailureTimer", EQ2Emu_lua_SetFailureTimer);
+  RegisterFunction(state, "IsGroundSpawn", EQ2Emu_lua_IsGroundSpawn);
+  RegisterFunction(state, "CanHarvest", EQ2Emu_lua_CanHarvest);
+  RegisterFunction(state, "SummonDumbFirePet", EQ2Emu_lua_SummonDumbFirePet);
+
+  RegisterFunction(state, "GetSkillValue", EQ2Emu_lua_GetSkillValue);
+  RegisterFunction(state, "GetSkillMaxValue", EQ2Emu_lua_GetSkillMaxValue);
+  RegisterFunction(state, "GetSkillName", EQ2Emu_lua_GetSkillName);
+  RegisterFunction(state, "SetSkillMaxValue", EQ2Emu_lua_SetSkillMaxValue);
+  RegisterFunction(state, "SetSkillValue", EQ2Emu_lua_SetSkillValue);
+  RegisterFunction(state, "GetSkill", EQ2Emu_lua_GetSkill);
+  RegisterFunction(state, "GetSkillIDByName", EQ2Emu_lua_GetSkillIDByName);
+  RegisterFunction(state, "AddProc", EQ2Emu_lua_AddProc);
+  RegisterFunction(state, "RemoveProc", EQ2Emu_lua_RemoveProc);
+  RegisterFunction(state, "Knockback", EQ2Emu_lua_Knockback);
+
+  RegisterFunction(state, "IsEpic", EQ2Emu_lua_IsEpic);
+  RegisterFunction(state, "IsHeroic", EQ2Emu_lua_IsHeroic);
+  RegisterFunction(state, "ProcDamage", EQ2Emu_lua_ProcDamage);
+  RegisterFunction(state, "ProcHeal", EQ2Emu_lua_ProcHeal);
+  RegisterFunction(state, "LastSpellAttackHit", EQ2Emu_lua_LastSpellAttackHit);
+  RegisterFunction(state, "LastProcHit", EQ2Emu_lua_LastProcHit);
+  RegisterFunction(state, "IsBehind", EQ2Emu_lua_IsBehind);
+  RegisterFunction(state, "IsFlanking", EQ2Emu_lua_IsFlanking);
+  RegisterFunction(state, "AddSpellTimer", EQ2Emu_lua_AddSpellTimer);
+  RegisterFunction(state, "GetItemCount", EQ2Emu_lua_GetItemCount);
+  RegisterFunction(state, "SetItemCount", EQ2Emu_lua_SetItemCount);
+  RegisterFunction(state, "Resurrect", EQ2Emu_lua_Resurrect);
+  RegisterFunction(state, "BreatheUnderwater", EQ2Emu_lua_BreatheUnderwater);
+  RegisterFunction(state, "BlurVision", EQ2Emu_lua_BlurVision);
+  RegisterFunction(state, "SetVision", EQ2Emu_lua_SetVision);
+  RegisterFunction(state, "GetItemSkillReq", EQ2Emu_lua_GetItemSkillReq);
+  RegisterFunction(state, "SetSpeedMultiplier", EQ2Emu_lua_SetSpeeedMultiplier);
+  RegisterFunction(state, "SetIllusion", EQ2Emu_lua_SetIllusion);
+  RegisterFunction(state, "ResetIllusion", EQ2Emu_lua_ResetIllusion);
+  RegisterFunction(state, "AddThreatTransfer", EQ2Emu_lua_AddThreatTransfer);
+  RegisterFunction(state, "RemoveThreatTransfer", EQ2Emu_lua_RemoveThreatTransfer);
+  RegisterFunction(state, "CureByType", EQ2Emu_lua_CureByType);
+  RegisterFunction(state, "CureByControlEffect", EQ2Emu_lua_CureByControlEffect);
+  RegisterFunction(state, "AddSpawnSpellBonus", EQ2Emu_lua_AddSpawnSpellBonus);
+  RegisterFunction(state, "CancelSpell", EQ2Emu_lua_CancelSpell);
+  RegisterFunction(state, "RemoveStealth", EQ2Emu_lua_RemoveStealth);
+  RegisterFunction(state, "RemoveInvis", EQ2Emu_lua_RemoveInvis);
+  RegisterFunction(state, "StartHeroicOpportunity", EQ2Emu_lua_StartHeroicOpportunity);
+  RegisterFunction(state, "CopySpawnAppearance", EQ2Emu_lua_CopySpawnAppearance);
+  RegisterFunction(state, "SetSpellTriggerCount", EQ2Emu_lua_SetSpellTriggerCount);
+  RegisterFunction(state, "GetSpellTriggerCount", EQ2Emu_lua_GetSpellTriggerCount);
+  RegisterFunction(state, "RemoveTriggerFromSpell", EQ2Emu_lua_RemoveTriggerFromSpell);
+  RegisterFunction(state, "AddImmunitySpell", EQ2Emu_lua_AddImmunitySpell);
+  RegisterFunction(state, "RemoveImmunitySpell", EQ2Emu_lua_RemoveImmunitySpell);
+  RegisterFunction(state, "SetSpellSnareValue", EQ2Emu_lua_SetSpellSnareValue);
+  RegisterFunction(state, "CheckRaceType", EQ2Emu_lua_CheckRaceType);
+  RegisterFunction(state, "GetRaceType", EQ2Emu_lua_GetRaceType);
+  RegisterFunction(state, "GetRaceBaseType", EQ2Emu_lua_GetRaceBaseType);
+  RegisterFunction(state, "GetQuestFlags", EQ2Emu_lua_GetQuestFlags);
+  RegisterFunction(state, "SetQuestFlags", EQ2Emu_lua_SetQuestFlags);
+  RegisterFunction(state, "SetQuestTimer", EQ2Emu_lua_SetQuestTimer);
+  RegisterFunction(state, "RemoveQuestStep", EQ2Emu_lua_RemoveQuestStep);
+  RegisterFunction(state, "ResetQuestStep", EQ2Emu_lua_ResetQuestStep);
+  RegisterFunction(state, "SetQuestTimerComplete", EQ2Emu_lua_SetQuestTimerComplete);
+  RegisterFunction(state, "AddQuestStepFailureAction", EQ2Emu_lua_AddQuestStepFailureAction);
+  RegisterFunction(state, "SetStepFailed", EQ2Emu_lua_SetStepFailed);
+  RegisterFunction(state, "GetQuestCompleteCount", EQ2Emu_lua_GetQuestCompleteCount);
+  RegisterFunction(state, "SetServerVariable", EQ2Emu_lua_SetServerVariable);
+  RegisterFunction(state, "GetServerVariable", EQ2Emu_lua_GetServerVariable);
+  RegisterFunction(state, "HasLanguage", EQ2Emu_lua_HasLanguage);
+  RegisterFunction(state, "AddLanguage", EQ2Emu_lua_AddLanguage);
+  RegisterFunction(state, "IsNight", EQ2Emu_lua_IsNight);
+  RegisterFunction(state, "AddMultiFloorLift", EQ2Emu_lua_AddMultiFloorLift);
+  RegisterFunction(state, "StartAutoMount", EQ2Emu_lua_StartAutoMount);
+  RegisterFunction(state, "EndAutoMount", EQ2Emu_lua_EndAutoMount);
+  RegisterFunction(state, "IsOnAutoMount", EQ2Emu_lua_IsOnAutoMount);
+  RegisterFunction(state, "SetPlayerHistory", EQ2Emu_lua_SetPlayerHistory);
+  RegisterFunction(state, "GetPlayerHistory", EQ2Emu_lua_GetPlayerHistory);
+  RegisterFunction(state, "SetGridID", EQ2Emu_lua_SetGridID);
+  RegisterFunction(state, "GetQuestStepProgress", EQ2Emu_lua_GetQuestStepProgress);
+  RegisterFunction(state, "SetPlayerLevel", EQ2Emu_lua_SetPlayerLevel);
+  RegisterFunction(state, "AddCoin", EQ2Emu_lua_AddCoin);
+  RegisterFunction(state, "RemoveCoin", EQ2Emu_lua_RemoveCoin);
+  RegisterFunction(state, "GetPlayersInZone", EQ2Emu_lua_GetPlayersInZone);
+  RegisterFunction(state, "SpawnGroupByID", EQ2Emu_lua_SpawnGroupByID);
+  RegisterFunction(state, "GetWeaponDamageType", EQ2Emu_lua_GetWeaponDamageType);
+  RegisterFunction(state, "PauseMovement", EQ2Emu_lua_PauseMovement);
+  RegisterFunction(state, "ResumeMovement", EQ2Emu_lua_ResumeMovement);
+  RegisterFunction(state, "GetProcPercentageForWeapon", EQ2Emu_lua_GetProcPercentageForWeapon);
+  RegisterFunction(state, "RemoveSpell", EQ2Emu_lua_RemoveSpell);
+  RegisterFunction(state, "DropChest", EQ2Emu_lua_DropChest);
+  RegisterFunction(state, "SendSkillUpdate", EQ2Emu_lua_SendSkillUpdate);
+  RegisterFunction(state, "SetPlayerAlignment", EQ2Emu_lua_SetPlayerAlignment);
+  RegisterFunction(state, "GetLastDamageTaken", EQ2Emu_lua_GetLastDamageTaken);
+  RegisterFunction(state, "GetLastDamageWarded", EQ2Emu_lua_GetLastDamageWarded);
+  RegisterFunction(state, "SetIgnoredByMobs", EQ2Emu_lua_SetIgnoredByMobs);
+}
+
+// Runs a binding through its profiler stats, which are passed in as the second upvalue
+static int CallBinding(lua_State* state) {
+  lua_CFunction function = lua_tocfunction(state, lua_upvalueindex(1));
+  LuaProfileStats* stats = (LuaProfileStats*)lua_touserdata(state, lua_upvalueindex(2));
+  if (!stats->profiler->IsEnabled())
+    return function(state);
+
+  int64 start = LuaProfiler::GetTime();
+  int ret = function(state);
+  stats->profiler->RecordCall(stats, LuaProfiler::GetTime() - start);
+  return ret;
+}
+
+void LuaInterface::RegisterFunction(lua_State* state, const char* name, lua_CFunction function) {
+  lua_pushcfunction(state, function);
+  lua_pushlightuserdata(state, profiler.GetStats("binding", name));
+  lua_pushcclosure(state, CallBinding, 2);
+  lua_setglobal(state, name);
 }
 
 void LuaInterface::LogError(const char* error, ...) {
@@ -1013,37 +1027,24 @@ void LuaInterface::ResetFunctionStack(lua_State* state) {
   lua_settop(state, 0);
 }
 
-void LuaInterface::AddUserDataPtr(LUAUserData* data) {
-  MLUAUserData.lock();
-  user_data[data] = Timer::GetCurrentTime2() + 300000; //allow a function to use this pointer for 5 minutes
-  MLUAUserData.unlock();
+// Builds the wrapper inside a full userdata owned by the state, so it lives as long as the
+// script keeps a reference to it and is freed by the state's garbage collector. The
+// wrappers only hold raw pointers, so they are never destructed.
+template <class T>
+static T* PushUserData(lua_State* state) {
+  T* data = new (lua_newuserdata(state, sizeof(T))) T();
+  luaL_setmetatable(state, LUA_USERDATA_METATABLE);
+  return data;
 }
 
-void LuaInterface::DeleteUserDataPtrs(bool all) {
-  MLUAUserData.lock();
-  if (user_data.size() > 0) {
-    map<LUAUserData*, int32>::iterator itr;
-    int32 time = Timer::GetCurrentTime2();
-    vector<LUAUserData*> tmp_deletes;
-    vector<LUAUserData*>::iterator del_itr;
-    for (itr = user_data.begin(); itr != user_data.end(); itr++) {
-      if (all || time >= itr->second)
-        tmp_deletes.push_back(itr->first);
-    }
-    LUAUserData* data = 0;
-    for (del_itr = tmp_deletes.begin(); del_itr != tmp_deletes.end(); del_itr++) {
-      data = *del_itr;
-      user_data.erase(data);
-      safe_delete(data);
-    }
-  }
-  MLUAUserData.unlock();
+LUAUserData* LuaInterface::GetUserData(lua_State* state, int8 arg_num) {
+  return (LUAUserData*)luaL_testudata(state, arg_num, LUA_USERDATA_METATABLE);
 }
 
 Spawn* LuaInterface::GetSpawn(lua_State* state, int8 arg_num) {
   Spawn* ret = 0;
-  if (lua_islightuserdata(state, arg_num)) {
-    LUAUserData* data = (LUAUserData*)lua_touserdata(state, arg_num);
+  if (lua_isuserdata(state, arg_num)) {
+    LUAUserData* data = GetUserData(state, arg_num);
     if (!data || !data->IsCorrectlyInitialized()) {
       LogError("GetSpawn error while processing %s", lua_tostring(state, -1));
     } else if (!data->IsSpawn()) {
@@ -1059,8 +1060,8 @@ Spawn* LuaInterface::GetSpawn(lua_State* state, int8 arg_num) {
 
 vector<ConversationOption>* LuaInterface::GetConversation(lua_State* state, int8 arg_num) {
   vector<ConversationOption>* ret = 0;
-  if (lua_islightuserdata(state, arg_num)) {
-    LUAUserData* data = (LUAUserData*)lua_touserdata(state, arg_num);
+  if (lua_isuserdata(state, arg_num)) {
+    LUAUserData* data = GetUserData(state, arg_num);
     if (!data || !data->IsCorrectlyInitialized()) {
       LogError("GetConversation error while processing %s", lua_tostring(state, -1));
     } else if (!data->IsConversationOption()) {
@@ -1076,8 +1077,8 @@ vector<ConversationOption>* LuaInterface::GetConversation(lua_State* state, int8
 
 vector<OptionWindowOption>* LuaInterface::GetOptionWindow(lua_State* state, int8 arg_num) {
   vector<OptionWindowOption>* ret = 0;
-  if (lua_islightuserdata(state, arg_num)) {
-    LUAUserData* data = (LUAUserData*)lua_touserdata(state, arg_num);
+  if (lua_isuserdata(state, arg_num)) {
+    LUAUserData* data = GetUserData(state, arg_num);
     if (!data || !data->IsCorrectlyInitialized()) {
       LogError("GetOptionWindow error while processing %s", lua_tostring(state, -1));
     } else if (!data->IsOptionWindow()) {
@@ -1093,8 +1094,8 @@ vector<OptionWindowOption>* LuaInterface::GetOptionWindow(lua_State* state, int8
 
 Quest* LuaInterface::GetQuest(lua_State* state, int8 arg_num) {
   Quest* ret = 0;
-  if (lua_islightuserdata(state, arg_num)) {
-    LUAUserData* data = (LUAUserData*)lua_touserdata(state, arg_num);
+  if (lua_isuserdata(state, arg_num)) {
+    LUAUserData* data = GetUserData(state, arg_num);
     if (!data || !data->IsCorrectlyInitialized()) {
       LogError("GetQuest error while processing %s", lua_tostring(state, 0));
     } else if (!data->IsQuest()) {
@@ -1110,8 +1111,8 @@ Quest* LuaInterface::GetQuest(lua_State* state, int8 arg_num) {
 
 Item* LuaInterface::GetItem(lua_State* state, int8 arg_num) {
   Item* ret = 0;
-  if (lua_islightuserdata(state, arg_num)) {
-    LUAUserData* data = (LUAUserData*)lua_touserdata(state, arg_num);
+  if (lua_isuserdata(state, arg_num)) {
+    LUAUserData* data = GetUserData(state, arg_num);
     if (!data || !data->IsCorrectlyInitialized()) {
       LogError("GetItem error while processing %s", lua_tostring(state, 0));
     } else if (!data->IsItem()) {
@@ -1127,8 +1128,8 @@ Item* LuaInterface::GetItem(lua_State* state, int8 arg_num) {
 
 Skill* LuaInterface::GetSkill(lua_State* state, int8 arg_num) {
   Skill* ret = 0;
-  if (lua_islightuserdata(state, arg_num)) {
-    LUAUserData* data = (LUAUserData*)lua_touserdata(state, arg_num);
+  if (lua_isuserdata(state, arg_num)) {
+    LUAUserData* data = GetUserData(state, arg_num);
     if (!data || !data->IsCorrectlyInitialized()) {
       LogError("GetSkill error while processing %s", lua_tostring(state, 0));
     } else if (!data->IsSkill()) {
@@ -1144,8 +1145,8 @@ Skill* LuaInterface::GetSkill(lua_State* state, int8 arg_num) {
 
 ZoneServer* LuaInterface::GetZone(lua_State* state, int8 arg_num) {
   ZoneServer* ret = 0;
-  if (lua_islightuserdata(state, arg_num)) {
-    LUAUserData* data = (LUAUserData*)lua_touserdata(state, arg_num);
+  if (lua_isuserdata(state, arg_num)) {
+    LUAUserData* data = GetUserData(state, arg_num);
     if (!data || !data->IsCorrectlyInitialized()) {
       LogError("GetZone error while processing %s", lua_tostring(state, -1));
     } else if (!data->IsZone()) {
@@ -1234,52 +1235,31 @@ void LuaInterface::SetSInt32Value(lua_State* state, sint32 value) {
 }
 
 void LuaInterface::SetSpawnValue(lua_State* state, Spawn* spawn) {
-  LUASpawnWrapper* spawn_wrapper = new LUASpawnWrapper();
-  spawn_wrapper->spawn = spawn;
-  AddUserDataPtr(spawn_wrapper);
-  lua_pushlightuserdata(state, spawn_wrapper);
+  PushUserData<LUASpawnWrapper>(state)->spawn = spawn;
 }
 
 void LuaInterface::SetConversationValue(lua_State* state, vector<ConversationOption>* conversation) {
-  LUAConversationOptionWrapper* conv_wrapper = new LUAConversationOptionWrapper();
-  conv_wrapper->conversation_options = conversation;
-  AddUserDataPtr(conv_wrapper);
-  lua_pushlightuserdata(state, conv_wrapper);
+  PushUserData<LUAConversationOptionWrapper>(state)->conversation_options = conversation;
 }
 
 void LuaInterface::SetOptionWindowValue(lua_State* state, vector<OptionWindowOption>* optionWindow) {
-  LUAOptionWindowWrapper* option_wrapper = new LUAOptionWindowWrapper();
-  option_wrapper->option_window_option = optionWindow;
-  AddUserDataPtr(option_wrapper);
-  lua_pushlightuserdata(state, option_wrapper);
+  PushUserData<LUAOptionWindowWrapper>(state)->option_window_option = optionWindow;
 }
 
 void LuaInterface::SetItemValue(lua_State* state, Item* item) {
-  LUAItemWrapper* item_wrapper = new LUAItemWrapper();
-  item_wrapper->item = item;
-  AddUserDataPtr(item_wrapper);
-  lua_pushlightuserdata(state, item_wrapper);
+  PushUserData<LUAItemWrapper>(state)->item = item;
 }
 
 void LuaInterface::SetSkillValue(lua_State* state, Skill* skill) {
-  LUASkillWrapper* skill_wrapper = new LUASkillWrapper();
-  skill_wrapper->skill = skill;
-  AddUserDataPtr(skill_wrapper);
-  lua_pushlightuserdata(state, skill_wrapper);
+  PushUserData<LUASkillWrapper>(state)->skill = skill;
 }
 
 void LuaInterface::SetQuestValue(lua_State* state, Quest* quest) {
-  LUAQuestWrapper* quest_wrapper = new LUAQuestWrapper();
-  quest_wrapper->quest = quest;
-  AddUserDataPtr(quest_wrapper);
-  lua_pushlightuserdata(state, quest_wrapper);
+  PushUserData<LUAQuestWrapper>(state)->quest = quest;
 }
 
 void LuaInterface::SetZoneValue(lua_State* state, ZoneServer* zone) {
-  LUAZoneWrapper* zone_wrapper = new LUAZoneWrapper();
-  zone_wrapper->zone = zone;
-  AddUserDataPtr(zone_wrapper);
-  lua_pushlightuserdata(state, zone_wrapper);
+  PushUserData<LUAZoneWrapper>(state)->zone = zone;
 }
 
 shared_ptr<LuaSpell> LuaInterface::GetSpell(const char* name) {
@@ -1350,101 +1330,113 @@ Mutex* LuaInterface::GetZoneScriptMutex(const char* name) {
 }
 
 void LuaInterface::UseItemScript(const char* name, lua_State* state, bool val) {
-  item_scripts[name][state] = val;
+  UseScriptState(item_scripts, MItemScripts, name, state, val);
 }
 
 void LuaInterface::UseSpawnScript(const char* name, lua_State* state, bool val) {
-  spawn_scripts[name][state] = val;
+  UseScriptState(spawn_scripts, MSpawnScripts, name, state, val);
 }
 
 void LuaInterface::UseZoneScript(const char* name, lua_State* state, bool val) {
-  zone_scripts[name][state] = val;
+  UseScriptState(zone_scripts, MZoneScripts, name, state, val);
 }
 
 lua_State* LuaInterface::GetItemScript(const char* name, bool create_new, bool use) {
-  map<string, map<lua_State*, bool>>::iterator itr;
-  map<lua_State*, bool>::iterator item_script_itr;
-  lua_State* ret = 0;
-  Mutex* mutex = 0;
-  if (item_scripts.count(name) > 0) {
-    mutex = GetItemScriptMutex(name);
-    mutex->readlock(__FUNCTION__, __LINE__);
-    for (item_script_itr = item_scripts[name].begin(); item_script_itr != item_scripts[name].end(); item_script_itr++) {
-      if (!item_script_itr->second) { //not in use
-        if (use)
-          item_script_itr->second = true;
-        ret = item_script_itr->first;
-      }
-    }
-    mutex->releasereadlock(__FUNCTION__, __LINE__);
-  }
-  if (!ret && create_new) {
-    if (name && LoadItemScript(name))
-      ret = GetItemScript(name, create_new, use);
-    else {
-      LogError("Error LUA Item Script '%s'", name);
-      return 0;
-    }
-  }
+  lua_State* ret = GetScriptState(item_scripts, MItemScripts, name, create_new, use);
+  if (!ret && create_new)
+    LogError("Error LUA Item Script '%s'", name);
   return ret;
 }
 
 lua_State* LuaInterface::GetSpawnScript(const char* name, bool create_new, bool use) {
   if (spawn_scripts_reloading)
     return 0;
-  map<string, map<lua_State*, bool>>::iterator itr;
-  map<lua_State*, bool>::iterator spawn_script_itr;
+  lua_State* ret = GetScriptState(spawn_scripts, MSpawnScripts, name, create_new, use);
+  if (!ret && create_new)
+    LogError("Error LUA Spawn Script '%s'", name);
+  return ret;
+}
+
+lua_State* LuaInterface::GetZoneScript(const char* name, bool create_new, bool use) {
+  lua_State* ret = GetScriptState(zone_scripts, MZoneScripts, name, create_new, use);
+  if (!ret && create_new)
+    LogError("Error LUA Zone Script '%s'", name);
+  return ret;
+}
+
+// Loads count new states of the script outside of the locks. With use set the last
+// one is handed to the caller, the rest go on the free stack.
+lua_State* LuaInterface::AddScriptStates(LuaScriptPoolList& scripts, Mutex& scripts_mutex, const char* name, int32 count, bool use) {
+  vector<lua_State*> new_states;
+  for (int32 i = 0; i < count; i++) {
+    lua_State* state = LoadLuaFile(name);
+    if (!state)
+      break;
+    new_states.push_back(state);
+  }
+  if (new_states.size() == 0)
+    return 0;
+
+  lua_State* ret = new_states.back();
+  // the free stacks are only touched under the read lock, so the write lock covers them here
+  scripts_mutex.writelock(__FUNCTION__, __LINE__);
+  unique_ptr<LuaScriptPool>& pool = scripts[name];
+  if (!pool)
+    pool = make_unique<LuaScriptPool>();
+  pool->states.insert(pool->states.end(), new_states.begin(), new_states.end());
+  pool->free_states.insert(pool->free_states.end(), new_states.begin(), use ? new_states.end() - 1 : new_states.end());
+  scripts_mutex.releasewritelock(__FUNCTION__, __LINE__);
+  return ret;
+}
+
+lua_State* LuaInterface::GetScriptState(LuaScriptPoolList& scripts, Mutex& scripts_mutex, const char* name, bool create_new, bool use) {
+  if (!name)
+    return 0;
   lua_State* ret = 0;
-  Mutex* mutex = 0;
-  if (spawn_scripts.count(string(name)) > 0) {
-    mutex = GetSpawnScriptMutex(name);
-    mutex->readlock(__FUNCTION__, __LINE__);
-    for (spawn_script_itr = spawn_scripts[name].begin(); spawn_script_itr != spawn_scripts[name].end(); spawn_script_itr++) {
-      if (!spawn_script_itr->second) { //not in use
-        if (use)
-          spawn_script_itr->second = true;
-        ret = spawn_script_itr->first;
-      }
+  bool loaded = false;
+  scripts_mutex.readlock(__FUNCTION__, __LINE__);
+  LuaScriptPoolList::iterator itr = scripts.find(name);
+  if (itr != scripts.end()) {
+    LuaScriptPool* pool = itr->second.get();
+    lock_guard<mutex> guard(pool->free_mutex);
+    loaded = true;
+    if (pool->free_states.size() > 0) {
+      ret = pool->free_states.back();
+      if (use)
+        pool->free_states.pop_back();
     }
-    mutex->releasereadlock(__FUNCTION__, __LINE__);
   }
+  scripts_mutex.releasereadlock(__FUNCTION__, __LINE__);
+
   if (!ret && create_new) {
-    if (name && LoadSpawnScript(name))
-      ret = GetSpawnScript(name, create_new, use);
-    else {
-      LogError("Error LUA Spawn Script '%s'", name);
-      return 0;
+    // the first use of a script fills its pool, later misses only add the state they need
+    int32 count = 1;
+    if (!loaded) {
+      count = rule_manager.GetGlobalRule(R_World, LuaStatePoolSize)->GetInt32();
+      if (count == 0)
+        count = 1;
     }
+    ret = AddScriptStates(scripts, scripts_mutex, name, count, use);
   }
   return ret;
 }
 
-lua_State* LuaInterface::GetZoneScript(const char* name, bool create_new, bool use) {
-  map<string, map<lua_State*, bool>>::iterator itr;
-  map<lua_State*, bool>::iterator zone_script_itr;
-  lua_State* ret = 0;
-  Mutex* mutex = 0;
-  if (zone_scripts.count(name) > 0) {
-    mutex = GetZoneScriptMutex(name);
-    mutex->readlock(__FUNCTION__, __LINE__);
-    for (zone_script_itr = zone_scripts[name].begin(); zone_script_itr != zone_scripts[name].end(); zone_script_itr++) {
-      if (!zone_script_itr->second) { //not in use
-        if (use)
-          zone_script_itr->second = true;
-        ret = zone_script_itr->first;
-      }
-    }
-    mutex->releasereadlock(__FUNCTION__, __LINE__);
-  }
-  if (!ret && create_new) {
-    if (name && LoadZoneScript(name))
-      ret = GetZoneScript(name);
+void LuaInterface::UseScriptState(LuaScriptPoolList& scripts, Mutex& scripts_mutex, const char* name, lua_State* state, bool val) {
+  scripts_mutex.readlock(__FUNCTION__, __LINE__);
+  LuaScriptPoolList::iterator itr = scripts.find(name);
+  // states of a destroyed pool have already been closed
+  if (itr != scripts.end()) {
+    LuaScriptPool* pool = itr->second.get();
+    lock_guard<mutex> guard(pool->free_mutex);
+    if (!val)
+      pool->free_states.push_back(state);
     else {
-      LogError("Error LUA Zone Script '%s'", name);
-      return 0;
+      vector<lua_State*>::iterator state_itr = find(pool->free_states.begin(), pool->free_states.end(), state);
+      if (state_itr != pool->free_states.end())
+        pool->free_states.erase(state_itr);
     }
   }
-  return ret;
+  scripts_mutex.releasereadlock(__FUNCTION__, __LINE__);
 }
 
 bool LuaInterface::RunItemScript(string script_name, const char* function_name, Item* item, Spawn* spawn) {
@@ -1461,10 +1453,10 @@ bool LuaInterface::RunItemScript(string script_name, const char* function_name,
       return false;
     }
     lua_getglobal(state, function_name);
-    lua_getglobal(state, function_name);
     if (!lua_isfunction(state, lua_gettop(state))) {
       lua_pop(state, 1);
       mutex->releasereadlock(__FUNCTION__);
+      UseItemScript(script_name.c_str(), state, false);
       return false;
     }
     SetItemValue(state, item);
@@ -1473,7 +1465,12 @@ bool LuaInterface::RunItemScript(string script_name, const char* function_name,
       SetSpawnValue(state, spawn);
       num_parms++;
     }
-    if (!CallItemScript(state, num_parms)) {
+    bool ret = false;
+    {
+      LuaProfileScope profile(&profiler, script_name.c_str(), function_name);
+      ret = CallItemScript(state, num_parms);
+    }
+    if (!ret) {
       if (mutex)
         mutex->releasereadlock(__FUNCTION__, __LINE__);
       UseItemScript(script_name.c_str(), state, false);
@@ -1504,6 +1501,7 @@ bool LuaInterface::RunSpawnScript(string script_name, const char* function_name,
     if (!lua_isfunction(state, lua_gettop(state))) {
       lua_pop(state, 1);
       mutex->releasereadlock(__FUNCTION__);
+      UseSpawnScript(script_name.c_str(), state, false);
       return false;
     }
     SetSpawnValue(state, npc);
@@ -1516,7 +1514,12 @@ bool LuaInterface::RunSpawnScript(string script_name, const char* function_name,
       SetStringValue(state, message);
       num_parms++;
     }
-    if (!CallSpawnScript(state, num_parms)) {
+    bool ret = false;
+    {
+      LuaProfileScope profile(&profiler, script_name.c_str(), function_name);
+      ret = CallSpawnScript(state, num_parms);
+    }
+    if (!ret) {
       if (mutex)
         mutex->releasereadlock(__FUNCTION__, __LINE__);
       UseSpawnScript(script_name.c_str(), state, false);
@@ -1547,6 +1550,7 @@ bool LuaInterface::RunZoneScript(string script_name, const char* function_name,
     if (!lua_isfunction(state, lua_gettop(state))) {
       lua_pop(state, 1);
       mutex->releasereadlock(__FUNCTION__);
+      UseZoneScript(script_name.c_str(), state, false);
       return false;
     }
     SetZoneValue(state, zone);
@@ -1559,7 +1563,12 @@ bool LuaInterface::RunZoneScript(string script_name, const char* function_name,
       SetInt32Value(state, grid_id);
       num_params++;
     }
-    if (!CallZoneScript(state, num_params)) {
+    bool ret = false;
+    {
+      LuaProfileScope profile(&profiler, script_name.c_str(), function_name);
+      ret = CallZoneScript(state, num_params);
+    }
+    if (!ret) {
       if (mutex)
         mutex->releasereadlock(__FUNCTION__, __LINE__);
       UseZoneScript(script_name.c_str(), state, false);
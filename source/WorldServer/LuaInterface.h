@@ -20,9 +20,11 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <vector>
 #include "../common/Mutex.h"
 #include "../common/timer.h"
+#include "LuaProfiler.h"
 
 #include "../LUA/lua.hpp"
 
@@ -106,6 +108,9 @@ struct LuaSpell {
   int32 effect_bitmask;
 };
 
+// Name of the metatable shared by every LUAUserData pushed to the scripts
+#define LUA_USERDATA_METATABLE "EQ2Emu.UserData"
+
 class LUAUserData {
 public:
   LUAUserData();
@@ -170,6 +175,16 @@ public:
   bool IsSkill();
 };
 
+// The states loaded for one spawn, item or zone script. Idle states wait on a stack
+// so checking one out or handing it back doesn't walk the whole pool.
+struct LuaScriptPool {
+  mutex free_mutex;
+  vector<lua_State*> states;
+  vector<lua_State*> free_states;
+};
+
+typedef map<string, unique_ptr<LuaScriptPool>> LuaScriptPoolList;
+
 class LuaInterface {
 public:
   LuaInterface();
@@ -198,8 +213,6 @@ public:
   string GetStringValue(lua_State* state, int8 arg_num = 1);
   bool GetBooleanValue(lua_State* state, int8 arg_num = 1);
 
-  void Process();
-
   void SetInt32Value(lua_State* state, int32 value);
   void SetSInt32Value(lua_State* state, sint32 value);
   void SetFloatValue(lua_State* state, float value);
@@ -216,7 +229,7 @@ public:
   void AddSpawnPointers(LuaSpell* spell, bool first_cast, bool precast = false, const char* function = 0, SpellScriptTimer* timer = 0);
   shared_ptr<LuaSpell> GetCurrentSpell(lua_State* state);
   void SetCurrentSpell(lua_State* state, shared_ptr<LuaSpell> spell);
-  bool CallSpellProcess(shared_ptr<LuaSpell> spell, int8 num_parameters);
+  bool CallSpellProcess(shared_ptr<LuaSpell> spell, int8 num_parameters, const char* function = 0);
   shared_ptr<LuaSpell> GetSpell(const char* name);
   void UseItemScript(const char* name, lua_State* state, bool val);
   void UseSpawnScript(const char* name, lua_State* state, bool val);
@@ -248,8 +261,8 @@ public:
   void UpdateDebugClients(shared_ptr<Client> client);
   void ProcessErrorMessage(const char* message);
   map<shared_ptr<Client>, int32> GetDebugClients() { return debug_clients; }
-  void AddUserDataPtr(LUAUserData* data);
-  void DeleteUserDataPtrs(bool all);
+  LUAUserData* GetUserData(lua_State* state, int8 arg_num = 1);
+  LuaProfiler* GetProfiler() { return &profiler; }
   Mutex* GetSpawnScriptMutex(const char* name);
   Mutex* GetItemScriptMutex(const char* name);
   Mutex* GetZoneScriptMutex(const char* name);
@@ -260,30 +273,37 @@ public:
 private:
   bool shutting_down;
   bool spawn_scripts_reloading;
-  Timer* user_data_timer;
-  map<LUAUserData*, int32> user_data;
   map<shared_ptr<Client>, int32> debug_clients;
   map<lua_State*, shared_ptr<LuaSpell>> current_spells;
   vector<string>* GetDirectoryListing(const char* directory);
   lua_State* LoadLuaFile(const char* name);
+  int LoadScriptChunk(lua_State* state, const char* name);
+  void ClearScriptBytecode(const char* name = 0);
   void RegisterFunctions(lua_State* state);
+  void RegisterFunction(lua_State* state, const char* name, lua_CFunction function);
+  lua_State* AddScriptStates(LuaScriptPoolList& scripts, Mutex& scripts_mutex, const char* name, int32 count, bool use);
+  lua_State* GetScriptState(LuaScriptPoolList& scripts, Mutex& scripts_mutex, const char* name, bool create_new, bool use);
+  void UseScriptState(LuaScriptPoolList& scripts, Mutex& scripts_mutex, const char* name, lua_State* state, bool val);
+  void DestroyScripts(LuaScriptPoolList& scripts, Mutex& scripts_mutex, map<string, Mutex*>& script_mutexes);
   map<string, unique_ptr<LuaSpell>> spells;
   map<int32, Quest*> quests;
   map<int32, lua_State*> quest_states;
-  map<string, map<lua_State*, bool>> item_scripts;
-  map<string, map<lua_State*, bool>> spawn_scripts;
-  map<string, map<lua_State*, bool>> zone_scripts;
+  LuaScriptPoolList item_scripts;
+  LuaScriptPoolList spawn_scripts;
+  LuaScriptPoolList zone_scripts;
+  // compiled chunks by file name, so new states skip the parser
+  map<string, string> script_bytecode;
   map<string, Mutex*> item_scripts_mutex;
   map<string, Mutex*> spawn_scripts_mutex;
   map<string, Mutex*> zone_scripts_mutex;
   map<int32, Mutex*> quests_mutex;
+  LuaProfiler profiler;
   Mutex MDebugClients;
   Mutex MSpells;
   Mutex MSpawnScripts;
   Mutex MItemScripts;
   Mutex MZoneScripts;
+  Mutex MScriptBytecode;
   Mutex MQuests;
-  Mutex MLUAUserData;
-  Mutex MLUAMain;
   Mutex MSpellDelete;
 };
\ No newline at end of file
@@ -0,0 +1,154 @@
+/*  
+    EQ2Emulator:  Everquest II Server Emulator
+    Copyright (C) 2007  EQ2EMulator Development Team (http://www.eq2emulator.net)
+
+    This file is part of EQ2Emulator.
+
+    EQ2Emulator is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    EQ2Emulator is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with EQ2Emulator.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "LuaProfiler.h"
+#include "../common/Log.h"
+#include <algorithm>
+#include <chrono>
+#include <stdio.h>
+
+LuaProfiler::LuaProfiler() {
+  enabled = false;
+  slow_call_ms = 0;
+}
+
+LuaProfiler::~LuaProfiler() {
+  for (auto& kv : stats_list)
+    delete kv.second;
+  stats_list.clear();
+}
+
+int64 LuaProfiler::GetTime() {
+  return chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+LuaProfileStats* LuaProfiler::GetStats(const char* script, const char* function) {
+  string key = string(script) + ":" + function;
+  lock_guard<mutex> guard(stats_mutex);
+
+  map<string, LuaProfileStats*>::iterator itr = stats_list.find(key);
+  if (itr != stats_list.end())
+    return itr->second;
+
+  LuaProfileStats* stats = new LuaProfileStats();
+  stats->profiler = this;
+  stats->script = script;
+  stats->function = function;
+  stats->calls = 0;
+  stats->total_us = 0;
+  stats->max_us = 0;
+  for (int32 i = 0; i < LUA_PROFILE_BUCKETS; i++)
+    stats->buckets[i] = 0;
+  stats_list[key] = stats;
+
+  return stats;
+}
+
+void LuaProfiler::RecordCall(LuaProfileStats* stats, int64 elapsed_us) {
+  int32 bucket = 0;
+  for (int64 limit = 2; elapsed_us >= limit && bucket < LUA_PROFILE_BUCKETS - 1; limit <<= 1)
+    bucket++;
+
+  stats->calls++;
+  stats->total_us += elapsed_us;
+  stats->buckets[bucket]++;
+
+  int64 max_us = stats->max_us.load();
+  while (elapsed_us > max_us && !stats->max_us.compare_exchange_weak(max_us, elapsed_us))
+    ;
+
+  int32 threshold = slow_call_ms;
+  if (threshold > 0 && elapsed_us >= (int64)threshold * 1000)
+    LogWrite(LUA__WARNING, 0, "LUA", "Slow call to %s in '%s' took %.2fms", stats->function.c_str(), stats->script.c_str(), elapsed_us / 1000.0f);
+}
+
+void LuaProfiler::Reset() {
+  // the stats are only zeroed, the script states keep pointers to the ones of their bindings
+  lock_guard<mutex> guard(stats_mutex);
+
+  for (auto& kv : stats_list) {
+    LuaProfileStats* stats = kv.second;
+    stats->calls = 0;
+    stats->total_us = 0;
+    stats->max_us = 0;
+    for (int32 i = 0; i < LUA_PROFILE_BUCKETS; i++)
+      stats->buckets[i] = 0;
+  }
+}
+
+int64 LuaProfiler::GetPercentile(LuaProfileStats* stats, int64 calls, int32 percent) {
+  int64 target = (calls * percent + 99) / 100;
+  int64 count = 0;
+
+  // reports the upper bound of the bucket the percentile falls in
+  for (int32 i = 0; i < LUA_PROFILE_BUCKETS; i++) {
+    count += stats->buckets[i];
+    if (count >= target)
+      return min((int64)1 << (i + 1), stats->max_us.load());
+  }
+
+  return stats->max_us;
+}
+
+void LuaProfiler::GetReport(vector<string>& lines, int32 max_lines) {
+  vector<LuaProfileStats*> list;
+
+  {
+    lock_guard<mutex> guard(stats_mutex);
+    for (auto& kv : stats_list) {
+      if (kv.second->calls > 0)
+        list.push_back(kv.second);
+    }
+  }
+
+  sort(list.begin(), list.end(), [](LuaProfileStats* a, LuaProfileStats* b) { return a->total_us.load() > b->total_us.load(); });
+
+  char line[512];
+  snprintf(line, sizeof(line), "%-40s %-30s %10s %12s %10s %10s %10s", "Script", "Function", "Calls", "Total ms", "Avg us", "p99 us", "Max us");
+  lines.push_back(line);
+
+  for (LuaProfileStats* stats : list) {
+    if (max_lines > 0 && lines.size() > max_lines)
+      break;
+
+    int64 calls = stats->calls;
+    int64 total_us = stats->total_us;
+    if (calls == 0)
+      continue;
+
+    snprintf(line, sizeof(line), "%-40.40s %-30.30s %10llu %12.2f %10llu %10llu %10llu", stats->script.c_str(), stats->function.c_str(), (unsigned long long)calls, total_us / 1000.0, (unsigned long long)(total_us / calls), (unsigned long long)GetPercentile(stats, calls, 99), (unsigned long long)stats->max_us.load());
+    lines.push_back(line);
+  }
+}
+
+bool LuaProfiler::WriteReport(const char* file_name) {
+  FILE* file = fopen(file_name, "w");
+  if (!file)
+    return false;
+
+  vector<string> lines;
+  GetReport(lines);
+
+  for (const string& line : lines)
+    fprintf(file, "%s\n", line.c_str());
+
+  fclose(file);
+  return true;
+}
@@ -0,0 +1,100 @@
+/*  
+    EQ2Emulator:  Everquest II Server Emulator
+    Copyright (C) 2007  EQ2EMulator Development Team (http://www.eq2emulator.net)
+
+    This file is part of EQ2Emulator.
+
+    EQ2Emulator is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    EQ2Emulator is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with EQ2Emulator.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "../common/types.h"
+
+using namespace std;
+
+class LuaProfiler;
+
+// Call times are kept in power of two buckets, 1us up to >= 8 seconds
+#define LUA_PROFILE_BUCKETS 24
+
+// Timings of one script function, or of one C binding when script is "binding"
+struct LuaProfileStats {
+  LuaProfiler* profiler;
+  string script;
+  string function;
+  atomic<int64> calls;
+  atomic<int64> total_us;
+  atomic<int64> max_us;
+  atomic<int64> buckets[LUA_PROFILE_BUCKETS];
+};
+
+// Records how long the calls into the scripts and the C bindings they call take. Nothing is
+// timed while it is disabled, the call sites only check the flag.
+class LuaProfiler {
+public:
+  LuaProfiler();
+  ~LuaProfiler();
+
+  bool IsEnabled() { return enabled.load(memory_order_relaxed); }
+  void SetEnabled(bool val) { enabled = val; }
+  // Calls that take at least this long are logged, 0 turns it off
+  int32 GetSlowCallThreshold() { return slow_call_ms; }
+  void SetSlowCallThreshold(int32 ms) { slow_call_ms = ms; }
+
+  // The returned stats stay valid until the profiler is destroyed
+  LuaProfileStats* GetStats(const char* script, const char* function);
+  void RecordCall(LuaProfileStats* stats, int64 elapsed_us);
+  void Reset();
+  // One line per function that was called, longest total time first. 0 lists all of them.
+  void GetReport(vector<string>& lines, int32 max_lines = 0);
+  bool WriteReport(const char* file_name);
+
+  static int64 GetTime();
+
+private:
+  static int64 GetPercentile(LuaProfileStats* stats, int64 calls, int32 percent);
+
+  atomic<bool> enabled;
+  atomic<int32> slow_call_ms;
+  mutex stats_mutex;
+  map<string, LuaProfileStats*> stats_list;
+};
+
+// Times a call for as long as it is in scope
+class LuaProfileScope {
+public:
+  LuaProfileScope(LuaProfiler* profiler, const char* script, const char* function) {
+    stats = 0;
+    start = 0;
+    if (profiler && profiler->IsEnabled() && script && function) {
+      stats = profiler->GetStats(script, function);
+      start = LuaProfiler::GetTime();
+    }
+  }
+
+  ~LuaProfileScope() {
+    if (stats)
+      stats->profiler->RecordCall(stats, LuaProfiler::GetTime() - start);
+  }
+
+private:
+  LuaProfileStats* stats;
+  int64 start;
+};
@@ -31,7 +31,7 @@ extern World world;
 
 /*  The NEW AI code  */
 
-Brain::Brain(NPC* npc) : override_target(0) {
+Brain::Brain(NPC* npc) : m_mostHated(-1), m_totalHate(0), override_target(0) {
   // Set the npc this brain will controll
   m_body = npc;
   // Set the default time between calls to think to 250 miliseconds (1/4 a second)
@@ -141,9 +141,10 @@ sint32 Brain::GetHate(Entity* entity) {
   MHateList.readlock(__FUNCTION__, __LINE__);
 
   // First check to see if the given entity is even in the hate list
-  if (m_hatelist.count(entity->GetID()) > 0)
+  sint32 index = FindHate(entity->GetID());
+  if (index >= 0)
     // Entity in the hate list so get the hate value for the entity
-    ret = m_hatelist[entity->GetID()];
+    ret = m_hatelist[index].hate;
 
   // Unlock the hate list
   MHateList.releasereadlock(__FUNCTION__, __LINE__);
@@ -155,29 +156,84 @@ sint32 Brain::GetHate(Entity* entity) {
 void Brain::AddHate(Entity* entity, sint32 hate, bool unprovoked) {
   // Lock the hate list, we are altering the list so use write lock
   MHateList.writelock(__FUNCTION__, __LINE__);
+  ApplyHate({entity, hate, unprovoked});
+  // Unlock the list
+  MHateList.releasewritelock(__FUNCTION__, __LINE__);
+}
 
-  if (m_hatelist.count(entity->GetID()) > 0)
-    m_hatelist[entity->GetID()] += hate;
-  else
-    m_hatelist.insert(std::pair<int32, sint32>(entity->GetID(), hate));
+void Brain::AddHate(const vector<HateChange>& hates) {
+  MHateList.writelock(__FUNCTION__, __LINE__);
+  for (const auto& change : hates)
+    ApplyHate(change);
+  MHateList.releasewritelock(__FUNCTION__, __LINE__);
+}
+
+sint32 Brain::FindHate(int32 spawn_id) {
+  for (size_t i = 0; i < m_hatelist.size(); i++) {
+    if (m_hatelist[i].spawn_id == spawn_id)
+      return i;
+  }
+
+  return -1;
+}
+
+void Brain::ApplyHate(const HateChange& change) {
+  Entity* entity = change.entity;
+  sint32 index = FindHate(entity->GetID());
+
+  if (index >= 0)
+    m_hatelist[index].hate += change.hate;
+  else {
+    index = m_hatelist.size();
+    m_hatelist.push_back({entity->GetID(), change.hate});
+  }
+
+  m_totalHate += change.hate;
+
+  // Only the changed entry can pass the current most hated, unless the most hated itself lost hate
+  if (m_mostHated < 0 || m_hatelist[index].hate > m_hatelist[m_mostHated].hate)
+    m_mostHated = index;
+  else if (index == m_mostHated && change.hate < 0)
+    FindMostHated();
 
   if (entity->HatedBy.count(m_body->GetID()) == 0)
     entity->HatedBy.insert(m_body->GetID());
 
   if (entity->IsPlayer())
-    static_cast<Player*>(entity)->AddToEncounterList(m_body->GetID(), Timer::GetCurrentTime2(), !unprovoked);
+    static_cast<Player*>(entity)->AddToEncounterList(m_body->GetID(), Timer::GetCurrentTime2(), !change.unprovoked);
+}
 
-  // Unlock the list
-  MHateList.releasewritelock(__FUNCTION__, __LINE__);
+void Brain::RemoveHate(sint32 index) {
+  sint32 last = m_hatelist.size() - 1;
+
+  m_totalHate -= m_hatelist[index].hate;
+
+  // Move the last entry into the hole so the list stays packed
+  m_hatelist[index] = m_hatelist[last];
+  m_hatelist.pop_back();
+
+  if (m_mostHated == index)
+    FindMostHated();
+  else if (m_mostHated == last)
+    m_mostHated = index;
+}
+
+void Brain::FindMostHated() {
+  m_mostHated = -1;
+
+  for (size_t i = 0; i < m_hatelist.size(); i++) {
+    if (m_mostHated < 0 || m_hatelist[i].hate > m_hatelist[m_mostHated].hate)
+      m_mostHated = i;
+  }
 }
 
 void Brain::ClearHate() {
   override_target = 0;
 
   MHateList.writelock(__FUNCTION__, __LINE__);
-  for (auto& kv : m_hatelist) {
+  for (const auto& entry : m_hatelist) {
     ZoneServer* zone = m_body->GetZone();
-    Spawn* spawn = zone->GetSpawnByID(kv.first);
+    Spawn* spawn = zone->GetSpawnByID(entry.spawn_id);
 
     if (spawn && spawn->IsEntity()) {
       static_cast<Entity*>(spawn)->HatedBy.erase(m_body->GetID());
@@ -189,6 +245,8 @@ void Brain::ClearHate() {
   }
 
   m_hatelist.clear();
+  m_mostHated = -1;
+  m_totalHate = 0;
   MHateList.releasewritelock(__FUNCTION__, __LINE__);
 }
 
@@ -198,8 +256,9 @@ void Brain::ClearHate(Entity* entity) {
   }
 
   MHateList.writelock(__FUNCTION__, __LINE__);
-  if (m_hatelist.count(entity->GetID()) > 0) {
-    m_hatelist.erase(entity->GetID());
+  sint32 index = FindHate(entity->GetID());
+  if (index >= 0) {
+    RemoveHate(index);
   }
 
   entity->HatedBy.erase(m_body->GetID());
@@ -207,29 +266,25 @@ void Brain::ClearHate(Entity* entity) {
 }
 
 Entity* Brain::GetMostHated() {
-  map<int32, sint32>::iterator itr;
-  int32 ret = override_target;
-
-  if (!ret) {
-    sint32 hate = 0;
-
-    MHateList.readlock(__FUNCTION__, __LINE__);
-    if (m_hatelist.size() > 0) {
-      for (itr = m_hatelist.begin(); itr != m_hatelist.end(); itr++) {
-        if (!hate || itr->second > hate) {
-          ret = itr->first;
-          hate = itr->second;
-        }
-      }
+  Entity* hated = nullptr;
+
+  // Dead entities are dropped from the list until a living one comes up
+  while (true) {
+    int32 ret = override_target;
+
+    if (!ret) {
+      MHateList.readlock(__FUNCTION__, __LINE__);
+      if (m_mostHated >= 0)
+        ret = m_hatelist[m_mostHated].spawn_id;
+      MHateList.releasereadlock(__FUNCTION__, __LINE__);
     }
-    MHateList.releasereadlock(__FUNCTION__, __LINE__);
-  }
 
-  Entity* hated = static_cast<Entity*>(GetBody()->GetZone()->GetSpawnByID(ret));
+    hated = static_cast<Entity*>(GetBody()->GetZone()->GetSpawnByID(ret));
+
+    if (!hated || hated->Alive())
+      break;
 
-  if (hated && !hated->Alive()) {
     ClearHate(hated);
-    hated = GetMostHated();
   }
 
   // Return our result
@@ -239,13 +294,9 @@ Entity* Brain::GetMostHated() {
 sint8 Brain::GetHatePercentage(Entity* entity) {
   float percentage = 0.0;
   MHateList.readlock(__FUNCTION__, __LINE__);
-  if (entity && m_hatelist.count(entity->GetID()) > 0 && m_hatelist[entity->GetID()] > 0) {
-    sint32 total_hate = 0;
-    map<int32, sint32>::iterator itr;
-    for (itr = m_hatelist.begin(); itr != m_hatelist.end(); itr++)
-      total_hate += itr->second;
-    percentage = m_hatelist[entity->GetID()] / total_hate;
-  }
+  sint32 index = entity ? FindHate(entity->GetID()) : -1;
+  if (index >= 0 && m_hatelist[index].hate > 0 && m_totalHate > 0)
+    percentage = (float)m_hatelist[index].hate / m_totalHate;
   MHateList.releasereadlock(__FUNCTION__, __LINE__);
 
   return (sint8)(percentage * 100);
@@ -253,13 +304,13 @@ sint8 Brain::GetHatePercentage(Entity* entity) {
 
 vector<Entity*>* Brain::GetHateList() {
   vector<Entity*>* ret = new vector<Entity*>;
-  map<int32, sint32>::iterator itr;
 
   // Lock the list
   MHateList.readlock(__FUNCTION__, __LINE__);
+  ret->reserve(m_hatelist.size());
   // Loop over the list storing the values into the new list
-  for (itr = m_hatelist.begin(); itr != m_hatelist.end(); itr++) {
-    Entity* ent = (Entity*)GetBody()->GetZone()->GetSpawnByID(itr->first);
+  for (const auto& entry : m_hatelist) {
+    Entity* ent = (Entity*)GetBody()->GetZone()->GetSpawnByID(entry.spawn_id);
     if (ent)
       ret->push_back(ent);
   }
@@ -58,6 +58,9 @@ public:
   /// <param name="entity">The entity we are adding to this NPC's hate list</param>
   /// <param name="hate">The amount of hate to add</param>
   virtual void AddHate(Entity* entity, sint32 hate, bool unprovoked = false);
+  /// <summary>Adds several amounts of hate to this NPC's hate list under one lock</summary>
+  /// <param name="hates">The entities and the hate to add for each</param>
+  void AddHate(const vector<HateChange>& hates);
   /// <summary>Completely clears the hate list for this npc</summary>
   void ClearHate();
   /// <summary>Removes the given entity from this NPC's hate list</summary>
@@ -130,11 +133,26 @@ protected:
   int32 m_spellRecovery;
 
 private:
+  struct HateEntry {
+    int32 spawn_id;
+    sint32 hate;
+  };
+
+  // MHateList must be held for these
+  sint32 FindHate(int32 spawn_id);
+  void ApplyHate(const HateChange& change);
+  void RemoveHate(sint32 index);
+  void FindMostHated();
+
   // MHateList = mutex to lock and unlock the hate list
   Mutex MHateList;
-  // m_hatelist = the list that stores all the hate,
-  // entity is the entity this npc hates and the int32 is the value for how much we hate the entity
-  map<int32, sint32> m_hatelist;
+  // m_hatelist = the list that stores all the hate, spawn_id is the entity this npc hates and hate is
+  // how much we hate it. Only a handful of entries is expected so a flat list is searched instead of a map
+  vector<HateEntry> m_hatelist;
+  // m_mostHated = index of the most hated entry in m_hatelist, -1 when the list is empty
+  sint32 m_mostHated;
+  // m_totalHate = the sum of all the hate in m_hatelist
+  sint64 m_totalHate;
   // m_lastTick = the last time we ran this brain
   int32 m_lastTick;
   // m_tick = the amount of time between Think() calls in milliseconds
@@ -0,0 +1,141 @@
+/*  
+    EQ2Emulator:  Everquest II Server Emulator
+    Copyright (C) 2007  EQ2EMulator Development Team (http://www.eq2emulator.net)
+
+    This file is part of EQ2Emulator.
+
+    EQ2Emulator is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    EQ2Emulator is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with EQ2Emulator.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "PacketBroadcast.h"
+#include "client.h"
+#include "../common/ConfigReader.h"
+#include "../common/Log.h"
+#include <algorithm>
+
+extern ConfigReader configReader;
+
+PacketBroadcast::PacketBroadcast(const char* struct_name, function<void(PacketStruct*)> fill) {
+  this->struct_name = struct_name;
+  this->fill = fill;
+  serialize_count = 0;
+}
+
+PacketBroadcast::PacketBroadcast(const char* struct_name, function<void(PacketStruct*)> fill, vector<const char*> recipient_fields, function<void(PacketStruct*, const shared_ptr<Client>&)> fill_recipient) {
+  this->struct_name = struct_name;
+  this->fill = fill;
+  this->recipient_fields = recipient_fields;
+  this->fill_recipient = fill_recipient;
+  serialize_count = 0;
+}
+
+PacketBroadcast::~PacketBroadcast() {
+  for (auto& kv : versions) {
+    if (kv.second.packet)
+      configReader.ReleaseStruct(kv.second.packet);
+  }
+}
+
+PacketBroadcast::VersionData* PacketBroadcast::GetVersionData(int16 version) {
+  map<int16, VersionData>::iterator itr = versions.find(version);
+  if (itr != versions.end())
+    return itr->second.packet ? &itr->second : 0;
+
+  VersionData& version_data = versions[version];
+  version_data.packet = configReader.AcquireStruct(struct_name.c_str(), version);
+  if (!version_data.packet)
+    return 0;
+
+  PacketStruct* packet = version_data.packet;
+  if (packet->GetOpcode() == OP_Unknown) {
+    LogWrite(PACKET__ERROR, 0, "Packet", "Warning: PacketStruct '%s' uses an unknown opcode and cannot be broadcast.", struct_name.c_str());
+    configReader.ReleaseStruct(packet);
+    version_data.packet = 0;
+    return 0;
+  }
+
+  if (fill)
+    fill(packet);
+
+  version_data.client_cmd = packet->IsClientCmd();
+  packet->TrackSerializedOffsets(recipient_fields.size() > 0);
+  version_data.data = *packet->serializeString();
+  serialize_count++;
+
+  for (const char* name : recipient_fields) {
+    RecipientField field;
+    field.data_struct = packet->findStruct(name, 0);
+
+    if (!field.data_struct || !packet->GetSerializedOffset(name, &field.offset, &field.length)) {
+      // the field is missing or not sent for this version, fall back to serializing every recipient
+      version_data.fields.clear();
+      break;
+    }
+
+    version_data.fields.push_back(field);
+  }
+  packet->TrackSerializedOffsets(false);
+
+  sort(version_data.fields.begin(), version_data.fields.end(), [](const RecipientField& a, const RecipientField& b) { return a.offset < b.offset; });
+
+  return &version_data;
+}
+
+bool PacketBroadcast::Send(const shared_ptr<Client>& client) {
+  if (!client)
+    return false;
+
+  VersionData* version_data = GetVersionData(client->GetVersion());
+  if (!version_data)
+    return false;
+
+  PacketStruct* packet = version_data->packet;
+
+  if (recipient_fields.size() == 0) {
+    client->QueuePacket(new EQ2Packet(packet->GetOpcode(), (const uchar*)version_data->data.c_str(), version_data->data.length()));
+    return true;
+  }
+
+  if (fill_recipient)
+    fill_recipient(packet, client);
+
+  if (version_data->fields.size() == 0) {
+    client->QueuePacket(packet->serialize());
+    serialize_count++;
+    return true;
+  }
+
+  // copy the shared bytes around the recipient's own values for its fields
+  const string& data = version_data->data;
+  string output;
+  output.reserve(data.length() + 64);
+
+  int32 pos = 0;
+  for (const RecipientField& field : version_data->fields) {
+    output.append(data, pos, field.offset - pos);
+    packet->AddSerializedData(field.data_struct, 0, &output);
+    pos = field.offset + field.length;
+  }
+  output.append(data, pos, string::npos);
+
+  // ClientCmdMsg packets start with the size of everything after it
+  if (version_data->client_cmd && output.length() != data.length()) {
+    int32 size = *(int32*)output.c_str();
+    size += output.length() - data.length();
+    memcpy(&output[0], &size, sizeof(int32));
+  }
+
+  client->QueuePacket(new EQ2Packet(packet->GetOpcode(), (const uchar*)output.c_str(), output.length()));
+  return true;
+}
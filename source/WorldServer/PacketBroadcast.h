@@ -0,0 +1,71 @@
+/*  
+    EQ2Emulator:  Everquest II Server Emulator
+    Copyright (C) 2007  EQ2EMulator Development Team (http://www.eq2emulator.net)
+
+    This file is part of EQ2Emulator.
+
+    EQ2Emulator is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    EQ2Emulator is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with EQ2Emulator.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../common/types.h"
+
+using namespace std;
+
+class Client;
+class DataStruct;
+class PacketStruct;
+
+// Sends the same packet to many clients. The packet is filled in and serialized once per
+// client version, every recipient gets a copy of those bytes. Fields that differ between
+// recipients are listed in recipient_fields, fill_recipient sets them and only those fields
+// are serialized again and spliced into the copy.
+class PacketBroadcast {
+public:
+  PacketBroadcast(const char* struct_name, function<void(PacketStruct*)> fill);
+  PacketBroadcast(const char* struct_name, function<void(PacketStruct*)> fill, vector<const char*> recipient_fields, function<void(PacketStruct*, const shared_ptr<Client>&)> fill_recipient);
+  ~PacketBroadcast();
+
+  bool Send(const shared_ptr<Client>& client);
+  int32 GetSerializeCount() { return serialize_count; }
+
+private:
+  struct RecipientField {
+    DataStruct* data_struct;
+    int32 offset;
+    int32 length;
+  };
+
+  struct VersionData {
+    PacketStruct* packet;
+    string data;
+    bool client_cmd;
+    // sorted by offset, empty if the fields could not be located and every recipient needs a full serialize
+    vector<RecipientField> fields;
+  };
+
+  VersionData* GetVersionData(int16 version);
+
+  string struct_name;
+  function<void(PacketStruct*)> fill;
+  vector<const char*> recipient_fields;
+  function<void(PacketStruct*, const shared_ptr<Client>&)> fill_recipient;
+  map<int16, VersionData> versions;
+  int32 serialize_count;
+};
@@ -210,6 +210,7 @@ EQ2Packet* Player::Move(float x, float y, float z, int16 version, float heading)
     SetX(x);
     SetY(y);
     SetZ(z);
+    UpdateGridCell();
 
     if (heading != -1.0f) {
       packet->setDataByName("heading", heading);
@@ -1372,6 +1373,10 @@ void Player::ResetQuickbarNeeded() {
   quickbar_updated = false;
 }
 
+void Player::SetQuickbarNeeded() {
+  quickbar_updated = true;
+}
+
 void Player::AddQuickbarItem(int32 bar, int32 slot, int32 type, int16 icon, int16 icon_type, int32 id, int8 tier, int32 unique_id, const char* text, bool update) {
   RemoveQuickbarItem(bar, slot, false);
 
@@ -2433,6 +2438,7 @@ void Player::PrepareIncomingMovementPacket(int32 len, uchar* data, int16 version
       SetX(x);
       SetY(y);
       SetZ(z);
+      UpdateGridCell();
 
       SetSpeedX(x_speed);
       SetSpeedY(y_speed);
@@ -3020,6 +3026,7 @@ void Player::CalculateLocation() {
       SetX(GetX() - (GetSpeed() * .5) * (GetHeading() / 90));
       SetZ(GetZ() - (GetSpeed() * .5) * ((90 - GetHeading()) / 90));
     }
+    UpdateGridCell();
   }
 }
 
@@ -4794,6 +4801,7 @@ void Player::HandleHistoryDiscovery(int8 subtype, int32 value, int32 value2) {
     hd->Value2 = value2;
     hd->EventDate = Timer::GetUnixTimeStamp();
     strcpy(hd->Location, GetZone()->GetZoneName());
+    hd->SaveNeeded = true;
 
     m_characterHistory[HISTORY_TYPE_DISCOVERY][HISTORY_SUBTYPE_LOCATION].push_back(hd);
     break;
@@ -4814,6 +4822,7 @@ void Player::HandleHistoryXP(int8 subtype, int32 value, int32 value2) {
     hd->Value2 = value2;
     hd->EventDate = Timer::GetUnixTimeStamp();
     strcpy(hd->Location, GetZone()->GetZoneName());
+    hd->SaveNeeded = true;
 
     m_characterHistory[HISTORY_TYPE_XP][HISTORY_SUBTYPE_ADVENTURE].push_back(hd);
   } break;
@@ -4837,19 +4846,37 @@ void Player::LoadPlayerHistory(int8 type, int8 subtype, HistoryData* hd) {
   m_characterHistory[type][subtype].push_back(hd);
 }
 
-void Player::SaveHistory() {
+void Player::SaveHistory(QueryBatch& batch) {
   LogWrite(PLAYER__DEBUG, 0, "Player", "Saving History for Player: '%s'", GetName());
 
   map<int8, map<int8, vector<HistoryData*>>>::iterator itr;
   map<int8, vector<HistoryData*>>::iterator itr2;
   vector<HistoryData*>::iterator itr3;
+  set<HistoryData*> saved;
   for (itr = m_characterHistory.begin(); itr != m_characterHistory.end(); itr++) {
     for (itr2 = itr->second.begin(); itr2 != itr->second.end(); itr2++) {
       for (itr3 = itr2->second.begin(); itr3 != itr2->second.end(); itr3++) {
-        database.SaveCharacterHistory(this, itr->first, itr2->first, (*itr3)->Value, (*itr3)->Value2, (*itr3)->Location, (*itr3)->EventDate);
+        if ((*itr3)->SaveNeeded) {
+          database.SaveCharacterHistory(this, itr->first, itr2->first, (*itr3)->Value, (*itr3)->Value2, (*itr3)->Location, (*itr3)->EventDate, batch);
+          (*itr3)->SaveNeeded = false;
+          saved.insert(*itr3);
+        }
       }
     }
   }
+
+  if (!saved.empty()) {
+    batch.OnFailure([this, saved]() {
+      for (auto& type : m_characterHistory) {
+        for (auto& subtype : type.second) {
+          for (HistoryData* hd : subtype.second) {
+            if (saved.count(hd) > 0)
+              hd->SaveNeeded = true;
+          }
+        }
+      }
+    });
+  }
 }
 
 void Player::InitXPTable() {
@@ -5157,16 +5184,28 @@ void Player::LoadLUAHistory(int32 event_id, LUAHistory* history) {
   m_charLuaHistory[event_id] = history;
 }
 
-void Player::SaveLUAHistory() {
+void Player::SaveLUAHistory(QueryBatch& batch) {
   LogWrite(PLAYER__DEBUG, 0, "Player", "Saving LUA History for Player: '%s'", GetName());
 
   map<int32, LUAHistory*>::iterator itr;
+  vector<int32> saved;
   for (itr = m_charLuaHistory.begin(); itr != m_charLuaHistory.end(); itr++) {
     if (itr->second->SaveNeeded) {
-      database.SaveCharacterLUAHistory(this, itr->first, itr->second->Value, itr->second->Value2);
+      database.SaveCharacterLUAHistory(this, itr->first, itr->second->Value, itr->second->Value2, batch);
       itr->second->SaveNeeded = false;
+      saved.push_back(itr->first);
     }
   }
+
+  if (!saved.empty()) {
+    batch.OnFailure([this, saved]() {
+      for (int32 event_id : saved) {
+        map<int32, LUAHistory*>::iterator itr = m_charLuaHistory.find(event_id);
+        if (itr != m_charLuaHistory.end())
+          itr->second->SaveNeeded = true;
+      }
+    });
+  }
 }
 
 void Player::UpdateLUAHistory(int32 event_id, int32 value, int32 value2) {
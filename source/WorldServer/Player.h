@@ -31,6 +31,7 @@
 #include "Titles.h"
 
 class Guild;
+class QueryBatch;
 
 #define CF_COMBAT_EXPERIENCE_ENABLED 0
 #define CF_ENABLE_CHANGE_LASTNAME 1
@@ -137,6 +138,7 @@ struct HistoryData {
   char Location[200];
   int32 EventID;
   int32 EventDate;
+  bool SaveNeeded;
 };
 
 /// <summary>History set through the LUA system</summary>
@@ -465,6 +467,7 @@ public:
   vector<QuickBarItem*>* GetQuickbar();
   bool UpdateQuickbarNeeded();
   void ResetQuickbarNeeded();
+  void SetQuickbarNeeded();
   void set_character_flag(int flag);
   void reset_character_flag(int flag);
   void toggle_character_flag(int flag);
@@ -768,7 +771,7 @@ public:
   void LoadPlayerHistory(int8 type, int8 subtype, HistoryData* hd);
 
   /// <summary>Save the player's history to the database</summary>
-  void SaveHistory();
+  void SaveHistory(QueryBatch& batch);
 
   /* New functions for spell locking and unlocking*/
   /// <summary>Lock all Spells, Combat arts, and Abilities (not trade skill spells)</summary>
@@ -856,7 +859,7 @@ public:
   EQ2_Color GetTempMountSaddleColor() { return tmp_mount_saddle_color; }
 
   void LoadLUAHistory(int32 event_id, LUAHistory* history);
-  void SaveLUAHistory();
+  void SaveLUAHistory(QueryBatch& batch);
   void UpdateLUAHistory(int32 event_id, int32 value, int32 value2);
   LUAHistory* GetLUAHistory(int32 event_id);
 
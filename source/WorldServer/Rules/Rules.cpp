@@ -31,6 +31,7 @@ Rule::Rule() {
   type = 0;
   strncpy(value, "", sizeof(value));
   strncpy(combined, "NONE", sizeof(combined));
+  ParseValue();
 }
 
 Rule::Rule(int32 category, int32 type, const char* value, const char* combined) {
@@ -38,6 +39,7 @@ Rule::Rule(int32 category, int32 type, const char* value, const char* combined)
   this->type = type;
   strncpy(this->value, value, sizeof(this->value));
   strncpy(this->combined, combined, sizeof(this->combined));
+  ParseValue();
 }
 
 Rule::Rule(Rule* rule_in) {
@@ -45,11 +47,24 @@ Rule::Rule(Rule* rule_in) {
   type = rule_in->GetType();
   strncpy(value, rule_in->GetValue(), sizeof(value));
   strncpy(combined, rule_in->GetCombined(), sizeof(combined));
+  ParseValue();
 }
 
 Rule::~Rule() {
 }
 
+void Rule::SetValue(const char* value) {
+  strncpy(this->value, value, sizeof(this->value));
+  ParseValue();
+}
+
+void Rule::ParseValue() {
+  uint_value = atoul(value);
+  int64_value = atoi64(value);
+  sint_value = atoi(value);
+  float_value = atof(value);
+}
+
 RuleSet::RuleSet() {
   id = 0;
   memset(name, 0, sizeof(name));
@@ -170,6 +185,11 @@ RuleManager::RuleManager() {
   m_global_rule_set.SetName("RuleManager::global_rule_set");
   m_zone_rule_sets.SetName("RuleManager::zone_rule_sets");
 
+  // empty until the rule sets are loaded, every rule reads as the blank rule
+  RuleTable* table = new RuleTable();
+  memset(table->rules, 0, sizeof(table->rules));
+  global_rules = table;
+
 #define RULE_INIT(category, type, value) rules[category][type] = new Rule(category, type, value, #category ":" #type)
 
   /* CLIENT */
@@ -256,6 +276,7 @@ RuleManager::RuleManager() {
   RULE_INIT(R_World, SaveHeadshotImage, "1");                  // default: true
   RULE_INIT(R_World, SendPaperdollImagesToLogin, "1");         // default: true
   RULE_INIT(R_World, TreasureChestDisabled, "0");              // default: false
+  RULE_INIT(R_World, LuaStatePoolSize, "2");                   // default: 2 - states loaded for a spawn, item or zone script on its first use
   //INSERT INTO `ruleset_details`(`id`, `ruleset_id`, `rule_category`, `rule_type`, `rule_value`, `description`) VALUES (NULL, '1', 'R_World', '', '', '')
 
   /* ZONE */
@@ -281,6 +302,10 @@ RuleManager::RuleManager() {
   RULE_INIT(R_Zone, DefaultZoneShutdownTimer, "300000");
   RULE_INIT(R_Zone, WeatherTimer, "60000");     // default: 1 minute
   RULE_INIT(R_Zone, SpawnDeleteTimer, "30000"); // default: 30 seconds, how long a spawn pointer is held onto after being removed from the world before deleting it
+  RULE_INIT(R_Zone, ZoneWorkerThreads, "0");    // default: 0 (2 per core, minimum 4) - threads shared by all zones to run their process loops, read when the first zone starts
+  RULE_INIT(R_Zone, SpawnWorkerThreads, "0");   // default: 0 (1 less than the cores) - threads shared by all zones to split up their aggro checks, read when the first zone starts
+  RULE_INIT(R_Zone, ZoneLoaderThreads, "0");    // default: 0 (2) - threads that load the data of new zones so the caller doesn't wait on it, read when the first zone starts
+  RULE_INIT(R_Zone, SpawnUpdateByteBudget, "1024"); // default: 1024 - bytes of spawn updates sent to a client per update tick, closest and most relevant spawns first
 #undef RULE_INIT
 }
 
@@ -295,6 +320,16 @@ RuleManager::~RuleManager() {
 
   ClearRuleSets();
   ClearZoneRuleSets();
+
+  retired_tables.push_back(global_rules.load());
+  for (RuleTable* table : retired_tables) {
+    for (Rule* rule : table->owned)
+      safe_delete(rule);
+    safe_delete(table);
+  }
+
+  for (RuleSet* rule_set : retired_rule_sets)
+    safe_delete(rule_set);
 }
 
 void RuleManager::LoadCodedDefaultsIntoRuleSet(RuleSet* rule_set) {
@@ -351,11 +386,34 @@ bool RuleManager::SetGlobalRuleSet(int32 rule_set_id) {
     return false;
 
   global_rule_set.CopyRulesInto(rule_sets[rule_set_id]);
+  PublishGlobalRules();
   return true;
 }
 
-Rule* RuleManager::GetGlobalRule(int32 category, int32 type) {
-  return global_rule_set.GetRule(category, type);
+void RuleManager::PublishGlobalRules() {
+  map<int32, map<int32, Rule*>>* global_rules_in = global_rule_set.GetRules();
+  map<int32, map<int32, Rule*>>::iterator itr;
+  map<int32, Rule*>::iterator itr2;
+  RuleTable* table = new RuleTable();
+
+  memset(table->rules, 0, sizeof(table->rules));
+
+  m_global_rule_set.writelock(__FUNCTION__, __LINE__);
+  for (itr = global_rules_in->begin(); itr != global_rules_in->end(); itr++) {
+    for (itr2 = itr->second.begin(); itr2 != itr->second.end(); itr2++) {
+      if (itr->first >= R_CategoryCount || itr2->first >= RuleTypeCount)
+        continue;
+
+      Rule* rule = new Rule(itr2->second);
+      table->rules[itr->first][itr2->first] = rule;
+      table->owned.push_back(rule);
+    }
+  }
+
+  retired_tables.push_back(global_rules.exchange(table, memory_order_acq_rel));
+  m_global_rule_set.releasewritelock(__FUNCTION__, __LINE__);
+
+  LogWrite(RULESYS__DEBUG, 3, "Rules", "--Published %u global rules", table->owned.size());
 }
 
 bool RuleManager::SetZoneRuleSet(int32 zone_id, int32 rule_set_id) {
@@ -393,6 +451,34 @@ Rule* RuleManager::GetZoneRule(int32 zone_id, int32 category, int32 type) {
   return ret ? ret : rules[category][type];
 }
 
+void RuleManager::RetireRuleSets() {
+  map<int32, RuleSet*>::iterator itr;
+
+  m_rule_sets.writelock(__FUNCTION__, __LINE__);
+  for (itr = rule_sets.begin(); itr != rule_sets.end(); itr++)
+    retired_rule_sets.push_back(itr->second);
+  rule_sets.clear();
+  m_rule_sets.releasewritelock(__FUNCTION__, __LINE__);
+}
+
+void RuleManager::RemapZoneRuleSets() {
+  map<int32, RuleSet*>::iterator itr;
+
+  m_rule_sets.readlock(__FUNCTION__, __LINE__);
+  m_zone_rule_sets.writelock(__FUNCTION__, __LINE__);
+  for (itr = zone_rule_sets.begin(); itr != zone_rule_sets.end();) {
+    map<int32, RuleSet*>::iterator rule_set_itr = rule_sets.find(itr->second->GetID());
+
+    if (rule_set_itr != rule_sets.end()) {
+      itr->second = rule_set_itr->second;
+      itr++;
+    } else
+      itr = zone_rule_sets.erase(itr);
+  }
+  m_zone_rule_sets.releasewritelock(__FUNCTION__, __LINE__);
+  m_rule_sets.releasereadlock(__FUNCTION__, __LINE__);
+}
+
 void RuleManager::ClearZoneRuleSets() {
   m_zone_rule_sets.writelock(__FUNCTION__, __LINE__);
   zone_rule_sets.clear();
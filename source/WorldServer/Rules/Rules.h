@@ -21,7 +21,9 @@
 #define RULES_H_
 
 #include <string.h>
+#include <atomic>
 #include <map>
+#include <vector>
 #include "../../common/Mutex.h"
 #include "../../common/types.h"
 
@@ -36,7 +38,10 @@ enum RuleCategory {
   R_Spawn,
   R_UI,
   R_World,
-  R_Zone
+  R_Zone,
+
+  /* keep last */
+  R_CategoryCount
 };
 
 enum RuleType {
@@ -118,6 +123,7 @@ enum RuleType {
   SaveHeadshotImage,
   SendPaperdollImagesToLogin,
   TreasureChestDisabled,
+  LuaStatePoolSize,
 
   /* ZONE */
   MinZoneLevelOverrideStatus,
@@ -142,7 +148,14 @@ enum RuleType {
   ClientSaveTimer,
   DefaultZoneShutdownTimer,
   WeatherTimer,
-  SpawnDeleteTimer
+  SpawnDeleteTimer,
+  ZoneWorkerThreads,
+  SpawnWorkerThreads,
+  ZoneLoaderThreads,
+  SpawnUpdateByteBudget,
+
+  /* keep last */
+  RuleTypeCount
 };
 
 class Rule {
@@ -152,31 +165,46 @@ public:
   Rule(Rule* rule_in);
   virtual ~Rule();
 
-  void SetValue(const char* value) { strncpy(this->value, value, sizeof(this->value)); }
+  void SetValue(const char* value);
 
   int32 GetCategory() { return category; }
   int32 GetType() { return type; }
   const char* GetValue() { return value; }
   const char* GetCombined() { return combined; }
 
-  int8 GetInt8() { return (int8)atoul(value); }
-  int16 GetInt16() { return (int16)atoul(value); }
-  int32 GetInt32() { return (int32)atoul(value); }
-  int64 GetInt64() { return (int64)atoi64(value); }
-  sint8 GetSInt8() { return (sint8)atoi(value); }
-  sint16 GetSInt16() { return (sint16)atoi(value); }
-  sint32 GetSInt32() { return (sint32)atoi(value); }
-  sint64 GetSInt64() { return (sint64)atoi64(value); }
-  bool GetBool() { return atoul(value) > 0 ? true : false; }
-  float GetFloat() { return atof(value); }
+  int8 GetInt8() { return (int8)uint_value; }
+  int16 GetInt16() { return (int16)uint_value; }
+  int32 GetInt32() { return (int32)uint_value; }
+  int64 GetInt64() { return (int64)int64_value; }
+  sint8 GetSInt8() { return (sint8)sint_value; }
+  sint16 GetSInt16() { return (sint16)sint_value; }
+  sint32 GetSInt32() { return sint_value; }
+  sint64 GetSInt64() { return int64_value; }
+  bool GetBool() { return uint_value > 0 ? true : false; }
+  float GetFloat() { return float_value; }
   char GetChar() { return value[0]; }
   const char* GetString() { return value; }
 
 private:
+  // parses value into the typed copies below, so the getters don't parse on every call
+  void ParseValue();
+
   int32 category;
   int32 type;
   char value[64];
   char combined[256];
+  int64 uint_value;
+  sint64 int64_value;
+  sint32 sint_value;
+  float float_value;
+};
+
+// A read only copy of the global rule set indexed by category and type. A new table is
+// published whenever the global rule set changes and the old one is kept until shutdown,
+// so a reader never has to lock and a Rule* it got stays valid.
+struct RuleTable {
+  Rule* rules[R_CategoryCount][RuleTypeCount];
+  vector<Rule*> owned;
 };
 
 class RuleSet {
@@ -221,12 +249,22 @@ public:
   Rule* GetBlankRule() { return &blank_rule; }
 
   bool SetGlobalRuleSet(int32 rule_set_id);
-  Rule* GetGlobalRule(int32 category, int32 type);
+  // Copies the global rule set into a new table for GetGlobalRule to read from
+  void PublishGlobalRules();
+  Rule* GetGlobalRule(int32 category, int32 type) {
+    RuleTable* table = global_rules.load(memory_order_acquire);
+    Rule* ret = (category < R_CategoryCount && type < RuleTypeCount) ? table->rules[category][type] : 0;
+    return ret ? ret : &blank_rule;
+  }
 
   bool SetZoneRuleSet(int32 zone_id, int32 rule_set_id);
   Rule* GetZoneRule(int32 zone_id, int32 category, int32 type);
   void ClearZoneRuleSets();
   bool HasZoneRuleSet(int32 zone_id);
+  // Moves the loaded rule sets aside before they are loaded again, zones keep using them until RemapZoneRuleSets
+  void RetireRuleSets();
+  // Points the zones at the reloaded rule sets with the same ids
+  void RemapZoneRuleSets();
 
   RuleSet* GetGlobalRuleSet() { return &global_rule_set; }
   map<int32, map<int32, Rule*>>* GetRules() { return &rules; }
@@ -240,6 +278,9 @@ private:
   map<int32, RuleSet*> rule_sets;      /* all of the possible rule sets from the database. map<rule set id, rule set> */
   RuleSet global_rule_set;             /* the global rule set, first fill it the defaults from the code, then over ride from the database */
   map<int32, RuleSet*> zone_rule_sets; /* references to a zone's rule set. map<zone id, rule set> */
+  atomic<RuleTable*> global_rules;     /* the published copy of global_rule_set that GetGlobalRule reads */
+  vector<RuleTable*> retired_tables;   /* tables replaced by a later publish, readers may still hold their rules */
+  vector<RuleSet*> retired_rule_sets;  /* rule sets replaced by a reload, zones may still hold their rules */
 };
 
 #endif
\ No newline at end of file
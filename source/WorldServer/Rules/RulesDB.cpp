@@ -38,8 +38,20 @@ void WorldDatabase::LoadGlobalRuleSet() {
     LogWrite(RULESYS__DEBUG, 5, "Rules", "\t\tLoading Global Ruleset id %i", rule_set_id);
   }
 
-  if (rule_set_id > 0 && !rule_manager.SetGlobalRuleSet(rule_set_id))
+  if (rule_set_id > 0 && rule_manager.SetGlobalRuleSet(rule_set_id))
+    return;
+
+  if (rule_set_id > 0)
     LogWrite(RULESYS__ERROR, 0, "Rules", "Error loading global rule set. A rule set with ID %u does not exist.", rule_set_id);
+
+  // no rule set was copied in, publish the coded defaults
+  rule_manager.PublishGlobalRules();
+}
+
+void WorldDatabase::ReloadRuleSets() {
+  rule_manager.RetireRuleSets();
+  LoadRuleSets();
+  rule_manager.RemapZoneRuleSets();
 }
 
 void WorldDatabase::LoadRuleSets() {
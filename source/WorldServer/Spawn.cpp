@@ -39,6 +39,124 @@ extern ConfigReader configReader;
 extern RuleManager rule_manager;
 extern World world;
 
+// Fields of the spawn info, pos and vis structs, set for every spawn update
+static const PacketField field_pvp_difficulty("pvp_difficulty");
+static const PacketField field_arrow_color("arrow_color");
+static const PacketField field_locked_no_loot("locked_no_loot");
+static const PacketField field_npc_con("npc_con");
+static const PacketField field_npc_hate("npc_hate");
+static const PacketField field_quest_flag("quest_flag");
+static const PacketField field_vis_flags("vis_flags");
+static const PacketField field_hand_flag("hand_flag");
+static const PacketField field_pos_grid_id("pos_grid_id");
+static const PacketField field_pos_heading1("pos_heading1");
+static const PacketField field_pos_heading2("pos_heading2");
+static const PacketField field_pos_collision_radius("pos_collision_radius");
+static const PacketField field_pos_size("pos_size");
+static const PacketField field_pos_size_multiplier("pos_size_multiplier");
+static const PacketField field_pos_size_ratio("pos_size_ratio");
+static const PacketField field_pos_size_multiplier_ratio("pos_size_multiplier_ratio");
+static const PacketField field_pos_state("pos_state");
+static const PacketField field_pos_x("pos_x");
+static const PacketField field_pos_y("pos_y");
+static const PacketField field_pos_z("pos_z");
+static const PacketField field_pos_unknown6("pos_unknown6");
+static const PacketField field_pos_unknown2("pos_unknown2");
+static const PacketField field_pos_x_velocity("pos_x_velocity");
+static const PacketField field_pos_y_velocity("pos_y_velocity");
+static const PacketField field_pos_z_velocity("pos_z_velocity");
+static const PacketField field_pos_next_x("pos_next_x");
+static const PacketField field_pos_next_y("pos_next_y");
+static const PacketField field_pos_next_z("pos_next_z");
+static const PacketField field_pos_x3("pos_x3");
+static const PacketField field_pos_y3("pos_y3");
+static const PacketField field_pos_z3("pos_z3");
+static const PacketField field_pos_speed("pos_speed");
+static const PacketField field_pos_side_speed("pos_side_speed");
+static const PacketField field_pos_move_type("pos_move_type");
+static const PacketField field_pos_movement_mode("pos_movement_mode");
+static const PacketField field_pos_unknown10("pos_unknown10");
+static const PacketField field_pos_pitch1("pos_pitch1");
+static const PacketField field_pos_pitch2("pos_pitch2");
+static const PacketField field_pos_roll("pos_roll");
+static const PacketField field_spawn_type("spawn_type");
+static const PacketField field_unknown5("unknown5");
+static const PacketField field_unknown7("unknown7");
+static const PacketField field_target_id("target_id");
+static const PacketField field_hp_remaining("hp_remaining");
+static const PacketField field_power_percent("power_percent");
+static const PacketField field_level("level");
+static const PacketField field_unknown4("unknown4");
+static const PacketField field_difficulty("difficulty");
+static const PacketField field_heroic_flag("heroic_flag");
+static const PacketField field_interaction_flag("interaction_flag");
+static const PacketField field_class("class");
+static const PacketField field_unknown600553("unknown600553");
+static const PacketField field_size_type("size_type");
+static const PacketField field_model_type("model_type");
+static const PacketField field_soga_model_type("soga_model_type");
+static const PacketField field_action_state("action_state");
+static const PacketField field_visual_state("visual_state");
+static const PacketField field_emote_state("emote_state");
+static const PacketField field_mood_state("mood_state");
+static const PacketField field_gender("gender");
+static const PacketField field_race("race");
+static const PacketField field_combat_voice("combat_voice");
+static const PacketField field_emote_voice("emote_voice");
+static const PacketField field_equipment_types("equipment_types");
+static const PacketField field_equipment_colors("equipment_colors");
+static const PacketField field_equipment_highlights("equipment_highlights");
+static const PacketField field_mount_type("mount_type");
+static const PacketField field_visual_flag("visual_flag");
+static const PacketField field_mount_saddle_color("mount_saddle_color");
+static const PacketField field_mount_color("mount_color");
+static const PacketField field_hair_type_id("hair_type_id");
+static const PacketField field_chest_type_id("chest_type_id");
+static const PacketField field_wing_type_id("wing_type_id");
+static const PacketField field_legs_type_id("legs_type_id");
+static const PacketField field_soga_hair_type_id("soga_hair_type_id");
+static const PacketField field_facial_hair_type_id("facial_hair_type_id");
+static const PacketField field_soga_facial_hair_type_id("soga_facial_hair_type_id");
+static const PacketField field_eye_type("eye_type");
+static const PacketField field_ear_type("ear_type");
+static const PacketField field_eye_brow_type("eye_brow_type");
+static const PacketField field_cheek_type("cheek_type");
+static const PacketField field_lip_type("lip_type");
+static const PacketField field_chin_type("chin_type");
+static const PacketField field_nose_type("nose_type");
+static const PacketField field_soga_eye_type("soga_eye_type");
+static const PacketField field_soga_ear_type("soga_ear_type");
+static const PacketField field_soga_eye_brow_type("soga_eye_brow_type");
+static const PacketField field_soga_cheek_type("soga_cheek_type");
+static const PacketField field_soga_lip_type("soga_lip_type");
+static const PacketField field_soga_chin_type("soga_chin_type");
+static const PacketField field_soga_nose_type("soga_nose_type");
+static const PacketField field_skin_color("skin_color");
+static const PacketField field_eye_color("eye_color");
+static const PacketField field_hair_type_color("hair_type_color");
+static const PacketField field_hair_type_highlight_color("hair_type_highlight_color");
+static const PacketField field_hair_face_color("hair_face_color");
+static const PacketField field_hair_face_highlight_color("hair_face_highlight_color");
+static const PacketField field_hair_highlight("hair_highlight");
+static const PacketField field_wing_color1("wing_color1");
+static const PacketField field_wing_color2("wing_color2");
+static const PacketField field_hair_color1("hair_color1");
+static const PacketField field_hair_color2("hair_color2");
+static const PacketField field_soga_skin_color("soga_skin_color");
+static const PacketField field_soga_eye_color("soga_eye_color");
+static const PacketField field_soga_hair_color1("soga_hair_color1");
+static const PacketField field_soga_hair_color2("soga_hair_color2");
+static const PacketField field_soga_hair_type_color("soga_hair_type_color");
+static const PacketField field_soga_hair_type_highlight_color("soga_hair_type_highlight_color");
+static const PacketField field_soga_hair_face_color("soga_hair_face_color");
+static const PacketField field_soga_hair_face_highlight_color("soga_hair_face_highlight_color");
+static const PacketField field_soga_hair_highlight("soga_hair_highlight");
+static const PacketField field_body_age("body_age");
+static const PacketField field_icon("icon");
+static const PacketField field_activity_status("activity_status");
+static const PacketField field_activity_timer("activity_timer");
+static const PacketField field_follow_target("follow_target");
+
 Spawn::Spawn() {
   group_id = 0;
   size_offset = 0;
@@ -66,6 +184,8 @@ Spawn::Spawn() {
   position_changed = false;
   send_spawn_changes = true;
   info_changed = false;
+  info_revision = 0;
+  pos_revision = 0;
   appearance.pos.Speed1 = 0;
   last_attacker = 0;
   faction_id = 0;
@@ -223,24 +343,24 @@ void Spawn::InitializeVisPacketData(Player* player, PacketStruct* vis_packet) {
       }
 
       if (IsPlayer())
-        vis_packet->setDataByName("pvp_difficulty", 6);
+        vis_packet->setDataByName(field_pvp_difficulty, 6);
 
-      vis_packet->setDataByName("arrow_color", arrow_color);
-      vis_packet->setDataByName("locked_no_loot", 1);
+      vis_packet->setDataByName(field_arrow_color, arrow_color);
+      vis_packet->setDataByName(field_locked_no_loot, 1);
 
       if (IsNPC() && (player->GetArrowColor(GetLevel()) == ARROW_COLOR_GRAY || player->IsStealthed() || player->IsInvis())) {
         if (npc_con == -4)
           npc_con = -3;
       }
 
-      vis_packet->setDataByName("npc_con", npc_con);
+      vis_packet->setDataByName(field_npc_con, npc_con);
 
       if (appearance.attackable == 1 && IsNPC() && (player->GetFactions()->GetCon(faction_id) <= -4 || ((NPC*)this)->Brain()->GetHate(player) > 1))
-        vis_packet->setDataByName("npc_hate", ((NPC*)this)->Brain()->GetHatePercentage(player));
+        vis_packet->setDataByName(field_npc_hate, ((NPC*)this)->Brain()->GetHatePercentage(player));
       int8 quest_flag = player->CheckQuestFlag(this);
       if (version < 1188 && quest_flag >= 16)
         quest_flag = 1;
-      vis_packet->setDataByName("quest_flag", quest_flag);
+      vis_packet->setDataByName(field_quest_flag, quest_flag);
     }
   }
 
@@ -275,12 +395,12 @@ void Spawn::InitializeVisPacketData(Player* player, PacketStruct* vis_packet) {
     vis_flags = req_quests_override & 0xFF;
   }
 
-  vis_packet->setDataByName("vis_flags", vis_flags);
+  vis_packet->setDataByName(field_vis_flags, vis_flags);
 
   if (MeetsSpawnAccessRequirements(player)) {
-    vis_packet->setDataByName("hand_flag", appearance.display_hand_icon);
+    vis_packet->setDataByName(field_hand_flag, appearance.display_hand_icon);
   } else if ((req_quests_override & 256) > 0) {
-    vis_packet->setDataByName("hand_flag", 1);
+    vis_packet->setDataByName(field_hand_flag, 1);
   }
 }
 
@@ -445,6 +565,80 @@ EQ2Packet* Spawn::spawn_serialize(Player* player, int16 version) {
   return ret;
 }
 
+void Spawn::GetSharedPacketData(Player* player, PacketStruct* packet, bool info, string& output) {
+  // The viewer specific info fields, everything else in the info and pos structs is
+  // the same for every viewer except the spawn itself (which never uses the shared copy)
+  static const char* viewer_fields[] = {"spawn_type", "unknown5", "unknown7", "target_id"};
+
+  int32 tick = GetZone()->GetSpawnUpdateTick();
+
+  MSharedPacketData.writelock(__FUNCTION__, __LINE__);
+
+  SerializedSpawnData& shared = info ? shared_info_data[packet->GetVersion()] : shared_pos_data[packet->GetVersion()];
+  int32 revision = info ? info_revision : pos_revision;
+
+  if (shared.data.empty() || shared.tick != tick || shared.revision != revision) {
+    packet->ResetData();
+
+    if (info)
+      InitializeInfoPacketSharedData(nullptr, packet);
+    else
+      InitializePosPacketData(nullptr, packet);
+
+    packet->TrackSerializedOffsets(true);
+    shared.data = *packet->serializeString();
+    shared.viewer_offsets.clear();
+
+    if (info) {
+      for (const char* name : viewer_fields) {
+        int32 offset;
+        int32 length;
+
+        if (packet->GetSerializedOffset(name, &offset, &length))
+          shared.viewer_offsets[name] = make_pair(offset, length);
+      }
+    }
+
+    packet->TrackSerializedOffsets(false);
+    shared.tick = tick;
+    shared.revision = revision;
+  }
+
+  output = shared.data;
+  bool patched = true;
+
+  if (!shared.viewer_offsets.empty()) {
+    // Serialize just the viewer's fields and patch them over the shared copy
+    packet->ResetData();
+    InitializeInfoPacketViewerData(player, packet);
+
+    for (const auto& kv : shared.viewer_offsets) {
+      DataStruct* data_struct = packet->findStruct(kv.first.c_str(), 0);
+      string field;
+
+      if (data_struct)
+        packet->AddSerializedData(data_struct, 0, &field);
+
+      if (field.length() != kv.second.second) {
+        patched = false;
+        break;
+      }
+
+      output.replace(kv.second.first, kv.second.second, field);
+    }
+  }
+
+  MSharedPacketData.releasewritelock(__FUNCTION__, __LINE__);
+
+  // A viewer field that serializes to a different size would shift the rest of
+  // the packet, so this viewer gets its own full copy instead
+  if (!patched) {
+    packet->ResetData();
+    InitializeInfoPacketData(player, packet);
+    output = *packet->serializeString();
+  }
+}
+
 uchar* Spawn::spawn_info_changes(Player* player, int16 version) {
   int16 index = player->player_spawn_index_map[this];
 
@@ -452,10 +646,17 @@ uchar* Spawn::spawn_info_changes(Player* player, int16 version) {
 
   player->info_mutex.writelock(__FUNCTION__, __LINE__);
 
-  packet->ResetData();
-  InitializeInfoPacketData(player, packet);
+  string shared_data;
+  string* data = &shared_data;
+
+  if (this == player) {
+    packet->ResetData();
+    InitializeInfoPacketData(player, packet);
+    data = packet->serializeString();
+  } else {
+    GetSharedPacketData(player, packet, true, shared_data);
+  }
 
-  string* data = packet->serializeString();
   int32 size = data->length();
   uchar* xor_info_packet = player->GetTempInfoPacketForXOR();
 
@@ -575,10 +776,17 @@ uchar* Spawn::spawn_pos_changes(Player* player, int16 version) {
 
   uchar* orig_packet = player->GetSpawnPosPacketForXOR(id);
 
-  packet->ResetData();
-  InitializePosPacketData(player, packet);
+  string shared_data;
+  string* data = &shared_data;
+
+  if (this == player) {
+    packet->ResetData();
+    InitializePosPacketData(player, packet);
+    data = packet->serializeString();
+  } else {
+    GetSharedPacketData(player, packet, false, shared_data);
+  }
 
-  string* data = packet->serializeString();
   int32 size = data->length();
   uchar* xor_pos_packet = player->GetTempPosPacketForXOR();
 
@@ -1289,9 +1497,15 @@ int32 Spawn::GetTransporterID() {
   return transporter_id;
 }
 
+void Spawn::UpdateGridCell() {
+  if (zone != nullptr && zone->Grid != nullptr)
+    zone->Grid->UpdateSpawnCell(this);
+}
+
+// player may be null when building the copy shared by every viewer other than this spawn
 void Spawn::InitializePosPacketData(Player* player, PacketStruct* packet) {
   int16 version = packet->GetVersion();
-  packet->setDataByName("pos_grid_id", appearance.pos.grid_id);
+  packet->setDataByName(field_pos_grid_id, appearance.pos.grid_id);
   bool include_heading = true;
   if (IsWidget() && ((Widget*)this)->GetIncludeHeading() == false)
     include_heading = false;
@@ -1301,30 +1515,30 @@ void Spawn::InitializePosPacketData(Player* player, PacketStruct* packet) {
     include_heading = false;
 
   if (include_heading) {
-    packet->setDataByName("pos_heading1", appearance.pos.Dir1);
-    packet->setDataByName("pos_heading2", appearance.pos.Dir2);
+    packet->setDataByName(field_pos_heading1, appearance.pos.Dir1);
+    packet->setDataByName(field_pos_heading2, appearance.pos.Dir2);
   }
 
-  packet->setDataByName("pos_collision_radius", appearance.pos.collision_radius > 0 ? appearance.pos.collision_radius : 32);
+  packet->setDataByName(field_pos_collision_radius, appearance.pos.collision_radius > 0 ? appearance.pos.collision_radius : 32);
 
   if (version <= 910) {
-    packet->setDataByName("pos_size", size > 0 ? size : 32);
-    packet->setDataByName("pos_size_multiplier", 32); //32 is normal
+    packet->setDataByName(field_pos_size, size > 0 ? size : 32);
+    packet->setDataByName(field_pos_size_multiplier, 32); //32 is normal
   } else {
     if (IsPlayer()) {
       if (this != player) {
-        packet->setDataByName("pos_size", 49152);
+        packet->setDataByName(field_pos_size, 49152);
       }
 
-      packet->setDataByName("pos_size_ratio", 1);
-      packet->setDataByName("pos_size_multiplier_ratio", (size > 0 ? (static_cast<float>(size) / 32) : 1));
+      packet->setDataByName(field_pos_size_ratio, 1);
+      packet->setDataByName(field_pos_size_multiplier_ratio, (size > 0 ? (static_cast<float>(size) / 32) : 1));
     } else {
-      packet->setDataByName("pos_size_ratio", (size > 0 ? (static_cast<float>(size) / 32) : 1));
-      packet->setDataByName("pos_size_multiplier_ratio", 1);
+      packet->setDataByName(field_pos_size_ratio, (size > 0 ? (static_cast<float>(size) / 32) : 1));
+      packet->setDataByName(field_pos_size_multiplier_ratio, 1);
     }
   }
 
-  packet->setDataByName("pos_state", appearance.pos.state);
+  packet->setDataByName(field_pos_state, appearance.pos.state);
 
   bool include_location = true;
   if (IsWidget() && ((Widget*)this)->GetIncludeLocation() == false)
@@ -1339,26 +1553,26 @@ void Spawn::InitializePosPacketData(Player* player, PacketStruct* packet) {
       float y = appearance.pos.Y - widget->GetWidgetY();
       float z = appearance.pos.Z - widget->GetWidgetZ();
 
-      packet->setDataByName("pos_x", x);
-      packet->setDataByName("pos_y", y);
-      packet->setDataByName("pos_z", z);
+      packet->setDataByName(field_pos_x, x);
+      packet->setDataByName(field_pos_y, y);
+      packet->setDataByName(field_pos_z, z);
     } else {
-      packet->setDataByName("pos_x", appearance.pos.X);
-      packet->setDataByName("pos_y", appearance.pos.Y);
-      packet->setDataByName("pos_z", appearance.pos.Z);
+      packet->setDataByName(field_pos_x, appearance.pos.X);
+      packet->setDataByName(field_pos_y, appearance.pos.Y);
+      packet->setDataByName(field_pos_z, appearance.pos.Z);
     }
 
     if (IsSign()) {
-      packet->setDataByName("pos_unknown6", 3, 2);
+      packet->setDataByName(field_pos_unknown6, 3, 2);
     }
   }
 
   if (IsPlayer()) {
-    packet->setDataByName("pos_unknown2", movement_unknown, 2);
+    packet->setDataByName(field_pos_unknown2, movement_unknown, 2);
 
-    packet->setDataByName("pos_x_velocity", static_cast<sint16>(GetSpeedX() * 32));
-    packet->setDataByName("pos_y_velocity", static_cast<sint16>(GetSpeedY() * 32));
-    packet->setDataByName("pos_z_velocity", static_cast<sint16>(GetSpeedZ() * 32));
+    packet->setDataByName(field_pos_x_velocity, static_cast<sint16>(GetSpeedX() * 32));
+    packet->setDataByName(field_pos_y_velocity, static_cast<sint16>(GetSpeedY() * 32));
+    packet->setDataByName(field_pos_z_velocity, static_cast<sint16>(GetSpeedZ() * 32));
   } else if (IsWidget() && ((Widget*)this)->GetMultiFloorLift()) {
     Widget* widget = (Widget*)this;
 
@@ -1376,62 +1590,90 @@ void Spawn::InitializePosPacketData(Player* player, PacketStruct* packet) {
       z = appearance.pos.Z - widget->GetWidgetZ();
     }
 
-    packet->setDataByName("pos_next_x", x);
-    packet->setDataByName("pos_next_y", y);
-    packet->setDataByName("pos_next_z", z);
+    packet->setDataByName(field_pos_next_x, x);
+    packet->setDataByName(field_pos_next_y, y);
+    packet->setDataByName(field_pos_next_z, z);
 
-    packet->setDataByName("pos_x3", x);
-    packet->setDataByName("pos_y3", y);
-    packet->setDataByName("pos_z3", z);
+    packet->setDataByName(field_pos_x3, x);
+    packet->setDataByName(field_pos_y3, y);
+    packet->setDataByName(field_pos_z3, z);
   } else {
-    packet->setDataByName("pos_next_x", appearance.pos.X2);
-    packet->setDataByName("pos_next_y", appearance.pos.Y2);
-    packet->setDataByName("pos_next_z", appearance.pos.Z2);
+    packet->setDataByName(field_pos_next_x, appearance.pos.X2);
+    packet->setDataByName(field_pos_next_y, appearance.pos.Y2);
+    packet->setDataByName(field_pos_next_z, appearance.pos.Z2);
 
-    packet->setDataByName("pos_x3", appearance.pos.X3);
-    packet->setDataByName("pos_y3", appearance.pos.Y3);
-    packet->setDataByName("pos_z3", appearance.pos.Z3);
+    packet->setDataByName(field_pos_x3, appearance.pos.X3);
+    packet->setDataByName(field_pos_y3, appearance.pos.Y3);
+    packet->setDataByName(field_pos_z3, appearance.pos.Z3);
   }
 
-  //packet->setDataByName("pos_unknown2", 4, 2);
+  //packet->setDataByName(field_pos_unknown2, 4, 2);
 
   int16 speed_multiplier = rule_manager.GetGlobalRule(R_Spawn, SpeedMultiplier)->GetInt16(); // was 1280, 600 and now 300... investigating why
 
   if (IsPlayer()) {
     Player* player = static_cast<Player*>(this);
 
-    packet->setDataByName("pos_speed", player->GetPosPacketSpeed() * speed_multiplier);
-    packet->setDataByName("pos_side_speed", player->GetSideSpeed() * speed_multiplier);
+    packet->setDataByName(field_pos_speed, player->GetPosPacketSpeed() * speed_multiplier);
+    packet->setDataByName(field_pos_side_speed, player->GetSideSpeed() * speed_multiplier);
   } else {
-    packet->setDataByName("pos_speed", GetSpeed() * speed_multiplier);
+    packet->setDataByName(field_pos_speed, GetSpeed() * speed_multiplier);
   }
 
   if (IsNPC() || IsPlayer()) {
-    packet->setDataByName("pos_move_type", 25);
+    packet->setDataByName(field_pos_move_type, 25);
   } else if (IsWidget() || IsSign()) {
-    packet->setDataByName("pos_move_type", 11);
+    packet->setDataByName(field_pos_move_type, 11);
   } else if (IsGroundSpawn()) {
-    packet->setDataByName("pos_move_type", 16);
+    packet->setDataByName(field_pos_move_type, 16);
   }
 
   if (!IsPlayer()) {
-    packet->setDataByName("pos_movement_mode", 2);
+    packet->setDataByName(field_pos_movement_mode, 2);
   }
 
   if (version <= 910)
-    packet->setDataByName("pos_unknown10", 0xFFFF, 1);
+    packet->setDataByName(field_pos_unknown10, 0xFFFF, 1);
   else
-    packet->setDataByName("pos_unknown10", 0xFFFF);
+    packet->setDataByName(field_pos_unknown10, 0xFFFF);
   if (version <= 910)
-    packet->setDataByName("pos_unknown10", 0xFFFF, 2);
+    packet->setDataByName(field_pos_unknown10, 0xFFFF, 2);
   else
-    packet->setDataByName("pos_unknown10", 0XFFFF, 1);
-  packet->setDataByName("pos_pitch1", appearance.pos.Pitch1);
-  packet->setDataByName("pos_pitch2", appearance.pos.Pitch2);
-  packet->setDataByName("pos_roll", appearance.pos.Roll);
+    packet->setDataByName(field_pos_unknown10, 0XFFFF, 1);
+  packet->setDataByName(field_pos_pitch1, appearance.pos.Pitch1);
+  packet->setDataByName(field_pos_pitch2, appearance.pos.Pitch2);
+  packet->setDataByName(field_pos_roll, appearance.pos.Roll);
 }
 
 void Spawn::InitializeInfoPacketData(Player* spawn, PacketStruct* packet) {
+  InitializeInfoPacketSharedData(spawn, packet);
+  InitializeInfoPacketViewerData(spawn, packet);
+}
+
+void Spawn::InitializeInfoPacketViewerData(Player* spawn, PacketStruct* packet) {
+  if (IsPlayer() && Alive()) {
+    if (spawn->IsHostile(this)) {
+      packet->setDataByName(field_spawn_type, 4);
+    } else {
+      packet->setDataByName(field_spawn_type, 0);
+    }
+  } else {
+    packet->setDataByName(field_spawn_type, spawn_type);
+  }
+
+  if (IsEntity() && spawn->IsHostile(this)) {
+    packet->setDataByName(field_unknown5, 1);
+    packet->setDataByName(field_unknown7, 255);
+  }
+
+  if (GetTarget() && GetTarget()->GetTargetable())
+    packet->setDataByName(field_target_id, ((spawn->GetIDWithPlayerSpawn(GetTarget()) * -1) - 1));
+  else
+    packet->setDataByName(field_target_id, 0);
+}
+
+// spawn may be null when building the copy shared by every viewer other than this spawn
+void Spawn::InitializeInfoPacketSharedData(Player* spawn, PacketStruct* packet) {
   int16 version = packet->GetVersion();
   if (appearance.targetable == 1 || appearance.show_level == 1 || appearance.display_name == 1) {
     if (!IsObject() && !IsGroundSpawn() && !IsWidget() && !IsSign()) {
@@ -1439,40 +1681,30 @@ void Spawn::InitializeInfoPacketData(Player* spawn, PacketStruct* packet) {
       if (GetHP() > 0)
         percent = (int8)(((float)GetHP() / GetTotalHP()) * 100);
       if (percent < 100) {
-        packet->setDataByName("hp_remaining", 100 ^ percent);
+        packet->setDataByName(field_hp_remaining, 100 ^ percent);
       } else
-        packet->setDataByName("hp_remaining", 0);
+        packet->setDataByName(field_hp_remaining, 0);
       if (GetTotalPower() > 0) {
         percent = (int8)(((float)GetPower() / GetTotalPower()) * 100);
         if (percent > 0)
-          packet->setDataByName("power_percent", percent);
+          packet->setDataByName(field_power_percent, percent);
         else
-          packet->setDataByName("power_percent", 0);
+          packet->setDataByName(field_power_percent, 0);
       }
     }
   }
-  packet->setDataByName("level", (int8)GetLevel());
-  packet->setDataByName("unknown4", (int8)GetLevel());
-  packet->setDataByName("difficulty", appearance.encounter_level);
-  packet->setDataByName("heroic_flag", appearance.heroic_flag);
+  packet->setDataByName(field_level, (int8)GetLevel());
+  packet->setDataByName(field_unknown4, (int8)GetLevel());
+  packet->setDataByName(field_difficulty, appearance.encounter_level);
+  packet->setDataByName(field_heroic_flag, appearance.heroic_flag);
 
   if (PVP::IsEnabled() && IsPlayer() && static_cast<Player*>(this)->GetGroupMemberInfo())
-    packet->setDataByName("heroic_flag", 1);
+    packet->setDataByName(field_heroic_flag, 1);
 
   if (!IsObject() && !IsGroundSpawn() && !IsWidget() && !IsSign())
-    packet->setDataByName("interaction_flag", 12); //this makes NPCs head turn to look at you
+    packet->setDataByName(field_interaction_flag, 12); //this makes NPCs head turn to look at you
 
-  if (IsPlayer() && Alive()) {
-    if (spawn->IsHostile(this)) {
-      packet->setDataByName("spawn_type", 4);
-    } else {
-      packet->setDataByName("spawn_type", 0);
-    }
-  } else {
-    packet->setDataByName("spawn_type", spawn_type);
-  }
-
-  packet->setDataByName("class", appearance.adventure_class);
+  packet->setDataByName(field_class, appearance.adventure_class);
 
   int16 model_type = appearance.model_type;
   if (GetIllusionModel() != 0) {
@@ -1484,78 +1716,78 @@ void Spawn::InitializeInfoPacketData(Player* spawn, PacketStruct* packet) {
       model_type = GetIllusionModel();
   }
 
-  packet->setDataByName("unknown600553", size_mod_a, 0);
-  packet->setDataByName("unknown600553", size_mod_b, 1);
-  packet->setDataByName("unknown600553", size_mod_c, 2);
-  packet->setDataByName("unknown600553", size_shrink_multiplier, 3);
-  packet->setDataByName("size_type", size_mod_unknown, 0);
+  packet->setDataByName(field_unknown600553, size_mod_a, 0);
+  packet->setDataByName(field_unknown600553, size_mod_b, 1);
+  packet->setDataByName(field_unknown600553, size_mod_c, 2);
+  packet->setDataByName(field_unknown600553, size_shrink_multiplier, 3);
+  packet->setDataByName(field_size_type, size_mod_unknown, 0);
 
-  packet->setDataByName("model_type", model_type);
+  packet->setDataByName(field_model_type, model_type);
   if (appearance.soga_model_type == 0)
-    packet->setDataByName("soga_model_type", model_type);
+    packet->setDataByName(field_soga_model_type, model_type);
   else
-    packet->setDataByName("soga_model_type", appearance.soga_model_type);
+    packet->setDataByName(field_soga_model_type, appearance.soga_model_type);
 
   if (GetTempActionState() >= 0)
-    packet->setDataByName("action_state", GetTempActionState());
+    packet->setDataByName(field_action_state, GetTempActionState());
   else
-    packet->setDataByName("action_state", appearance.action_state);
+    packet->setDataByName(field_action_state, appearance.action_state);
 
   if (GetTempVisualState() >= 0) {
     if (this != spawn || (GetTempVisualState() != 290 && GetTempVisualState() != 11757 && GetTempVisualState() != 11758))
-      packet->setDataByName("visual_state", GetTempVisualState());
+      packet->setDataByName(field_visual_state, GetTempVisualState());
   } else {
-    packet->setDataByName("visual_state", appearance.visual_state);
+    packet->setDataByName(field_visual_state, appearance.visual_state);
   }
-  packet->setDataByName("emote_state", appearance.emote_state);
-  packet->setDataByName("mood_state", appearance.mood_state);
-  packet->setDataByName("gender", appearance.gender);
-  packet->setDataByName("race", appearance.race);
+  packet->setDataByName(field_emote_state, appearance.emote_state);
+  packet->setDataByName(field_mood_state, appearance.mood_state);
+  packet->setDataByName(field_gender, appearance.gender);
+  packet->setDataByName(field_race, appearance.race);
   if (IsEntity()) {
     Entity* entity = ((Entity*)this);
-    packet->setDataByName("combat_voice", entity->GetCombatVoice());
-    packet->setDataByName("emote_voice", entity->GetEmoteVoice());
+    packet->setDataByName(field_combat_voice, entity->GetCombatVoice());
+    packet->setDataByName(field_emote_voice, entity->GetEmoteVoice());
     for (int i = 0; i < 25; i++) {
       if (i == 2) { //don't send helm if hidden flag
         if (IsPlayer()) {
           if (((Player*)this)->get_character_flag(CF_HIDE_HELM)) {
-            packet->setDataByName("equipment_types", 0, i);
-            packet->setColorByName("equipment_colors", 0, i);
-            packet->setColorByName("equipment_highlights", 0, i);
+            packet->setDataByName(field_equipment_types, 0, i);
+            packet->setColorByName(field_equipment_colors, 0, i);
+            packet->setColorByName(field_equipment_highlights, 0, i);
             continue;
           }
         }
         if (IsBot()) {
           if (!((Bot*)this)->ShowHelm) {
-            packet->setDataByName("equipment_types", 0, i);
-            packet->setColorByName("equipment_colors", 0, i);
-            packet->setColorByName("equipment_highlights", 0, i);
+            packet->setDataByName(field_equipment_types, 0, i);
+            packet->setColorByName(field_equipment_colors, 0, i);
+            packet->setColorByName(field_equipment_highlights, 0, i);
             continue;
           }
         }
       } else if (i == 19) { //don't send cloak if hidden
         if (IsPlayer()) {
           if (!((Player*)this)->get_character_flag(CF_SHOW_CLOAK)) {
-            packet->setDataByName("equipment_types", 0, i);
-            packet->setColorByName("equipment_colors", 0, i);
-            packet->setColorByName("equipment_highlights", 0, i);
+            packet->setDataByName(field_equipment_types, 0, i);
+            packet->setColorByName(field_equipment_colors, 0, i);
+            packet->setColorByName(field_equipment_highlights, 0, i);
             continue;
           }
         }
         if (IsBot()) {
           if (!((Bot*)this)->ShowCloak) {
-            packet->setDataByName("equipment_types", 0, i);
-            packet->setColorByName("equipment_colors", 0, i);
-            packet->setColorByName("equipment_highlights", 0, i);
+            packet->setDataByName(field_equipment_types, 0, i);
+            packet->setColorByName(field_equipment_colors, 0, i);
+            packet->setColorByName(field_equipment_highlights, 0, i);
             continue;
           }
         }
       }
-      packet->setDataByName("equipment_types", entity->equipment.equip_id[i], i);
-      packet->setColorByName("equipment_colors", entity->equipment.color[i], i);
-      packet->setColorByName("equipment_highlights", entity->equipment.highlight[i], i);
+      packet->setDataByName(field_equipment_types, entity->equipment.equip_id[i], i);
+      packet->setColorByName(field_equipment_colors, entity->equipment.color[i], i);
+      packet->setColorByName(field_equipment_highlights, entity->equipment.highlight[i], i);
     }
-    packet->setDataByName("mount_type", entity->GetMount());
+    packet->setDataByName(field_mount_type, entity->GetMount());
 
     // find the visual flags
     int8 vis_flag = 0;
@@ -1572,68 +1804,63 @@ void Spawn::InitializeInfoPacketData(Player* spawn, PacketStruct* packet) {
     if ((IsPlayer() && ((Player*)this)->get_character_flag(CF_HIDE_HOOD)) || appearance.hide_hood)
       vis_flag += INFO_VIS_FLAG_HIDE_HOOD;
 
-    packet->setDataByName("visual_flag", vis_flag);
-    packet->setColorByName("mount_saddle_color", entity->GetMountSaddleColor());
-    packet->setColorByName("mount_color", entity->GetMountColor());
-    packet->setDataByName("hair_type_id", entity->features.hair_type);
-    packet->setDataByName("chest_type_id", entity->features.chest_type);
-    packet->setDataByName("wing_type_id", entity->features.wing_type);
-    packet->setDataByName("legs_type_id", entity->features.legs_type);
-    packet->setDataByName("soga_hair_type_id", entity->features.soga_hair_type);
-    packet->setDataByName("facial_hair_type_id", entity->features.hair_face_type);
-    packet->setDataByName("soga_facial_hair_type_id", entity->features.soga_hair_face_type);
+    packet->setDataByName(field_visual_flag, vis_flag);
+    packet->setColorByName(field_mount_saddle_color, entity->GetMountSaddleColor());
+    packet->setColorByName(field_mount_color, entity->GetMountColor());
+    packet->setDataByName(field_hair_type_id, entity->features.hair_type);
+    packet->setDataByName(field_chest_type_id, entity->features.chest_type);
+    packet->setDataByName(field_wing_type_id, entity->features.wing_type);
+    packet->setDataByName(field_legs_type_id, entity->features.legs_type);
+    packet->setDataByName(field_soga_hair_type_id, entity->features.soga_hair_type);
+    packet->setDataByName(field_facial_hair_type_id, entity->features.hair_face_type);
+    packet->setDataByName(field_soga_facial_hair_type_id, entity->features.soga_hair_face_type);
     for (int i = 0; i < 3; i++) {
-      packet->setDataByName("eye_type", entity->features.eye_type[i], i);
-      packet->setDataByName("ear_type", entity->features.ear_type[i], i);
-      packet->setDataByName("eye_brow_type", entity->features.eye_brow_type[i], i);
-      packet->setDataByName("cheek_type", entity->features.cheek_type[i], i);
-      packet->setDataByName("lip_type", entity->features.lip_type[i], i);
-      packet->setDataByName("chin_type", entity->features.chin_type[i], i);
-      packet->setDataByName("nose_type", entity->features.nose_type[i], i);
-      packet->setDataByName("soga_eye_type", entity->features.soga_eye_type[i], i);
-      packet->setDataByName("soga_ear_type", entity->features.soga_ear_type[i], i);
-      packet->setDataByName("soga_eye_brow_type", entity->features.soga_eye_brow_type[i], i);
-      packet->setDataByName("soga_cheek_type", entity->features.soga_cheek_type[i], i);
-      packet->setDataByName("soga_lip_type", entity->features.soga_lip_type[i], i);
-      packet->setDataByName("soga_chin_type", entity->features.soga_chin_type[i], i);
-      packet->setDataByName("soga_nose_type", entity->features.soga_nose_type[i], i);
-    }
-    packet->setColorByName("skin_color", entity->features.skin_color);
-    packet->setColorByName("eye_color", entity->features.eye_color);
-    packet->setColorByName("hair_type_color", entity->features.hair_type_color);
-    packet->setColorByName("hair_type_highlight_color", entity->features.hair_type_highlight_color);
-    packet->setColorByName("hair_face_color", entity->features.hair_face_color);
-    packet->setColorByName("hair_face_highlight_color", entity->features.hair_face_highlight_color);
-    packet->setColorByName("hair_highlight", entity->features.hair_highlight_color);
-    packet->setColorByName("wing_color1", entity->features.wing_color1);
-    packet->setColorByName("wing_color2", entity->features.wing_color2);
-    packet->setColorByName("hair_color1", entity->features.hair_color1);
-    packet->setColorByName("hair_color2", entity->features.hair_color2);
-    packet->setColorByName("soga_skin_color", entity->features.soga_skin_color);
-    packet->setColorByName("soga_eye_color", entity->features.soga_eye_color);
-    packet->setColorByName("soga_hair_color1", entity->features.soga_hair_color1);
-    packet->setColorByName("soga_hair_color2", entity->features.soga_hair_color2);
-    packet->setColorByName("soga_hair_type_color", entity->features.soga_hair_type_color);
-    packet->setColorByName("soga_hair_type_highlight_color", entity->features.soga_hair_type_highlight_color);
-    packet->setColorByName("soga_hair_face_color", entity->features.soga_hair_face_color);
-    packet->setColorByName("soga_hair_face_highlight_color", entity->features.soga_hair_face_highlight_color);
-    packet->setColorByName("soga_hair_highlight", entity->features.soga_hair_highlight_color);
-
-    packet->setDataByName("body_age", entity->features.body_age);
-
-    if (spawn->IsHostile(this)) {
-      packet->setDataByName("unknown5", 1);
-      packet->setDataByName("unknown7", 255);
-    }
+      packet->setDataByName(field_eye_type, entity->features.eye_type[i], i);
+      packet->setDataByName(field_ear_type, entity->features.ear_type[i], i);
+      packet->setDataByName(field_eye_brow_type, entity->features.eye_brow_type[i], i);
+      packet->setDataByName(field_cheek_type, entity->features.cheek_type[i], i);
+      packet->setDataByName(field_lip_type, entity->features.lip_type[i], i);
+      packet->setDataByName(field_chin_type, entity->features.chin_type[i], i);
+      packet->setDataByName(field_nose_type, entity->features.nose_type[i], i);
+      packet->setDataByName(field_soga_eye_type, entity->features.soga_eye_type[i], i);
+      packet->setDataByName(field_soga_ear_type, entity->features.soga_ear_type[i], i);
+      packet->setDataByName(field_soga_eye_brow_type, entity->features.soga_eye_brow_type[i], i);
+      packet->setDataByName(field_soga_cheek_type, entity->features.soga_cheek_type[i], i);
+      packet->setDataByName(field_soga_lip_type, entity->features.soga_lip_type[i], i);
+      packet->setDataByName(field_soga_chin_type, entity->features.soga_chin_type[i], i);
+      packet->setDataByName(field_soga_nose_type, entity->features.soga_nose_type[i], i);
+    }
+    packet->setColorByName(field_skin_color, entity->features.skin_color);
+    packet->setColorByName(field_eye_color, entity->features.eye_color);
+    packet->setColorByName(field_hair_type_color, entity->features.hair_type_color);
+    packet->setColorByName(field_hair_type_highlight_color, entity->features.hair_type_highlight_color);
+    packet->setColorByName(field_hair_face_color, entity->features.hair_face_color);
+    packet->setColorByName(field_hair_face_highlight_color, entity->features.hair_face_highlight_color);
+    packet->setColorByName(field_hair_highlight, entity->features.hair_highlight_color);
+    packet->setColorByName(field_wing_color1, entity->features.wing_color1);
+    packet->setColorByName(field_wing_color2, entity->features.wing_color2);
+    packet->setColorByName(field_hair_color1, entity->features.hair_color1);
+    packet->setColorByName(field_hair_color2, entity->features.hair_color2);
+    packet->setColorByName(field_soga_skin_color, entity->features.soga_skin_color);
+    packet->setColorByName(field_soga_eye_color, entity->features.soga_eye_color);
+    packet->setColorByName(field_soga_hair_color1, entity->features.soga_hair_color1);
+    packet->setColorByName(field_soga_hair_color2, entity->features.soga_hair_color2);
+    packet->setColorByName(field_soga_hair_type_color, entity->features.soga_hair_type_color);
+    packet->setColorByName(field_soga_hair_type_highlight_color, entity->features.soga_hair_type_highlight_color);
+    packet->setColorByName(field_soga_hair_face_color, entity->features.soga_hair_face_color);
+    packet->setColorByName(field_soga_hair_face_highlight_color, entity->features.soga_hair_face_highlight_color);
+    packet->setColorByName(field_soga_hair_highlight, entity->features.soga_hair_highlight_color);
+
+    packet->setDataByName(field_body_age, entity->features.body_age);
   } else {
     EQ2_Color empty;
     empty.red = 255;
     empty.blue = 255;
     empty.green = 255;
-    packet->setColorByName("skin_color", empty);
-    packet->setColorByName("eye_color", empty);
-    packet->setColorByName("soga_skin_color", empty);
-    packet->setColorByName("soga_eye_color", empty);
+    packet->setColorByName(field_skin_color, empty);
+    packet->setColorByName(field_eye_color, empty);
+    packet->setColorByName(field_soga_skin_color, empty);
+    packet->setColorByName(field_soga_eye_color, empty);
   }
 
   /*if (appearance.icon == 0) {
@@ -1672,7 +1899,7 @@ void Spawn::InitializeInfoPacketData(Player* spawn, PacketStruct* packet) {
       temp_icon += 12; // add the CoE icon
     }
   }
-  packet->setDataByName("icon", temp_icon); //appearance.icon);
+  packet->setDataByName(field_icon, temp_icon); //appearance.icon);
 
   int16 temp_activity_status = 0;
   int32 temp_activity_timer = 0;
@@ -1754,21 +1981,16 @@ void Spawn::InitializeInfoPacketData(Player* spawn, PacketStruct* packet) {
   } else
     temp_activity_status = appearance.activity_status;
 
-  packet->setDataByName("activity_status", temp_activity_status);
-  packet->setDataByName("activity_timer", temp_activity_timer);
+  packet->setDataByName(field_activity_status, temp_activity_status);
+  packet->setDataByName(field_activity_timer, temp_activity_timer);
 
   // If player and player has a follow target
   if (IsPlayer()) {
     if (((Player*)this)->GetFollowTarget())
-      packet->setDataByName("follow_target", ((((Player*)this)->GetIDWithPlayerSpawn(((Player*)this)->GetFollowTarget()) * -1) - 1));
+      packet->setDataByName(field_follow_target, ((((Player*)this)->GetIDWithPlayerSpawn(((Player*)this)->GetFollowTarget()) * -1) - 1));
     else
-      packet->setDataByName("follow_target", 0);
+      packet->setDataByName(field_follow_target, 0);
   }
-  if (GetTarget() && GetTarget()->GetTargetable())
-    packet->setDataByName("target_id", ((spawn->GetIDWithPlayerSpawn(GetTarget()) * -1) - 1));
-  else
-    packet->setDataByName("target_id", 0);
-
   //Send spell effects for target window
   if (IsEntity()) {
     InfoStruct* info = ((Entity*)this)->GetInfoStruct();
@@ -1855,6 +2077,7 @@ void Spawn::ProcessMovement() {
       SetX(boat->GetX() + player->GetBoatX());
       SetY(boat->GetY() + player->GetBoatY());
       SetZ(boat->GetZ() + player->GetBoatZ());
+      UpdateGridCell();
     }
     return;
   }
@@ -2211,14 +2434,9 @@ bool Spawn::CalculateChange() {
         SetY(ny + tar_vy, false);
         SetZ(nz + tar_vz, false);
       }
+      UpdateGridCell();
 
       if (GetZone()->Grid != nullptr) {
-        Cell* newCell = GetZone()->Grid->GetCell(GetX(), GetZ());
-        if (newCell != Cell_Info.CurrentCell) {
-          GetZone()->Grid->RemoveSpawnFromCell(this);
-          GetZone()->Grid->AddSpawn(this, newCell);
-        }
-
         int32 newGrid = GetZone()->Grid->GetGridID(this);
         if (newGrid != appearance.pos.grid_id) {
           SetPos(&(appearance.pos.grid_id), newGrid);
@@ -2446,6 +2664,12 @@ int32 Spawn::GetSpawnGroupID() {
 }
 
 void Spawn::AddSpawnUpdate(bool info_changed, bool pos_changed, bool vis_changed) {
+  // Invalidates the shared serialized copies, callers have already written the change
+  if (info_changed)
+    info_revision++;
+  if (pos_changed)
+    pos_revision++;
+
   if (GetZone()) {
     GetZone()->AddSpawnUpdate(GetID(), info_changed, pos_changed, vis_changed);
   }
@@ -19,6 +19,7 @@
 */
 #pragma once
 
+#include <atomic>
 #include <deque>
 #include <vector>
 #include "../common/ConfigReader.h"
@@ -212,6 +213,15 @@ struct SpawnData {
   int32 size;
 };
 
+// A spawn substruct serialized once per update tick and shared by every viewer on the same struct version
+struct SerializedSpawnData {
+  int32 tick;
+  int32 revision;
+  string data;
+  // field name -> offset/length of the viewer specific fields patched into each viewer's copy
+  map<string, pair<int32, int32>> viewer_offsets;
+};
+
 class Spawn {
 public:
   Spawn();
@@ -232,20 +242,23 @@ public:
 
   template <class Field, class Value>
   void SetPos(Field* field, Value value, bool setUpdateFlags = true) {
-    if (setUpdateFlags) {
-      AddSpawnUpdate(false, true, false);
-    }
-
     Set(field, value, setUpdateFlags);
+
+    // after the write, so a shared copy built from the old value is not kept
+    if (setUpdateFlags)
+      AddSpawnUpdate(false, true, false);
+    else
+      pos_revision++;
   }
 
   template <class Field, class Value>
   void SetInfo(Field* field, Value value, bool setUpdateFlags = true) {
-    if (setUpdateFlags) {
-      AddSpawnUpdate(true, false, false);
-    }
-
     Set(field, value);
+
+    if (setUpdateFlags)
+      AddSpawnUpdate(true, false, false);
+    else
+      info_revision++;
   }
 
   template <class Field, class Value>
@@ -259,20 +272,22 @@ public:
 
   template <class Field>
   void SetPos(Field* field, char* value, bool setUpdateFlags = true) {
-    if (setUpdateFlags) {
-      AddSpawnUpdate(false, true, false);
-    }
-
     Set(field, value, setUpdateFlags);
+
+    if (setUpdateFlags)
+      AddSpawnUpdate(false, true, false);
+    else
+      pos_revision++;
   }
 
   template <class Field>
   void SetInfo(Field* field, char* value, bool setUpdateFlags = true) {
-    if (setUpdateFlags) {
-      AddSpawnUpdate(true, false, false);
-    }
-
     Set(field, value);
+
+    if (setUpdateFlags)
+      AddSpawnUpdate(true, false, false);
+    else
+      info_revision++;
   }
 
   EntityCommand* CreateEntityCommand(EntityCommand* old_command) {
@@ -885,8 +900,13 @@ public:
   int32 GetTransporterID();
   bool MeetsSpawnAccessRequirements(Player* player);
 
+  // Moves the spawn to its new SPGrid cell, call once after both X and Z have changed
+  void UpdateGridCell();
+
   void InitializePosPacketData(Player* player, PacketStruct* packet);
   void InitializeInfoPacketData(Player* player, PacketStruct* packet);
+  void InitializeInfoPacketSharedData(Player* player, PacketStruct* packet);
+  void InitializeInfoPacketViewerData(Player* player, PacketStruct* packet);
   void InitializeVisPacketData(Player* player, PacketStruct* packet);
   void InitializeHeaderPacketData(Player* player, PacketStruct* packet, int16 index);
   void InitializeFooterPacketData(Player* player, PacketStruct* packet);
@@ -1057,4 +1077,12 @@ private:
   int16 m_illusionModel;
 
   Mutex m_Update;
+
+  // Serialized info/pos structs keyed by struct version, see GetSharedPacketData()
+  void GetSharedPacketData(Player* player, PacketStruct* packet, bool info, string& output);
+  map<int16, SerializedSpawnData> shared_info_data;
+  map<int16, SerializedSpawnData> shared_pos_data;
+  atomic<int32> info_revision;
+  atomic<int32> pos_revision;
+  Mutex MSharedPacketData;
 };
\ No newline at end of file
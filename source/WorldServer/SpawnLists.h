@@ -67,6 +67,12 @@ public:
       safe_delete(entities[i]);
   }
   void AddSpawn(SpawnEntry* entity) { entities.push_back(entity); }
+  SpawnLocation* Copy() {
+    SpawnLocation* ret = new SpawnLocation(*this);
+    for (int32 i = 0; i < ret->entities.size(); i++)
+      ret->entities[i] = new SpawnEntry(*entities[i]);
+    return ret;
+  }
   vector<SpawnEntry*> entities;
   float x;
   float y;
@@ -524,7 +524,7 @@ bool SpellProcess::ProcessSpell(shared_ptr<LuaSpell> spell, Spawn* target, bool
       }
       }
     }
-    ret = lua_interface->CallSpellProcess(spell, 2 + data.size());
+    ret = lua_interface->CallSpellProcess(spell, 2 + data.size(), function ? function : (first_cast ? "cast" : "tick"));
   }
 
   return ret;
@@ -1188,7 +1188,13 @@ void SpellProcess::ProcessSpell(ZoneServer* zone, Spell* spell, Entity* caster,
 
         lua_interface->AddSpawnPointers(lua_spell.get(), false, true);
 
-        if (lua_pcall(lua_spell->state, 2, 2, 0) == 0) {
+        int lua_ret = 0;
+        {
+          LuaProfileScope profile(lua_interface->GetProfiler(), lua_spell->file_name.c_str(), "precast");
+          lua_ret = lua_pcall(lua_spell->state, 2, 2, 0);
+        }
+
+        if (lua_ret == 0) {
           result = lua_interface->GetBooleanValue(lua_spell->state, 1);
           int8 error = lua_interface->GetInt8Value(lua_spell->state, 2) == 0 ? SPELL_ERROR_CANNOT_PREPARE : lua_interface->GetInt8Value(lua_spell->state, 2);
           lua_interface->ResetFunctionStack(lua_spell->state);
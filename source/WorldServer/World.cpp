@@ -100,7 +100,6 @@ World::World() : save_time_timer(300000), time_tick_timer(3000), vitality_timer(
   ts_xp_rate = -1;
   vitality_frequency = 0xFFFFFFFF;
   vitality_amount = -1;
-  last_checked_time = 0;
   items_loaded = false;
   spells_loaded = false;
   achievments_loaded = false;
@@ -238,11 +237,6 @@ float World::GetTSXPRate() {
 }
 
 void World::Process() {
-  if (last_checked_time > Timer::GetCurrentTime2())
-    return;
-
-  last_checked_time = Timer::GetCurrentTime2() + 1000;
-
   if (save_time_timer.Check())
     database.SaveWorldTime(&world_time);
 
@@ -389,7 +383,7 @@ ZoneList::~ZoneList() {
 
 void ZoneList::CheckFriendList(const shared_ptr<Client>& client) {
   LogWrite(WORLD__DEBUG, 0, "World", "Sending FriendList...");
-  MClientList.lock();
+  shared_lock<shared_timed_mutex> guard(client_map_mutex);
   map<string, shared_ptr<Client>>::iterator itr;
   for (itr = client_map.begin(); itr != client_map.end(); itr++) {
     if (itr->second != client && itr->second) {
@@ -399,11 +393,10 @@ void ZoneList::CheckFriendList(const shared_ptr<Client>& client) {
       }
     }
   }
-  MClientList.unlock();
 }
 
 void ZoneList::CheckFriendZoned(const shared_ptr<Client>& client) {
-  MClientList.lock();
+  shared_lock<shared_timed_mutex> guard(client_map_mutex);
   map<string, shared_ptr<Client>>::iterator itr;
   for (itr = client_map.begin(); itr != client_map.end(); itr++) {
     if (itr->second != client && itr->second) {
@@ -412,7 +405,6 @@ void ZoneList::CheckFriendZoned(const shared_ptr<Client>& client) {
       }
     }
   }
-  MClientList.unlock();
 }
 
 bool ZoneList::HandleGlobalChatMessage(const shared_ptr<Client>& from, char* to, int16 channel, const char* message, const char* channel_name) {
@@ -605,6 +597,28 @@ ZoneServer* ZoneList::Get(int32 id, bool loadZone) {
   return tmp;
 }
 
+void ZoneList::Prewarm(int32 zone_id) {
+  // instances are created for their players when they zone in
+  if (zone_id == 0 || database.GetInstanceTypeByZoneID(zone_id) != NONE)
+    return;
+
+  list<ZoneServer*>::iterator zone_iter;
+  bool loaded = false;
+  MZoneList.readlock(__FUNCTION__, __LINE__);
+  for (zone_iter = zlist.begin(); zone_iter != zlist.end(); zone_iter++) {
+    if (!(*zone_iter)->isZoneShuttingDown() && (*zone_iter)->GetZoneID() == zone_id) {
+      loaded = true;
+      break;
+    }
+  }
+  MZoneList.releasereadlock(__FUNCTION__, __LINE__);
+
+  if (!loaded) {
+    LogWrite(ZONE__INFO, 0, "Zone", "Prewarming zone %u", zone_id);
+    Get(zone_id);
+  }
+}
+
 void ZoneList::SendZoneList(const shared_ptr<Client>& client) {
   list<ZoneServer*>::iterator zone_iter;
   ZoneServer* tmp = 0;
@@ -684,28 +698,105 @@ ZoneServer* ZoneList::GetByLowestPopulation(int32 zone_id) {
 }
 
 bool ZoneList::ClientConnected(int32 account_id) {
-  bool ret = false;
-  map<string, shared_ptr<Client>>::iterator itr;
-  MClientList.lock();
-  for (itr = client_map.begin(); itr != client_map.end(); itr++) {
-    if (itr->second && itr->second->GetAccountID() == account_id && (itr->second->GetPlayer()->GetActivityStatus() & ACTIVITY_STATUS_LINKDEAD) == 0) {
-      ret = true;
+  shared_lock<shared_timed_mutex> guard(client_map_mutex);
+
+  auto range = client_account_ids.equal_range(account_id);
+  for (auto itr = range.first; itr != range.second; itr++) {
+    if (itr->second->GetAccountID() == account_id && (itr->second->GetPlayer()->GetActivityStatus() & ACTIVITY_STATUS_LINKDEAD) == 0)
+      return true;
+  }
+
+  return false;
+}
+
+void ZoneList::AddClientToMap(string name, shared_ptr<Client> client) {
+  if (!client)
+    return;
+
+  name = ToLower(name);
+  unique_lock<shared_timed_mutex> guard(client_map_mutex);
+
+  auto itr = client_map.find(name);
+  if (itr != client_map.end())
+    RemoveClientIndexes(itr->second);
+
+  client_map[name] = client;
+  client_char_ids[client->GetCharacterID()] = client;
+  client_account_ids.insert(make_pair(client->GetAccountID(), client));
+  if (client->getConnection())
+    client_streams[client->getConnection()] = client;
+}
+
+void ZoneList::RemoveClientFromMap(string name) {
+  name = ToLower(name);
+  unique_lock<shared_timed_mutex> guard(client_map_mutex);
+
+  auto itr = client_map.find(name);
+  if (itr != client_map.end()) {
+    RemoveClientIndexes(itr->second);
+    client_map.erase(itr);
+  }
+}
+
+// client_map_mutex must be held for writing
+void ZoneList::RemoveClientIndexes(const shared_ptr<Client>& client) {
+  // the entries may already belong to a newer client for the same character or stream
+  auto char_itr = client_char_ids.find(client->GetCharacterID());
+  if (char_itr != client_char_ids.end() && char_itr->second == client)
+    client_char_ids.erase(char_itr);
+
+  auto range = client_account_ids.equal_range(client->GetAccountID());
+  for (auto itr = range.first; itr != range.second; itr++) {
+    if (itr->second == client) {
+      client_account_ids.erase(itr);
       break;
-    } else if (!itr->second) {
-      client_map.erase(itr);
-      if (client_map.size() > 0) {
-        itr = client_map.begin();
-        if (itr == client_map.end()) {
-          if (itr->second && itr->second->GetAccountID() == account_id && (itr->second->GetPlayer()->GetActivityStatus() & ACTIVITY_STATUS_LINKDEAD) == 0)
-            ret = true;
-          break;
-        }
-      } else
+    }
+  }
+
+  // the client may have dropped its stream already, then it has to be searched for
+  auto stream_itr = client->getConnection() ? client_streams.find(client->getConnection()) : client_streams.end();
+  if (stream_itr == client_streams.end() || stream_itr->second != client) {
+    for (stream_itr = client_streams.begin(); stream_itr != client_streams.end(); stream_itr++) {
+      if (stream_itr->second == client)
         break;
     }
   }
-  MClientList.unlock();
-  return ret;
+  if (stream_itr != client_streams.end())
+    client_streams.erase(stream_itr);
+}
+
+shared_ptr<Client> ZoneList::GetClientByCharID(int32 id) {
+  shared_lock<shared_timed_mutex> guard(client_map_mutex);
+
+  auto itr = client_char_ids.find(id);
+  if (itr != client_char_ids.end())
+    return itr->second;
+
+  return nullptr;
+}
+
+shared_ptr<Client> ZoneList::GetClientByAccountID(int32 account_id) {
+  shared_lock<shared_timed_mutex> guard(client_map_mutex);
+
+  auto itr = client_account_ids.find(account_id);
+  if (itr != client_account_ids.end())
+    return itr->second;
+
+  return nullptr;
+}
+
+shared_ptr<Client> ZoneList::GetClientByEQStream(EQStream* eqs) {
+  if (!eqs)
+    return nullptr;
+
+  shared_lock<shared_timed_mutex> guard(client_map_mutex);
+
+  // a client drops its stream when it disconnects, so make sure it still owns it
+  auto itr = client_streams.find(eqs);
+  if (itr != client_streams.end() && itr->second->getConnection() == eqs)
+    return itr->second;
+
+  return nullptr;
 }
 
 void ZoneList::ReloadClientQuests() {
@@ -1015,12 +1106,11 @@ void ZoneList::ShutDownZones() {
 
 void ZoneList::ReloadMail() {
   map<string, shared_ptr<Client>>::iterator itr;
-  MClientList.writelock(__FUNCTION__, __LINE__);
+  shared_lock<shared_timed_mutex> guard(client_map_mutex);
   for (itr = client_map.begin(); itr != client_map.end(); itr++) {
     itr->second->GetPlayer()->DeleteMail();
     database.LoadPlayerMail(itr->second);
   }
-  MClientList.releasewritelock(__FUNCTION__, __LINE__);
 }
 
 void World::AddSpawnScript(int32 id, const char* name) {
@@ -24,6 +24,8 @@
 #include <vector>
 #include <map>
 #include <list>
+#include <unordered_map>
+#include <shared_mutex>
 #include "SpawnLists.h"
 #include "zoneserver.h"
 #include "NPC.h"
@@ -286,18 +288,15 @@ public:
   ZoneServer* Get(int32 id, bool loadZone = true);
   ZoneServer* Get(const char* zone_name, bool loadZone = true);
   ZoneServer* GetByInstanceID(int32 id, int32 zone_id = 0);
+  // Starts loading a zone in the background if no copy of it is running
+  void Prewarm(int32 zone_id);
 
   /// <summary>Get the instance for the given zone id with the lowest population</summary>
   /// <param name='zone_id'>The id of the zone to look up</param>
   /// <returns>ZoneServer* of an active zone with the given id</returns>
   ZoneServer* GetByLowestPopulation(int32 zone_id);
 
-  void AddClientToMap(string name, shared_ptr<Client> client) {
-    name = ToLower(name);
-    MClientList.lock();
-    client_map[name] = client;
-    MClientList.unlock();
-  }
+  void AddClientToMap(string name, shared_ptr<Client> client);
   void CheckFriendList(const shared_ptr<Client>& client);
   void CheckFriendZoned(const shared_ptr<Client>& client);
 
@@ -311,48 +310,18 @@ public:
 
   shared_ptr<Client> GetClientByCharName(string name) {
     name = ToLower(name);
-    shared_ptr<Client> ret = nullptr;
-
-    MClientList.lock();
-    if (client_map.count(name) > 0) {
-      ret = client_map[name];
-    }
-    MClientList.unlock();
-
-    return ret;
-  }
+    shared_lock<shared_timed_mutex> guard(client_map_mutex);
 
-  shared_ptr<Client> GetClientByCharID(int32 id) {
-    shared_ptr<Client> ret = nullptr;
+    auto itr = client_map.find(name);
+    if (itr != client_map.end())
+      return itr->second;
 
-    MClientList.lock();
-    for (auto itr = client_map.begin(); itr != client_map.end(); itr++) {
-      if (itr->second->GetCharacterID() == id) {
-        ret = itr->second;
-        break;
-      }
-    }
-    MClientList.unlock();
-
-    return ret;
+    return nullptr;
   }
 
-  shared_ptr<Client> GetClientByEQStream(EQStream* eqs) {
-    shared_ptr<Client> ret = nullptr;
-
-    if (eqs) {
-      MClientList.lock();
-      for (auto itr = client_map.begin(); itr != client_map.end(); itr++) {
-        if (itr->second->getConnection() == eqs) {
-          ret = itr->second;
-          break;
-        }
-      }
-      MClientList.unlock();
-    }
-
-    return ret;
-  }
+  shared_ptr<Client> GetClientByCharID(int32 id);
+  shared_ptr<Client> GetClientByAccountID(int32 account_id);
+  shared_ptr<Client> GetClientByEQStream(EQStream* eqs);
 
   shared_ptr<Client> GetInactiveClientByCharID(int32 id) {
     lock_guard<mutex> guard(client_timeouts_mutex);
@@ -373,15 +342,7 @@ public:
     lock_guard<mutex> guard(client_timeouts_mutex);
     client_timeouts.insert(make_pair<shared_ptr<Client>&, int32>(client, Timer::GetUnixTimeStamp() + timeout));
   }
-  void RemoveClientFromMap(string name) {
-    name = ToLower(name);
-
-    MClientList.lock();
-    if (client_map.count(name) > 0) {
-      client_map.erase(name);
-    }
-    MClientList.unlock();
-  }
+  void RemoveClientFromMap(string name);
   bool ClientConnected(int32 account_id);
   void ReloadClientQuests();
   bool DepopFinished();
@@ -400,12 +361,18 @@ public:
   void CheckClientTimeouts();
 
 private:
-  Mutex MClientList;
+  void RemoveClientIndexes(const shared_ptr<Client>& client);
+
+  shared_timed_mutex client_map_mutex;
   Mutex MZoneList;
   mutex client_timeouts_mutex;
 
   map<ZoneServer*, int32> removed_zoneservers;
   map<string, shared_ptr<Client>> client_map;
+  // lookups by character id, account id and stream, kept in sync with client_map
+  unordered_map<int32, shared_ptr<Client>> client_char_ids;
+  unordered_multimap<int32, shared_ptr<Client>> client_account_ids;
+  unordered_map<EQStream*, shared_ptr<Client>> client_streams;
   map<shared_ptr<Client>, int32> client_timeouts;
   list<ZoneServer*> zlist;
 };
@@ -547,7 +514,6 @@ private:
   //map<string, string> pending_groups;
   map<int32, Statistic*> server_statistics;
   MutexMap<int32, LottoPlayer*> lotto_players;
-  int32 last_checked_time;
   Timer save_time_timer;
   Timer time_tick_timer;
   Timer vitality_timer;
@@ -68,6 +68,7 @@ extern RuleManager rule_manager;
 extern MasterLanguagesList master_languages_list;
 
 WorldDatabase::WorldDatabase() {
+  memset(&save_stats, 0, sizeof(save_stats));
 }
 
 WorldDatabase::~WorldDatabase() {
@@ -121,7 +122,7 @@ void WorldDatabase::LoadBuyBacks(const shared_ptr<Client>& client) {
   }
 }
 
-void WorldDatabase::SaveBuyBacks(const shared_ptr<Client>& client) {
+void WorldDatabase::SaveBuyBacks(const shared_ptr<Client>& client, QueryBatch& batch) {
   LogWrite(MERCHANT__DEBUG, 3, "Merchant", "Saving Buybacks - Player: %u", client->GetCharacterID());
 
   deque<BuyBackItem*>* buybacks = client->GetBuyBacks();
@@ -129,16 +130,28 @@ void WorldDatabase::SaveBuyBacks(const shared_ptr<Client>& client) {
   if (buybacks && buybacks->size() > 0) {
     BuyBackItem* item = 0;
     deque<BuyBackItem*>::iterator itr;
+    set<BuyBackItem*> saved;
 
     for (itr = buybacks->begin(); itr != buybacks->end(); itr++) {
       item = *itr;
 
       if (item && item->save_needed) {
         LogWrite(MERCHANT__DEBUG, 5, "Merchant", "SaveBuyBack: char: %u, item: %u, qty: %i, price: %u", client->GetCharacterID(), item->item_id, item->quantity, item->price);
-        SaveBuyBack(client->GetCharacterID(), item->item_id, item->quantity, item->price);
+        batch.AddRow("character_buyback", "char_id, item_id, quantity, price", nullptr, "%u, %u, %i, %u", client->GetCharacterID(), item->item_id, item->quantity, item->price);
         item->save_needed = false;
+        saved.insert(item);
       }
     }
+
+    // only buybacks still in the list are touched, the others have been deleted
+    if (!saved.empty()) {
+      batch.OnFailure([buybacks, saved]() {
+        for (BuyBackItem* item : *buybacks) {
+          if (saved.count(item) > 0)
+            item->save_needed = true;
+        }
+      });
+    }
   }
 }
 
@@ -262,7 +275,7 @@ void WorldDatabase::DeleteCharacterActiveSpells(const shared_ptr<Client>& client
   }
 }
 
-void WorldDatabase::SavePlayerSpells(const shared_ptr<Client>& client) {
+void WorldDatabase::SavePlayerSpells(const shared_ptr<Client>& client, QueryBatch& batch) {
   if (!client)
     return;
 
@@ -272,16 +285,27 @@ void WorldDatabase::SavePlayerSpells(const shared_ptr<Client>& client) {
   if (spells) {
     vector<SpellBookEntry*>::iterator itr;
     SpellBookEntry* spell = 0;
+    vector<int32> saved;
 
     for (itr = spells->begin(); itr != spells->end(); itr++) {
       spell = *itr;
-      Query query;
       LogWrite(SPELL__DEBUG, 5, "Spells", "\tSaving SpellID: %u, tier: %i, slot: %i", spell->spell_id, spell->tier, spell->slot);
-      query.RunQuery2(Q_INSERT, "INSERT INTO character_spells (char_id, spell_id, tier) SELECT %u, %u, %i ON DUPLICATE KEY UPDATE tier = %i",
-                      client->GetPlayer()->GetCharacterID(), spell->spell_id, spell->tier, spell->tier);
+      batch.AddRow("character_spells", "char_id, spell_id, tier", "tier = VALUES(tier)", "%u, %u, %i", client->GetPlayer()->GetCharacterID(), spell->spell_id, spell->tier);
       spell->save_needed = false;
+      saved.push_back(spell->spell_id);
     }
     safe_delete(spells);
+
+    if (!saved.empty()) {
+      Player* player = client->GetPlayer();
+      batch.OnFailure([player, saved]() {
+        for (int32 spell_id : saved) {
+          SpellBookEntry* spell = player->GetSpellBookSpell(spell_id);
+          if (spell)
+            spell->save_needed = true;
+        }
+      });
+    }
   }
 }
 
@@ -2209,56 +2233,83 @@ void WorldDatabase::DeleteCharacterQuest(int32 quest_id, int32 char_id, bool rep
     LogWrite(DATABASE__ERROR, 0, "DBNew", "Error (%u) in DeleteCharacterQuest query:\n%s", database_new.GetError(), database_new.GetErrorMsg());
 }
 
-void WorldDatabase::SaveCharacterSkills(const shared_ptr<Client>& client) {
+void WorldDatabase::SaveCharacterSkills(const shared_ptr<Client>& client, QueryBatch& batch) {
   vector<Skill*>* skills = client->GetPlayer()->GetSkills()->GetSaveNeededSkills();
   if (skills) {
-    Query query;
-    if (skills->size() > 0) {
-      Skill* skill = 0;
-      for (int32 i = 0; i < skills->size(); i++) {
-        skill = skills->at(i);
-        query.RunQuery2(Q_REPLACE, "replace into character_skills (char_id, skill_id, current_val, max_val) values(%u, %u, %i, %i)", client->GetCharacterID(), skill->skill_id, skill->current_val, skill->max_val);
-      }
-      if (query.GetErrorNumber() && query.GetError() && query.GetErrorNumber() < 0xFFFFFFFF)
-        LogWrite(WORLD__ERROR, 0, "World", "Error in SaveCharacterSkills query '%s': %s", query.GetQuery(), query.GetError());
+    Skill* skill = 0;
+    vector<int32> saved;
+    for (int32 i = 0; i < skills->size(); i++) {
+      skill = skills->at(i);
+      batch.AddRow("character_skills", "char_id, skill_id, current_val, max_val", "current_val = VALUES(current_val), max_val = VALUES(max_val)", "%u, %u, %i, %i", client->GetCharacterID(), skill->skill_id, skill->current_val, skill->max_val);
+      saved.push_back(skill->skill_id);
     }
     safe_delete(skills);
+
+    if (!saved.empty()) {
+      PlayerSkillList* skill_list = client->GetPlayer()->GetSkills();
+      batch.OnFailure([skill_list, saved]() {
+        for (int32 skill_id : saved) {
+          Skill* skill = skill_list->GetSkill(skill_id);
+          if (skill)
+            skill->save_needed = true;
+        }
+      });
+    }
   }
 }
 
-void WorldDatabase::SaveCharacterQuests(const shared_ptr<Client>& client) {
-  Query query;
+void WorldDatabase::SaveCharacterQuests(const shared_ptr<Client>& client, QueryBatch& batch) {
+  CharacterSaveState* save_state = client->GetSaveState();
   map<int32, Quest*>::iterator itr;
+  vector<int32> saved;
   master_quest_list.LockQuests();    //prevent reloading until we are done
   client->GetPlayer()->LockQuests(); //prevent all quest modifications until we are done
   map<int32, Quest*>* quests = client->GetPlayer()->GetPlayerQuests();
   for (itr = quests->begin(); itr != quests->end(); itr++) {
-    if (client->GetCurrentQuestID() == itr->first) {
-      query.RunQuery2(Q_UPDATE, "update character_quests set current_quest = 0 where char_id = %u", client->GetCharacterID());
-      query.RunQuery2(Q_UPDATE, "update character_quests set current_quest = 1 where char_id = %u and quest_id = %u", client->GetCharacterID(), itr->first);
+    if (client->GetCurrentQuestID() == itr->first && save_state->current_quest_id != itr->first) {
+      batch.AddQuery("update character_quests set current_quest = 0 where char_id = %u", client->GetCharacterID());
+      batch.AddQuery("update character_quests set current_quest = 1 where char_id = %u and quest_id = %u", client->GetCharacterID(), itr->first);
+      save_state->current_quest_id = itr->first;
     }
     if (itr->second->GetSaveNeeded()) {
-      query.RunQuery2(Q_INSERT, "insert ignore into character_quests (char_id, quest_id, given_date, quest_giver) values(%u, %u, now(), %u)", client->GetCharacterID(), itr->first, itr->second->GetQuestGiver());
-      query.RunQuery2(Q_UPDATE, "update character_quests set tracked = %i, quest_flags = %u, hidden = %i, complete_count = %u where char_id = %u and quest_id = %u", itr->second->IsTracked() ? 1 : 0, itr->second->GetQuestFlags(), itr->second->IsHidden() ? 1 : 0, itr->second->GetCompleteCount(), client->GetCharacterID(), itr->first);
-      SaveCharacterQuestProgress(client, itr->second);
+      batch.AddQuery("insert ignore into character_quests (char_id, quest_id, given_date, quest_giver) values(%u, %u, now(), %u)", client->GetCharacterID(), itr->first, itr->second->GetQuestGiver());
+      batch.AddQuery("update character_quests set tracked = %i, quest_flags = %u, hidden = %i, complete_count = %u where char_id = %u and quest_id = %u", itr->second->IsTracked() ? 1 : 0, itr->second->GetQuestFlags(), itr->second->IsHidden() ? 1 : 0, itr->second->GetCompleteCount(), client->GetCharacterID(), itr->first);
+      SaveCharacterQuestProgress(client, itr->second, batch);
       itr->second->SetSaveNeeded(false);
+      saved.push_back(itr->first);
     }
   }
-  if (query.GetErrorNumber() && query.GetError() && query.GetErrorNumber() < 0xFFFFFFFF)
-    LogWrite(WORLD__ERROR, 0, "World", "Error in SaveCharacterQuests query '%s': %s", query.GetQuery(), query.GetError());
   quests = client->GetPlayer()->GetCompletedPlayerQuests();
   for (itr = quests->begin(); itr != quests->end(); itr++) {
     if (itr->second->GetSaveNeeded()) {
-      query.RunQuery2(Q_DELETE, "delete FROM character_quest_progress where char_id = %u and quest_id = %u", client->GetCharacterID(), itr->first);
+      batch.AddQuery("delete FROM character_quest_progress where char_id = %u and quest_id = %u", client->GetCharacterID(), itr->first);
 
       /* incase the quest is completed before the quest could be inserted in the PlayerQuests loop, we first try to insert it.  If it already exists then we can just update
 			 * the completed_date */
-      query.RunQuery2(Q_INSERT, "INSERT INTO character_quests (char_id, quest_id, quest_giver, current_quest, given_date, completed_date, complete_count) values (%u,%u,%u,0, now(),now(), %u) ON DUPLICATE KEY UPDATE completed_date = now(), complete_count = %u, current_quest = 0", client->GetCharacterID(), itr->first, itr->second->GetQuestGiver(), itr->second->GetCompleteCount(), itr->second->GetCompleteCount());
+      batch.AddQuery("INSERT INTO character_quests (char_id, quest_id, quest_giver, current_quest, given_date, completed_date, complete_count) values (%u,%u,%u,0, now(),now(), %u) ON DUPLICATE KEY UPDATE completed_date = now(), complete_count = %u, current_quest = 0", client->GetCharacterID(), itr->first, itr->second->GetQuestGiver(), itr->second->GetCompleteCount(), itr->second->GetCompleteCount());
       itr->second->SetSaveNeeded(false);
+      saved.push_back(itr->first);
     }
   }
   client->GetPlayer()->UnlockQuests();
   master_quest_list.UnlockQuests();
+
+  if (!saved.empty()) {
+    Player* player = client->GetPlayer();
+    batch.OnFailure([player, saved]() {
+      player->LockQuests();
+      for (int32 quest_id : saved) {
+        map<int32, Quest*>::iterator itr = player->GetPlayerQuests()->find(quest_id);
+        if (itr != player->GetPlayerQuests()->end())
+          itr->second->SetSaveNeeded(true);
+
+        itr = player->GetCompletedPlayerQuests()->find(quest_id);
+        if (itr != player->GetCompletedPlayerQuests()->end())
+          itr->second->SetSaveNeeded(true);
+      }
+      player->UnlockQuests();
+    });
+  }
 }
 
 void WorldDatabase::SaveCharRepeatableQuest(const shared_ptr<Client>& client, int32 quest_id, int16 quest_complete_count) {
@@ -2266,8 +2317,7 @@ void WorldDatabase::SaveCharRepeatableQuest(const shared_ptr<Client>& client, in
     LogWrite(DATABASE__ERROR, 0, "DBNew", "DB Error %u\n%s", database_new.GetError(), database_new.GetErrorMsg());
 }
 
-void WorldDatabase::SaveCharacterQuestProgress(const shared_ptr<Client>& client, Quest* quest) {
-  Query query;
+void WorldDatabase::SaveCharacterQuestProgress(const shared_ptr<Client>& client, Quest* quest, QueryBatch& batch) {
   vector<QuestStep*>* steps = quest->GetQuestSteps();
   vector<QuestStep*>::iterator itr;
   QuestStep* step = 0;
@@ -2275,11 +2325,9 @@ void WorldDatabase::SaveCharacterQuestProgress(const shared_ptr<Client>& client,
     for (itr = steps->begin(); itr != steps->end(); itr++) {
       step = *itr;
       if (step && step->GetQuestCurrentQuantity() > 0)
-        query.RunQuery2(Q_REPLACE, "replace into character_quest_progress (char_id, quest_id, step_id, progress) values(%u, %u, %u, %i)", client->GetCharacterID(), quest->GetQuestID(), step->GetStepID(), step->GetQuestCurrentQuantity());
+        batch.AddRow("character_quest_progress", "char_id, quest_id, step_id, progress", "progress = VALUES(progress)", "%u, %u, %u, %i", client->GetCharacterID(), quest->GetQuestID(), step->GetStepID(), step->GetQuestCurrentQuantity());
     }
   }
-  if (query.GetErrorNumber() && query.GetError() && query.GetErrorNumber() < 0xFFFFFFFF)
-    LogWrite(WORLD__ERROR, 0, "World", "Error in SaveCharacterQuestProgress query '%s': %s", query.GetQuery(), query.GetError());
 }
 
 void WorldDatabase::LoadCharacterQuestProgress(const shared_ptr<Client>& client) {
@@ -2855,10 +2903,18 @@ void WorldDatabase::EnableConstraints() {
   Query query;
   query.RunQuery2("/*!40101 SET SQL_MODE=@OLD_SQL_MODE */", Q_DBMS);
   query.RunQuery2("/*!40014 SET FOREIGN_KEY_CHECKS=@OLD_FOREIGN_KEY_CHECKS */", Q_DBMS);
+  query.RunQuery2("/*!40101 SET CHARACTER_SET_CLIENT=@OLD_CHARACTER_SET_CLIENT, CHARACTER_SET_RESULTS=@OLD_CHARACTER_SET_RESULTS, COLLATION_CONNECTION=@OLD_COLLATION_CONNECTION */", Q_DBMS);
+
+  // the connection goes back to the pool with its settings restored
+  ReleaseReservedConnection();
 }
 
 void WorldDatabase::DisableConstraints() {
+  // the settings are per connection, so the patch statements that follow must run on this one
+  ReserveConnection();
+
   Query query;
+  query.RunQuery2("/*!40101 SET @OLD_CHARACTER_SET_CLIENT=@@CHARACTER_SET_CLIENT, @OLD_CHARACTER_SET_RESULTS=@@CHARACTER_SET_RESULTS, @OLD_COLLATION_CONNECTION=@@COLLATION_CONNECTION */", Q_DBMS);
   query.RunQuery2("/*!40101 SET NAMES utf8 */", Q_DBMS);
   query.RunQuery2("/*!40101 SET SQL_MODE=''*/", Q_DBMS);
   query.RunQuery2("/*!40014 SET @OLD_FOREIGN_KEY_CHECKS=@@FOREIGN_KEY_CHECKS, FOREIGN_KEY_CHECKS=0 */", Q_DBMS);
@@ -3494,8 +3550,8 @@ int8 WorldDatabase::GetInstanceTypeByZoneID(int32 zoneID) {
   return ret;
 }
 
-void WorldDatabase::Save(const shared_ptr<Client>& client) {
-  Query query;
+void WorldDatabase::Save(const shared_ptr<Client>& client, QueryBatch& batch) {
+  CharacterSaveState* save_state = client->GetSaveState();
   Player* player = client->GetPlayer();
   if (!player->CheckPlayerInfo())
     return;
@@ -3507,21 +3563,26 @@ void WorldDatabase::Save(const shared_ptr<Client>& client) {
   int32 zone_id = 0;
   if (client->GetCurrentZone())
     zone_id = client->GetCurrentZone()->GetZoneID();
-  query.RunQuery2(Q_UPDATE, "update characters set current_zone_id=%u, x=%f, y=%f, z=%f, heading=%f, level=%i,instance_id=%i,last_saved=%i, `class`=%i, `tradeskill_level`=%i, `tradeskill_class`=%i, alignment=%i where id = %u", zone_id, player->GetX(), player->GetY(), player->GetZ(), player->GetHeading(), player->GetLevel(), instance_id, client->GetLastSavedTimeStamp(), client->GetPlayer()->GetAdventureClass(), client->GetPlayer()->GetTSLevel(), client->GetPlayer()->GetTradeskillClass(), client->GetPlayer()->GetAlignment(), client->GetCharacterID());
-  query.RunQuery2(Q_UPDATE, "update character_details set hp=%u, power=%u, str=%i, sta=%i, agi=%i, wis=%i, intel=%i, heat=%i, cold=%i, magic=%i, mental=%i, divine=%i, disease=%i, poison=%i, coin_copper=%u, coin_silver=%u, coin_gold=%u, coin_plat=%u, max_hp = %u, max_power=%u, xp = %u, xp_needed = %u, xp_debt = %u, xp_vitality = %f, tradeskill_xp = %u, tradeskill_xp_needed = %u, tradeskill_xp_vitality = %f, bank_copper = %u, bank_silver = %u, bank_gold = %u, bank_plat = %u, bind_zone_id=%u, bind_x = %f, bind_y = %f, bind_z = %f, bind_heading = %f, house_zone_id=%u, combat_voice = %i, emote_voice = %i, auto_attack_mode = %i, biography='%s', flags=%u, flags2=%u, last_name='%s', fame=%u where char_id = %u",
+  batch.AddQueryIfChanged(save_state->character_row, "update characters set current_zone_id=%u, x=%f, y=%f, z=%f, heading=%f, level=%i,instance_id=%i,last_saved=%i, `class`=%i, `tradeskill_level`=%i, `tradeskill_class`=%i, alignment=%i where id = %u", zone_id, player->GetX(), player->GetY(), player->GetZ(), player->GetHeading(), player->GetLevel(), instance_id, client->GetLastSavedTimeStamp(), client->GetPlayer()->GetAdventureClass(), client->GetPlayer()->GetTSLevel(), client->GetPlayer()->GetTradeskillClass(), client->GetPlayer()->GetAlignment(), client->GetCharacterID());
+  batch.AddQueryIfChanged(save_state->details_row, "update character_details set hp=%u, power=%u, str=%i, sta=%i, agi=%i, wis=%i, intel=%i, heat=%i, cold=%i, magic=%i, mental=%i, divine=%i, disease=%i, poison=%i, coin_copper=%u, coin_silver=%u, coin_gold=%u, coin_plat=%u, max_hp = %u, max_power=%u, xp = %u, xp_needed = %u, xp_debt = %u, xp_vitality = %f, tradeskill_xp = %u, tradeskill_xp_needed = %u, tradeskill_xp_vitality = %f, bank_copper = %u, bank_silver = %u, bank_gold = %u, bank_plat = %u, bind_zone_id=%u, bind_x = %f, bind_y = %f, bind_z = %f, bind_heading = %f, house_zone_id=%u, combat_voice = %i, emote_voice = %i, auto_attack_mode = %i, biography='%s', flags=%u, flags2=%u, last_name='%s', fame=%u where char_id = %u",
                   player->GetHP(), player->GetPower(), player->GetStrBase(), player->GetStaBase(), player->GetAgiBase(), player->GetWisBase(), player->GetIntBase(), player->GetHeatResistanceBase(), player->GetColdResistanceBase(), player->GetMagicResistanceBase(),
                   player->GetMentalResistanceBase(), player->GetDivineResistanceBase(), player->GetDiseaseResistanceBase(), player->GetPoisonResistanceBase(), player->GetCoinsCopper(), player->GetCoinsSilver(), player->GetCoinsGold(), player->GetCoinsPlat(), player->GetTotalHPBase(), player->GetTotalPowerBase(), player->GetXP(), player->GetNeededXP(), player->GetXPDebt(), player->GetXPVitality(), player->GetTSXP(), player->GetNeededTSXP(), player->GetTSXPVitality(), player->GetBankCoinsCopper(),
                   player->GetBankCoinsSilver(), player->GetBankCoinsGold(), player->GetBankCoinsPlat(), client->GetPlayer()->GetPlayerInfo()->GetBindZoneID(), client->GetPlayer()->GetPlayerInfo()->GetBindZoneX(), client->GetPlayer()->GetPlayerInfo()->GetBindZoneY(), client->GetPlayer()->GetPlayerInfo()->GetBindZoneZ(), client->GetPlayer()->GetPlayerInfo()->GetBindZoneHeading(), client->GetPlayer()->GetPlayerInfo()->GetHouseZoneID(),
                   client->GetPlayer()->GetCombatVoice(), client->GetPlayer()->GetEmoteVoice(), client->GetPlayer()->GetAutoAttackMode(), getSafeEscapeString(client->GetPlayer()->GetBiography().c_str()).c_str(), player->GetFlags(), player->GetFlags2(), client->GetPlayer()->GetLastName(), client->GetPlayer()->GetFame(), client->GetCharacterID());
   map<string, int8>::iterator itr;
+  // friend and ignore entries are marked 0 once added and 3 once deleted
+  vector<pair<string, int8>> saved_friends;
+  vector<pair<string, int8>> saved_ignored;
   map<string, int8>* friends = player->GetFriends();
   if (friends && friends->size() > 0) {
     for (itr = friends->begin(); itr != friends->end(); itr++) {
       if (itr->second == 1) {
-        query.RunQuery2(Q_INSERT, "insert ignore into character_social (char_id, name, type) values(%u, '%s', 'FRIEND')", client->GetCharacterID(), getSafeEscapeString(itr->first.c_str()).c_str());
+        batch.AddQuery("insert ignore into character_social (char_id, name, type) values(%u, '%s', 'FRIEND')", client->GetCharacterID(), getSafeEscapeString(itr->first.c_str()).c_str());
+        saved_friends.push_back(make_pair(itr->first, itr->second));
         itr->second = 0;
       } else if (itr->second == 2) {
-        query.RunQuery2(Q_DELETE, "delete FROM character_social where char_id = %u and name = '%s'", client->GetCharacterID(), getSafeEscapeString(itr->first.c_str()).c_str());
+        batch.AddQuery("delete FROM character_social where char_id = %u and name = '%s'", client->GetCharacterID(), getSafeEscapeString(itr->first.c_str()).c_str());
+        saved_friends.push_back(make_pair(itr->first, itr->second));
         itr->second = 3;
       }
     }
@@ -3530,22 +3591,85 @@ void WorldDatabase::Save(const shared_ptr<Client>& client) {
   if (ignored && ignored->size() > 0) {
     for (itr = ignored->begin(); itr != ignored->end(); itr++) {
       if (itr->second == 1) {
-        query.RunQuery2(Q_INSERT, "insert ignore into character_social (char_id, name, type) values(%u, '%s', 'IGNORE')", client->GetCharacterID(), getSafeEscapeString(itr->first.c_str()).c_str());
+        batch.AddQuery("insert ignore into character_social (char_id, name, type) values(%u, '%s', 'IGNORE')", client->GetCharacterID(), getSafeEscapeString(itr->first.c_str()).c_str());
+        saved_ignored.push_back(make_pair(itr->first, itr->second));
         itr->second = 0;
       } else if (itr->second == 2) {
-        query.RunQuery2(Q_DELETE, "delete FROM character_social where char_id = %u and name = '%s'", client->GetCharacterID(), getSafeEscapeString(itr->first.c_str()).c_str());
+        batch.AddQuery("delete FROM character_social where char_id = %u and name = '%s'", client->GetCharacterID(), getSafeEscapeString(itr->first.c_str()).c_str());
+        saved_ignored.push_back(make_pair(itr->first, itr->second));
         itr->second = 3;
       }
     }
   }
-  SavePlayerFactions(client);
-  SaveCharacterQuests(client);
-  SaveCharacterSkills(client);
-  SavePlayerSpells(client);
+  if (!saved_friends.empty() || !saved_ignored.empty()) {
+    batch.OnFailure([player, saved_friends, saved_ignored]() {
+      // put back the pending add (1) or delete (2) unless the entry changed again since
+      auto restore = [](map<string, int8>* list, const vector<pair<string, int8>>& saved) {
+        for (const auto& entry : saved) {
+          map<string, int8>::iterator itr = list->find(entry.first);
+          if (itr != list->end() && itr->second == (entry.second == 1 ? 0 : 3))
+            itr->second = entry.second;
+        }
+      };
+
+      restore(player->GetFriends(), saved_friends);
+      restore(player->GetIgnoredPlayers(), saved_ignored);
+    });
+  }
+  SavePlayerFactions(client, batch);
+  SaveCharacterQuests(client, batch);
+  SaveCharacterSkills(client, batch);
+  SavePlayerSpells(client, batch);
   SavePlayerMail(client);
-  SavePlayerCollections(client);
+  SavePlayerCollections(client, batch);
+}
 
-  LogWrite(PLAYER__INFO, 3, "Player", "Player '%s (%u) data saved.", player->GetName(), player->GetCharacterID());
+bool WorldDatabase::SaveCharacterBatch(const shared_ptr<Client>& client, QueryBatch& batch) {
+  Player* player = client->GetPlayer();
+
+  if (batch.IsEmpty()) {
+    lock_guard<mutex> guard(save_stats_mutex);
+    save_stats.skipped++;
+
+    LogWrite(PLAYER__DEBUG, 3, "Player", "Player '%s' (%u) has no changes to save.", player->GetName(), player->GetCharacterID());
+    return true;
+  }
+
+  int32 rows = batch.GetRowCount();
+  int32 statements = batch.GetStatementCount();
+  int32 start = Timer::GetCurrentTime2();
+  char errbuf[MYSQL_ERRMSG_SIZE];
+
+  bool ret = batch.Execute(errbuf);
+  int32 elapsed = Timer::GetCurrentTime2() - start;
+
+  {
+    lock_guard<mutex> guard(save_stats_mutex);
+    save_stats.saves++;
+    save_stats.rows += rows;
+    save_stats.statements += statements;
+    save_stats.total_ms += elapsed;
+    if (elapsed > save_stats.max_ms)
+      save_stats.max_ms = elapsed;
+    if (!ret)
+      save_stats.failed++;
+  }
+
+  if (ret) {
+    LogWrite(PLAYER__INFO, 3, "Player", "Player '%s (%u) data saved: %u row(s) in %u statement(s), %ums.", player->GetName(), player->GetCharacterID(), rows, statements, elapsed);
+  } else {
+    // the transaction was rolled back; the collectors marked their rows as needing a save
+    // again, and resetting the save state rewrites the rows that have no flag of their own
+    *client->GetSaveState() = CharacterSaveState();
+    LogWrite(PLAYER__ERROR, 0, "Player", "Failed to save player '%s' (%u): %s", player->GetName(), player->GetCharacterID(), errbuf);
+  }
+
+  return ret;
+}
+
+CharacterSaveStats WorldDatabase::GetCharacterSaveStats() {
+  lock_guard<mutex> guard(save_stats_mutex);
+  return save_stats;
 }
 
 void WorldDatabase::LoadEntityCommands(ZoneServer* zone) {
@@ -3767,13 +3891,19 @@ void WorldDatabase::LoadFactionList() {
   LoadFactionAlliances();
 }
 
-void WorldDatabase::SavePlayerFactions(const shared_ptr<Client>& client) {
+void WorldDatabase::SavePlayerFactions(const shared_ptr<Client>& client, QueryBatch& batch) {
   LogWrite(PLAYER__DEBUG, 3, "Player", "Saving Player Factions...");
-  Query query;
+  map<int32, sint32>& saved_factions = client->GetSaveState()->factions;
   map<int32, sint32>* factions = client->GetPlayer()->GetFactions()->GetFactionValues();
   map<int32, sint32>::iterator itr;
-  for (itr = factions->begin(); itr != factions->end(); itr++)
-    query.RunQuery2(Q_INSERT, "insert into character_factions (char_id, faction_id, faction_level) values(%u, %u, %i) ON DUPLICATE KEY UPDATE faction_level=%i", client->GetCharacterID(), itr->first, itr->second, itr->second);
+  for (itr = factions->begin(); itr != factions->end(); itr++) {
+    map<int32, sint32>::iterator saved = saved_factions.find(itr->first);
+    if (saved != saved_factions.end() && saved->second == itr->second)
+      continue;
+
+    batch.AddRow("character_factions", "char_id, faction_id, faction_level", "faction_level = VALUES(faction_level)", "%u, %u, %i", client->GetCharacterID(), itr->first, itr->second);
+    saved_factions[itr->first] = itr->second;
+  }
 }
 
 bool WorldDatabase::LoadPlayerFactions(const shared_ptr<Client>& client) {
@@ -3882,7 +4012,7 @@ void WorldDatabase::GetPetNames(ZoneServer* zone) {
 
   if (database_new.Select(&result, "SELECT pet_name FROM spawn_pet_names")) {
     while (result.Next()) {
-      zone->pet_names.push_back(result.GetStringStr("pet_name"));
+      zone->AddPetName(result.GetStringStr("pet_name"));
       total++;
       LogWrite(PET__DEBUG, 5, "Pet", "---Loading Pet Name: '%s'", result.GetStringStr("pet_name"));
     }
@@ -3993,7 +4123,7 @@ int32 WorldDatabase::GetMaxHotBarID() {
   return ret;
 }
 
-void WorldDatabase::SaveQuickBar(int32 char_id, vector<QuickBarItem*>* quickbar_items) {
+void WorldDatabase::SaveQuickBar(int32 char_id, vector<QuickBarItem*>* quickbar_items, QueryBatch& batch) {
   vector<QuickBarItem*>::iterator itr;
   QuickBarItem* qbi = 0;
   for (itr = quickbar_items->begin(); itr != quickbar_items->end(); itr++) {
@@ -4001,17 +4131,10 @@ void WorldDatabase::SaveQuickBar(int32 char_id, vector<QuickBarItem*>* quickbar_
     if (!qbi)
       continue;
     if (qbi->deleted == false) {
-      Query query;
-      if (qbi->text.size > 0) {
-        query.RunQuery2(Q_REPLACE, "replace into character_skillbar (id, hotbar, slot, char_id, spell_id, type, text_val, tier) values(%u, %u, %u, %u, %u, %i, '%s', %i)",
-                        qbi->unique_id, qbi->hotbar, qbi->slot, char_id, qbi->id, qbi->type, getSafeEscapeString(qbi->text.data.c_str()).c_str(), qbi->tier);
-      } else {
-        query.RunQuery2(Q_REPLACE, "replace into character_skillbar (id, hotbar, slot, char_id, spell_id, type, text_val, tier) values(%u, %u, %u, %u, %u, %i, 'Unused', %i)",
-                        qbi->unique_id, qbi->hotbar, qbi->slot, char_id, qbi->id, qbi->type, qbi->tier);
-      }
+      batch.AddRow("character_skillbar", "id, hotbar, slot, char_id, spell_id, type, text_val, tier", "hotbar = VALUES(hotbar), slot = VALUES(slot), char_id = VALUES(char_id), spell_id = VALUES(spell_id), type = VALUES(type), text_val = VALUES(text_val), tier = VALUES(tier)",
+                   "%u, %u, %u, %u, %u, %i, '%s', %i", qbi->unique_id, qbi->hotbar, qbi->slot, char_id, qbi->id, qbi->type, qbi->text.size > 0 ? getSafeEscapeString(qbi->text.data.c_str()).c_str() : "Unused", qbi->tier);
     } else {
-      Query query;
-      query.RunQuery2(Q_DELETE, "delete FROM character_skillbar where hotbar=%u and slot=%u and char_id=%u", qbi->hotbar, qbi->slot, char_id);
+      batch.AddQuery("delete FROM character_skillbar where hotbar=%u and slot=%u and char_id=%u", qbi->hotbar, qbi->slot, char_id);
     }
   }
 }
@@ -4059,7 +4182,138 @@ void WorldDatabase::LoadTraits() {
   LogWrite(SPELL__INFO, 0, "Traits", "Loaded %u Trait(s)", master_trait_list.Size());
 }
 
-Spell* WorldDatabase::GenerateSpell(DatabaseResult& result, string spell_name, string hash_string) {
+// Columns of the spell query in LoadSpells(), looked up once per result
+struct SpellColumns {
+  SpellColumns(DatabaseResult& result);
+
+  unsigned int id;
+  unsigned int name;
+  unsigned int description;
+  unsigned int icon;
+  unsigned int icon_heroic_op;
+  unsigned int icon_backdrop;
+  unsigned int spell_visual;
+  unsigned int type;
+  unsigned int target_type;
+  unsigned int cast_type;
+  unsigned int spell_book_type;
+  unsigned int det_type;
+  unsigned int incurable;
+  unsigned int control_effect_type;
+  unsigned int casting_flags;
+  unsigned int savage_bar;
+  unsigned int savage_bar_slot;
+  unsigned int spell_type;
+  unsigned int interruptable;
+  unsigned int duration_until_cancel;
+  unsigned int can_effect_raid;
+  unsigned int affect_only_group_members;
+  unsigned int display_spell_tier;
+  unsigned int friendly_spell;
+  unsigned int group_spell;
+  unsigned int is_active;
+  unsigned int persist_through_death;
+  unsigned int cast_while_moving;
+  unsigned int not_maintained;
+  unsigned int class_skill;
+  unsigned int mastery_skill;
+  unsigned int req_concentration;
+  unsigned int hp_req;
+  unsigned int hp_upkeep;
+  unsigned int hp_req_percent;
+  unsigned int power_req;
+  unsigned int power_upkeep;
+  unsigned int power_req_percent;
+  unsigned int savagery_req;
+  unsigned int savagery_upkeep;
+  unsigned int savagery_req_percent;
+  unsigned int dissonance_req;
+  unsigned int dissonance_upkeep;
+  unsigned int dissonance_req_percent;
+  unsigned int call_frequency;
+  unsigned int cast_time;
+  unsigned int duration1;
+  unsigned int duration2;
+  unsigned int hit_bonus;
+  unsigned int max_aoe_targets;
+  unsigned int min_range;
+  unsigned int radius;
+  unsigned int range;
+  unsigned int recast;
+  unsigned int recovery;
+  unsigned int resistibility;
+  unsigned int linked_timer_id;
+  unsigned int success_message;
+  unsigned int fade_message;
+  unsigned int effect_message;
+  unsigned int lua_script;
+};
+
+SpellColumns::SpellColumns(DatabaseResult& result) {
+  id = result.GetFieldIndex("id");
+  name = result.GetFieldIndex("name");
+  description = result.GetFieldIndex("description");
+  icon = result.GetFieldIndex("icon");
+  icon_heroic_op = result.GetFieldIndex("icon_heroic_op");
+  icon_backdrop = result.GetFieldIndex("icon_backdrop");
+  spell_visual = result.GetFieldIndex("spell_visual");
+  type = result.GetFieldIndex("type");
+  target_type = result.GetFieldIndex("target_type");
+  cast_type = result.GetFieldIndex("cast_type");
+  spell_book_type = result.GetFieldIndex("spell_book_type");
+  det_type = result.GetFieldIndex("det_type");
+  incurable = result.GetFieldIndex("incurable");
+  control_effect_type = result.GetFieldIndex("control_effect_type");
+  casting_flags = result.GetFieldIndex("casting_flags");
+  savage_bar = result.GetFieldIndex("savage_bar");
+  savage_bar_slot = result.GetFieldIndex("savage_bar_slot");
+  spell_type = result.GetFieldIndex("spell_type");
+  interruptable = result.GetFieldIndex("interruptable");
+  duration_until_cancel = result.GetFieldIndex("duration_until_cancel");
+  can_effect_raid = result.GetFieldIndex("can_effect_raid");
+  affect_only_group_members = result.GetFieldIndex("affect_only_group_members");
+  display_spell_tier = result.GetFieldIndex("display_spell_tier");
+  friendly_spell = result.GetFieldIndex("friendly_spell");
+  group_spell = result.GetFieldIndex("group_spell");
+  is_active = result.GetFieldIndex("is_active");
+  persist_through_death = result.GetFieldIndex("persist_through_death");
+  cast_while_moving = result.GetFieldIndex("cast_while_moving");
+  not_maintained = result.GetFieldIndex("not_maintained");
+  class_skill = result.GetFieldIndex("class_skill");
+  mastery_skill = result.GetFieldIndex("mastery_skill");
+  req_concentration = result.GetFieldIndex("req_concentration");
+  hp_req = result.GetFieldIndex("hp_req");
+  hp_upkeep = result.GetFieldIndex("hp_upkeep");
+  hp_req_percent = result.GetFieldIndex("hp_req_percent");
+  power_req = result.GetFieldIndex("power_req");
+  power_upkeep = result.GetFieldIndex("power_upkeep");
+  power_req_percent = result.GetFieldIndex("power_req_percent");
+  savagery_req = result.GetFieldIndex("savagery_req");
+  savagery_upkeep = result.GetFieldIndex("savagery_upkeep");
+  savagery_req_percent = result.GetFieldIndex("savagery_req_percent");
+  dissonance_req = result.GetFieldIndex("dissonance_req");
+  dissonance_upkeep = result.GetFieldIndex("dissonance_upkeep");
+  dissonance_req_percent = result.GetFieldIndex("dissonance_req_percent");
+  call_frequency = result.GetFieldIndex("call_frequency");
+  cast_time = result.GetFieldIndex("cast_time");
+  duration1 = result.GetFieldIndex("duration1");
+  duration2 = result.GetFieldIndex("duration2");
+  hit_bonus = result.GetFieldIndex("hit_bonus");
+  max_aoe_targets = result.GetFieldIndex("max_aoe_targets");
+  min_range = result.GetFieldIndex("min_range");
+  radius = result.GetFieldIndex("radius");
+  range = result.GetFieldIndex("range");
+  recast = result.GetFieldIndex("recast");
+  recovery = result.GetFieldIndex("recovery");
+  resistibility = result.GetFieldIndex("resistibility");
+  linked_timer_id = result.GetFieldIndex("linked_timer_id");
+  success_message = result.GetFieldIndex("success_message");
+  fade_message = result.GetFieldIndex("fade_message");
+  effect_message = result.GetFieldIndex("effect_message");
+  lua_script = result.GetFieldIndex("lua_script");
+}
+
+Spell* WorldDatabase::GenerateSpell(DatabaseResult& result, const SpellColumns& columns, string spell_name, string hash_string) {
   string hash_hex;
   picosha2::hash256_hex_string(hash_string, hash_hex);
   sint32 spell_id = std::stoi(hash_hex.substr(0, 7), nullptr, 16);
@@ -4070,88 +4324,90 @@ Spell* WorldDatabase::GenerateSpell(DatabaseResult& result, string spell_name, s
   data->tier = 1;
   data->name.data = spell_name;
   data->name.size = data->name.data.length();
-  data->description.data = result.GetStringStr("description");
+  unsigned long length;
+  const char* value = result.GetString(columns.description, &length);
+  data->description.data.assign(value, length);
   data->description.size = data->description.data.length();
-  data->icon = result.GetSInt16Str("icon");
-  data->icon_heroic_op = result.GetInt16Str("icon_heroic_op");
-  data->icon_backdrop = result.GetInt16Str("icon_backdrop");
-  data->spell_visual = result.GetInt32Str("spell_visual");
-  data->type = result.GetInt16Str("type");
-  data->target_type = result.GetInt8Str("target_type");
-  data->cast_type = result.GetInt8Str("cast_type");
-  data->spell_book_type = result.GetInt32Str("spell_book_type");
-  data->det_type = result.GetInt8Str("det_type");
-  data->incurable = (result.GetInt8Str("incurable") == 1);
-  data->control_effect_type = result.GetInt8Str("control_effect_type");
-  data->casting_flags = result.GetInt32Str("casting_flags");
-  data->savage_bar = result.GetInt8Str("savage_bar");
-  data->savage_bar_slot = result.GetInt8Str("savage_bar_slot");
-  data->spell_type = result.IsNullStr("spell_type") ? 0 : result.GetInt8Str("spell_type");
+  data->icon = result.GetSInt16(columns.icon);
+  data->icon_heroic_op = result.GetInt16(columns.icon_heroic_op);
+  data->icon_backdrop = result.GetInt16(columns.icon_backdrop);
+  data->spell_visual = result.GetInt32(columns.spell_visual);
+  data->type = result.GetInt16(columns.type);
+  data->target_type = result.GetInt8(columns.target_type);
+  data->cast_type = result.GetInt8(columns.cast_type);
+  data->spell_book_type = result.GetInt32(columns.spell_book_type);
+  data->det_type = result.GetInt8(columns.det_type);
+  data->incurable = (result.GetInt8(columns.incurable) == 1);
+  data->control_effect_type = result.GetInt8(columns.control_effect_type);
+  data->casting_flags = result.GetInt32(columns.casting_flags);
+  data->savage_bar = result.GetInt8(columns.savage_bar);
+  data->savage_bar_slot = result.GetInt8(columns.savage_bar_slot);
+  data->spell_type = result.IsNull(columns.spell_type) ? 0 : result.GetInt8(columns.spell_type);
 
   /* Toggles */
-  data->interruptable = (result.GetInt8Str("interruptable") == 1);
-  data->duration_until_cancel = (result.GetInt8Str("duration_until_cancel") == 1);
-  data->can_effect_raid = result.GetInt8Str("can_effect_raid");
-  data->affect_only_group_members = result.GetInt8Str("affect_only_group_members");
-  data->display_spell_tier = result.GetInt8Str("display_spell_tier");
-  data->friendly_spell = result.GetInt8Str("friendly_spell");
-  data->group_spell = result.GetInt8Str("group_spell");
-  data->is_active = result.GetInt8Str("is_active");
-  data->persist_though_death = (result.GetInt8Str("persist_through_death") == 1);
-  data->cast_while_moving = (result.GetInt8Str("cast_while_moving") == 1);
-  data->not_maintained = (result.GetInt8Str("not_maintained") == 1);
+  data->interruptable = (result.GetInt8(columns.interruptable) == 1);
+  data->duration_until_cancel = (result.GetInt8(columns.duration_until_cancel) == 1);
+  data->can_effect_raid = result.GetInt8(columns.can_effect_raid);
+  data->affect_only_group_members = result.GetInt8(columns.affect_only_group_members);
+  data->display_spell_tier = result.GetInt8(columns.display_spell_tier);
+  data->friendly_spell = result.GetInt8(columns.friendly_spell);
+  data->group_spell = result.GetInt8(columns.group_spell);
+  data->is_active = result.GetInt8(columns.is_active);
+  data->persist_though_death = (result.GetInt8(columns.persist_through_death) == 1);
+  data->cast_while_moving = (result.GetInt8(columns.cast_while_moving) == 1);
+  data->not_maintained = (result.GetInt8(columns.not_maintained) == 1);
 
   /* Skill Requirements */
-  data->class_skill = result.GetInt32Str("class_skill");
-  data->mastery_skill = result.GetInt32Str("mastery_skill");
+  data->class_skill = result.GetInt32(columns.class_skill);
+  data->mastery_skill = result.GetInt32(columns.mastery_skill);
   // no min_class_skill_req?
 
   /* Cost  */
-  data->req_concentration = result.GetInt16Str("req_concentration");
-  data->hp_req = result.GetInt16Str("hp_req");
-  data->hp_upkeep = result.GetInt16Str("hp_upkeep");
-  data->hp_req_percent = result.GetInt8Str("hp_req_percent");
-  data->power_req = 0; //result.GetInt16Str("power_req");
-  data->power_upkeep = result.GetInt16Str("power_upkeep");
-  data->power_req_percent = result.GetInt8Str("power_req_percent");
-  data->savagery_req = result.GetInt16Str("savagery_req");
-  data->savagery_upkeep = result.GetInt16Str("savagery_upkeep");
-  data->savagery_req_percent = result.GetInt8Str("savagery_req_percent");
-  data->dissonance_req = result.GetInt16Str("dissonance_req");
-  data->dissonance_upkeep = result.GetInt16Str("dissonance_upkeep");
-  data->dissonance_req_percent = result.GetInt8Str("dissonance_req_percent");
+  data->req_concentration = result.GetInt16(columns.req_concentration);
+  data->hp_req = result.GetInt16(columns.hp_req);
+  data->hp_upkeep = result.GetInt16(columns.hp_upkeep);
+  data->hp_req_percent = result.GetInt8(columns.hp_req_percent);
+  data->power_req = 0; //result.GetInt16(columns.power_req);
+  data->power_upkeep = result.GetInt16(columns.power_upkeep);
+  data->power_req_percent = result.GetInt8(columns.power_req_percent);
+  data->savagery_req = result.GetInt16(columns.savagery_req);
+  data->savagery_upkeep = result.GetInt16(columns.savagery_upkeep);
+  data->savagery_req_percent = result.GetInt8(columns.savagery_req_percent);
+  data->dissonance_req = result.GetInt16(columns.dissonance_req);
+  data->dissonance_upkeep = result.GetInt16(columns.dissonance_upkeep);
+  data->dissonance_req_percent = result.GetInt8(columns.dissonance_req_percent);
 
   /* Spell Parameters */
-  data->call_frequency = result.GetInt32Str("call_frequency");
-  data->cast_time = result.GetInt16Str("cast_time");
-  data->duration1 = result.GetInt32Str("duration1");
-  data->duration2 = result.GetInt32Str("duration2");
-  data->hit_bonus = result.GetFloatStr("hit_bonus");
-  data->max_aoe_targets = result.GetInt16Str("max_aoe_targets");
-  data->min_range = result.GetFloatStr("min_range");
-  data->radius = result.GetFloatStr("radius");
-  data->range = result.GetFloatStr("range");
-  data->recast = result.GetFloatStr("recast");
-  data->recovery = result.GetFloatStr("recovery");
-  data->resistibility = result.GetFloatStr("resistibility");
-  data->linked_timer = result.GetInt32Str("linked_timer_id");
+  data->call_frequency = result.GetInt32(columns.call_frequency);
+  data->cast_time = result.GetInt16(columns.cast_time);
+  data->duration1 = result.GetInt32(columns.duration1);
+  data->duration2 = result.GetInt32(columns.duration2);
+  data->hit_bonus = result.GetFloat(columns.hit_bonus);
+  data->max_aoe_targets = result.GetInt16(columns.max_aoe_targets);
+  data->min_range = result.GetFloat(columns.min_range);
+  data->radius = result.GetFloat(columns.radius);
+  data->range = result.GetFloat(columns.range);
+  data->recast = result.GetFloat(columns.recast);
+  data->recovery = result.GetFloat(columns.recovery);
+  data->resistibility = result.GetFloat(columns.resistibility);
+  data->linked_timer = result.GetInt32(columns.linked_timer_id);
 
   /* Cast Messaging */
-  string message = result.GetStringStr("success_message");
-  if (message.length() > 0)
-    data->success_message = message;
+  value = result.GetString(columns.success_message, &length);
+  if (length > 0)
+    data->success_message.assign(value, length);
 
-  message = result.GetStringStr("fade_message");
-  if (message.length() > 0)
-    data->fade_message = string(message);
+  value = result.GetString(columns.fade_message, &length);
+  if (length > 0)
+    data->fade_message.assign(value, length);
 
-  message = result.GetStringStr("effect_message");
-  if (message.length() > 0)
-    data->effect_message = string(message);
+  value = result.GetString(columns.effect_message, &length);
+  if (length > 0)
+    data->effect_message.assign(value, length);
 
-  string lua_script = result.GetStringStr("lua_script");
-  if (lua_script.length() > 0)
-    data->lua_script = string(lua_script);
+  value = result.GetString(columns.lua_script, &length);
+  if (length > 0)
+    data->lua_script.assign(value, length);
 
   Spell* spell = new Spell(data);
 
@@ -4181,8 +4437,10 @@ void WorldDatabase::LoadSpells() {
 		)END";
 
   if (database_new.Select(&result, query_string)) {
+    SpellColumns columns(result);
+
     while (result.Next()) {
-      int32 spell_id = result.GetInt32Str("id");
+      int32 spell_id = result.GetInt32(columns.id);
 
       vector<SpellDisplayEffect*> spell_display_effects = LoadSpellEffect(spell_id);
       vector<LUAData*> lua_data = LoadSpellLuaData(spell_id);
@@ -4195,14 +4453,14 @@ void WorldDatabase::LoadSpells() {
           Spell* spell = nullptr;
 
           if (spell_map.count(spell_level->spell_level) == 0) {
-            string spell_name = result.GetStringStr("name");
+            string spell_name = result.GetString(columns.name);
             string hash_string = to_string(spell_id) + " " + to_string(spell_level->spell_level);
 
             if (level_data->at(spell_id).size() > 1 && spell_num > 1) {
               spell_name += " " + int_to_roman(spell_num);
             }
 
-            spell = GenerateSpell(result, spell_name, hash_string);
+            spell = GenerateSpell(result, columns, spell_name, hash_string);
             spell_map.insert(pair<int32, Spell*>(spell_level->spell_level, spell));
 
             for (auto lua_datum : lua_data) {
@@ -4233,10 +4491,10 @@ void WorldDatabase::LoadSpells() {
         }
       }
 
-      string spell_name = result.GetStringStr("name");
+      string spell_name = result.GetString(columns.name);
       string hash_string = to_string(spell_id);
 
-      Spell* spell = GenerateSpell(result, spell_name, hash_string);
+      Spell* spell = GenerateSpell(result, columns, spell_name, hash_string);
       for (auto lua_datum : lua_data) {
         spell->AddSpellLuaData(lua_datum->type, lua_datum->int_value, lua_datum->float_value, lua_datum->bool_value, lua_datum->string_value, lua_datum->flat_value, lua_datum->is_scaling);
       }
@@ -4273,28 +4531,33 @@ vector<LUAData*> WorldDatabase::LoadSpellLuaData(int32 spell_id) {
   vector<LUAData*> lua_data;
 
   if (database_new.Select(&result, "SELECT value_type, value, flat_value, scale_per_level FROM spell_data WHERE spell_id = %u ORDER BY index_field", spell_id)) {
+    unsigned int field_flat_value = result.GetFieldIndex("flat_value");
+    unsigned int field_scale_per_level = result.GetFieldIndex("scale_per_level");
+    unsigned int field_value_type = result.GetFieldIndex("value_type");
+    unsigned int field_value = result.GetFieldIndex("value");
+
     while (result.Next()) {
       LUAData* data = new LUAData;
       data->int_value = 0;
       data->float_value = 0;
       data->bool_value = false;
-      data->flat_value = result.GetInt32Str("flat_value");
-      data->is_scaling = result.GetInt8Str("scale_per_level") == 0 ? false : true;
+      data->flat_value = result.GetInt32(field_flat_value);
+      data->is_scaling = result.GetInt8(field_scale_per_level) == 0 ? false : true;
 
-      const char* type = result.GetStringStr("value_type");
+      const char* type = result.GetString(field_value_type);
 
       if (!strcmp(type, "INT")) {
         data->type = 0;
-        data->int_value = result.GetInt32Str("value");
+        data->int_value = result.GetInt32(field_value);
       } else if (!strcmp(type, "FLOAT")) {
         data->type = 1;
-        data->float_value = result.GetFloatStr("value");
+        data->float_value = result.GetFloat(field_value);
       } else if (!strcmp(type, "BOOL")) {
         data->type = 2;
-        data->bool_value = result.GetInt32Str("value") == 0 ? false : true;
+        data->bool_value = result.GetInt32(field_value) == 0 ? false : true;
       } else if (!strcmp(type, "STRING")) {
         data->type = 3;
-        data->string_value = result.GetStringStr("value");
+        data->string_value = result.GetString(field_value);
       }
 
       lua_data.push_back(data);
@@ -4330,11 +4593,15 @@ vector<SpellDisplayEffect*> WorldDatabase::LoadSpellEffect(int32 spell_id) {
   vector<SpellDisplayEffect*> spell_effects;
 
   if (database_new.Select(&result, "SELECT percentage, bullet, description FROM spell_display_effects WHERE spell_id = %u", spell_id)) {
+    unsigned int field_description = result.GetFieldIndex("description");
+    unsigned int field_percentage = result.GetFieldIndex("percentage");
+    unsigned int field_bullet = result.GetFieldIndex("bullet");
+
     while (result.Next()) {
       SpellDisplayEffect* spell_display_effect = new SpellDisplayEffect();
-      spell_display_effect->description = result.GetStringStr("description");
-      spell_display_effect->percentage = result.GetInt8Str("percentage");
-      spell_display_effect->subbullet = result.GetInt8Str("bullet");
+      spell_display_effect->description = result.GetString(field_description);
+      spell_display_effect->percentage = result.GetInt8(field_percentage);
+      spell_display_effect->subbullet = result.GetInt8(field_bullet);
       spell_effects.push_back(spell_display_effect);
     }
   }
@@ -5581,6 +5848,7 @@ void WorldDatabase::LoadCharacterHistory(int32 char_id, Player* player) {
     strcpy(hd->Location, result.GetString(4));
     // skipped event id as use for it has not been determined yet
     hd->EventDate = result.GetInt32(6);
+    hd->SaveNeeded = false;
 
     player->LoadPlayerHistory(type, subtype, hd);
   }
@@ -5598,7 +5866,7 @@ void WorldDatabase::LoadSpellErrors() {
   }
 }
 
-void WorldDatabase::SaveCharacterHistory(Player* player, int8 type, int8 subtype, int32 value, int32 value2, char* location, int32 event_date) {
+void WorldDatabase::SaveCharacterHistory(Player* player, int8 type, int8 subtype, int32 value, int32 value2, char* location, int32 event_date, QueryBatch& batch) {
   LogWrite(PLAYER__INFO, 1, "Player", "Saving character history, type = %i subtype = %i", type, subtype);
   string str_type;
   string str_subtype;
@@ -5646,9 +5914,8 @@ void WorldDatabase::SaveCharacterHistory(Player* player, int8 type, int8 subtype
     return;
   }
 
-  Query query;
-  query.RunQuery2(Q_REPLACE, "replace into character_history (char_id, type, subtype, value, value2, location, event_date) values (%u, '%s', '%s', %i, %i, '%s', %u)",
-                  player->GetCharacterID(), str_type.c_str(), str_subtype.c_str(), value, value2, location, event_date);
+  batch.AddRow("character_history", "char_id, type, subtype, value, value2, location, event_date", "value = VALUES(value), value2 = VALUES(value2), location = VALUES(location), event_date = VALUES(event_date)",
+               "%u, '%s', '%s', %i, %i, '%s', %u", player->GetCharacterID(), str_type.c_str(), str_subtype.c_str(), value, value2, getSafeEscapeString(location).c_str(), event_date);
 }
 
 void WorldDatabase::LoadTransportMaps(ZoneServer* zone) {
@@ -6481,9 +6748,8 @@ void WorldDatabase::LoadZoneFlightPathLocations(ZoneServer* zone) {
   LogWrite(ZONE__DEBUG, 0, "Zone", "Loaded %u flight path locations for %s", total, zone->GetZoneDescription());
 }
 
-void WorldDatabase::SaveCharacterLUAHistory(Player* player, int32 event_id, int32 value, int32 value2) {
-  if (!database_new.Query("REPLACE INTO character_lua_history (char_id, event_id, value, value2) VALUES (%u, %u, %u, %u)", player->GetCharacterID(), event_id, value, value2))
-    LogWrite(DATABASE__ERROR, 0, "DBNew", "MySQL Error %u: %s", database_new.GetError(), database_new.GetErrorMsg());
+void WorldDatabase::SaveCharacterLUAHistory(Player* player, int32 event_id, int32 value, int32 value2, QueryBatch& batch) {
+  batch.AddRow("character_lua_history", "char_id, event_id, value, value2", "value = VALUES(value), value2 = VALUES(value2)", "%u, %u, %u, %u", player->GetCharacterID(), event_id, value, value2);
 }
 
 void WorldDatabase::LoadCharacterLUAHistory(int32 char_id, Player* player) {
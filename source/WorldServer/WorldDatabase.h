@@ -53,6 +53,8 @@
 using namespace std;
 
 struct GuildEvent;
+struct ItemColumns;
+struct SpellColumns;
 struct GuildMember;
 struct PointHistory;
 
@@ -114,6 +116,17 @@ struct StartingItem {
   int8 count;
 };
 
+// Totals for the batched character saves since the server started
+struct CharacterSaveStats {
+  int32 saves;
+  int32 skipped;
+  int32 failed;
+  int32 rows;
+  int32 statements;
+  int32 total_ms;
+  int32 max_ms;
+};
+
 class Bot;
 
 class WorldDatabase : public Database {
@@ -131,8 +144,8 @@ public:
   void SavePlayerActiveSpells(const shared_ptr<Client>& client);
   void DeleteCharacterActiveSpells(const shared_ptr<Client>& client, bool delete_all = false);
   int32 LoadItemBlueStats();
-  void SaveQuickBar(int32 char_id, vector<QuickBarItem*>* quickbar_items);
-  void SavePlayerSpells(const shared_ptr<Client>& client);
+  void SaveQuickBar(int32 char_id, vector<QuickBarItem*>* quickbar_items, QueryBatch& batch);
+  void SavePlayerSpells(const shared_ptr<Client>& client, QueryBatch& batch);
   int32 LoadSkills();
   void LoadCommandList();
   map<int8, vector<MacroData*>>* LoadCharacterMacros(int32 char_id);
@@ -156,12 +169,15 @@ public:
   void SaveVariable(const char* name, const char* value, const char* comment);
   void LoadVisualStates();
   void LoadAppearanceMasterList();
-  void Save(const shared_ptr<Client>& client);
-  void SaveItems(const shared_ptr<Client>& client);
+  void Save(const shared_ptr<Client>& client, QueryBatch& batch);
+  bool SaveCharacterBatch(const shared_ptr<Client>& client, QueryBatch& batch);
+  CharacterSaveStats GetCharacterSaveStats();
+  void SaveItems(const shared_ptr<Client>& client, QueryBatch& batch);
   void SaveItem(int32 account_id, int32 char_id, Item* item, const char* type);
+  void SaveItem(int32 account_id, int32 char_id, Item* item, const char* type, QueryBatch& batch);
   void DeleteBuyBack(int32 char_id, int32 item_id, int8 quantity, int32 price);
   void LoadBuyBacks(const shared_ptr<Client>& client);
-  void SaveBuyBacks(const shared_ptr<Client>& client);
+  void SaveBuyBacks(const shared_ptr<Client>& client, QueryBatch& batch);
   void SaveBuyBack(int32 char_id, int32 item_id, int8 quantity, int32 price);
   void LoadCharacterActiveSpells(Player* player);
   void DeleteItem(int32 char_id, Item* item, const char* type);
@@ -175,9 +191,9 @@ public:
   int32 LoadNPCAppearanceEquipmentData(ZoneServer* zone);
   void SaveNPCAppearanceEquipment(int32 spawn_id, int8 slot_id, int16 type, int8 red = 0, int8 green = 0, int8 blue = 0, int8 hred = 0, int8 hgreen = 0, int8 hblue = 0);
   void LoadSpecialZones();
-  void SaveCharacterSkills(const shared_ptr<Client>& client);
-  void SaveCharacterQuests(const shared_ptr<Client>& client);
-  void SaveCharacterQuestProgress(const shared_ptr<Client>& client, Quest* quest);
+  void SaveCharacterSkills(const shared_ptr<Client>& client, QueryBatch& batch);
+  void SaveCharacterQuests(const shared_ptr<Client>& client, QueryBatch& batch);
+  void SaveCharacterQuestProgress(const shared_ptr<Client>& client, Quest* quest, QueryBatch& batch);
   void DeleteCharacterQuest(int32 quest_id, int32 char_id, bool repeated_quest = false);
   void LoadCharacterQuests(const shared_ptr<Client>& client);
   void LoadCharacterQuestProgress(const shared_ptr<Client>& client);
@@ -208,7 +224,7 @@ public:
   void LoadFactionAlliances();
   void LoadFactionList();
   bool LoadPlayerFactions(const shared_ptr<Client>& client);
-  void SavePlayerFactions(const shared_ptr<Client>& client);
+  void SavePlayerFactions(const shared_ptr<Client>& client, QueryBatch& batch);
   void LoadSpawnScriptData();
   void LoadZoneScriptData();
   int32 LoadSpellScriptData();
@@ -275,7 +291,7 @@ public:
   void LoadTransporters(ZoneServer* zone);
   void LoadTransportMaps(ZoneServer* zone);
   void LoadDataFromRow(MYSQL_ROW row, Item* item); // JA - eventually get rid of this function when all DB calls are converted
-  void LoadDataFromRow(DatabaseResult* result, Item* item);
+  void LoadDataFromRow(DatabaseResult* result, const ItemColumns& columns, Item* item);
   void LoadCharacterItemList(int32 account_id, int32 char_id, Player* player);
   bool loadCharacter(const char* name, int32 account_id, const shared_ptr<Client>& client);
   bool LoadCharacterStats(int32 id, int32 account_id, const shared_ptr<Client>& client);
@@ -317,7 +333,7 @@ public:
   int32 GetCharacterAccountID(int32 character_id);
   void LoadEntityCommands(ZoneServer* zone);
   void LoadSpells();
-  Spell* GenerateSpell(DatabaseResult& result, string spell_name, string hash_string);
+  Spell* GenerateSpell(DatabaseResult& result, const SpellColumns& columns, string spell_name, string hash_string);
   void LoadSpellEffects();
   vector<SpellDisplayEffect*> LoadSpellEffect(int32 spell_id);
   vector<LUAData*> LoadSpellLuaData(int32 spell_id);
@@ -403,10 +419,10 @@ public:
   int32 LoadCollectionRewards(Collection* collection);
   void LoadPlayerCollections(Player* player);
   void LoadPlayerCollectionItems(Player* player, Collection* collection);
-  void SavePlayerCollections(const shared_ptr<Client>& client);
-  void SavePlayerCollection(const shared_ptr<Client>& client, Collection* collection);
-  void SavePlayerCollectionItems(const shared_ptr<Client>& client, Collection* collection);
-  void SavePlayerCollectionItem(const shared_ptr<Client>& client, Collection* collection, int32 item_id);
+  void SavePlayerCollections(const shared_ptr<Client>& client, QueryBatch& batch);
+  void SavePlayerCollection(const shared_ptr<Client>& client, Collection* collection, QueryBatch& batch);
+  void SavePlayerCollectionItems(const shared_ptr<Client>& client, Collection* collection, QueryBatch& batch);
+  void SavePlayerCollectionItem(const shared_ptr<Client>& client, Collection* collection, int32 item_id, QueryBatch& batch);
 
   /* Commands */
   map<int32, string>* GetSpawnTemplateListByName(const char* name);
@@ -464,6 +480,7 @@ public:
   /* Rules */
   void LoadGlobalRuleSet();
   void LoadRuleSets();
+  void ReloadRuleSets();
   void LoadRuleSetDetails(RuleSet* rule_set);
 
   /* Titles */
@@ -488,7 +505,7 @@ public:
   /* Tradeskills */
 
   /* Character History */
-  void SaveCharacterHistory(Player* player, int8 type, int8 subtype, int32 value, int32 value2, char* location, int32 event_date);
+  void SaveCharacterHistory(Player* player, int8 type, int8 subtype, int32 value, int32 value2, char* location, int32 event_date, QueryBatch& batch);
 
   /* Housing */
   void LoadHouseZones();
@@ -543,7 +560,7 @@ public:
   void LoadZoneFlightPathLocations(ZoneServer* zone);
 
   /* Character LUA History */
-  void SaveCharacterLUAHistory(Player* player, int32 event_id, int32 value, int32 value2);
+  void SaveCharacterLUAHistory(Player* player, int32 event_id, int32 value, int32 value2, QueryBatch& batch);
   void LoadCharacterLUAHistory(int32 char_id, Player* player);
 
   /* Bots - BotDB.cpp */
@@ -572,6 +589,8 @@ public:
 
 private:
   DatabaseNew database_new;
+  CharacterSaveStats save_stats;
+  mutex save_stats_mutex;
   map<int32, string> zone_names;
   string skills;
   int32 max_zonename;
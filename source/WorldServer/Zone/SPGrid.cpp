@@ -262,17 +262,26 @@ Cell* SPGrid::GetCell(int32 x, int32 z) {
 }
 
 Cell* SPGrid::GetCell(float x, float z) {
+  // Get the cell coordinates relative to the min bounds, spawns outside
+  // of the map bounds are put in the closest edge cell
+  int32 CellX = GetCellCoord(x, m_MinX, m_CellSize, m_NumCellsX);
+  int32 CellZ = GetCellCoord(z, m_MinZ, m_CellSize, m_NumCellsZ);
+
+  return GetCell(CellX, CellZ);
+}
+
+sint32 SPGrid::GetCellCoord(float value, float min, int32 cellSize, int32 numCells) {
   // As cell grid coordinates are all positive we need to
-  // modify the coordinates by subtracting the min bounds
-  float newX = x - m_MinX;
-  float newZ = z - m_MinZ;
+  // modify the coordinate by subtracting the min bounds
+  sint32 coord = (sint32)floor((value - min) / cellSize);
 
-  // Get the cell coordinates by doing int division
-  // with the modified coordinates and the cell size
-  int32 CellX = (int32)(newX / m_CellSize);
-  int32 CellZ = (int32)(newZ / m_CellSize);
+  if (coord < 0)
+    return 0;
 
-  return GetCell(CellX, CellZ);
+  if (coord >= (sint32)numCells)
+    return numCells > 0 ? numCells - 1 : 0;
+
+  return coord;
 }
 
 FaceCell* SPGrid::GetFaceCell(int32 x, int32 z) {
@@ -286,15 +295,9 @@ FaceCell* SPGrid::GetFaceCell(int32 x, int32 z) {
 }
 
 FaceCell* SPGrid::GetFaceCell(float x, float z) {
-  // As cell grid coordinates are all positive we need to
-  // modify the coordinates by subtracting the min bounds
-  float newX = x - m_MinX;
-  float newZ = z - m_MinZ;
-
-  // Get the cell coordinates by doing int division
-  // with the modified coordinates and the cell size
-  int32 CellX = (int32)(newX / FACECELLSIZEDEFAULT);
-  int32 CellZ = (int32)(newZ / FACECELLSIZEDEFAULT);
+  // Get the face cell coordinates relative to the min bounds
+  int32 CellX = GetCellCoord(x, m_MinX, FACECELLSIZEDEFAULT, m_NumFaceCellsX);
+  int32 CellZ = GetCellCoord(z, m_MinZ, FACECELLSIZEDEFAULT, m_NumFaceCellsZ);
 
   return GetFaceCell(CellX, CellZ);
 }
@@ -385,17 +388,80 @@ int32 SPGrid::GetGridID(Spawn* spawn) {
 }
 
 void SPGrid::AddSpawn(Spawn* spawn) {
+  if (m_Cells.empty())
+    return;
+
+  unique_lock<shared_timed_mutex> guard(m_SpawnLock);
+
   Cell* cell = GetCell(spawn->GetX(), spawn->GetZ());
-  AddSpawn(spawn, cell);
+  AddSpawnToCell(spawn, cell);
 }
 
 void SPGrid::AddSpawn(Spawn* spawn, Cell* cell) {
+  unique_lock<shared_timed_mutex> guard(m_SpawnLock);
+
+  AddSpawnToCell(spawn, cell);
+}
+
+void SPGrid::AddSpawnToCell(Spawn* spawn, Cell* cell) {
   cell->SpawnList.push_back(spawn);
   spawn->Cell_Info.CurrentCell = cell;
   spawn->Cell_Info.CellListIndex = cell->SpawnList.size() - 1;
 }
 
 void SPGrid::RemoveSpawnFromCell(Spawn* spawn) {
+  unique_lock<shared_timed_mutex> guard(m_SpawnLock);
+
+  RemoveSpawnFromCurrentCell(spawn);
+}
+
+void SPGrid::UpdateSpawnCell(Spawn* spawn) {
+  Cell* cell = GetCell(spawn->GetX(), spawn->GetZ());
+
+  // Most movement stays inside the same cell, so check under the shared lock first
+  {
+    shared_lock<shared_timed_mutex> guard(m_SpawnLock);
+
+    // Spawns that were never added to the grid (or already removed) are left alone
+    if (spawn->Cell_Info.CurrentCell == nullptr || spawn->Cell_Info.CurrentCell == cell)
+      return;
+  }
+
+  unique_lock<shared_timed_mutex> guard(m_SpawnLock);
+
+  // The spawn may have been moved or removed while the lock was released
+  if (spawn->Cell_Info.CurrentCell == nullptr || spawn->Cell_Info.CurrentCell == cell)
+    return;
+
+  RemoveSpawnFromCurrentCell(spawn);
+  AddSpawnToCell(spawn, cell);
+}
+
+void SPGrid::GetSpawnsInRange(float x, float z, float radius, vector<Spawn*>& spawns) {
+  if (m_Cells.empty())
+    return;
+
+  // Get the cell bounds of the square around the point, every spawn
+  // within the radius is guaranteed to be in one of these cells
+  int32 MinCellX = GetCellCoord(x - radius, m_MinX, m_CellSize, m_NumCellsX);
+  int32 MaxCellX = GetCellCoord(x + radius, m_MinX, m_CellSize, m_NumCellsX);
+  int32 MinCellZ = GetCellCoord(z - radius, m_MinZ, m_CellSize, m_NumCellsZ);
+  int32 MaxCellZ = GetCellCoord(z + radius, m_MinZ, m_CellSize, m_NumCellsZ);
+
+  shared_lock<shared_timed_mutex> guard(m_SpawnLock);
+
+  for (int32 CellZ = MinCellZ; CellZ <= MaxCellZ; CellZ++) {
+    for (int32 CellX = MinCellX; CellX <= MaxCellX; CellX++) {
+      Cell& cell = m_Cells[CellZ * m_NumCellsX + CellX];
+      spawns.insert(spawns.end(), cell.SpawnList.begin(), cell.SpawnList.end());
+    }
+  }
+}
+
+void SPGrid::RemoveSpawnFromCurrentCell(Spawn* spawn) {
+  if (spawn->Cell_Info.CurrentCell == nullptr)
+    return;
+
   vector<Spawn*>& spawns = spawn->Cell_Info.CurrentCell->SpawnList;
 
   // Only do the vector swap if the vector has more than 1 spawn in it
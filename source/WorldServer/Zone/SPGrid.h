@@ -22,6 +22,7 @@ along with EQ2Emulator.  If not, see <http://www.gnu.org/licenses/>.
 #include <vector>
 #include <map>
 #include <cmath>
+#include <shared_mutex>
 #include "../../common/types.h"
 
 class Spawn;
@@ -80,6 +81,12 @@ public:
   // Removes the spawn from the cell it is currently in
   void RemoveSpawnFromCell(Spawn* spawn);
 
+  // Moves the spawn to the cell for its current position if it has left its old cell
+  void UpdateSpawnCell(Spawn* spawn);
+
+  // Fills spawns with every spawn in the cells overlapping the square of the given radius around x, z
+  void GetSpawnsInRange(float x, float z, float radius, std::vector<Spawn*>& spawns);
+
   // Get cell based on cell coordinates
   FaceCell* GetFaceCell(int32 x, int32 z);
 
@@ -87,6 +94,13 @@ public:
   FaceCell* GetFaceCell(float x, float z);
 
 private:
+  // Converts a world coordinate to a cell coordinate clamped to the grid
+  sint32 GetCellCoord(float value, float min, int32 cellSize, int32 numCells);
+
+  void AddSpawnToCell(Spawn* spawn, Cell* cell);
+
+  void RemoveSpawnFromCurrentCell(Spawn* spawn);
+
   // 1-D array for cells as it is better performance wise then 2-D
   std::vector<Cell> m_Cells;
 
@@ -105,4 +119,7 @@ private:
 
   int32 m_NumFaceCellsX;
   int32 m_NumFaceCellsZ;
+
+  // Guards the spawn lists of all cells, spawns move between cells from both the client and spawn threads
+  std::shared_timed_mutex m_SpawnLock;
 };
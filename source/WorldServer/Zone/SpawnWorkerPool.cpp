@@ -0,0 +1,154 @@
+/*
+EQ2Emulator:  Everquest II Server Emulator
+Copyright (C) 2007  EQ2EMulator Development Team (http://www.eq2emulator.net)
+
+This file is part of EQ2Emulator.
+EQ2Emulator is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+EQ2Emulator is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with EQ2Emulator.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "SpawnWorkerPool.h"
+#include "../../common/Log.h"
+
+SpawnWorkerPool::SpawnWorkerPool() {
+  running = false;
+}
+
+SpawnWorkerPool::~SpawnWorkerPool() {
+  Stop();
+}
+
+void SpawnWorkerPool::Start(int32 worker_count) {
+  lock_guard<mutex> guard(jobs_mutex);
+
+  if (running)
+    return;
+
+  if (worker_count == 0) {
+    // the thread asking for the work runs a share of it too
+    worker_count = thread::hardware_concurrency();
+    if (worker_count > 0)
+      worker_count--;
+  }
+
+  running = true;
+
+  for (int32 i = 0; i < worker_count; i++)
+    workers.push_back(thread(&SpawnWorkerPool::WorkerLoop, this));
+
+  LogWrite(ZONE__INFO, 0, "Zone", "Spawn worker pool started with %u workers", worker_count);
+}
+
+void SpawnWorkerPool::Stop() {
+  {
+    lock_guard<mutex> guard(jobs_mutex);
+
+    if (!running)
+      return;
+
+    running = false;
+  }
+
+  jobs_cv.notify_all();
+
+  for (auto& worker : workers)
+    worker.join();
+  workers.clear();
+}
+
+void SpawnWorkerPool::ParallelFor(int32 count, int32 chunk_size, function<void(int32, int32)> work) {
+  if (count == 0)
+    return;
+
+  if (chunk_size == 0)
+    chunk_size = 1;
+
+  bool queue_job;
+  {
+    lock_guard<mutex> guard(jobs_mutex);
+    queue_job = running && !workers.empty() && count >= SPAWN_WORKER_MIN_RANGE;
+  }
+
+  if (!queue_job) {
+    work(0, count);
+    return;
+  }
+
+  shared_ptr<SpawnWorkerJob> job = make_shared<SpawnWorkerJob>();
+  job->work = work;
+  job->count = count;
+  job->chunk_size = chunk_size;
+  job->next = 0;
+  job->finished = 0;
+
+  {
+    lock_guard<mutex> guard(jobs_mutex);
+    jobs.push_back(job);
+  }
+  jobs_cv.notify_all();
+
+  while (RunChunk(job.get()))
+    ;
+
+  // the last chunks may still be running on the workers
+  unique_lock<mutex> lock(jobs_mutex);
+  done_cv.wait(lock, [&]() { return job->finished.load() == job->count; });
+}
+
+int32 SpawnWorkerPool::GetWorkerCount() {
+  lock_guard<mutex> guard(jobs_mutex);
+  return workers.size();
+}
+
+bool SpawnWorkerPool::RunChunk(SpawnWorkerJob* job) {
+  int32 begin = job->next.fetch_add(job->chunk_size);
+  if (begin >= job->count)
+    return false;
+
+  int32 end = begin + job->chunk_size;
+  if (end > job->count)
+    end = job->count;
+
+  job->work(begin, end);
+
+  if (job->finished.fetch_add(end - begin) + (end - begin) == job->count) {
+    lock_guard<mutex> guard(jobs_mutex);
+    done_cv.notify_all();
+  }
+
+  return true;
+}
+
+void SpawnWorkerPool::WorkerLoop() {
+  unique_lock<mutex> lock(jobs_mutex);
+
+  while (true) {
+    jobs_cv.wait(lock, [this]() { return !running || !jobs.empty(); });
+
+    if (!running)
+      break;
+
+    shared_ptr<SpawnWorkerJob> job = jobs.front();
+
+    // every chunk has been claimed, the threads that claimed them finish the job
+    if (job->next.load() >= job->count) {
+      jobs.pop_front();
+      continue;
+    }
+
+    lock.unlock();
+    while (RunChunk(job.get()))
+      ;
+    lock.lock();
+  }
+}
@@ -0,0 +1,74 @@
+/*
+EQ2Emulator:  Everquest II Server Emulator
+Copyright (C) 2007  EQ2EMulator Development Team (http://www.eq2emulator.net)
+
+This file is part of EQ2Emulator.
+EQ2Emulator is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+EQ2Emulator is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with EQ2Emulator.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "../../common/types.h"
+
+using namespace std;
+
+// Ranges smaller than this are run on the calling thread, handing them out costs more than it saves
+#define SPAWN_WORKER_MIN_RANGE 32
+#define SPAWN_WORKER_CHUNK 8
+
+// A range of work split into chunks, every thread that joins in claims the next chunk
+// until none are left
+struct SpawnWorkerJob {
+  function<void(int32, int32)> work;
+  int32 count;
+  int32 chunk_size;
+  atomic<int32> next;
+  atomic<int32> finished;
+};
+
+// Worker threads shared by all zones to spread the read only parts of their spawn loops
+// across cores. The calling thread works on its own range as well, so a range always
+// finishes even while every worker is busy with another zone.
+class SpawnWorkerPool {
+public:
+  SpawnWorkerPool();
+  ~SpawnWorkerPool();
+
+  // 0 workers picks one less than the number of cores
+  void Start(int32 worker_count = 0);
+  void Stop();
+  // Calls work(begin, end) for chunks covering [0, count) and returns once all of them are done
+  void ParallelFor(int32 count, int32 chunk_size, function<void(int32, int32)> work);
+  int32 GetWorkerCount();
+
+private:
+  void WorkerLoop();
+  // Runs the next unclaimed chunk of the job, false if there was none left
+  bool RunChunk(SpawnWorkerJob* job);
+
+  mutex jobs_mutex;
+  condition_variable jobs_cv;
+  condition_variable done_cv;
+  deque<shared_ptr<SpawnWorkerJob>> jobs;
+  vector<thread> workers;
+  bool running;
+};
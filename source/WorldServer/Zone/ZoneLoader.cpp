@@ -0,0 +1,111 @@
+/*
+EQ2Emulator:  Everquest II Server Emulator
+Copyright (C) 2007  EQ2EMulator Development Team (http://www.eq2emulator.net)
+
+This file is part of EQ2Emulator.
+EQ2Emulator is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+EQ2Emulator is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with EQ2Emulator.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "ZoneLoader.h"
+#include "../zoneserver.h"
+#include "../../common/Log.h"
+
+ZoneLoader::ZoneLoader() {
+  active = 0;
+  running = false;
+}
+
+ZoneLoader::~ZoneLoader() {
+  Stop();
+}
+
+void ZoneLoader::Start(int32 worker_count) {
+  lock_guard<mutex> guard(queue_mutex);
+
+  if (running)
+    return;
+
+  if (worker_count == 0)
+    worker_count = ZONE_LOADER_DEFAULT_WORKERS;
+
+  running = true;
+  for (int32 i = 0; i < worker_count; i++)
+    workers.push_back(thread(&ZoneLoader::WorkerLoop, this));
+
+  LogWrite(ZONE__INFO, 0, "Zone", "Zone loader started with %u workers", worker_count);
+}
+
+void ZoneLoader::Stop() {
+  {
+    lock_guard<mutex> guard(queue_mutex);
+
+    if (!running)
+      return;
+
+    running = false;
+  }
+
+  queue_cv.notify_all();
+
+  // the workers finish the queued boots first, a zone that never boots is never deleted
+  for (auto& worker : workers)
+    worker.join();
+  workers.clear();
+}
+
+void ZoneLoader::Boot(ZoneServer* zone) {
+  {
+    lock_guard<mutex> guard(queue_mutex);
+
+    if (running) {
+      queue.push_back(zone);
+      queue_cv.notify_one();
+      return;
+    }
+  }
+
+  zone->Boot();
+}
+
+int32 ZoneLoader::GetBootingCount() {
+  lock_guard<mutex> guard(queue_mutex);
+  return queue.size() + active;
+}
+
+int32 ZoneLoader::GetWorkerCount() {
+  lock_guard<mutex> guard(queue_mutex);
+  return workers.size();
+}
+
+void ZoneLoader::WorkerLoop() {
+  unique_lock<mutex> lock(queue_mutex);
+
+  while (true) {
+    queue_cv.wait(lock, [this]() { return !running || !queue.empty(); });
+
+    if (queue.empty())
+      break;
+
+    ZoneServer* zone = queue.front();
+    queue.pop_front();
+    active++;
+
+    lock.unlock();
+    zone->Boot();
+    lock.lock();
+
+    active--;
+  }
+}
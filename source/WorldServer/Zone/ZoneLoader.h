@@ -0,0 +1,61 @@
+/*
+EQ2Emulator:  Everquest II Server Emulator
+Copyright (C) 2007  EQ2EMulator Development Team (http://www.eq2emulator.net)
+
+This file is part of EQ2Emulator.
+EQ2Emulator is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+EQ2Emulator is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with EQ2Emulator.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "../../common/types.h"
+
+using namespace std;
+
+class ZoneServer;
+
+#define ZONE_LOADER_DEFAULT_WORKERS 2
+
+// Boots new zones off the thread that asked for them. A zone is listed right away and
+// queues up its clients until its data is loaded, then its loops are started.
+class ZoneLoader {
+public:
+  ZoneLoader();
+  ~ZoneLoader();
+
+  // 0 workers uses ZONE_LOADER_DEFAULT_WORKERS
+  void Start(int32 worker_count = 0);
+  void Stop();
+  // Runs zone->Boot() on a loader thread, or right here when the loader isn't running
+  void Boot(ZoneServer* zone);
+  // Zones waiting for a loader thread or being loaded
+  int32 GetBootingCount();
+  int32 GetWorkerCount();
+
+private:
+  void WorkerLoop();
+
+  mutex queue_mutex;
+  condition_variable queue_cv;
+  deque<ZoneServer*> queue;
+  vector<thread> workers;
+  int32 active;
+  bool running;
+};
@@ -0,0 +1,292 @@
+/*
+EQ2Emulator:  Everquest II Server Emulator
+Copyright (C) 2007  EQ2EMulator Development Team (http://www.eq2emulator.net)
+
+This file is part of EQ2Emulator.
+EQ2Emulator is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+EQ2Emulator is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with EQ2Emulator.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "ZoneScheduler.h"
+#include "../../common/Log.h"
+#include <chrono>
+
+ZoneScheduler::ZoneScheduler() {
+  current_slot = 0;
+  wheel_time = 0;
+  scheduled_count = 0;
+  running = false;
+}
+
+ZoneScheduler::~ZoneScheduler() {
+  Stop();
+}
+
+int64 ZoneScheduler::GetSteadyTime() {
+  return chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void ZoneScheduler::Start(int32 worker_count) {
+  lock_guard<mutex> guard(tasks_mutex);
+
+  if (running)
+    return;
+
+  if (worker_count == 0) {
+    // zone tasks can block on the database, so allow more workers than cores
+    worker_count = thread::hardware_concurrency() * 2;
+    if (worker_count < ZONE_SCHEDULER_MIN_WORKERS)
+      worker_count = ZONE_SCHEDULER_MIN_WORKERS;
+  }
+
+  running = true;
+  wheel.resize(ZONE_SCHEDULER_SLOTS);
+  current_slot = 0;
+  wheel_time = GetSteadyTime();
+
+  for (int32 i = 0; i < worker_count; i++)
+    workers.push_back(thread(&ZoneScheduler::WorkerLoop, this));
+  timer_thread = thread(&ZoneScheduler::TimerLoop, this);
+
+  LogWrite(ZONE__INFO, 0, "Zone", "Zone scheduler started with %u workers", worker_count);
+}
+
+void ZoneScheduler::Stop() {
+  {
+    lock_guard<mutex> guard(tasks_mutex);
+
+    if (!running)
+      return;
+
+    running = false;
+  }
+
+  ready_cv.notify_all();
+  timer_cv.notify_all();
+
+  for (auto& worker : workers)
+    worker.join();
+  workers.clear();
+
+  if (timer_thread.joinable())
+    timer_thread.join();
+
+  lock_guard<mutex> guard(tasks_mutex);
+  tasks.clear();
+  ready.clear();
+  wheel.clear();
+  scheduled_count = 0;
+}
+
+shared_ptr<ZoneTask> ZoneScheduler::AddTask(ZoneServer* zone, const char* name, function<sint32()> run, int32 delay) {
+  shared_ptr<ZoneTask> task = make_shared<ZoneTask>();
+  task->zone = zone;
+  task->name = name;
+  task->run = run;
+  task->state = ZONE_TASK_REMOVED;
+  task->wake_pending = false;
+  task->slot = 0;
+  task->rounds = 0;
+
+  lock_guard<mutex> guard(tasks_mutex);
+  tasks.push_back(task);
+  Schedule(task, delay);
+
+  return task;
+}
+
+void ZoneScheduler::Wake(const shared_ptr<ZoneTask>& task) {
+  if (!task)
+    return;
+
+  lock_guard<mutex> guard(tasks_mutex);
+
+  switch (task->state) {
+  case ZONE_TASK_WAITING:
+    Unschedule(task);
+    Enqueue(task);
+    break;
+  case ZONE_TASK_SLEEPING:
+    Enqueue(task);
+    break;
+  case ZONE_TASK_RUNNING:
+    task->wake_pending = true;
+    break;
+  }
+}
+
+void ZoneScheduler::RemoveTasks(ZoneServer* zone) {
+  unique_lock<mutex> lock(tasks_mutex);
+  thread::id self = this_thread::get_id();
+
+  for (auto itr = tasks.begin(); itr != tasks.end();) {
+    shared_ptr<ZoneTask> task = *itr;
+
+    if (task->zone != zone) {
+      itr++;
+      continue;
+    }
+
+    if (task->state == ZONE_TASK_WAITING)
+      Unschedule(task);
+
+    // queued tasks are skipped by the workers once they are marked removed
+    bool is_running = (task->state == ZONE_TASK_RUNNING);
+    task->state = ZONE_TASK_REMOVED;
+
+    if (is_running)
+      itr++;
+    else
+      itr = tasks.erase(itr);
+  }
+
+  // running tasks are dropped from the list by their worker once they return
+  done_cv.wait(lock, [&]() {
+    for (const auto& task : tasks) {
+      if (task->zone == zone && task->worker != thread::id() && task->worker != self)
+        return false;
+    }
+
+    return true;
+  });
+}
+
+int32 ZoneScheduler::GetTaskCount() {
+  lock_guard<mutex> guard(tasks_mutex);
+  return tasks.size();
+}
+
+int32 ZoneScheduler::GetWorkerCount() {
+  lock_guard<mutex> guard(tasks_mutex);
+  return workers.size();
+}
+
+void ZoneScheduler::Schedule(const shared_ptr<ZoneTask>& task, int32 delay) {
+  if (delay == 0 || !running) {
+    Enqueue(task);
+    return;
+  }
+
+  int64 now = GetSteadyTime();
+
+  // the timer thread stops turning the wheel while it is empty
+  if (scheduled_count == 0)
+    wheel_time = now;
+
+  int64 ticks = (now + delay - wheel_time + ZONE_SCHEDULER_TICK - 1) / ZONE_SCHEDULER_TICK;
+  if (ticks == 0)
+    ticks = 1;
+
+  task->slot = (current_slot + ticks) % ZONE_SCHEDULER_SLOTS;
+  task->rounds = (ticks - 1) / ZONE_SCHEDULER_SLOTS;
+  task->state = ZONE_TASK_WAITING;
+
+  list<shared_ptr<ZoneTask>>& slot = wheel[task->slot];
+  task->slot_itr = slot.insert(slot.end(), task);
+
+  if (scheduled_count++ == 0)
+    timer_cv.notify_one();
+}
+
+void ZoneScheduler::Unschedule(const shared_ptr<ZoneTask>& task) {
+  wheel[task->slot].erase(task->slot_itr);
+  scheduled_count--;
+}
+
+void ZoneScheduler::Enqueue(const shared_ptr<ZoneTask>& task) {
+  task->state = ZONE_TASK_QUEUED;
+  ready.push_back(task);
+  ready_cv.notify_one();
+}
+
+void ZoneScheduler::TimerLoop() {
+  unique_lock<mutex> lock(tasks_mutex);
+
+  while (running) {
+    int64 now = GetSteadyTime();
+
+    while (scheduled_count > 0 && wheel_time + ZONE_SCHEDULER_TICK <= now) {
+      wheel_time += ZONE_SCHEDULER_TICK;
+      current_slot = (current_slot + 1) % ZONE_SCHEDULER_SLOTS;
+
+      list<shared_ptr<ZoneTask>>& slot = wheel[current_slot];
+      for (auto itr = slot.begin(); itr != slot.end();) {
+        shared_ptr<ZoneTask> task = *itr;
+
+        if (task->rounds > 0) {
+          task->rounds--;
+          itr++;
+          continue;
+        }
+
+        itr = slot.erase(itr);
+        scheduled_count--;
+        Enqueue(task);
+      }
+    }
+
+    if (scheduled_count == 0)
+      timer_cv.wait(lock);
+    else
+      timer_cv.wait_until(lock, chrono::steady_clock::time_point(chrono::milliseconds(wheel_time + ZONE_SCHEDULER_TICK)));
+  }
+}
+
+void ZoneScheduler::WorkerLoop() {
+  unique_lock<mutex> lock(tasks_mutex);
+
+  while (true) {
+    ready_cv.wait(lock, [this]() { return !running || !ready.empty(); });
+
+    if (!running)
+      break;
+
+    shared_ptr<ZoneTask> task = ready.front();
+    ready.pop_front();
+
+    if (task->state != ZONE_TASK_QUEUED)
+      continue;
+
+    task->state = ZONE_TASK_RUNNING;
+    task->wake_pending = false;
+    task->worker = this_thread::get_id();
+
+    lock.unlock();
+    sint32 delay = task->run();
+    lock.lock();
+
+    task->worker = thread::id();
+
+    if (task->state == ZONE_TASK_REMOVED || (delay < 0 && delay != ZONE_TASK_SLEEP)) {
+      task->state = ZONE_TASK_REMOVED;
+
+      for (auto itr = tasks.begin(); itr != tasks.end(); itr++) {
+        if (*itr == task) {
+          tasks.erase(itr);
+          break;
+        }
+      }
+
+      done_cv.notify_all();
+      continue;
+    }
+
+    if (task->wake_pending) {
+      task->wake_pending = false;
+      Enqueue(task);
+    } else if (delay == ZONE_TASK_SLEEP)
+      task->state = ZONE_TASK_SLEEPING;
+    else
+      Schedule(task, delay);
+  }
+}
@@ -0,0 +1,106 @@
+/*
+EQ2Emulator:  Everquest II Server Emulator
+Copyright (C) 2007  EQ2EMulator Development Team (http://www.eq2emulator.net)
+
+This file is part of EQ2Emulator.
+EQ2Emulator is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+EQ2Emulator is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with EQ2Emulator.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../../common/types.h"
+
+using namespace std;
+
+class ZoneServer;
+
+// Each wheel slot covers ZONE_SCHEDULER_TICK ms, one full turn is ~2.5 seconds
+#define ZONE_SCHEDULER_TICK 5
+#define ZONE_SCHEDULER_SLOTS 512
+#define ZONE_SCHEDULER_MIN_WORKERS 4
+
+#define ZONE_TASK_WAITING 0
+#define ZONE_TASK_QUEUED 1
+#define ZONE_TASK_RUNNING 2
+#define ZONE_TASK_REMOVED 3
+#define ZONE_TASK_SLEEPING 4
+
+// Returned by run() to wait for Wake() instead of a timer
+#define ZONE_TASK_SLEEP -2
+
+// A repeating piece of zone work. run() returns the delay in ms before the task
+// should run again, ZONE_TASK_SLEEP to wait until it is woken or -1 once it is finished.
+struct ZoneTask {
+  ZoneServer* zone;
+  string name;
+  function<sint32()> run;
+  int8 state;
+  bool wake_pending;
+  int32 slot;
+  int32 rounds;
+  list<shared_ptr<ZoneTask>>::iterator slot_itr;
+  thread::id worker;
+};
+
+// Runs the zone loops on a shared pool of workers. Tasks wait on a timer wheel until
+// they are due or woken, so a zone doesn't keep threads of its own and a task is never
+// run by two workers at the same time.
+class ZoneScheduler {
+public:
+  ZoneScheduler();
+  ~ZoneScheduler();
+
+  // 0 workers picks a count from the number of cores
+  void Start(int32 worker_count = 0);
+  void Stop();
+  shared_ptr<ZoneTask> AddTask(ZoneServer* zone, const char* name, function<sint32()> run, int32 delay = 0);
+  // Runs the task as soon as a worker is free, or again right after the current run
+  void Wake(const shared_ptr<ZoneTask>& task);
+  // Stops all tasks of the zone and waits for the ones running on other threads to return
+  void RemoveTasks(ZoneServer* zone);
+  int32 GetTaskCount();
+  int32 GetWorkerCount();
+
+private:
+  void WorkerLoop();
+  void TimerLoop();
+  // tasks_mutex must be held for these
+  void Schedule(const shared_ptr<ZoneTask>& task, int32 delay);
+  void Unschedule(const shared_ptr<ZoneTask>& task);
+  void Enqueue(const shared_ptr<ZoneTask>& task);
+  static int64 GetSteadyTime();
+
+  mutex tasks_mutex;
+  condition_variable ready_cv;
+  condition_variable timer_cv;
+  condition_variable done_cv;
+  vector<shared_ptr<ZoneTask>> tasks;
+  deque<shared_ptr<ZoneTask>> ready;
+  vector<list<shared_ptr<ZoneTask>>> wheel;
+  int32 current_slot;
+  int64 wheel_time;
+  int32 scheduled_count;
+  vector<thread> workers;
+  thread timer_thread;
+  bool running;
+};
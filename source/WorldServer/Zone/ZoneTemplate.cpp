@@ -0,0 +1,192 @@
+/*
+EQ2Emulator:  Everquest II Server Emulator
+Copyright (C) 2007  EQ2EMulator Development Team (http://www.eq2emulator.net)
+
+This file is part of EQ2Emulator.
+EQ2Emulator is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+EQ2Emulator is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with EQ2Emulator.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "ZoneTemplate.h"
+#include "../zoneserver.h"
+#include "../World.h"
+#include "../SpawnLists.h"
+
+ZoneTemplate::ZoneTemplate(int32 zone_id) {
+  this->zone_id = zone_id;
+  has_spawn_locations = false;
+
+  MTransporters.SetName("ZoneTemplate::transporters");
+  MTransportMaps.SetName("ZoneTemplate::m_transportMaps");
+}
+
+ZoneTemplate::~ZoneTemplate() {
+  ClearLootTables();
+
+  map<int32, NPC*>::iterator npc_list_iter;
+  for (npc_list_iter = npc_list.begin(); npc_list_iter != npc_list.end(); npc_list_iter++) {
+    safe_delete(npc_list_iter->second);
+  }
+  npc_list.clear();
+  map<int32, Object*>::iterator object_list_iter;
+  for (object_list_iter = object_list.begin(); object_list_iter != object_list.end(); object_list_iter++) {
+    safe_delete(object_list_iter->second);
+  }
+  object_list.clear();
+  map<int32, GroundSpawn*>::iterator groundspawn_list_iter;
+  for (groundspawn_list_iter = groundspawn_list.begin(); groundspawn_list_iter != groundspawn_list.end(); groundspawn_list_iter++) {
+    safe_delete(groundspawn_list_iter->second);
+  }
+  groundspawn_list.clear();
+  map<int32, Widget*>::iterator widget_list_iter;
+  for (widget_list_iter = widget_list.begin(); widget_list_iter != widget_list.end(); widget_list_iter++) {
+    safe_delete(widget_list_iter->second);
+  }
+  widget_list.clear();
+  map<int32, Sign*>::iterator sign_list_iter;
+  for (sign_list_iter = sign_list.begin(); sign_list_iter != sign_list.end(); sign_list_iter++) {
+    safe_delete(sign_list_iter->second);
+  }
+  sign_list.clear();
+
+  ClearEntityCommands();
+
+  DeleteGroundSpawnItems();
+  DeleteGlobalTransporters();
+  DeleteTransporterMaps();
+  DeleteSpawnLocations();
+}
+
+void ZoneTemplate::ClearEntityCommands() {
+  if (entity_command_list.size() > 0) {
+    map<int32, vector<EntityCommand*>*>::iterator itr;
+    for (itr = entity_command_list.begin(); itr != entity_command_list.end(); itr++) {
+      vector<EntityCommand*>* entity_commands = itr->second;
+      if (entity_commands && entity_commands->size() > 0) {
+        vector<EntityCommand*>::iterator v_itr;
+        for (v_itr = entity_commands->begin(); v_itr != entity_commands->end(); v_itr++)
+          safe_delete(*v_itr);
+        entity_commands->clear();
+      }
+      safe_delete(entity_commands);
+    }
+    entity_command_list.clear();
+  }
+}
+
+// TODO - mis-named, should be DeleteGroundSpawnEntries() but this is ok for now :)
+void ZoneTemplate::DeleteGroundSpawnItems() {
+  map<int32, vector<GroundSpawnEntry*>>::iterator groundspawnentry_map_itr;
+  vector<GroundSpawnEntry*>::iterator groundspawnentry_itr;
+  for (groundspawnentry_map_itr = groundspawn_entries.begin(); groundspawnentry_map_itr != groundspawn_entries.end(); groundspawnentry_map_itr++) {
+    for (groundspawnentry_itr = groundspawnentry_map_itr->second.begin(); groundspawnentry_itr != groundspawnentry_map_itr->second.end(); groundspawnentry_itr++) {
+      safe_delete(*groundspawnentry_itr);
+    }
+  }
+  groundspawn_entries.clear();
+
+  map<int32, vector<GroundSpawnEntryItem*>>::iterator groundspawnitem_map_itr;
+  vector<GroundSpawnEntryItem*>::iterator groundspawnitem_itr;
+  for (groundspawnitem_map_itr = groundspawn_items.begin(); groundspawnitem_map_itr != groundspawn_items.end(); groundspawnitem_map_itr++) {
+    for (groundspawnitem_itr = groundspawnitem_map_itr->second.begin(); groundspawnitem_itr != groundspawnitem_map_itr->second.end(); groundspawnitem_itr++) {
+      safe_delete(*groundspawnitem_itr);
+    }
+  }
+  groundspawn_items.clear();
+}
+
+void ZoneTemplate::ClearLootTables() {
+  map<int32, LootTable*>::iterator table_itr;
+  for (table_itr = loot_tables.begin(); table_itr != loot_tables.end(); table_itr++) {
+    safe_delete(table_itr->second);
+  }
+
+  map<int32, vector<LootDrop*>>::iterator drop_itr;
+  vector<LootDrop*>::iterator drop_itr2;
+  for (drop_itr = loot_drops.begin(); drop_itr != loot_drops.end(); drop_itr++) {
+    for (drop_itr2 = drop_itr->second.begin(); drop_itr2 != drop_itr->second.end(); drop_itr2++) {
+      safe_delete(*drop_itr2);
+    }
+  }
+
+  map<int32, vector<ZoneLoot*>>::iterator zone_itr;
+  vector<ZoneLoot*>::iterator zone_itr2;
+  for (zone_itr = zone_loot_list.begin(); zone_itr != zone_loot_list.end(); zone_itr++) {
+    for (zone_itr2 = zone_itr->second.begin(); zone_itr2 != zone_itr->second.end(); zone_itr2++) {
+      safe_delete(*zone_itr2);
+    }
+  }
+
+  loot_tables.clear();
+  loot_drops.clear();
+  spawn_loot_list.clear();
+  level_loot_list.clear();
+  racial_loot_list.clear();
+  zone_loot_list.clear();
+}
+
+void ZoneTemplate::DeleteGlobalTransporters() {
+  MTransporters.lock();
+  map<int32, vector<TransportDestination*>>::iterator itr;
+  vector<TransportDestination*>::iterator transport_vector_itr;
+  for (itr = transporters.begin(); itr != transporters.end(); itr++) {
+    for (transport_vector_itr = itr->second.begin(); transport_vector_itr != itr->second.end(); transport_vector_itr++) {
+      safe_delete(*transport_vector_itr);
+    }
+  }
+  map<int32, MutexList<LocationTransportDestination*>*>::iterator itr2;
+  for (itr2 = location_transporters.begin(); itr2 != location_transporters.end(); itr2++) {
+    itr2->second->clear(true);
+    delete itr2->second;
+  }
+  transporters.clear();
+  location_transporters.clear();
+  MTransporters.unlock();
+}
+
+void ZoneTemplate::DeleteTransporterMaps() {
+  MTransportMaps.writelock(__FUNCTION__, __LINE__);
+  m_transportMaps.clear();
+  MTransportMaps.releasewritelock(__FUNCTION__, __LINE__);
+}
+
+void ZoneTemplate::DeleteSpawnLocations() {
+  map<int32, SpawnLocation*>::iterator itr;
+  for (itr = spawn_location_list.begin(); itr != spawn_location_list.end(); itr++)
+    safe_delete(itr->second);
+
+  spawn_location_list.clear();
+  spawn_group_associations.clear();
+  spawn_group_chances.clear();
+  spawn_group_locations.clear();
+  spawn_location_groups.clear();
+  has_spawn_locations = false;
+}
+
+shared_ptr<ZoneTemplate> ZoneTemplateList::Get(int32 zone_id) {
+  lock_guard<mutex> guard(templates_mutex);
+
+  map<int32, shared_ptr<ZoneTemplate>>::iterator itr = templates.find(zone_id);
+  if (itr != templates.end())
+    return itr->second;
+
+  return shared_ptr<ZoneTemplate>();
+}
+
+void ZoneTemplateList::Add(const shared_ptr<ZoneTemplate>& zone_template) {
+  lock_guard<mutex> guard(templates_mutex);
+
+  // instances still running on the old template keep it until they shut down
+  templates[zone_template->GetZoneID()] = zone_template;
+}
@@ -0,0 +1,114 @@
+/*
+EQ2Emulator:  Everquest II Server Emulator
+Copyright (C) 2007  EQ2EMulator Development Team (http://www.eq2emulator.net)
+
+This file is part of EQ2Emulator.
+EQ2Emulator is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+EQ2Emulator is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with EQ2Emulator.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+#include "../../common/types.h"
+#include "../../common/Mutex.h"
+#include "../MutexList.h"
+
+using namespace std;
+
+class NPC;
+class Object;
+class Sign;
+class Widget;
+class GroundSpawn;
+class SpawnLocation;
+struct EntityCommand;
+struct GroundSpawnEntry;
+struct GroundSpawnEntryItem;
+struct LootTable;
+struct LootDrop;
+struct ZoneLoot;
+struct TransportDestination;
+struct LocationTransportDestination;
+
+// The spawn, loot and transport data of a zone as loaded from the database. It is
+// shared by every instance of the zone and is only written while it is being loaded,
+// reloads load a fresh copy for the reloading zone and other instances keep the old one.
+class ZoneTemplate {
+public:
+  ZoneTemplate(int32 zone_id);
+  ~ZoneTemplate();
+
+  int32 GetZoneID() { return zone_id; }
+
+  void ClearEntityCommands();
+  void DeleteGroundSpawnItems();
+  void ClearLootTables();
+  void DeleteGlobalTransporters();
+  void DeleteTransporterMaps();
+  void DeleteSpawnLocations();
+
+  map<int32, vector<EntityCommand*>*> entity_command_list;
+  map<int32, map<int32, int8>> npc_spell_list;
+  map<int32, map<int32, int16>> npc_skill_list;
+  map<int32, vector<int32>> npc_equipment_list;
+  map<int32, NPC*> npc_list;
+  map<int32, Object*> object_list;
+  map<int32, Sign*> sign_list;
+  map<int32, Widget*> widget_list;
+  map<int32, vector<GroundSpawnEntry*>> groundspawn_entries;
+  map<int32, vector<GroundSpawnEntryItem*>> groundspawn_items;
+  map<int32, GroundSpawn*> groundspawn_list;
+  map<int32, LootTable*> loot_tables;
+  map<int32, vector<LootDrop*>> loot_drops;
+  map<int32, vector<int32>> spawn_loot_list;
+  map<int8, vector<int32>> level_loot_list;
+  map<int16, vector<int32>> racial_loot_list;
+  map<int32, vector<ZoneLoot*>> zone_loot_list;
+  map<int32, vector<TransportDestination*>> transporters;
+  map<int32, MutexList<LocationTransportDestination*>*> location_transporters;
+  Mutex MTransporters;
+  Mutex MTransportMaps;
+  // Map <transport if, map name>
+  map<int32, string> m_transportMaps;
+  vector<string> pet_names;
+
+  // Copy of the zone's spawn locations and groups, instances start from these instead of the database
+  bool has_spawn_locations;
+  map<int32, SpawnLocation*> spawn_location_list;
+  map<int32, set<int32>> spawn_group_associations;
+  map<int32, float> spawn_group_chances;
+  map<int32, map<int32, int32>> spawn_group_locations;
+  map<int32, list<int32>> spawn_location_groups;
+
+private:
+  int32 zone_id;
+};
+
+// Loaded templates by zone id, kept until the zone's spawns are reloaded
+class ZoneTemplateList {
+public:
+  shared_ptr<ZoneTemplate> Get(int32 zone_id);
+  void Add(const shared_ptr<ZoneTemplate>& zone_template);
+
+private:
+  mutex templates_mutex;
+  map<int32, shared_ptr<ZoneTemplate>> templates;
+};
@@ -41,7 +41,6 @@ along with EQ2Emulator.  If not, see <http://www.gnu.org/licenses/>.
 #include "Chat/Chat.h"
 #include "PVP.h"
 #include <atomic>
-#include <thread>
 
 //#include "Quests.h"
 
@@ -129,6 +128,7 @@ Client::Client(EQStream* ieqs) : pos_update(500), quest_pos_timer(2000), lua_deb
   SetMailTransaction(0);
   timestamp_flag = 0;
   current_quest_id = 0;
+  save_state.current_quest_id = 0;
   last_update_time = 0;
   quest_updates = false;
 
@@ -1043,6 +1043,7 @@ bool Client::HandlePacket(EQApplicationPacket* app) {
       spawn->SetX(place_object->getType_float_ByName("x"));
       spawn->SetY(place_object->getType_float_ByName("y"));
       spawn->SetZ(place_object->getType_float_ByName("z"));
+      spawn->UpdateGridCell();
       spawn->SetHeading(place_object->getType_float_ByName("heading") + 180);
       spawn->SetSpawnOrigX(spawn->GetX());
       spawn->SetSpawnOrigY(spawn->GetY());
@@ -2417,10 +2418,9 @@ bool Client::Process(bool zone_process) {
 
   if (!ret) {
     shared_ptr<Client> client = shared_from_this();
-    thread t([client]() {
+    database.QueueWork(GetCharacterID(), [client]() {
       client->Save();
     });
-    t.detach();
   }
 
   return ret;
@@ -2592,10 +2592,9 @@ void Client::Disconnect(bool send_disconnect) {
     getConnection()->SendDisconnect(true);
 
   shared_ptr<Client> client = shared_from_this();
-  thread t([client]() {
+  database.QueueWork(GetCharacterID(), [client]() {
     client->Save();
   });
-  t.detach();
 
   GetPlayer()->WritePlayerStatistics();
 
@@ -2628,6 +2627,7 @@ bool Client::Summon(const char* search_name) {
       target->SetX(GetPlayer()->GetX());
       target->SetY(GetPlayer()->GetY());
       target->SetZ(GetPlayer()->GetZ());
+      target->UpdateGridCell();
       target->SetHeading(GetPlayer()->GetHeading());
       target->SetLocation(GetPlayer()->GetLocation());
 
@@ -2850,6 +2850,7 @@ bool Client::GotoSpawn(const char* search_name) {
       GetPlayer()->SetX(target->GetX());
       GetPlayer()->SetY(target->GetY());
       GetPlayer()->SetZ(target->GetZ());
+      GetPlayer()->UpdateGridCell();
       GetPlayer()->SetHeading(target->GetHeading());
       GetPlayer()->SetLocation(target->GetLocation());
       Message(CHANNEL_COLOR_YELLOW, "Warping to '%s'", target->GetName());
@@ -2986,13 +2987,12 @@ void Client::Zone(ZoneServer* new_zone, bool set_coords) {
   set_next_zone_coords = set_coords;
 
   shared_ptr<Client> client = shared_from_this();
-  thread t([this, client]() {
+  database.QueueWork(GetCharacterID(), [this, client]() {
     database.SavePlayerActiveSpells(shared_from_this());
     client->Save();
 
     waiting_to_zone = false;
   });
-  t.detach();
 }
 
 void Client::Zone(const char* new_zone, bool set_coords) {
@@ -3118,20 +3118,26 @@ void Client::Save() {
 
     UpdateCharacterInstances();
 
-    database.Save(shared_from_this());
+    QueryBatch batch;
+    database.Save(shared_from_this(), batch);
 
     if (GetPlayer()->UpdateQuickbarNeeded()) {
       lock_guard<mutex> guard(GetPlayer()->quickbar_mutex);
 
-      database.SaveQuickBar(GetCharacterID(), GetPlayer()->GetQuickbar());
+      database.SaveQuickBar(GetCharacterID(), GetPlayer()->GetQuickbar(), batch);
       GetPlayer()->ResetQuickbarNeeded();
+
+      Player* player = GetPlayer();
+      batch.OnFailure([player]() { player->SetQuickbarNeeded(); });
     }
 
-    database.SaveItems(shared_from_this());
-    database.SaveBuyBacks(shared_from_this());
+    database.SaveItems(shared_from_this(), batch);
+    database.SaveBuyBacks(shared_from_this(), batch);
+
+    GetPlayer()->SaveHistory(batch);
+    GetPlayer()->SaveLUAHistory(batch);
 
-    GetPlayer()->SaveHistory();
-    GetPlayer()->SaveLUAHistory();
+    database.SaveCharacterBatch(shared_from_this(), batch);
   }
 }
 
@@ -7578,84 +7584,57 @@ void Client::AddChangedSpawn(shared_ptr<SpawnUpdate> spawn_update) {
       return;
     }
 
-    lock_guard<mutex> guard(update_mutex);
+    int8 flags = 0;
 
     if (spawn_update->info_changed) {
-      bool has_update = false;
-
-      for (int32 spawn_id : info_changes) {
-        if (spawn_update->spawn_id == spawn_id) {
-          has_update = true;
-          break;
-        }
-      }
-
-      if (!has_update) {
-        info_changes.push_back(spawn_update->spawn_id);
-      }
+      flags |= SPAWN_UPDATE_INFO;
     }
 
     if (spawn_update->pos_changed) {
-      bool has_update = false;
+      flags |= SPAWN_UPDATE_POS;
+    }
 
-      for (int32 spawn_id : pos_changes) {
-        if (spawn_update->spawn_id == spawn_id) {
-          has_update = true;
-          break;
-        }
-      }
+    if (spawn_update->vis_changed) {
+      flags |= SPAWN_UPDATE_VIS;
+    }
 
-      if (!has_update) {
-        pos_changes.push_back(spawn_update->spawn_id);
-      }
+    if (flags == 0) {
+      return;
     }
 
-    if (spawn_update->vis_changed) {
-      bool has_update = false;
+    lock_guard<mutex> guard(update_mutex);
 
-      for (int32 spawn_id : vis_changes) {
-        if (spawn_update->spawn_id == spawn_id) {
-          has_update = true;
-          break;
-        }
-      }
+    PendingSpawnUpdate& pending = pending_spawn_updates[spawn_update->spawn_id];
 
-      if (!has_update) {
-        vis_changes.push_back(spawn_update->spawn_id);
-      }
+    // a spawn that is already queued keeps its place
+    if (pending.flags == 0) {
+      pending.queued_tick = GetCurrentZone()->GetSpawnUpdateTick();
     }
+
+    pending.flags |= flags;
   }
 }
 
 void Client::RemoveChangedSpawn(int32 spawn_id) {
   lock_guard<mutex> guard(update_mutex);
+  pending_spawn_updates.erase(spawn_id);
+}
 
-  for (auto itr = info_changes.begin(); itr != info_changes.end();) {
-    if (*itr == spawn_id) {
-      info_changes.erase(itr);
-      break;
-    } else {
-      ++itr;
-    }
-  }
+// Lower goes first. Starts from the distance to the player, the player's own spawn and
+// target go first, spawns attacking the player and group members count as closer.
+float Client::GetSpawnUpdatePriority(Spawn* spawn, const PendingSpawnUpdate& pending, int32 tick) {
+  Player* player = GetPlayer();
+  float priority = player->GetDistance(spawn);
 
-  for (auto itr = pos_changes.begin(); itr != pos_changes.end();) {
-    if (*itr == spawn_id) {
-      pos_changes.erase(itr);
-      break;
-    } else {
-      ++itr;
-    }
+  if (spawn == player || spawn == player->GetTarget()) {
+    priority = 0;
+  } else if (spawn->GetTarget() == player || (spawn->IsPlayer() && player->IsGroupMember((Entity*)spawn))) {
+    priority *= 0.25f;
+  } else if (spawn->IsPlayer()) {
+    priority *= 0.5f;
   }
 
-  for (auto itr = vis_changes.begin(); itr != vis_changes.end();) {
-    if (*itr == spawn_id) {
-      vis_changes.erase(itr);
-      break;
-    } else {
-      ++itr;
-    }
-  }
+  return priority - (tick - pending.queued_tick) * SPAWN_UPDATE_AGE_DISTANCE;
 }
 
 void Client::SendSpawnChanges(bool only_pos_changes, bool only_players) {
@@ -7663,122 +7642,97 @@ void Client::SendSpawnChanges(bool only_pos_changes, bool only_players) {
     return;
   }
 
-  int8 max_info = 1;
-  int8 max_pos = 10;
-  int8 max_vis = 1;
-
-  int8 cur_info = 0;
-  int8 cur_pos = 0;
-  int8 cur_vis = 0;
-
-  set<Spawn*> spawns_to_send;
-
-  lock_guard<mutex> guard(update_mutex);
-
-  while (!info_changes.empty() && cur_info < max_info) {
-    int32 spawn_id = info_changes.front();
-
-    Spawn* spawn = GetCurrentZone()->GetSpawnByID(spawn_id);
-
-    if (spawn) {
-      spawn->info_changed = true;
-      spawns_to_send.insert(spawn);
-      ++cur_info;
-    }
+  ZoneServer* zone = GetCurrentZone();
+  int32 tick = zone->GetSpawnUpdateTick();
+  int32 byte_budget = rule_manager.GetGlobalRule(R_Zone, SpawnUpdateByteBudget)->GetInt32();
 
-    info_changes.pop_front();
-  }
+  map<int32, SpawnData> info_changes;
+  map<int32, SpawnData> pos_changes;
+  map<int32, SpawnData> vis_changes;
 
-  while (!pos_changes.empty() && cur_pos < max_pos) {
-    int32 spawn_id = pos_changes.front();
+  int32 info_size = 0;
+  int32 pos_size = 0;
+  int32 vis_size = 0;
 
-    Spawn* spawn = GetCurrentZone()->GetSpawnByID(spawn_id);
+  {
+    lock_guard<mutex> guard(update_mutex);
 
-    if (spawn) {
-      spawn->position_changed = true;
-      spawns_to_send.insert(spawn);
-      ++cur_pos;
+    if (pending_spawn_updates.empty()) {
+      return;
     }
 
-    pos_changes.pop_front();
-  }
+    vector<pair<float, Spawn*>> ranked;
+    ranked.reserve(pending_spawn_updates.size());
 
-  while (!vis_changes.empty() && cur_vis < max_vis) {
-    int32 spawn_id = vis_changes.front();
+    for (auto itr = pending_spawn_updates.begin(); itr != pending_spawn_updates.end();) {
+      Spawn* spawn = zone->GetSpawnByID(itr->first);
 
-    Spawn* spawn = GetCurrentZone()->GetSpawnByID(spawn_id);
+      if (!spawn) {
+        itr = pending_spawn_updates.erase(itr);
+        continue;
+      }
 
-    if (spawn) {
-      spawn->vis_changed = true;
-      spawns_to_send.insert(spawn);
-      ++cur_vis;
+      ranked.push_back(make_pair(GetSpawnUpdatePriority(spawn, itr->second, tick), spawn));
+      ++itr;
     }
 
-    vis_changes.pop_front();
-  }
+    sort(ranked.begin(), ranked.end(), [](const pair<float, Spawn*>& a, const pair<float, Spawn*>& b) { return a.first < b.first; });
 
-  if (spawns_to_send.size() > 0) {
-    SendSpawnChanges(spawns_to_send);
-  }
-}
+    // the budget is checked after each spawn, so at least one goes out every tick
+    for (const auto& entry : ranked) {
+      if (info_size + pos_size + vis_size >= byte_budget) {
+        break;
+      }
 
-void Client::SendSpawnChanges(set<Spawn*>& spawns) {
-  map<int32, SpawnData> info_changes;
-  map<int32, SpawnData> pos_changes;
-  map<int32, SpawnData> vis_changes;
+      Spawn* spawn = entry.second;
+      auto pending = pending_spawn_updates.find(spawn->GetID());
+      int8 flags = pending->second.flags;
+      pending_spawn_updates.erase(pending);
 
-  int32 info_size = 0;
-  int32 pos_size = 0;
-  int32 vis_size = 0;
-
-  for (const auto& spawn : spawns) {
-    int16 index = player->player_spawn_index_map[spawn];
+      int16 index = player->player_spawn_index_map[spawn];
 
-    if (spawn->info_changed) {
-      auto info_change = spawn->spawn_info_changes(GetPlayer(), GetVersion());
+      if (flags & SPAWN_UPDATE_INFO) {
+        auto info_change = spawn->spawn_info_changes(GetPlayer(), GetVersion());
 
-      if (info_change) {
-        SpawnData data;
-        data.spawn = spawn;
-        data.data = info_change;
-        data.size = spawn->info_packet_size;
-        info_size += spawn->info_packet_size;
+        if (info_change) {
+          SpawnData data;
+          data.spawn = spawn;
+          data.data = info_change;
+          data.size = spawn->info_packet_size;
+          info_size += spawn->info_packet_size;
 
-        info_changes[index] = data;
+          info_changes[index] = data;
+        }
       }
-    }
 
-    if (spawn->position_changed) {
-      auto pos_change = spawn->spawn_pos_changes(GetPlayer(), GetVersion());
+      if (flags & SPAWN_UPDATE_POS) {
+        auto pos_change = spawn->spawn_pos_changes(GetPlayer(), GetVersion());
 
-      if (pos_change) {
-        SpawnData data;
-        data.spawn = spawn;
-        data.data = pos_change;
-        data.size = spawn->pos_packet_size;
-        pos_size += spawn->pos_packet_size;
+        if (pos_change) {
+          SpawnData data;
+          data.spawn = spawn;
+          data.data = pos_change;
+          data.size = spawn->pos_packet_size;
+          pos_size += spawn->pos_packet_size;
 
-        pos_changes[index] = data;
+          pos_changes[index] = data;
+        }
       }
-    }
 
-    if (spawn->vis_changed) {
-      auto vis_change = spawn->spawn_vis_changes(GetPlayer(), GetVersion());
+      if (flags & SPAWN_UPDATE_VIS) {
+        auto vis_change = spawn->spawn_vis_changes(GetPlayer(), GetVersion());
 
-      if (vis_change) {
-        SpawnData data;
-        data.spawn = spawn;
-        data.data = vis_change;
-        data.size = spawn->vis_packet_size;
-        vis_size += spawn->vis_packet_size;
+        if (vis_change) {
+          SpawnData data;
+          data.spawn = spawn;
+          data.data = vis_change;
+          data.size = spawn->vis_packet_size;
+          vis_size += spawn->vis_packet_size;
 
-        vis_changes[index] = data;
+          vis_changes[index] = data;
+        }
       }
     }
-
-    spawn->info_changed = false;
-    spawn->position_changed = false;
-    spawn->vis_changed = false;
   }
 
   if (info_size == 0 && pos_size == 0 && vis_size == 0) {
@@ -22,6 +22,7 @@
 #include <atomic>
 #include <mutex>
 #include <set>
+#include <unordered_map>
 #include "Player.h"
 
 class Collection;
@@ -136,6 +137,28 @@ struct IncomingPaperdollImage {
   int8 image_type;
 };
 
+// What the last save wrote for rows that have no save_needed flag of their own
+struct CharacterSaveState {
+  string character_row;
+  string details_row;
+  int32 current_quest_id;
+  map<int32, sint32> factions;
+  vector<int32> overflow_items;
+};
+
+#define SPAWN_UPDATE_INFO 1
+#define SPAWN_UPDATE_POS 2
+#define SPAWN_UPDATE_VIS 4
+
+// Every update tick a spawn update waits counts as this much less distance, so far
+// away spawns still get their turn once the closer ones have been sent
+#define SPAWN_UPDATE_AGE_DISTANCE 10.0f
+
+struct PendingSpawnUpdate {
+  int8 flags;
+  int32 queued_tick;
+};
+
 class Client : public enable_shared_from_this<Client> {
 public:
   Client(EQStream* ieqs);
@@ -238,6 +261,7 @@ public:
   int8 GetTimeStampFlag() { return timestamp_flag; }
   bool UpdateQuickbarNeeded();
   void Save();
+  CharacterSaveState* GetSaveState() { return &save_state; }
   bool remove_from_list;
   void CloseLoot();
   void SendPendingLoot(int32 total_coins, Entity* entity);
@@ -401,7 +425,7 @@ private:
   void GiveQuestReward(Quest* quest);
   void SetStepComplete(int32 quest_id, int32 step);
   void AddStepProgress(int32 quest_id, int32 step, int32 progress);
-  void SendSpawnChanges(set<Spawn*>& spawns);
+  float GetSpawnUpdatePriority(Spawn* spawn, const PendingSpawnUpdate& pending, int32 tick);
 
   map<int32, map<int32, int32>> quest_pending_updates;
   vector<QueuedQuest*> quest_queue;
@@ -414,6 +438,7 @@ private:
   Spawn* transport_spawn;
   Mutex MBuyBack;
   deque<BuyBackItem*> buy_back_items;
+  CharacterSaveState save_state;
   Spawn* merchant_transaction;
   Spawn* mail_transaction;
   Mutex MPendingQuestAccept;
@@ -489,9 +514,8 @@ private:
   bool on_auto_mount;
   bool EntityCommandPrecheck(Spawn* spawn, const char* command);
 
-  deque<int32> info_changes;
-  deque<int32> pos_changes;
-  deque<int32> vis_changes;
+  // spawn updates waiting to be sent by spawn id, SendSpawnChanges() picks them by priority
+  unordered_map<int32, PendingSpawnUpdate> pending_spawn_updates;
 
   mutex update_mutex;
 };
@@ -36,6 +36,7 @@ using namespace std;
 #include "../common/timer.h"
 #include "../common/EQStreamFactory.h"
 #include "../common/EQStream.h"
+#include "../common/EventLoop.h"
 #include "net.h"
 
 #include "Variables.h"
@@ -79,6 +80,7 @@ using namespace std;
 NetConnection net;
 World world;
 EQStreamFactory eqsf(LoginStream);
+EventLoop world_events;
 LoginServer loginserver;
 MasterServer master_server;
 LuaInterface* lua_interface = new LuaInterface();
@@ -87,6 +89,10 @@ LuaInterface* lua_interface = new LuaInterface();
 #include "Titles.h"
 #include "Languages.h"
 #include "Achievements/Achievements.h"
+#include "Zone/ZoneScheduler.h"
+#include "Zone/SpawnWorkerPool.h"
+#include "Zone/ZoneTemplate.h"
+#include "Zone/ZoneLoader.h"
 
 #include "Patch/patch.h"
 
@@ -108,6 +114,10 @@ ConfigReader configReader;
 int32 MasterItemList::next_unique_id = 0;
 int last_signal = 0;
 RuleManager rule_manager;
+ZoneScheduler zone_scheduler;
+SpawnWorkerPool spawn_worker_pool;
+ZoneTemplateList zone_templates;
+ZoneLoader zone_loader;
 MasterTitlesList master_titles_list;
 MasterLanguagesList master_languages_list;
 extern MasterAchievementList master_achievement_list;
@@ -295,12 +305,6 @@ int main(int argc, char** argv) {
     return 1;
   }
 
-  Timer InterserverTimer(INTERSERVER_TIMER); // does MySQL pings and auto-reconnect
-  InterserverTimer.Trigger();
-
-  Timer* TimeoutTimer = new Timer(5000);
-  TimeoutTimer->Start();
-
   UpdateWindowTitle(0);
 
   LogWrite(ZONE__INFO, 0, "Zone", "Starting static zones...");
@@ -308,6 +312,20 @@ int main(int argc, char** argv) {
 
   map<EQStream*, int32> connecting_clients;
 
+  // periodic work is flagged by its own timer and run by the next pass, new streams and client packets wake the loop right away
+  bool world_due = true;
+  bool servers_due = true;
+  bool timeouts_due = false;
+  bool interserver_due = true; // does MySQL pings and auto-reconnect
+  world_events.Open();
+  world_events.AddTimer(WORLD_PROCESS_INTERVAL, [&world_due]() { world_due = true; });
+  world_events.AddTimer(SERVER_PROCESS_INTERVAL, [&servers_due]() { servers_due = true; });
+  world_events.AddTimer(CLIENT_PROCESS_INTERVAL, []() {}); // the client list runs on every pass
+  world_events.AddTimer(STREAM_TIMEOUT_INTERVAL, [&timeouts_due]() { timeouts_due = true; });
+  world_events.AddTimer(INTERSERVER_TIMER, [&interserver_due]() { interserver_due = true; });
+  eqsf.SetPacketCallback([]() { world_events.Wake(); });
+  eqsf.SetNewStreamCallback([]() { world_events.Wake(); });
+
   //LogWrite(WORLD__DEBUG, 0, "Thread", "Starting console command thread...");
   //thread thr3(EQ2ConsoleListener, nullptr);
   //thr3.detach();
@@ -359,17 +377,26 @@ int main(int argc, char** argv) {
       }
     }
 
-    world.Process();
+    if (world_due) {
+      world_due = false;
+      world.Process();
+    }
+
     client_list.Process();
-    loginserver.Process();
-    master_server.Process();
 
-    if (TimeoutTimer->Check()) {
+    if (servers_due) {
+      servers_due = false;
+      loginserver.Process();
+      master_server.Process();
+    }
+
+    if (timeouts_due) {
+      timeouts_due = false;
       eqsf.CheckTimeout();
     }
 
-    if (InterserverTimer.Check()) {
-      InterserverTimer.Start();
+    if (interserver_due) {
+      interserver_due = false;
       database.ping();
 
       if (getenv("MASTER_SERVER_ENABLED") == "true" && !master_server.Connected() && master_server.Connect()) {
@@ -385,7 +412,7 @@ int main(int argc, char** argv) {
       }
     }
 
-    this_thread::yield();
+    world_events.RunOnce();
   }
 
   LogWrite(WORLD__DEBUG, 0, "World", "The world is ending!");
@@ -395,10 +422,12 @@ int main(int argc, char** argv) {
 
   LogWrite(WORLD__DEBUG, 0, "World", "Shutting down zones...");
   zone_list.ShutDownZones();
+  zone_loader.Stop();
+  zone_scheduler.Stop();
+  spawn_worker_pool.Stop();
 
   LogWrite(WORLD__DEBUG, 0, "World", "Shutting down LUA interface...");
   safe_delete(lua_interface);
-  safe_delete(TimeoutTimer);
   eqsf.Close();
   map<int16, OpcodeManager*>::iterator opcode_itr;
   for (opcode_itr = EQOpcodeManager.begin(); opcode_itr != EQOpcodeManager.end(); opcode_itr++) {
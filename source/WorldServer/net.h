@@ -44,6 +44,10 @@ void WelcomeHeader();
 
 #define PORT 9000
 #define LOGIN_PORT 9100
+#define WORLD_PROCESS_INTERVAL 1000 // ms between world timer checks
+#define SERVER_PROCESS_INTERVAL 50 // ms between login and master server packet polls
+#define CLIENT_PROCESS_INTERVAL 50 // ms between client passes when no packets arrive
+#define STREAM_TIMEOUT_INTERVAL 5000 // ms between stream timeout checks
 
 class NetConnection {
 public:
@@ -71,6 +71,7 @@ extern int errno;
 #include "Factions.h"
 #include "VisualStates.h"
 #include "ClientPacketFunctions.h"
+#include "PacketBroadcast.h"
 #include "SpellProcess.h"
 #include "../common/Log.h"
 #include "Rules/Rules.h"
@@ -82,6 +83,10 @@ extern int errno;
 #include "PVP.h"
 
 #include "Zone/SPGrid.h"
+#include "Zone/ZoneScheduler.h"
+#include "Zone/SpawnWorkerPool.h"
+#include "Zone/ZoneTemplate.h"
+#include "Zone/ZoneLoader.h"
 #include "Bots/Bot.h"
 
 #ifdef WIN32
@@ -103,6 +108,10 @@ extern LuaInterface* lua_interface;
 extern MasterFactionList master_faction_list;
 extern VisualStates visual_states;
 extern RuleManager rule_manager;
+extern ZoneScheduler zone_scheduler;
+extern SpawnWorkerPool spawn_worker_pool;
+extern ZoneTemplateList zone_templates;
+extern ZoneLoader zone_loader;
 extern Chat chat;
 extern MasterRaceTypeList race_types_list;
 extern MasterSpellList master_spell_list;
@@ -110,6 +119,12 @@ extern MasterSkillList master_skill_list;
 
 int32 MinInstanceID = 1000;
 
+// sent for every spawn leaving range, so the struct id is only looked up once
+static int32 GetDestroyGhostStructID() {
+  static const int32 struct_id = configReader.GetStructID("WS_DestroyGhostCmd");
+  return struct_id;
+}
+
 ZoneServer::ZoneServer(const char* name) {
   depop_zone = false;
   repop_zone = false;
@@ -129,6 +144,7 @@ ZoneServer::ZoneServer(const char* name) {
   zone_motd = "";
   finished_depop = true;
   initial_spawn_threads_active = 0;
+  data_loader_active = false;
   minimumStatus = 0;
   minimumLevel = 0;
   maximumLevel = 0;
@@ -156,12 +172,22 @@ ZoneServer::ZoneServer(const char* name) {
   zone_file;
 
   reloading = true;
+  spawn_update_tick = 0;
+  // replaced by the shared template of the zone once its data is loaded
+  zone_template = make_shared<ZoneTemplate>(0);
+  force_template_reload = false;
+  publish_template = false;
+  spawn_locations_from_template = false;
+  booting = false;
+  spawn_data_loaded = false;
 }
 
 ZoneServer::~ZoneServer() {
   zoneShuttingDown = true; //ensure other threads shut down too
   //allow other threads to properly shut down
-  while (spawnthread_active || initial_spawn_threads_active > 0) {
+  while (spawnthread_active || initial_spawn_threads_active > 0 || data_loader_active) {
+    if (data_loader_active)
+      LogWrite(ZONE__DEBUG, 7, "Zone", "Zone shutdown waiting on data loader thread");
     if (spawnthread_active)
       LogWrite(ZONE__DEBUG, 7, "Zone", "Zone shutdown waiting on spawn thread");
     if (initial_spawn_threads_active > 0)
@@ -186,7 +212,8 @@ ZoneServer::~ZoneServer() {
   DelayedSpawnRemoval(true);
   DeleteSpawns(true);
 
-  DeleteGlobalSpawns();
+  // the template is freed with the last instance using it
+  zone_template.reset();
 
   DeleteFlightPaths();
 
@@ -222,26 +249,19 @@ void ZoneServer::Init() {
   //AddSpawn(unknown_spawn);
 
   /* Dynamic Timers */
-  regenTimer.Start(rule_manager.GetGlobalRule(R_Zone, RegenTimer)->GetInt32());
   shutdownTimer.Disable();
-  spawn_range.Start(rule_manager.GetGlobalRule(R_Zone, CheckAttackPlayer)->GetInt32());
-  aggro_timer.Start(rule_manager.GetGlobalRule(R_Zone, CheckAttackNPC)->GetInt32());
 
   /* Weather stuff */
   InitWeather();
 
   /* Static Timers */
   // JA - haven't decided yet if these should remain hard-coded. Changing them could break EQ2Emu functionality
-  spawn_check_add.Start(1000);
-  spawn_check_remove.Start(1000);
   spawn_expire_timer.Start(10000);
-  respawn_timer.Start(10000);
   // there was never a starter for these?
   widget_timer.Start(5000);
 
   tracking_timer.Start(5000);
 
-  movement_timer.Start(5);
   location_prox_timer.Start(1000);
   location_grid_timer.Start(1000);
 
@@ -255,28 +275,13 @@ void ZoneServer::Init() {
   sscanf(rule_manager.GetGlobalRule(R_World, DawnTime)->GetString(), "%d:%d", &dawn_hour, &dawn_minute);
 
   player_pos_update.Start(125);
-  spawn_update.Start(100); //rule_manager.GetGlobalRule(R_Zone, SpawnUpdateTimer)->GetInt16());
   spawn_pos_update.Start(200);
 
   spawn_delete_timer = rule_manager.GetGlobalRule(R_Zone, SpawnDeleteTimer)->GetInt32();
 
-  database.LoadZoneFlightPaths(this);
-
   world.UpdateServerStatistic(STAT_SERVER_NUM_ACTIVE_ZONES, 1);
   UpdateWindowTitle(0);
 
-  if (Grid == nullptr) {
-    Grid = new SPGrid(string(GetZoneFile()), 0);
-    if (Grid->Init())
-      LogWrite(ZONE__DEBUG, 0, "SPGrid", "ZoneServer::Init() successfully initialized the grid");
-    else {
-      LogWrite(ZONE__DEBUG, 0, "SPGrid", "ZoneServer::Init() failed to initialize the grid... poor tron...");
-      delete Grid;
-      Grid = nullptr;
-    }
-  } else
-    LogWrite(ZONE__ERROR, 0, "SPGrid", "ZoneServer::Init() Grid is not null in init, wtf!");
-
   MMasterSpawnLock.SetName("ZoneServer::MMasterSpawnLock");
   m_npc_faction_list.SetName("ZoneServer::npc_faction_list");
   m_enemy_faction_list.SetName("ZoneServer::enemy_faction_list");
@@ -284,7 +289,6 @@ void ZoneServer::Init() {
   MDeadSpawns.SetName("ZoneServer::dead_spawns");
   MTransportSpawns.SetName("ZoneServer::transport_spawns");
   MSpawnList.SetName("ZoneServer::spawn_list");
-  MTransporters.SetName("ZoneServer::m_transportMaps");
   MSpawnGroupAssociation.SetName("ZoneServer::spawn_group_associations");
   MSpawnGroupLocations.SetName("ZoneServer::spawn_group_locations");
   MSpawnLocationGroups.SetName("ZoneServer::spawn_location_groups");
@@ -295,14 +299,132 @@ void ZoneServer::Init() {
   MSpawnScriptTimers.SetName("ZoneServer::spawn_script_timers");
   MRemoveSpawnScriptTimersList.SetName("ZoneServer::remove_spawn_script_timers_list");
 
-  thread z(std::bind(ZoneLoop, this));
-  z.detach();
+  // the data is loaded on a zone loader thread, clients wait in incoming_clients until it is done
+  booting = true;
+  zone_loader.Start(rule_manager.GetGlobalRule(R_Zone, ZoneLoaderThreads)->GetInt32());
+  zone_loader.Boot(this);
+}
+
+void ZoneServer::Boot() {
+#ifndef NO_CATCH
+  try {
+#endif
+    if (!zoneShuttingDown) {
+      database.LoadZoneFlightPaths(this);
+
+      if (Grid == nullptr) {
+        Grid = new SPGrid(string(GetZoneFile()), 0);
+        if (Grid->Init())
+          LogWrite(ZONE__DEBUG, 0, "SPGrid", "ZoneServer::Boot() successfully initialized the grid");
+        else {
+          LogWrite(ZONE__DEBUG, 0, "SPGrid", "ZoneServer::Boot() failed to initialize the grid... poor tron...");
+          delete Grid;
+          Grid = nullptr;
+        }
+      } else
+        LogWrite(ZONE__ERROR, 0, "SPGrid", "ZoneServer::Boot() Grid is not null in init, wtf!");
+
+      LoadZoneTemplate();
+      reloading = false;
+      LoadSpawnData();
+      spawn_data_loaded = true;
+    }
+#ifndef NO_CATCH
+  } catch (...) {
+    LogWrite(ZONE__ERROR, 0, "Zone", "Exception while loading '%s'", GetZoneName());
+    zoneShuttingDown = true;
+  }
+#endif
+
+  LogWrite(ZONE__INFO, 0, "Zone", "Zone '%s' finished loading", zone_name);
+  booting = false;
+
+  zone_scheduler.Start(rule_manager.GetGlobalRule(R_Zone, ZoneWorkerThreads)->GetInt32());
+  spawn_worker_pool.Start(rule_manager.GetGlobalRule(R_Zone, SpawnWorkerThreads)->GetInt32());
+
+  spawnthread_active = true;
+  zone_task = zone_scheduler.AddTask(this, "ZoneProcess", std::bind(ZoneLoop, this));
+  spawn_task = zone_scheduler.AddTask(this, "SpawnProcess", std::bind(SpawnLoop, this));
+
+  // each subsystem only runs when its own interval is due
+  movement_task = AddZoneTask("Movement", ZONE_MOVEMENT_INTERVAL, false, [this]() { MovementProcess(); });
+  aggro_task = AddZoneTask("Aggro", rule_manager.GetGlobalRule(R_Zone, CheckAttackNPC)->GetInt32(), false, [this]() { AggroProcess(); });
+  regen_task = AddZoneTask("Regen", rule_manager.GetGlobalRule(R_Zone, RegenTimer)->GetInt32(), true, [this]() { RegenUpdate(); });
+  range_task = AddZoneTask("SpawnRange", rule_manager.GetGlobalRule(R_Zone, CheckAttackPlayer)->GetInt32(), false, [this]() { CheckSpawnRanges(true, false); });
+  visibility_task = AddZoneTask("SpawnVisibility", ZONE_VISIBILITY_INTERVAL, false, [this]() { CheckSpawnRanges(false, true); });
+  update_task = AddZoneTask("SpawnUpdate", ZONE_SPAWN_UPDATE_INTERVAL, false, [this]() { SpawnUpdateProcess(); });
+  respawn_task = AddZoneTask("Respawn", ZONE_RESPAWN_INTERVAL, true, [this]() { CheckRespawns(); });
+  if (weather_enabled)
+    weather_task = AddZoneTask("Weather", rule_manager.GetGlobalRule(R_Zone, WeatherTimer)->GetInt32(), true, [this]() { ProcessWeather(); });
+}
+
+shared_ptr<ZoneTask> ZoneServer::AddZoneTask(const char* name, int32 interval, bool zone_lock, function<void()> work) {
+  // a rule of 0 used to run the old timer on every pass of the zone loop
+  if (interval < ZONE_TASK_MIN_INTERVAL)
+    interval = ZONE_TASK_MIN_INTERVAL;
+
+  return zone_scheduler.AddTask(this, name, std::bind(&ZoneServer::RunZoneTask, this, interval, zone_lock, work), interval);
+}
+
+sint32 ZoneServer::GetProcessDelay() {
+  if (GetClientCount() > 0)
+    return ZONE_PROCESS_INTERVAL;
 
-  thread s(std::bind(SpawnLoop, this));
-  s.detach();
+  // an empty zone only runs again to shut down, clients and their packets wake it
+  if (shutdownTimer.Enabled()) {
+    int32 remaining = shutdownTimer.GetRemainingTime();
+    return remaining < ZONE_TASK_MIN_INTERVAL ? ZONE_TASK_MIN_INTERVAL : remaining;
+  }
 
-  thread u(std::bind(UpdateLoop, this));
-  u.detach();
+  return ZONE_TASK_SLEEP;
+}
+
+sint32 ZoneServer::RunZoneTask(int32 interval, bool zone_lock, const function<void()>& work) {
+  if (zoneShuttingDown)
+    return -1;
+
+  // an empty zone costs nothing until a client arrives, loading wakes the tasks once it is done
+  if (GetClientCount() == 0 || LoadingData)
+    return ZONE_TASK_SLEEP;
+
+  if (zone_lock)
+    MMasterZoneLock->lock();
+#ifndef NO_CATCH
+  try {
+#endif
+    if (!reloading_spellprocess)
+      work();
+#ifndef NO_CATCH
+  } catch (...) {
+    LogWrite(ZONE__ERROR, 0, "Zone", "Error processing a zone task, shutting down zone '%s'...", GetZoneName());
+    if (zone_lock)
+      MMasterZoneLock->unlock();
+    Shutdown();
+    return -1;
+  }
+#endif
+  if (zone_lock)
+    MMasterZoneLock->unlock();
+
+  return interval;
+}
+
+void ZoneServer::Shutdown() {
+  zoneShuttingDown = true;
+  WakeTasks();
+}
+
+void ZoneServer::WakeTasks() {
+  zone_scheduler.Wake(zone_task);
+  zone_scheduler.Wake(spawn_task);
+  zone_scheduler.Wake(movement_task);
+  zone_scheduler.Wake(aggro_task);
+  zone_scheduler.Wake(regen_task);
+  zone_scheduler.Wake(range_task);
+  zone_scheduler.Wake(visibility_task);
+  zone_scheduler.Wake(update_task);
+  zone_scheduler.Wake(respawn_task);
+  zone_scheduler.Wake(weather_task);
 }
 
 void ZoneServer::InitWeather() {
@@ -357,7 +479,6 @@ void ZoneServer::InitWeather() {
 
     SetRain(weather_current_severity);
     weather_last_changed_time = Timer::GetUnixTimeStamp();
-    weatherTimer.Start(rule_manager.GetGlobalRule(R_Zone, WeatherTimer)->GetInt32());
   }
 }
 void ZoneServer::DeleteSpellProcess() {
@@ -702,9 +823,9 @@ void ZoneServer::ProcessDepop(bool respawns_allowed, bool repop) {
       }
 
       if (!packet || packet_version != client->GetVersion()) {
-        safe_delete(packet);
+        configReader.ReleaseStruct(packet);
         packet_version = client->GetVersion();
-        packet = configReader.getStruct("WS_DestroyGhostCmd", packet_version);
+        packet = configReader.AcquireStructByID(GetDestroyGhostStructID(), packet_version);
       }
 
       MSpawnList.readlock(__FUNCTION__, __LINE__);
@@ -721,7 +842,7 @@ void ZoneServer::ProcessDepop(bool respawns_allowed, bool repop) {
 
   DeleteTransporters();
 
-  safe_delete(packet);
+  configReader.ReleaseStruct(packet);
 
   if (!repop && respawns_allowed) {
     ClearSpawnRangeMap();
@@ -759,6 +880,7 @@ void ZoneServer::ProcessDepop(bool respawns_allowed, bool repop) {
 
   if (repop) {
     LoadingData = true;
+    zone_scheduler.Wake(zone_task);
   }
 }
 
@@ -767,6 +889,7 @@ void ZoneServer::Depop(bool respawns, bool repop) {
   repop_zone = repop;
   finished_depop = false;
   depop_zone = true;
+  zone_scheduler.Wake(spawn_task);
 }
 
 bool ZoneServer::AddCloseSpawnsToSpawnGroup(Spawn* spawn, float radius) {
@@ -795,7 +918,7 @@ bool ZoneServer::AddCloseSpawnsToSpawnGroup(Spawn* spawn, float radius) {
 
 void ZoneServer::RepopSpawns(const shared_ptr<Client>& client, Spawn* in_spawn) {
   vector<Spawn*>* spawns = in_spawn->GetSpawnGroup();
-  PacketStruct* packet = configReader.getStruct("WS_DestroyGhostCmd", client->GetVersion());
+  PacketStruct* packet = configReader.AcquireStructByID(GetDestroyGhostStructID(), client->GetVersion());
   ;
   if (spawns) {
     if (!packet)
@@ -810,8 +933,8 @@ void ZoneServer::RepopSpawns(const shared_ptr<Client>& client, Spawn* in_spawn)
   }
   safe_delete(spawns);
   SendRemoveSpawn(client, in_spawn, packet);
-  spawn_check_add.Trigger();
-  safe_delete(packet);
+  zone_scheduler.Wake(visibility_task);
+  configReader.ReleaseStruct(packet);
 }
 
 bool ZoneServer::CheckNPCAttacks(NPC* npc, Spawn* victim, shared_ptr<Client> client) {
@@ -886,76 +1009,137 @@ bool ZoneServer::CheckNPCAttacks(NPC* npc, Spawn* victim, shared_ptr<Client> cli
   return true;
 }
 
-bool ZoneServer::CheckEnemyList(NPC* npc) {
+static bool CompareSpawnDistance(const pair<float, Spawn*>& a, const pair<float, Spawn*>& b) {
+  return a.first < b.first;
+}
+
+void ZoneServer::FindEnemies(AggroCandidates* candidates) {
+  // Runs on the spawn workers, so only reads are allowed here. SpawnProcess holds the
+  // MSpawnList readlock, taking it again could wait behind a writer forever.
   vector<int32>* factions;
   vector<int32>::iterator faction_itr;
   vector<int32>* spawns;
   vector<int32>::iterator spawn_itr;
-  map<float, Spawn*> attack_spawns;
-  map<float, Spawn*> reverse_attack_spawns;
-  map<float, Spawn*>::iterator itr;
+  map<int32, Spawn*>::iterator spawn_list_itr;
+  NPC* npc = candidates->npc;
   int32 faction_id = npc->GetFactionID();
   float distance;
 
   if (faction_id == 0)
-    return true;
+    return;
+
+  if (Grid != nullptr) {
+    // With a grid only the spawns around the npc are checked, instead of every member of its enemy factions
+    vector<int32> enemy_factions;
+    vector<int32> reverse_enemy_factions;
+    map<int32, vector<int32>*>::iterator enemy_itr;
+
+    m_enemy_faction_list.readlock(__FUNCTION__, __LINE__);
+    enemy_itr = enemy_faction_list.find(faction_id);
+    if (enemy_itr != enemy_faction_list.end())
+      enemy_factions = *enemy_itr->second;
+    m_enemy_faction_list.releasereadlock(__FUNCTION__, __LINE__);
+
+    m_reverse_enemy_faction_list.readlock(__FUNCTION__, __LINE__);
+    enemy_itr = reverse_enemy_faction_list.find(faction_id);
+    if (enemy_itr != reverse_enemy_faction_list.end())
+      reverse_enemy_factions = *enemy_itr->second;
+    m_reverse_enemy_faction_list.releasereadlock(__FUNCTION__, __LINE__);
+
+    if (enemy_factions.size() == 0 && reverse_enemy_factions.size() == 0)
+      return;
 
-  m_enemy_faction_list.readlock(__FUNCTION__, __LINE__);
-  if (enemy_faction_list.count(faction_id) > 0) {
-    factions = enemy_faction_list[faction_id];
+    float radius = npc->GetAggroRadius();
+    vector<Spawn*> nearby_spawns;
+    Grid->GetSpawnsInRange(npc->GetX(), npc->GetZ(), radius, nearby_spawns);
 
-    for (faction_itr = factions->begin(); faction_itr != factions->end(); faction_itr++) {
-      m_npc_faction_list.readlock(__FUNCTION__, __LINE__);
-      if (npc_faction_list.count(*faction_itr) > 0) {
-        spawns = npc_faction_list[*faction_itr];
-        spawn_itr = spawns->begin();
+    m_npc_faction_list.readlock(__FUNCTION__, __LINE__);
+    for (Spawn* spawn : nearby_spawns) {
+      // the faction lists only hold living npcs
+      if (spawn == npc || !spawn->IsNPC() || !spawn->Alive())
+        continue;
 
-        for (spawn_itr = spawns->begin(); spawn_itr != spawns->end(); spawn_itr++) {
-          Spawn* spawn = GetSpawnByID(*spawn_itr);
-          if (spawn) {
-            if ((distance = spawn->GetDistance(npc)) <= npc->GetAggroRadius())
-              attack_spawns[distance] = spawn;
+      int32 spawn_faction_id = spawn->GetFactionID();
+      if (npc_faction_list.count(spawn_faction_id) == 0)
+        continue;
+
+      bool enemy = find(enemy_factions.begin(), enemy_factions.end(), spawn_faction_id) != enemy_factions.end();
+      bool reverse_enemy = find(reverse_enemy_factions.begin(), reverse_enemy_factions.end(), spawn_faction_id) != reverse_enemy_factions.end();
+      if ((!enemy && !reverse_enemy) || (distance = spawn->GetDistance(npc)) > radius)
+        continue;
+
+      if (enemy)
+        candidates->attack_spawns.push_back(make_pair(distance, spawn));
+      if (reverse_enemy)
+        candidates->reverse_attack_spawns.push_back(make_pair(distance, spawn));
+    }
+    m_npc_faction_list.releasereadlock(__FUNCTION__, __LINE__);
+  } else {
+    m_enemy_faction_list.readlock(__FUNCTION__, __LINE__);
+    if (enemy_faction_list.count(faction_id) > 0) {
+      factions = enemy_faction_list[faction_id];
+
+      for (faction_itr = factions->begin(); faction_itr != factions->end(); faction_itr++) {
+        m_npc_faction_list.readlock(__FUNCTION__, __LINE__);
+        if (npc_faction_list.count(*faction_itr) > 0) {
+          spawns = npc_faction_list[*faction_itr];
+
+          for (spawn_itr = spawns->begin(); spawn_itr != spawns->end(); spawn_itr++) {
+            spawn_list_itr = spawn_list.find(*spawn_itr);
+            if (spawn_list_itr != spawn_list.end() && spawn_list_itr->second) {
+              Spawn* spawn = spawn_list_itr->second;
+              if ((distance = spawn->GetDistance(npc)) <= npc->GetAggroRadius())
+                candidates->attack_spawns.push_back(make_pair(distance, spawn));
+            }
           }
         }
+        m_npc_faction_list.releasereadlock(__FUNCTION__, __LINE__);
       }
-      m_npc_faction_list.releasereadlock(__FUNCTION__, __LINE__);
     }
-  }
-  m_enemy_faction_list.releasereadlock(__FUNCTION__, __LINE__);
+    m_enemy_faction_list.releasereadlock(__FUNCTION__, __LINE__);
 
-  m_reverse_enemy_faction_list.readlock(__FUNCTION__, __LINE__);
-  if (reverse_enemy_faction_list.count(faction_id) > 0) {
-    factions = reverse_enemy_faction_list[faction_id];
+    m_reverse_enemy_faction_list.readlock(__FUNCTION__, __LINE__);
+    if (reverse_enemy_faction_list.count(faction_id) > 0) {
+      factions = reverse_enemy_faction_list[faction_id];
 
-    for (faction_itr = factions->begin(); faction_itr != factions->end(); faction_itr++) {
-      m_npc_faction_list.readlock(__FUNCTION__, __LINE__);
-      if (npc_faction_list.count(*faction_itr) > 0) {
-        spawns = npc_faction_list[*faction_itr];
-        spawn_itr = spawns->begin();
+      for (faction_itr = factions->begin(); faction_itr != factions->end(); faction_itr++) {
+        m_npc_faction_list.readlock(__FUNCTION__, __LINE__);
+        if (npc_faction_list.count(*faction_itr) > 0) {
+          spawns = npc_faction_list[*faction_itr];
 
-        for (spawn_itr = spawns->begin(); spawn_itr != spawns->end(); spawn_itr++) {
-          Spawn* spawn = GetSpawnByID(*spawn_itr);
-          if (spawn) {
-            if ((distance = spawn->GetDistance(npc)) <= npc->GetAggroRadius())
-              reverse_attack_spawns[distance] = spawn;
+          for (spawn_itr = spawns->begin(); spawn_itr != spawns->end(); spawn_itr++) {
+            spawn_list_itr = spawn_list.find(*spawn_itr);
+            if (spawn_list_itr != spawn_list.end() && spawn_list_itr->second) {
+              Spawn* spawn = spawn_list_itr->second;
+              if ((distance = spawn->GetDistance(npc)) <= npc->GetAggroRadius())
+                candidates->reverse_attack_spawns.push_back(make_pair(distance, spawn));
+            }
           }
         }
+        m_npc_faction_list.releasereadlock(__FUNCTION__, __LINE__);
       }
-      m_npc_faction_list.releasereadlock(__FUNCTION__, __LINE__);
     }
+    m_reverse_enemy_faction_list.releasereadlock(__FUNCTION__, __LINE__);
   }
-  m_reverse_enemy_faction_list.releasereadlock(__FUNCTION__, __LINE__);
 
-  if (attack_spawns.size() > 0) {
-    for (itr = attack_spawns.begin(); itr != attack_spawns.end(); itr++)
-      CheckNPCAttacks(npc, itr->second);
-  }
-  if (reverse_attack_spawns.size() > 0) {
-    for (itr = reverse_attack_spawns.begin(); itr != reverse_attack_spawns.end(); itr++)
-      CheckNPCAttacks((NPC*)itr->second, npc);
-  }
+  sort(candidates->attack_spawns.begin(), candidates->attack_spawns.end(), CompareSpawnDistance);
+  sort(candidates->reverse_attack_spawns.begin(), candidates->reverse_attack_spawns.end(), CompareSpawnDistance);
+}
+
+bool ZoneServer::AttackEnemies(const AggroCandidates& candidates) {
+  NPC* npc = candidates.npc;
+
+  // an earlier spawn in this pass may have killed or pulled the npc since its enemies were found
+  if (!npc->Alive() || npc->m_runningBack)
+    return true;
+
+  for (const auto& candidate : candidates.attack_spawns)
+    CheckNPCAttacks(npc, candidate.second);
 
-  return attack_spawns.size() == 0;
+  for (const auto& candidate : candidates.reverse_attack_spawns)
+    CheckNPCAttacks((NPC*)candidate.second, npc);
+
+  return candidates.attack_spawns.size() == 0;
 }
 
 void ZoneServer::RemoveDeadEnemyList(Spawn* spawn) {
@@ -1133,6 +1317,49 @@ void ZoneServer::CheckSpawnRange(Spawn* spawn) {
   }
 }
 
+// Grid version of the range check, the caller must hold MSpawnList for reading
+void ZoneServer::CheckSpawnRange(const shared_ptr<Client>& client) {
+  Player* player = client->GetPlayer();
+  vector<Spawn*> nearby_spawns;
+  set<int32> nearby_ids;
+
+  // Anything outside of the cells around the player is past the remove distance
+  Grid->GetSpawnsInRange(player->GetX(), player->GetZ(), REMOVE_SPAWN_DISTANCE, nearby_spawns);
+
+  for (Spawn* spawn : nearby_spawns) {
+    CheckSpawnRange(client, spawn);
+    nearby_ids.insert(spawn->GetID());
+  }
+
+  vector<int32> stale_ids;
+  map<int32, float>* client_range = GetClientRangeMap(client);
+
+  if (client_range) {
+    lock_guard<mutex> guard(client_range_mutex_map[client]);
+
+    for (const auto& kv : *client_range) {
+      if (nearby_ids.count(kv.first) == 0) {
+        stale_ids.push_back(kv.first);
+      }
+    }
+  }
+
+  // Spawns that left the area get one last distance update so the remove and proximity
+  // checks see them leave, they are dropped from the range map once the client no longer has them
+  for (int32 spawn_id : stale_ids) {
+    auto itr = spawn_list.find(spawn_id);
+    Spawn* spawn = itr != spawn_list.end() ? itr->second : nullptr;
+
+    if (spawn) {
+      CheckSpawnRange(client, spawn);
+    }
+
+    if (!spawn || !player->WasSentSpawn(spawn_id) || player->WasSpawnRemoved(spawn)) {
+      RemoveFromClientRangeMap(client, spawn_id);
+    }
+  }
+}
+
 void ZoneServer::PrepareSpawnID(Player* player, Spawn* spawn) {
   player->spawn_id++;
   player->player_spawn_id_map[player->spawn_id] = spawn;
@@ -1229,28 +1456,62 @@ void ZoneServer::CheckRemoveSpawnFromClient(Spawn* spawn) {
 
   for (const auto& client : clients) {
     if (!packet || packet_version != client->GetVersion()) {
-      safe_delete(packet);
+      configReader.ReleaseStruct(packet);
       packet_version = client->GetVersion();
-      packet = configReader.getStruct("WS_DestroyGhostCmd", packet_version);
+      packet = configReader.AcquireStructByID(GetDestroyGhostStructID(), packet_version);
     }
 
-    if (spawn && spawn != client->GetPlayer() && !spawn->IsWidget() && client->GetPlayer()->WasSentSpawn(spawn->GetID()) && !client->GetPlayer()->WasSpawnRemoved(spawn)) {
-      // TODO: Check exists? This can return 0.0
-      float distance = GetClientRangeDistance(client, spawn->GetID());
-      bool should_hide = false;
+    CheckRemoveSpawnFromClient(client, spawn, packet);
+  }
+  configReader.ReleaseStruct(packet);
+}
 
-      if (spawn->IsPlayer() && static_cast<Player*>(spawn)->IsStealthed()) {
-        Player* player = static_cast<Player*>(spawn);
+// Grid version of the remove check, the caller must hold MSpawnList for reading
+void ZoneServer::CheckRemoveSpawnFromClient(const shared_ptr<Client>& client) {
+  vector<int32> spawn_ids;
+  map<int32, float>* client_range = GetClientRangeMap(client);
 
-        should_hide = client->GetPlayer()->IsHostile(player) && distance > 30;
-      }
+  // The range map only holds the spawns around the client and the ones that just left
+  if (client_range) {
+    lock_guard<mutex> guard(client_range_mutex_map[client]);
 
-      if (should_hide || distance > REMOVE_SPAWN_DISTANCE) {
-        SendRemoveSpawn(client, spawn, packet);
-      }
+    for (const auto& kv : *client_range) {
+      spawn_ids.push_back(kv.first);
+    }
+  }
+
+  if (spawn_ids.empty()) {
+    return;
+  }
+
+  PacketStruct* packet = configReader.AcquireStructByID(GetDestroyGhostStructID(), client->GetVersion());
+
+  for (int32 spawn_id : spawn_ids) {
+    auto itr = spawn_list.find(spawn_id);
+
+    if (itr != spawn_list.end()) {
+      CheckRemoveSpawnFromClient(client, itr->second, packet);
+    }
+  }
+  configReader.ReleaseStruct(packet);
+}
+
+void ZoneServer::CheckRemoveSpawnFromClient(const shared_ptr<Client>& client, Spawn* spawn, PacketStruct* packet) {
+  if (spawn && spawn != client->GetPlayer() && !spawn->IsWidget() && client->GetPlayer()->WasSentSpawn(spawn->GetID()) && !client->GetPlayer()->WasSpawnRemoved(spawn)) {
+    // TODO: Check exists? This can return 0.0
+    float distance = GetClientRangeDistance(client, spawn->GetID());
+    bool should_hide = false;
+
+    if (spawn->IsPlayer() && static_cast<Player*>(spawn)->IsStealthed()) {
+      Player* player = static_cast<Player*>(spawn);
+
+      should_hide = client->GetPlayer()->IsHostile(player) && distance > 30;
+    }
+
+    if (should_hide || distance > REMOVE_SPAWN_DISTANCE) {
+      SendRemoveSpawn(client, spawn, packet);
     }
   }
-  safe_delete(packet);
 }
 
 bool ZoneServer::CombatProcess(Spawn* spawn) {
@@ -1343,91 +1604,32 @@ void ZoneServer::RemoveDamagedSpawn(Spawn* spawn) {
     damaged_spawns.Remove(spawn->GetID());
 }
 
-bool ZoneServer::Process() {
-  MMasterZoneLock->lock(); //Changing this back to a recursive lock to fix a possible /reload spells crash with multiple zones running - Foof
+void ZoneServer::LoadData() {
+  MMasterZoneLock->lock();
 #ifndef NO_CATCH
   try {
 #endif
-    if (LoadingData) {
-      while (zoneID == 0) { //this is loaded by world
-        Sleep(10);
-      }
+    while (zoneID == 0 && !zoneShuttingDown) { //this is loaded by world
+      Sleep(10);
+    }
 
+    if (!zoneShuttingDown) {
       if (reloading) {
-        LogWrite(COMMAND__DEBUG, 0, "Command", "-Loading Entity Commands...");
-        database.LoadEntityCommands(this);
-        LogWrite(NPC__INFO, 0, "NPC", "-Loading NPC data...");
-        database.LoadNPCs(this);
-        LogWrite(NPC__INFO, 0, "NPC", "-Load NPC data complete!");
-
-        LogWrite(OBJECT__INFO, 0, "Object", "-Loading Object data...");
-        database.LoadObjects(this);
-        LogWrite(OBJECT__INFO, 0, "Object", "-Load Object data complete!");
-
-        LogWrite(SIGN__INFO, 0, "Sign", "-Loading Sign data...");
-        database.LoadSigns(this);
-        LogWrite(SIGN__INFO, 0, "Sign", "-Load Sign data complete!");
-
-        LogWrite(WIDGET__INFO, 0, "Widget", "-Loading Widget data...");
-        database.LoadWidgets(this);
-        LogWrite(WIDGET__INFO, 0, "Widget", "-Load Widget data complete!");
-
-        LogWrite(GROUNDSPAWN__INFO, 0, "GSpawn", "-Loading Groundspawn data...");
-        database.LoadGroundSpawns(this);
-        database.LoadGroundSpawnEntries(this);
-        LogWrite(GROUNDSPAWN__INFO, 0, "GSpawn", "-Load Groundspawn data complete!");
-
-        LogWrite(PET__INFO, 0, "Pet", "-Loading Pet data...");
-        database.GetPetNames(this);
-        LogWrite(PET__INFO, 0, "Pet", "-Load Pet data complete!");
-
-        LogWrite(LOOT__INFO, 0, "Loot", "-Loading Spawn loot data...");
-        database.LoadLoot(this);
-        LogWrite(LOOT__INFO, 0, "Loot", "-Loading Spawn loot data complete!");
-
-        LogWrite(TRANSPORT__INFO, 0, "Transport", "-Loading Transporters...");
-        database.LoadTransporters(this);
-        LogWrite(TRANSPORT__INFO, 0, "Transport", "-Loading Transporters complete!");
+        LoadZoneTemplate();
         reloading = false;
+        spawn_data_loaded = false;
       }
 
-      MSpawnGroupAssociation.writelock(__FUNCTION__, __LINE__);
-      spawn_group_associations.clear();
-      MSpawnGroupAssociation.releasewritelock(__FUNCTION__, __LINE__);
-
-      MSpawnGroupLocations.writelock(__FUNCTION__, __LINE__);
-      spawn_group_locations.clear();
-      MSpawnGroupLocations.releasewritelock(__FUNCTION__, __LINE__);
-
-      MSpawnLocationGroups.writelock(__FUNCTION__, __LINE__);
-      spawn_location_groups.clear();
-      MSpawnLocationGroups.releasewritelock(__FUNCTION__, __LINE__);
-
-      MSpawnGroupChances.writelock(__FUNCTION__, __LINE__);
-      spawn_group_chances.clear();
-      MSpawnGroupChances.releasewritelock(__FUNCTION__, __LINE__);
-
-      DeleteTransporters();
-      ReloadTransporters();
+      // the first load is done by the zone loader while the zone boots
+      if (spawn_data_loaded)
+        spawn_data_loaded = false;
+      else
+        LoadSpawnData();
 
-      database.LoadSpawns(this);
       ProcessSpawnLocations();
 
-      if (!revive_points)
-        revive_points = new vector<RevivePoint*>;
-      else {
-        while (!revive_points->empty()) {
-          safe_delete(revive_points->back());
-          revive_points->pop_back();
-        }
-      }
-      database.LoadRevivePoints(revive_points, GetZoneID());
-
       LoadingData = false;
 
-      spawn_range.Trigger();
-      spawn_check_add.Trigger();
-
       RemoveLocationGrids();
       database.LoadLocationGrids(this);
 
@@ -1437,7 +1639,38 @@ bool ZoneServer::Process() {
         lua_interface->RunZoneScript(zone_script, "init_zone_script", this);
       }
     }
+#ifndef NO_CATCH
+  } catch (...) {
+    LogWrite(ZONE__ERROR, 0, "Zone", "Exception while loading '%s'", GetZoneName());
+    zoneShuttingDown = true;
+  }
+#endif
+  MMasterZoneLock->unlock();
+
+  // the zone's tasks sleep while it loads, the range checks send the new spawns right away
+  WakeTasks();
+  data_loader_active = false;
+}
 
+bool ZoneServer::Process() {
+  // loading blocks on the database, so it runs on its own thread instead of a shared zone worker
+  if (LoadingData) {
+    if (!data_loader_active && !zoneShuttingDown) {
+      data_loader_active = true;
+      thread w(std::bind(&ZoneServer::LoadData, this));
+      w.detach();
+    }
+
+    if (shutdownTimer.Enabled() && shutdownTimer.Check())
+      zoneShuttingDown = true;
+
+    return !zoneShuttingDown;
+  }
+
+  MMasterZoneLock->lock(); //Changing this back to a recursive lock to fix a possible /reload spells crash with multiple zones running - Foof
+#ifndef NO_CATCH
+  try {
+#endif
     if (shutdownTimer.Enabled() && shutdownTimer.Check())
       zoneShuttingDown = true;
 
@@ -1465,10 +1698,6 @@ bool ZoneServer::Process() {
     if (tradeskillMgr)
       tradeskillMgr->Process();
 
-    // Possibility to do a client loop
-    if (weather_enabled && weatherTimer.Check())
-      ProcessWeather();
-
     // client related loop, move to main thread?
     if (!zoneShuttingDown)
       ProcessDrowning();
@@ -1503,8 +1732,6 @@ bool ZoneServer::Process() {
     write_statistics_mutex.unlock();
 
     if (lua_interface) {
-      lua_interface->Process();
-
       /* refactor this? */
       const char* zone_script = world.GetZoneScript(GetZoneID());
       if (zone_script) {
@@ -1522,18 +1749,10 @@ bool ZoneServer::Process() {
       }
     }
 
-    // damaged spawns loop, spawn related, move to spawn thread?
-    if (regenTimer.Check())
-      RegenUpdate();
-
     // heading_timers loop
     if (!zoneShuttingDown)
       CheckHeadingTimers();
 
-    // respawn_timers loop
-    if (respawn_timer.Check() && !zoneShuttingDown)
-      CheckRespawns();
-
     // spawn_expire_timers loop
     if (spawn_expire_timer.Check() && !zoneShuttingDown)
       CheckSpawnExpireTimers();
@@ -1570,33 +1789,17 @@ bool ZoneServer::SpawnProcess() {
   MMasterSpawnLock.writelock(__FUNCTION__, __LINE__);
   // If the zone is loading data or shutting down don't do anything
   if (!LoadingData && !zoneShuttingDown && !reloading_spellprocess) {
-    // Set some bool's for timers
-    bool movement = movement_timer.Check();
-    bool aggroCheck = aggro_timer.Check();
     vector<int32> pending_spawn_list_remove;
 
     MSpawnList.readlock(__FUNCTION__, __LINE__);
     for (const auto& kv : spawn_list) {
-      if (zoneShuttingDown) {
+      if (zoneShuttingDown)
         break;
-      }
-
-      Spawn* spawn = kv.second;
 
-      if (spawn) {
-        if (movement) {
-          spawn->ProcessMovement();
-          spawn->last_movement_update = Timer::GetCurrentTime2();
-        }
-
-        if (aggroCheck) {
-          ProcessAggroChecks(spawn);
-        }
-
-        CombatProcess(spawn);
-      } else {
+      if (kv.second)
+        CombatProcess(kv.second);
+      else
         pending_spawn_list_remove.push_back(kv.first);
-      }
     }
     MSpawnList.releasereadlock(__FUNCTION__, __LINE__);
 
@@ -1641,65 +1844,122 @@ bool ZoneServer::SpawnProcess() {
   return (zoneShuttingDown == false);
 }
 
-bool ZoneServer::UpdateProcess() {
-  if (!zoneShuttingDown) {
-    {
-      lock_guard<mutex> guard(changed_spawns_mutex);
-
-      for (const auto& kv : changed_spawns) {
-        shared_ptr<SpawnUpdate> spawn_update = kv.second;
-
-        shared_lock<shared_timed_mutex> guard(clients_mutex);
+void ZoneServer::MovementProcess() {
+  MMasterSpawnLock.writelock(__FUNCTION__, __LINE__);
+  if (!LoadingData && !zoneShuttingDown && !reloading_spellprocess) {
+    // Movement runs spawn scripts, so the spawns are moved one at a time on this task
+    MSpawnList.readlock(__FUNCTION__, __LINE__);
+    for (const auto& kv : spawn_list) {
+      if (zoneShuttingDown)
+        break;
 
-        for (const auto& client : clients) {
-          if (!spawn_update->client || client == spawn_update->client) {
-            client->AddChangedSpawn(spawn_update);
-          }
-        }
+      if (kv.second) {
+        kv.second->ProcessMovement();
+        kv.second->last_movement_update = Timer::GetCurrentTime2();
       }
+    }
+    MSpawnList.releasereadlock(__FUNCTION__, __LINE__);
+  }
+  MMasterSpawnLock.releasewritelock(__FUNCTION__, __LINE__);
+}
+
+void ZoneServer::AggroProcess() {
+  MMasterSpawnLock.writelock(__FUNCTION__, __LINE__);
+  if (!LoadingData && !zoneShuttingDown && !reloading_spellprocess) {
+    vector<Spawn*> spawns;
+    vector<AggroCandidates> aggro_candidates;
 
-      changed_spawns.clear();
+    MSpawnList.readlock(__FUNCTION__, __LINE__);
+    spawns.reserve(spawn_list.size());
+    for (const auto& kv : spawn_list) {
+      if (kv.second)
+        spawns.push_back(kv.second);
     }
 
-    /*if (player_pos_update.Check()) {
-			SendSpawnChanges(true, true);
-		}
+    // The enemies in range are found across the spawn workers, the attacks that
+    // change state are then run here in spawn order
+    ProcessAggroChecks(spawns, &aggro_candidates);
 
-		if (spawn_pos_update.Check()) {
-			SendSpawnChanges(true);
-		}*/
+    for (const auto& candidates : aggro_candidates) {
+      if (zoneShuttingDown)
+        break;
 
-    if (spawn_update.Check()) {
-      SendSpawnChanges();
+      AttackEnemies(candidates);
     }
+    MSpawnList.releasereadlock(__FUNCTION__, __LINE__);
+  }
+  MMasterSpawnLock.releasewritelock(__FUNCTION__, __LINE__);
+}
 
-    if (!reloading) {
-      bool spawnRange = spawn_range.Check();
-      bool checkRemove = spawn_check_remove.Check();
+void ZoneServer::SpawnUpdateProcess() {
+  {
+    lock_guard<mutex> guard(changed_spawns_mutex);
 
-      MSpawnList.readlock(__FUNCTION__, __LINE__);
-      for (const auto& kv : spawn_list) {
-        const auto spawn = kv.second;
+    for (const auto& kv : changed_spawns) {
+      shared_ptr<SpawnUpdate> spawn_update = kv.second;
 
-        if (spawn) {
-          if (spawnRange) {
-            CheckSpawnRange(spawn);
-          }
+      shared_lock<shared_timed_mutex> guard(clients_mutex);
 
-          if (checkRemove) {
-            CheckRemoveSpawnFromClient(spawn);
-          }
+      for (const auto& client : clients) {
+        if (!spawn_update->client || client == spawn_update->client) {
+          client->AddChangedSpawn(spawn_update);
         }
       }
-      MSpawnList.releasereadlock(__FUNCTION__, __LINE__);
+    }
+
+    changed_spawns.clear();
+  }
+
+  /*if (player_pos_update.Check()) {
+		SendSpawnChanges(true, true);
+	}
+
+	if (spawn_pos_update.Check()) {
+		SendSpawnChanges(true);
+	}*/
+
+  SendSpawnChanges();
+}
 
-      if (spawn_check_add.Check()) {
-        CheckSendSpawnToClient();
+void ZoneServer::CheckSpawnRanges(bool spawnRange, bool checkRemove) {
+  if (reloading)
+    return;
+
+  MSpawnList.readlock(__FUNCTION__, __LINE__);
+  if (Grid != nullptr) {
+    // With a grid each client only has to look at the spawns in the cells around it
+    shared_lock<shared_timed_mutex> guard(clients_mutex);
+
+    for (const auto& client : clients) {
+      if (spawnRange && client->IsReadyForSpawns()) {
+        CheckSpawnRange(client);
+      }
+
+      if (checkRemove) {
+        CheckRemoveSpawnFromClient(client);
+      }
+    }
+  } else {
+    for (const auto& kv : spawn_list) {
+      const auto spawn = kv.second;
+
+      if (spawn) {
+        if (spawnRange) {
+          CheckSpawnRange(spawn);
+        }
+
+        if (checkRemove) {
+          CheckRemoveSpawnFromClient(spawn);
+        }
       }
     }
   }
+  MSpawnList.releasereadlock(__FUNCTION__, __LINE__);
 
-  return (zoneShuttingDown == false);
+  // the spawns that came into range are sent with the removals
+  if (checkRemove) {
+    CheckSendSpawnToClient();
+  }
 }
 
 void ZoneServer::CheckDeadSpawnRemoval() {
@@ -1781,26 +2041,25 @@ void ZoneServer::AddSpawnExpireTimer(Spawn* spawn, int32 expire_time, int32 expi
   }
 }
 
-void ZoneServer::SaveClient(const shared_ptr<Client>& client) {
-  client->Save();
-}
-
 void ZoneServer::SaveClients() {
-  vector<thread> workers;
-
   shared_lock<shared_timed_mutex> guard(clients_mutex);
+  lock_guard<mutex> saves_guard(pending_saves_mutex);
+
+  for (auto itr = pending_saves.begin(); itr != pending_saves.end();) {
+    if (itr->second.wait_for(chrono::seconds(0)) == future_status::ready)
+      itr = pending_saves.erase(itr);
+    else
+      itr++;
+  }
 
   for (const auto client : clients) {
-    if (client->IsConnected()) {
-      workers.push_back(thread([this, client]() {
-        SaveClient(client);
-      }));
+    // skip clients whose previous save has not finished yet
+    if (client->IsConnected() && pending_saves.count(client->GetCharacterID()) == 0) {
+      pending_saves[client->GetCharacterID()] = database.QueueWork(client->GetCharacterID(), [client]() {
+        client->Save();
+      });
     }
   }
-
-  for_each(workers.begin(), workers.end(), [](thread& t) {
-    t.join();
-  });
 }
 
 void ZoneServer::SendSpawnVisualState(Spawn* spawn, int16 type) {
@@ -1834,6 +2093,8 @@ void ZoneServer::ResendSpawns(const shared_ptr<Client>& client) {
 void ZoneServer::SendSpawnChanges(bool only_pos_changes, bool only_players) {
   shared_lock<shared_timed_mutex> guard(clients_mutex);
 
+  spawn_update_tick++;
+
   for (const auto& client : clients) {
     client->SendSpawnChanges(only_pos_changes, only_players);
   }
@@ -2759,8 +3020,10 @@ void ZoneServer::AddSpawn(Spawn* spawn) {
     MPendingSpawnListAdd.releasewritelock(__FUNCTION__, __LINE__);
   } else
     ((Player*)spawn)->SetReturningFromLD(false);
-  spawn_range.Trigger();
-  spawn_check_add.Trigger();
+  // the spawn task moves it to the spawn list, the range checks send it to the clients
+  zone_scheduler.Wake(spawn_task);
+  zone_scheduler.Wake(range_task);
+  zone_scheduler.Wake(visibility_task);
   if (spawn->IsNPC())
     AddEnemyList((NPC*)spawn);
   if (spawn->IsPlayer() && ((Player*)spawn)->GetGroupMemberInfo())
@@ -2776,15 +3039,30 @@ void ZoneServer::AddSpawn(Spawn* spawn) {
 }
 
 void ZoneServer::AddClient(shared_ptr<Client> client) {
-  unique_lock<shared_timed_mutex> guard(clients_mutex);
+  {
+    unique_lock<shared_timed_mutex> guard(clients_mutex);
+
+    clients.push_back(client);
+  }
 
-  clients.push_back(client);
+  // the client's packets are handled by Process, run it as soon as one arrives
+  shared_ptr<ZoneTask> task = zone_task;
+  if (task && client->getConnection())
+    client->getConnection()->SetInboundCallback([task]() { zone_scheduler.Wake(task); });
+
+  // an empty zone only runs once a second, get it going for the new client
+  WakeTasks();
 }
 
 void ZoneServer::AddIncomingClient(shared_ptr<Client> client) {
-  lock_guard<mutex> guard(incoming_clients_mutex);
+  {
+    lock_guard<mutex> guard(incoming_clients_mutex);
 
-  incoming_clients.push_back(client);
+    incoming_clients.push_back(client);
+  }
+
+  // the zone process moves it to the clients, an empty zone is asleep until then
+  zone_scheduler.Wake(zone_task);
 }
 
 void ZoneServer::RemoveClient(shared_ptr<Client> client) {
@@ -3008,21 +3286,46 @@ void ZoneServer::HandleChatMessage(const shared_ptr<Client>& client, Spawn* from
 }
 
 void ZoneServer::HandleChatMessage(Spawn* from, const char* to, int16 channel, const char* message, float distance, const char* channel_name, bool show_bubble, int32 language) {
+  PacketBroadcast broadcast("WS_HearChat", [&](PacketStruct* packet) {
+    if (from)
+      packet->setMediumStringByName("from", from->GetName());
+    packet->setDataByName("channel", channel);
+    packet->setDataByName("to_spawn_id", 0xFFFFFFFF);
+    packet->setMediumStringByName("message", message);
+    packet->setDataByName("language", language);
+    packet->setDataByName("show_bubble", show_bubble ? 1 : 0);
+    if (channel_name)
+      packet->setMediumStringByName("channel_name", channel_name);
+  }, {"to", "from_spawn_id", "understood"}, [&](PacketStruct* packet, const shared_ptr<Client>& client) {
+    packet->setMediumStringByName("to", client->GetPlayer() != from ? client->GetPlayer()->GetName() : "");
+    if (from && ((from == client->GetPlayer()) || (client->GetPlayer()->WasSentSpawn(from->GetID()) && !client->GetPlayer()->WasSpawnRemoved(from))))
+      packet->setDataByName("from_spawn_id", client->GetPlayer()->GetIDWithPlayerSpawn(from));
+    else
+      packet->setDataByName("from_spawn_id", 0xFFFFFFFF);
+    packet->setDataByName("understood", (language > 0 && !client->GetPlayer()->HasLanguage(language)) ? 0 : 1);
+  });
+
   shared_lock<shared_timed_mutex> guard(clients_mutex);
 
   for (const auto& client : clients) {
-    if (client->IsConnected()) {
-      HandleChatMessage(client, from, to, channel, message, distance, channel_name, show_bubble, language);
+    if (client->IsConnected() && (!distance || from->GetDistance(client->GetPlayer()) <= distance) && (!from || !client->GetPlayer()->IsIgnored(from->GetName()))) {
+      broadcast.Send(client);
     }
   }
 }
 
 void ZoneServer::HandleBroadcast(const char* message) {
+  PacketBroadcast broadcast("WS_DisplayText", [&](PacketStruct* packet) {
+    packet->setDataByName("color", CHANNEL_BROADCAST);
+    packet->setMediumStringByName("text", message);
+    packet->setDataByName("unknown02", 0x00ff);
+  });
+
   shared_lock<shared_timed_mutex> guard(clients_mutex);
 
   for (const auto& client : clients) {
     if (client->IsConnected()) {
-      client->SimpleMessage(CHANNEL_BROADCAST, message);
+      broadcast.Send(client);
     }
   }
 }
@@ -3034,12 +3337,27 @@ void ZoneServer::HandleAnnouncement(const char* message) {
     words = 5;
   }
 
+  PacketBroadcast text("WS_DisplayText", [&](PacketStruct* packet) {
+    packet->setDataByName("color", CHANNEL_BROADCAST);
+    packet->setMediumStringByName("text", message);
+    packet->setDataByName("unknown02", 0x00ff);
+  });
+  PacketBroadcast popup("WS_OnScreenMsg", [&](PacketStruct* packet) {
+    packet->setDataByName("unknown", 10);
+    packet->setMediumStringByName("text", message);
+    packet->setMediumStringByName("message_type", "ui_harvest_normal");
+    packet->setDataByName("size", (float)words);
+    packet->setDataByName("red", 0xFF);
+    packet->setDataByName("green", 0xFF);
+    packet->setDataByName("blue", 0x00);
+  });
+
   shared_lock<shared_timed_mutex> guard(clients_mutex);
 
   for (const auto& client : clients) {
     if (client->IsConnected()) {
-      client->SimpleMessage(CHANNEL_BROADCAST, message);
-      client->SendPopupMessage(10, message, "ui_harvest_normal", words, 0xFF, 0xFF, 0x00);
+      text.Send(client);
+      popup.Send(client);
     }
   }
 }
@@ -3641,9 +3959,9 @@ void ZoneServer::RemoveSpawn(Spawn* spawn, bool delete_spawn, bool respawn, bool
 
     for (const auto& client : clients) {
       if (client->IsConnected() && (!packet || packet_version != client->GetVersion())) {
-        safe_delete(packet);
+        configReader.ReleaseStruct(packet);
         packet_version = client->GetVersion();
-        packet = configReader.getStruct("WS_DestroyGhostCmd", packet_version);
+        packet = configReader.AcquireStructByID(GetDestroyGhostStructID(), packet_version);
       }
 
       if (client->GetPlayer()->HasTarget() && client->GetPlayer()->GetTarget() == spawn) {
@@ -3655,7 +3973,7 @@ void ZoneServer::RemoveSpawn(Spawn* spawn, bool delete_spawn, bool respawn, bool
     }
   }
 
-  safe_delete(packet);
+  configReader.ReleaseStruct(packet);
 
   // Do we really need the mutex locks and check to dead_spawns as we remove it from dead spawns at the start of this function
   if (lock) {
@@ -3687,8 +4005,8 @@ void ZoneServer::RemoveSpawnFromClient(Spawn* spawn, bool skip_if_client) {
     }
 
     if (!packet || packet_version != client->GetVersion()) {
-      safe_delete(packet);
-      packet = configReader.getStruct("WS_DestroyGhostCmd", client->GetVersion());
+      configReader.ReleaseStruct(packet);
+      packet = configReader.AcquireStructByID(GetDestroyGhostStructID(), client->GetVersion());
     }
 
     if (client->GetPlayer()->HasTarget() && client->GetPlayer()->GetTarget() == spawn) {
@@ -3698,6 +4016,7 @@ void ZoneServer::RemoveSpawnFromClient(Spawn* spawn, bool skip_if_client) {
     SendRemoveSpawn(client, spawn, packet);
     RemoveFromClientRangeMap(client, spawn->GetID());
   }
+  configReader.ReleaseStruct(packet);
 }
 
 Spawn* ZoneServer::GetClosestSpawn(Spawn* spawn, int32 spawn_id) {
@@ -4184,28 +4503,28 @@ void ZoneServer::SendDamagePacket(Spawn* attacker, Spawn* victim, int8 type1, in
     switch (type1) {
     case DAMAGE_PACKET_TYPE_SIPHON_SPELL:
     case DAMAGE_PACKET_TYPE_SIPHON_SPELL2:
-      packet = configReader.getStruct("WS_HearSiphonSpellDamage", client->GetVersion());
+      packet = configReader.AcquireStruct("WS_HearSiphonSpellDamage", client->GetVersion());
       break;
     case DAMAGE_PACKET_TYPE_MULTIPLE_DAMAGE:
-      packet = configReader.getStruct("WS_HearMultipleDamage", client->GetVersion());
+      packet = configReader.AcquireStruct("WS_HearMultipleDamage", client->GetVersion());
       break;
     case DAMAGE_PACKET_TYPE_SIMPLE_CRIT_DMG:
     case DAMAGE_PACKET_TYPE_SIMPLE_DAMAGE:
-      packet = configReader.getStruct("WS_HearSimpleDamage", client->GetVersion());
+      packet = configReader.AcquireStruct("WS_HearSimpleDamage", client->GetVersion());
       break;
     case DAMAGE_PACKET_TYPE_RANGE_CRIT_DMG:
     case DAMAGE_PACKET_TYPE_SPELL_DAMAGE2:
     case DAMAGE_PACKET_TYPE_SPELL_DAMAGE3:
     case DAMAGE_PACKET_TYPE_SPELL_CRIT_DMG:
     case DAMAGE_PACKET_TYPE_SPELL_DAMAGE:
-      packet = configReader.getStruct("WS_HearSpellDamage", client->GetVersion());
+      packet = configReader.AcquireStruct("WS_HearSpellDamage", client->GetVersion());
       break;
     case DAMAGE_PACKET_TYPE_RANGE_DAMAGE:
-      packet = configReader.getStruct("WS_HearRangeDamage", client->GetVersion());
+      packet = configReader.AcquireStruct("WS_HearRangeDamage", client->GetVersion());
       break;
     case DAMAGE_PACKET_TYPE_RANGE_SPELL_DMG:
     case DAMAGE_PACKET_TYPE_RANGE_SPELL_DMG2:
-      packet = configReader.getStruct("WS_HearRangeDamage", client->GetVersion());
+      packet = configReader.AcquireStruct("WS_HearRangeDamage", client->GetVersion());
       break;
     default:
       LogWrite(ZONE__ERROR, 0, "Zone", "Unknown Damage Packet type: %i in ZoneServer::SendDamagePacket.", type1);
@@ -4232,7 +4551,7 @@ void ZoneServer::SendDamagePacket(Spawn* attacker, Spawn* victim, int8 type1, in
 
       EQ2Packet* app = packet->serialize();
       client->QueuePacket(app);
-      safe_delete(packet);
+      configReader.ReleaseStruct(packet);
     }
   }
 }
@@ -4253,7 +4572,7 @@ void ZoneServer::SendHealPacket(Spawn* caster, Spawn* target, int16 heal_type, i
     if (target && target->GetDistance(client->GetPlayer()) > 50)
       continue;
 
-    PacketStruct* packet = configReader.getStruct("WS_HearHeal", client->GetVersion());
+    PacketStruct* packet = configReader.AcquireStruct("WS_HearHeal", client->GetVersion());
     if (packet) {
       packet->setDataByName("caster", client->GetPlayer()->GetIDWithPlayerSpawn(caster));
       packet->setDataByName("target", client->GetPlayer()->GetIDWithPlayerSpawn(target));
@@ -4262,7 +4581,7 @@ void ZoneServer::SendHealPacket(Spawn* caster, Spawn* target, int16 heal_type, i
       packet->setDataByName("type", heal_type);
       EQ2Packet* app = packet->serialize();
       client->QueuePacket(app);
-      safe_delete(packet);
+      configReader.ReleaseStruct(packet);
     }
   }
 }
@@ -4283,7 +4602,7 @@ void ZoneServer::SendThreatPacket(Spawn* caster, Spawn* target, int32 threat_amt
     if (target && target->GetDistance(client->GetPlayer()) > 50)
       continue;
 
-    PacketStruct* packet = configReader.getStruct("WS_HearThreatCmd", client->GetVersion());
+    PacketStruct* packet = configReader.AcquireStruct("WS_HearThreatCmd", client->GetVersion());
     if (packet) {
       packet->setDataByName("spell_name", spell_name);
       packet->setDataByName("spawn_id", client->GetPlayer()->GetIDWithPlayerSpawn(caster));
@@ -4292,7 +4611,7 @@ void ZoneServer::SendThreatPacket(Spawn* caster, Spawn* target, int32 threat_amt
 
       client->QueuePacket(packet->serialize());
     }
-    safe_delete(packet);
+    configReader.ReleaseStruct(packet);
   }
 }
 
@@ -5461,14 +5780,22 @@ void ZoneServer::SendEpicMobDeathToGuild(Player* killer, Spawn* victim) {
   }
 }
 
-void ZoneServer::ProcessAggroChecks(Spawn* spawn) {
+void ZoneServer::ProcessAggroChecks(const vector<Spawn*>& spawns, vector<AggroCandidates>* candidates) {
   // If faction based combat is not allowed then no need to run the loops so just return out
   if (!rule_manager.GetGlobalRule(R_Faction, AllowFactionBasedCombat)->GetBool())
     return;
 
-  if (spawn && spawn->IsNPC() && spawn->Alive())
-    if (!static_cast<NPC*>(spawn)->m_runningBack)
-      CheckEnemyList(static_cast<NPC*>(spawn));
+  for (Spawn* spawn : spawns) {
+    if (spawn->IsNPC() && spawn->Alive() && !static_cast<NPC*>(spawn)->m_runningBack && static_cast<NPC*>(spawn)->GetFactionID() != 0) {
+      candidates->push_back(AggroCandidates());
+      candidates->back().npc = static_cast<NPC*>(spawn);
+    }
+  }
+
+  spawn_worker_pool.ParallelFor(candidates->size(), SPAWN_WORKER_CHUNK, [this, candidates](int32 begin, int32 end) {
+    for (int32 i = begin; i < end; i++)
+      FindEnemies(&candidates->at(i));
+  });
 }
 
 void ZoneServer::SendUpdateTitles(const shared_ptr<Client>& client, Title* suffix, Title* prefix) {
@@ -5480,41 +5807,45 @@ void ZoneServer::SendUpdateTitles(Spawn* spawn, Title* suffix, Title* prefix) {
     return;
   }
 
-  shared_lock<shared_timed_mutex> guard(clients_mutex);
-
-  for (const auto& client : clients) {
-    PacketStruct* packet = configReader.getStruct("WS_UpdateTitle", client->GetVersion());
+  string prefix_title;
 
-    if (packet) {
-      packet->setDataByName("player_id", client->GetPlayer()->GetIDWithPlayerSpawn(spawn));
-      packet->setDataByName("player_name", spawn->GetName());
-      packet->setDataByName("unknown1", 1, 1);
+  if (prefix) {
+    prefix_title = prefix->GetName();
+  } else {
+    prefix_title = spawn->GetPrefixTitle();
+  }
 
-      if (suffix) {
-        packet->setDataByName("suffix_title", suffix->GetName());
-      } else {
-        packet->setDataByName("suffix_title", spawn->GetSuffixTitle());
-      }
+  string pvp_title;
 
-      string prefix_title;
+  if (spawn->IsPlayer()) {
+    pvp_title = PVP::GetRank(static_cast<Player*>(spawn));
+  }
 
-      if (prefix) {
-        prefix_title = prefix->GetName();
-      } else {
-        prefix_title = spawn->GetPrefixTitle();
-      }
+  PacketBroadcast broadcast("WS_UpdateTitle", [&](PacketStruct* packet) {
+    packet->setDataByName("player_name", spawn->GetName());
+    packet->setDataByName("unknown1", 1, 1);
 
-      if (spawn->IsPlayer()) {
-        string pvp_title = PVP::GetRank(static_cast<Player*>(spawn));
-        packet->setMediumStringByName("pvp_title", pvp_title.c_str());
-      }
+    if (suffix) {
+      packet->setDataByName("suffix_title", suffix->GetName());
+    } else {
+      packet->setDataByName("suffix_title", spawn->GetSuffixTitle());
+    }
 
-      packet->setDataByName("prefix_title", prefix_title.c_str());
-      packet->setDataByName("last_name", spawn->GetLastName());
-      packet->setDataByName("sub_title", spawn->GetSubTitle());
-      client->QueuePacket(packet->serialize());
-      safe_delete(packet);
+    if (spawn->IsPlayer()) {
+      packet->setMediumStringByName("pvp_title", pvp_title.c_str());
     }
+
+    packet->setDataByName("prefix_title", prefix_title.c_str());
+    packet->setDataByName("last_name", spawn->GetLastName());
+    packet->setDataByName("sub_title", spawn->GetSubTitle());
+  }, {"player_id"}, [&](PacketStruct* packet, const shared_ptr<Client>& client) {
+    packet->setDataByName("player_id", client->GetPlayer()->GetIDWithPlayerSpawn(spawn));
+  });
+
+  shared_lock<shared_timed_mutex> guard(clients_mutex);
+
+  for (const auto& client : clients) {
+    broadcast.Send(client);
   }
 }
 
@@ -5681,10 +6012,11 @@ void ZoneServer::HidePrivateSpawns() {
       Player* player = client->GetPlayer();
 
       if (player->WasSentSpawn(spawn->GetID()) && !player->WasSpawnRemoved(spawn)) {
-        PacketStruct* packet = configReader.getStruct("WS_DestroyGhostCmd", client->GetVersion());
+        PacketStruct* packet = configReader.AcquireStructByID(GetDestroyGhostStructID(), client->GetVersion());
 
         SendRemoveSpawn(client, spawn, packet);
         RemoveFromClientRangeMap(client, spawn->GetID());
+        configReader.ReleaseStruct(packet);
 
         if (player->GetTarget() == spawn) {
           player->SetTarget(0);
@@ -5766,14 +6098,23 @@ vector<Spawn*> ZoneServer::GetSpawnsByID(int32 id) {
   return tmp_list;
 }
 
+// Closest first
 vector<Spawn*> ZoneServer::GetAttackableSpawnsByDistance(Spawn* caster, float distance) {
   vector<Spawn*> ret;
-  Spawn* spawn = 0;
+  vector<Spawn*> nearby_spawns;
+  vector<pair<float, Spawn*>> in_range;
   map<int32, Spawn*>::iterator itr;
+
   MSpawnList.readlock(__FUNCTION__, __LINE__);
-  for (itr = spawn_list.begin(); itr != spawn_list.end(); itr++) {
-    spawn = itr->second;
+  if (Grid != nullptr)
+    Grid->GetSpawnsInRange(caster->GetX(), caster->GetZ(), distance, nearby_spawns);
+  else {
+    nearby_spawns.reserve(spawn_list.size());
+    for (itr = spawn_list.begin(); itr != spawn_list.end(); itr++)
+      nearby_spawns.push_back(itr->second);
+  }
 
+  for (Spawn* spawn : nearby_spawns) {
     if (!spawn || !spawn->Alive() || spawn == caster)
       continue;
 
@@ -5783,10 +6124,20 @@ vector<Spawn*> ZoneServer::GetAttackableSpawnsByDistance(Spawn* caster, float di
     if (caster->IsPet() && ((NPC*)caster)->GetOwner() && ((NPC*)caster)->GetOwner() == ((NPC*)spawn))
       continue;
 
-    if (((spawn->IsNPC() && spawn->appearance.attackable > 0) || (spawn->IsPlayer() && ((Player*)caster)->CanAttackTarget((Player*)spawn))) && spawn->GetDistance(caster, true) <= distance)
-      ret.push_back(spawn);
+    if ((spawn->IsNPC() && spawn->appearance.attackable > 0) || (spawn->IsPlayer() && ((Player*)caster)->CanAttackTarget((Player*)spawn))) {
+      float spawn_distance = spawn->GetDistance(caster, true);
+      if (spawn_distance <= distance)
+        in_range.push_back(make_pair(spawn_distance, spawn));
+    }
   }
   MSpawnList.releasereadlock(__FUNCTION__, __LINE__);
+
+  sort(in_range.begin(), in_range.end(), CompareSpawnDistance);
+
+  ret.reserve(in_range.size());
+  for (const auto& spawn : in_range)
+    ret.push_back(spawn.second);
+
   return ret;
 }
 
@@ -6008,57 +6359,47 @@ void ZoneServer::ClearHate(Entity* entity) {
   MSpawnList.releasereadlock(__FUNCTION__, __LINE__);
 }
 
-void ZoneLoop(ZoneServer* zs) {
-  if (zs) {
-    while (zs->Process()) {
-      if (zs->GetClientCount() == 0) {
-        Sleep(1000);
-      } else {
-        Sleep(10);
-      }
-    }
-  }
+sint32 ZoneLoop(ZoneServer* zs) {
+  if (!zs)
+    return -1;
+
+  if (zs->Process())
+    return zs->GetProcessDelay();
+
+  // the other tasks of the zone must be finished before it is deleted
+  zone_scheduler.RemoveTasks(zs);
+  zs->spawnthread_active = false;
 
   zs->Process();
-  safe_delete(zs);
-}
 
-void UpdateLoop(ZoneServer* zs) {
-  if (zs) {
-    while (zs->UpdateProcess()) {
-      if (zs->GetClientCount() == 0) {
-        Sleep(1000);
-      } else {
-        Sleep(10);
-      }
-    }
-  }
+  // the destructor waits for the zone's loader and initial spawn threads, keep that off the shared workers
+  thread w([zs]() { delete zs; });
+  w.detach();
+  return -1;
 }
 
-void SpawnLoop(ZoneServer* zs) {
-  if (zs) {
+sint32 SpawnLoop(ZoneServer* zs) {
+  if (!zs)
+    return -1;
+
 #ifndef NO_CATCH
-    try {
+  try {
 #endif
-      zs->spawnthread_active = true;
-      while (zs->SpawnProcess()) {
-        if (zs->GetClientCount() == 0)
-          Sleep(1000);
-        else
-          Sleep(20);
-      }
-      zs->spawnthread_active = false;
+    if (zs->SpawnProcess())
+      return zs->GetClientCount() == 0 ? ZONE_TASK_SLEEP : ZONE_SPAWN_INTERVAL;
 #ifndef NO_CATCH
+  } catch (...) {
+    LogWrite(ZONE__ERROR, 0, "Zone", "Error Processing SpawnLoop, shutting down zone '%s'...", zs->GetZoneName());
+    try {
+      zs->Shutdown();
     } catch (...) {
-      LogWrite(ZONE__ERROR, 0, "Zone", "Error Processing SpawnLoop, shutting down zone '%s'...", zs->GetZoneName());
-      try {
-        zs->Shutdown();
-      } catch (...) {
-        LogWrite(ZONE__ERROR, 0, "Zone", "Error Processing SpawnLoop while shutting down zone '%s'...", zs->GetZoneName());
-      }
+      LogWrite(ZONE__ERROR, 0, "Zone", "Error Processing SpawnLoop while shutting down zone '%s'...", zs->GetZoneName());
     }
-#endif
   }
+#endif
+
+  zs->spawnthread_active = false;
+  return -1;
 }
 
 void SendInitialSpawns(shared_ptr<Client> client) {
@@ -6147,26 +6488,26 @@ Spawn* ZoneServer::GetSpawn(int32 id) {
 }
 
 vector<EntityCommand*>* ZoneServer::GetEntityCommandList(int32 id) {
-  if (entity_command_list.count(id) > 0)
-    return entity_command_list[id];
+  if (zone_template->entity_command_list.count(id) > 0)
+    return zone_template->entity_command_list[id];
   else
     return 0;
 }
 
 void ZoneServer::SetEntityCommandList(int32 id, EntityCommand* command) {
-  if (entity_command_list.count(id) == 0)
-    entity_command_list[id] = new vector<EntityCommand*>;
+  if (zone_template->entity_command_list.count(id) == 0)
+    zone_template->entity_command_list[id] = new vector<EntityCommand*>;
 
-  entity_command_list[id]->push_back(command);
+  zone_template->entity_command_list[id]->push_back(command);
 }
 
 EntityCommand* ZoneServer::GetEntityCommand(int32 id, string name) {
   EntityCommand* ret = 0;
-  if (entity_command_list.count(id) == 0)
+  if (zone_template->entity_command_list.count(id) == 0)
     return ret;
 
   vector<EntityCommand*>::iterator itr;
-  for (itr = entity_command_list[id]->begin(); itr != entity_command_list[id]->end(); itr++) {
+  for (itr = zone_template->entity_command_list[id]->begin(); itr != zone_template->entity_command_list[id]->end(); itr++) {
     if ((*itr)->name == name) {
       ret = (*itr);
       break;
@@ -6176,45 +6517,28 @@ EntityCommand* ZoneServer::GetEntityCommand(int32 id, string name) {
   return ret;
 }
 
-void ZoneServer::ClearEntityCommands() {
-  if (entity_command_list.size() > 0) {
-    map<int32, vector<EntityCommand*>*>::iterator itr;
-    for (itr = entity_command_list.begin(); itr != entity_command_list.end(); itr++) {
-      vector<EntityCommand*>* entity_commands = itr->second;
-      if (entity_commands && entity_commands->size() > 0) {
-        vector<EntityCommand*>::iterator v_itr;
-        for (v_itr = entity_commands->begin(); v_itr != entity_commands->end(); v_itr++)
-          safe_delete(*v_itr);
-        entity_commands->clear();
-      }
-      safe_delete(entity_commands);
-    }
-    entity_command_list.clear();
-  }
-}
-
 void ZoneServer::AddNPCSpell(int32 list_id, int32 spell_id, int8 tier) {
-  npc_spell_list[list_id][spell_id] = tier;
+  zone_template->npc_spell_list[list_id][spell_id] = tier;
 }
 
 vector<Spell*>* ZoneServer::GetNPCSpells(int32 primary_list, int32 secondary_list) {
   vector<Spell*>* ret = 0;
-  if (npc_spell_list.count(primary_list) > 0) {
+  if (zone_template->npc_spell_list.count(primary_list) > 0) {
     ret = new vector<Spell*>();
     map<int32, int8>::iterator itr;
     Spell* tmpSpell = 0;
-    for (itr = npc_spell_list[primary_list].begin(); itr != npc_spell_list[primary_list].end(); itr++) {
+    for (itr = zone_template->npc_spell_list[primary_list].begin(); itr != zone_template->npc_spell_list[primary_list].end(); itr++) {
       tmpSpell = master_spell_list.GetSpell(itr->first, itr->second);
       if (tmpSpell)
         ret->push_back(tmpSpell);
     }
   }
-  if (npc_spell_list.count(secondary_list) > 0) {
+  if (zone_template->npc_spell_list.count(secondary_list) > 0) {
     if (!ret)
       ret = new vector<Spell*>();
     map<int32, int8>::iterator itr;
     Spell* tmpSpell = 0;
-    for (itr = npc_spell_list[secondary_list].begin(); itr != npc_spell_list[secondary_list].end(); itr++) {
+    for (itr = zone_template->npc_spell_list[secondary_list].begin(); itr != zone_template->npc_spell_list[secondary_list].end(); itr++) {
       tmpSpell = master_spell_list.GetSpell(itr->first, itr->second);
       if (tmpSpell)
         ret->push_back(tmpSpell);
@@ -6228,16 +6552,16 @@ vector<Spell*>* ZoneServer::GetNPCSpells(int32 primary_list, int32 secondary_lis
 }
 
 void ZoneServer::AddNPCSkill(int32 list_id, int32 skill_id, int16 value) {
-  npc_skill_list[list_id][skill_id] = value;
+  zone_template->npc_skill_list[list_id][skill_id] = value;
 }
 
 map<string, Skill*>* ZoneServer::GetNPCSkills(int32 primary_list, int32 secondary_list) {
   map<string, Skill*>* ret = 0;
-  if (npc_skill_list.count(primary_list) > 0) {
+  if (zone_template->npc_skill_list.count(primary_list) > 0) {
     ret = new map<string, Skill*>();
     map<int32, int16>::iterator itr;
     Skill* tmpSkill = 0;
-    for (itr = npc_skill_list[primary_list].begin(); itr != npc_skill_list[primary_list].end(); itr++) {
+    for (itr = zone_template->npc_skill_list[primary_list].begin(); itr != zone_template->npc_skill_list[primary_list].end(); itr++) {
       tmpSkill = master_skill_list.GetSkill(itr->first);
       if (tmpSkill) {
         tmpSkill = new Skill(tmpSkill);
@@ -6247,12 +6571,12 @@ map<string, Skill*>* ZoneServer::GetNPCSkills(int32 primary_list, int32 secondar
       }
     }
   }
-  if (npc_skill_list.count(secondary_list) > 0) {
+  if (zone_template->npc_skill_list.count(secondary_list) > 0) {
     if (!ret)
       ret = new map<string, Skill*>();
     map<int32, int16>::iterator itr;
     Skill* tmpSkill = 0;
-    for (itr = npc_skill_list[secondary_list].begin(); itr != npc_skill_list[secondary_list].end(); itr++) {
+    for (itr = zone_template->npc_skill_list[secondary_list].begin(); itr != zone_template->npc_skill_list[secondary_list].end(); itr++) {
       tmpSkill = master_skill_list.GetSkill(itr->first);
       if (tmpSkill) {
         tmpSkill = new Skill(tmpSkill);
@@ -6270,15 +6594,15 @@ map<string, Skill*>* ZoneServer::GetNPCSkills(int32 primary_list, int32 secondar
 }
 
 void ZoneServer::AddNPCEquipment(int32 list_id, int32 item_id) {
-  npc_equipment_list[list_id].push_back(item_id);
+  zone_template->npc_equipment_list[list_id].push_back(item_id);
 }
 
 void ZoneServer::SetNPCEquipment(NPC* npc) {
-  if (npc_equipment_list.count(npc->GetEquipmentListID()) > 0) {
+  if (zone_template->npc_equipment_list.count(npc->GetEquipmentListID()) > 0) {
     Item* tmpItem = 0;
     int8 slot = 0;
     vector<int32>::iterator itr;
-    for (itr = npc_equipment_list[npc->GetEquipmentListID()].begin(); itr != npc_equipment_list[npc->GetEquipmentListID()].end(); itr++) {
+    for (itr = zone_template->npc_equipment_list[npc->GetEquipmentListID()].begin(); itr != zone_template->npc_equipment_list[npc->GetEquipmentListID()].end(); itr++) {
       tmpItem = master_item_list.GetItem(*itr);
       if (tmpItem) {
         slot = npc->GetEquipmentList()->GetFreeSlot(tmpItem);
@@ -6292,36 +6616,27 @@ void ZoneServer::SetNPCEquipment(NPC* npc) {
 }
 
 void ZoneServer::AddNPC(int32 id, NPC* npc) {
-  npc_list[id] = npc;
+  zone_template->npc_list[id] = npc;
 }
 
 void ZoneServer::AddWidget(int32 id, Widget* widget) {
-  widget_list[id] = widget;
+  zone_template->widget_list[id] = widget;
 }
 
 Widget* ZoneServer::GetWidget(int32 id, bool override_loading) {
-  if ((!reloading || override_loading) && widget_list.count(id) > 0)
-    return widget_list[id];
+  if ((!reloading || override_loading) && zone_template->widget_list.count(id) > 0)
+    return zone_template->widget_list[id];
   else
     return 0;
 }
 
 Widget* ZoneServer::GetNewWidget(int32 id) {
-  if (!reloading && widget_list.count(id) > 0)
-    return widget_list[id]->Copy();
+  if (!reloading && zone_template->widget_list.count(id) > 0)
+    return zone_template->widget_list[id]->Copy();
   else
     return 0;
 }
 
-void ZoneServer::LoadGroundSpawnEntries() {
-  MGroundSpawnItems.lock();
-  database.LoadGroundSpawnEntries(this);
-  MGroundSpawnItems.unlock();
-}
-
-void ZoneServer::LoadGroundSpawnItems() {
-}
-
 void ZoneServer::AddGroundSpawnEntry(int32 groundspawn_id, int16 min_skill_level, int16 min_adventure_level, int8 bonus_table, float harvest1, float harvest3, float harvest5, float harvest_imbue, float harvest_rare, float harvest10, int32 harvest_coin) {
   GroundSpawnEntry* entry = new GroundSpawnEntry;
   entry->min_skill_level = min_skill_level;
@@ -6334,7 +6649,7 @@ void ZoneServer::AddGroundSpawnEntry(int32 groundspawn_id, int16 min_skill_level
   entry->harvest_rare = harvest_rare;
   entry->harvest10 = harvest10;
   entry->harvest_coin = harvest_coin;
-  groundspawn_entries[groundspawn_id].push_back(entry);
+  zone_template->groundspawn_entries[groundspawn_id].push_back(entry);
 }
 
 void ZoneServer::AddGroundSpawnItem(int32 groundspawn_id, int32 item_id, int8 is_rare, int32 grid_id) {
@@ -6342,120 +6657,67 @@ void ZoneServer::AddGroundSpawnItem(int32 groundspawn_id, int32 item_id, int8 is
   entry->item_id = item_id;
   entry->is_rare = is_rare;
   entry->grid_id = grid_id;
-  groundspawn_items[groundspawn_id].push_back(entry);
+  zone_template->groundspawn_items[groundspawn_id].push_back(entry);
 }
 
 vector<GroundSpawnEntry*>* ZoneServer::GetGroundSpawnEntries(int32 id) {
   vector<GroundSpawnEntry*>* ret = 0;
-  MGroundSpawnItems.lock();
-  if (groundspawn_entries.count(id) > 0)
-    ret = &groundspawn_entries[id];
-  MGroundSpawnItems.unlock();
+  if (zone_template->groundspawn_entries.count(id) > 0)
+    ret = &zone_template->groundspawn_entries[id];
   return ret;
 }
 
 vector<GroundSpawnEntryItem*>* ZoneServer::GetGroundSpawnEntryItems(int32 id) {
   vector<GroundSpawnEntryItem*>* ret = 0;
-  if (groundspawn_items.count(id) > 0)
-    ret = &groundspawn_items[id];
+  if (zone_template->groundspawn_items.count(id) > 0)
+    ret = &zone_template->groundspawn_items[id];
   return ret;
 }
 
-// TODO - mis-named, should be DeleteGroundSpawnEntries() but this is ok for now :)
-void ZoneServer::DeleteGroundSpawnItems() {
-  MGroundSpawnItems.lock();
-
-  map<int32, vector<GroundSpawnEntry*>>::iterator groundspawnentry_map_itr;
-  vector<GroundSpawnEntry*>::iterator groundspawnentry_itr;
-  for (groundspawnentry_map_itr = groundspawn_entries.begin(); groundspawnentry_map_itr != groundspawn_entries.end(); groundspawnentry_map_itr++) {
-    for (groundspawnentry_itr = groundspawnentry_map_itr->second.begin(); groundspawnentry_itr != groundspawnentry_map_itr->second.end(); groundspawnentry_itr++) {
-      safe_delete(*groundspawnentry_itr);
-    }
-  }
-  groundspawn_entries.clear();
-
-  map<int32, vector<GroundSpawnEntryItem*>>::iterator groundspawnitem_map_itr;
-  vector<GroundSpawnEntryItem*>::iterator groundspawnitem_itr;
-  for (groundspawnitem_map_itr = groundspawn_items.begin(); groundspawnitem_map_itr != groundspawn_items.end(); groundspawnitem_map_itr++) {
-    for (groundspawnitem_itr = groundspawnitem_map_itr->second.begin(); groundspawnitem_itr != groundspawnitem_map_itr->second.end(); groundspawnitem_itr++) {
-      safe_delete(*groundspawnitem_itr);
-    }
-  }
-  groundspawn_items.clear();
-
-  MGroundSpawnItems.unlock();
-}
-
 void ZoneServer::AddGroundSpawn(int32 id, GroundSpawn* spawn) {
-  groundspawn_list[id] = spawn;
+  zone_template->groundspawn_list[id] = spawn;
 }
 
 GroundSpawn* ZoneServer::GetGroundSpawn(int32 id, bool override_loading) {
-  if ((!reloading || override_loading) && groundspawn_list.count(id) > 0)
-    return groundspawn_list[id];
+  if ((!reloading || override_loading) && zone_template->groundspawn_list.count(id) > 0)
+    return zone_template->groundspawn_list[id];
   else
     return 0;
 }
 
 GroundSpawn* ZoneServer::GetNewGroundSpawn(int32 id) {
-  if (!reloading && groundspawn_list.count(id) > 0)
-    return groundspawn_list[id]->Copy();
+  if (!reloading && zone_template->groundspawn_list.count(id) > 0)
+    return zone_template->groundspawn_list[id]->Copy();
   else
     return 0;
 }
 
 void ZoneServer::AddLootTable(int32 id, LootTable* table) {
-  loot_tables[id] = table;
+  zone_template->loot_tables[id] = table;
 }
 
 void ZoneServer::AddLootDrop(int32 id, LootDrop* drop) {
-  loot_drops[id].push_back(drop);
+  zone_template->loot_drops[id].push_back(drop);
 }
 
 void ZoneServer::AddSpawnLootList(int32 spawn_id, int32 id) {
-  spawn_loot_list[spawn_id].push_back(id);
+  zone_template->spawn_loot_list[spawn_id].push_back(id);
 }
 
 void ZoneServer::AddLevelLootList(int8 level, int32 id) {
-  level_loot_list[level].push_back(id);
+  zone_template->level_loot_list[level].push_back(id);
 }
 
 void ZoneServer::AddRacialLootList(int16 racial_id, int32 id) {
-  racial_loot_list[racial_id].push_back(id);
+  zone_template->racial_loot_list[racial_id].push_back(id);
 }
 
 void ZoneServer::AddZoneLootList(int32 zone, ZoneLoot* loot) {
-  zone_loot_list[zone].push_back(loot);
+  zone_template->zone_loot_list[zone].push_back(loot);
 }
 
 void ZoneServer::ClearLootTables() {
-  map<int32, LootTable*>::iterator table_itr;
-  for (table_itr = loot_tables.begin(); table_itr != loot_tables.end(); table_itr++) {
-    safe_delete(table_itr->second);
-  }
-
-  map<int32, vector<LootDrop*>>::iterator drop_itr;
-  vector<LootDrop*>::iterator drop_itr2;
-  for (drop_itr = loot_drops.begin(); drop_itr != loot_drops.end(); drop_itr++) {
-    for (drop_itr2 = drop_itr->second.begin(); drop_itr2 != drop_itr->second.end(); drop_itr2++) {
-      safe_delete(*drop_itr2);
-    }
-  }
-
-  map<int32, vector<ZoneLoot*>>::iterator zone_itr;
-  vector<ZoneLoot*>::iterator zone_itr2;
-  for (zone_itr = zone_loot_list.begin(); zone_itr != zone_loot_list.end(); zone_itr++) {
-    for (zone_itr2 = zone_itr->second.begin(); zone_itr2 != zone_itr->second.end(); zone_itr2++) {
-      safe_delete(*zone_itr2);
-    }
-  }
-
-  loot_tables.clear();
-  loot_drops.clear();
-  spawn_loot_list.clear();
-  level_loot_list.clear();
-  racial_loot_list.clear();
-  zone_loot_list.clear();
+  zone_template->ClearLootTables();
 }
 
 vector<int32> ZoneServer::GetSpawnLootList(int32 spawn_id, int32 zone_id, int8 spawn_level, int16 racial_id) {
@@ -6463,18 +6725,18 @@ vector<int32> ZoneServer::GetSpawnLootList(int32 spawn_id, int32 zone_id, int8 s
   if (reloading)
     return ret;
 
-  if (spawn_loot_list.count(spawn_id) > 0)
-    ret.insert(ret.end(), spawn_loot_list[spawn_id].begin(), spawn_loot_list[spawn_id].end());
+  if (zone_template->spawn_loot_list.count(spawn_id) > 0)
+    ret.insert(ret.end(), zone_template->spawn_loot_list[spawn_id].begin(), zone_template->spawn_loot_list[spawn_id].end());
 
-  if (level_loot_list.count(spawn_level) > 0)
-    ret.insert(ret.end(), level_loot_list[spawn_level].begin(), level_loot_list[spawn_level].end());
+  if (zone_template->level_loot_list.count(spawn_level) > 0)
+    ret.insert(ret.end(), zone_template->level_loot_list[spawn_level].begin(), zone_template->level_loot_list[spawn_level].end());
 
-  if (racial_loot_list.count(racial_id) > 0)
-    ret.insert(ret.end(), racial_loot_list[racial_id].begin(), racial_loot_list[racial_id].end());
+  if (zone_template->racial_loot_list.count(racial_id) > 0)
+    ret.insert(ret.end(), zone_template->racial_loot_list[racial_id].begin(), zone_template->racial_loot_list[racial_id].end());
 
-  if (zone_loot_list.count(zone_id) > 0) {
+  if (zone_template->zone_loot_list.count(zone_id) > 0) {
     vector<ZoneLoot*>::iterator itr;
-    for (itr = zone_loot_list[zone_id].begin(); itr != zone_loot_list[zone_id].end(); itr++) {
+    for (itr = zone_template->zone_loot_list[zone_id].begin(); itr != zone_template->zone_loot_list[zone_id].end(); itr++) {
       ZoneLoot* loot = *itr;
       if (loot->minLevel == 0 && loot->maxLevel == 0)
         ret.push_back(loot->table_id);
@@ -6489,14 +6751,18 @@ vector<int32> ZoneServer::GetSpawnLootList(int32 spawn_id, int32 zone_id, int8 s
 }
 
 vector<LootDrop*>* ZoneServer::GetLootDrops(int32 table_id) {
-  if (!reloading && loot_drops.count(table_id) > 0)
-    return &(loot_drops[table_id]);
+  if (!reloading && zone_template->loot_drops.count(table_id) > 0)
+    return &(zone_template->loot_drops[table_id]);
   else
     return 0;
 }
 
 LootTable* ZoneServer::GetLootTable(int32 table_id) {
-  return loot_tables[table_id];
+  map<int32, LootTable*>::iterator itr = zone_template->loot_tables.find(table_id);
+  if (itr != zone_template->loot_tables.end())
+    return itr->second;
+
+  return 0;
 }
 
 void ZoneServer::AddLocationTransporter(int32 zone_id, string message, float trigger_x, float trigger_y, float trigger_z, float trigger_radius, int32 destination_zone_id, float destination_x, float destination_y, float destination_z, float destination_heading, int32 cost, int32 unique_id) {
@@ -6513,11 +6779,11 @@ void ZoneServer::AddLocationTransporter(int32 zone_id, string message, float tri
   loc->destination_heading = destination_heading;
   loc->cost = cost;
   loc->unique_id = unique_id;
-  MTransporters.lock();
-  if (location_transporters.count(zone_id) == 0)
-    location_transporters[zone_id] = new MutexList<LocationTransportDestination*>();
-  location_transporters[zone_id]->Add(loc);
-  MTransporters.unlock();
+  zone_template->MTransporters.lock();
+  if (zone_template->location_transporters.count(zone_id) == 0)
+    zone_template->location_transporters[zone_id] = new MutexList<LocationTransportDestination*>();
+  zone_template->location_transporters[zone_id]->Add(loc);
+  zone_template->MTransporters.unlock();
 }
 
 void ZoneServer::AddTransporter(int32 transport_id, int8 type, string name, string message, int32 destination_zone_id, float destination_x, float destination_y, float destination_z, float destination_heading, int32 cost, int32 unique_id, int8 min_level, int8 max_level, int32 quest_req, int16 quest_step_req, int32 quest_complete, int32 map_x, int32 map_y) {
@@ -6542,100 +6808,43 @@ void ZoneServer::AddTransporter(int32 transport_id, int8 type, string name, stri
   transport->map_x = map_x;
   transport->map_y = map_y;
 
-  MTransporters.lock();
-  transporters[transport_id].push_back(transport);
-  MTransporters.unlock();
+  zone_template->MTransporters.lock();
+  zone_template->transporters[transport_id].push_back(transport);
+  zone_template->MTransporters.unlock();
 }
 
 vector<TransportDestination*>* ZoneServer::GetTransporters(int32 transport_id) {
   vector<TransportDestination*>* ret = 0;
-  MTransporters.lock();
-  if (transporters.count(transport_id) > 0)
-    ret = &transporters[transport_id];
-  MTransporters.unlock();
+  zone_template->MTransporters.lock();
+  if (zone_template->transporters.count(transport_id) > 0)
+    ret = &zone_template->transporters[transport_id];
+  zone_template->MTransporters.unlock();
   return ret;
 }
 
 MutexList<LocationTransportDestination*>* ZoneServer::GetLocationTransporters(int32 zone_id) {
   MutexList<LocationTransportDestination*>* ret = 0;
-  MTransporters.lock();
-  if (location_transporters.count(zone_id) > 0)
-    ret = location_transporters[zone_id];
-  MTransporters.unlock();
+  zone_template->MTransporters.lock();
+  if (zone_template->location_transporters.count(zone_id) > 0)
+    ret = zone_template->location_transporters[zone_id];
+  zone_template->MTransporters.unlock();
   return ret;
 }
 
 void ZoneServer::DeleteGlobalTransporters() {
-  MTransporters.lock();
-  map<int32, vector<TransportDestination*>>::iterator itr;
-  vector<TransportDestination*>::iterator transport_vector_itr;
-  for (itr = transporters.begin(); itr != transporters.end(); itr++) {
-    for (transport_vector_itr = itr->second.begin(); transport_vector_itr != itr->second.end(); transport_vector_itr++) {
-      safe_delete(*transport_vector_itr);
-    }
-  }
-  map<int32, MutexList<LocationTransportDestination*>*>::iterator itr2;
-  for (itr2 = location_transporters.begin(); itr2 != location_transporters.end(); itr2++) {
-    itr2->second->clear(true);
-    delete itr2->second;
-  }
-  transporters.clear();
-  location_transporters.clear();
-  MTransporters.unlock();
-}
-
-void ZoneServer::DeleteGlobalSpawns() {
-  ClearLootTables();
-
-  map<int32, NPC*>::iterator npc_list_iter;
-  for (npc_list_iter = npc_list.begin(); npc_list_iter != npc_list.end(); npc_list_iter++) {
-    safe_delete(npc_list_iter->second);
-  }
-  npc_list.clear();
-  map<int32, Object*>::iterator object_list_iter;
-  for (object_list_iter = object_list.begin(); object_list_iter != object_list.end(); object_list_iter++) {
-    safe_delete(object_list_iter->second);
-  }
-  object_list.clear();
-  map<int32, GroundSpawn*>::iterator groundspawn_list_iter;
-  for (groundspawn_list_iter = groundspawn_list.begin(); groundspawn_list_iter != groundspawn_list.end(); groundspawn_list_iter++) {
-    safe_delete(groundspawn_list_iter->second);
-  }
-  groundspawn_list.clear();
-  map<int32, Widget*>::iterator widget_list_iter;
-  for (widget_list_iter = widget_list.begin(); widget_list_iter != widget_list.end(); widget_list_iter++) {
-    safe_delete(widget_list_iter->second);
-  }
-  widget_list.clear();
-  map<int32, Sign*>::iterator sign_list_iter;
-  for (sign_list_iter = sign_list.begin(); sign_list_iter != sign_list.end(); sign_list_iter++) {
-    safe_delete(sign_list_iter->second);
-  }
-  sign_list.clear();
-
-  /*map<int32, AppearanceData*>::iterator appearance_list_iter;
-	for(appearance_list_iter=npc_appearance_list.begin();appearance_list_iter!=npc_appearance_list.end();appearance_list_iter++) {
-		safe_delete(appearance_list_iter->second);
-	}
-	npc_appearance_list.clear();*/
-
-  ClearEntityCommands();
-
-  DeleteGroundSpawnItems();
-  DeleteGlobalTransporters();
-  DeleteTransporterMaps();
+  zone_template->DeleteGlobalTransporters();
 }
 
 void ZoneServer::AddTransportMap(int32 id, string name) {
-  MTransportMaps.writelock(__FUNCTION__, __LINE__);
-  m_transportMaps[id] = name;
-  MTransportMaps.releasewritelock(__FUNCTION__, __LINE__);
+  zone_template->MTransportMaps.writelock(__FUNCTION__, __LINE__);
+  zone_template->m_transportMaps[id] = name;
+  zone_template->MTransportMaps.releasewritelock(__FUNCTION__, __LINE__);
 }
 
 bool ZoneServer::TransportHasMap(int32 id) {
-  MTransportMaps.readlock(__FUNCTION__, __LINE__);
-  bool ret = m_transportMaps.count(id) > 0;
-  MTransportMaps.releasereadlock(__FUNCTION__, __LINE__);
+  zone_template->MTransportMaps.readlock(__FUNCTION__, __LINE__);
+  bool ret = zone_template->m_transportMaps.count(id) > 0;
+  zone_template->MTransportMaps.releasereadlock(__FUNCTION__, __LINE__);
 
   return ret;
 }
@@ -6643,18 +6852,196 @@ bool ZoneServer::TransportHasMap(int32 id) {
 string ZoneServer::GetTransportMap(int32 id) {
   string ret;
 
-  MTransportMaps.readlock(__FUNCTION__, __LINE__);
-  if (m_transportMaps.count(id) > 0)
-    ret = m_transportMaps[id];
-  MTransportMaps.releasereadlock(__FUNCTION__, __LINE__);
+  zone_template->MTransportMaps.readlock(__FUNCTION__, __LINE__);
+  if (zone_template->m_transportMaps.count(id) > 0)
+    ret = zone_template->m_transportMaps[id];
+  zone_template->MTransportMaps.releasereadlock(__FUNCTION__, __LINE__);
 
   return ret;
 }
 
 void ZoneServer::DeleteTransporterMaps() {
-  MTransportMaps.writelock(__FUNCTION__, __LINE__);
-  m_transportMaps.clear();
-  MTransportMaps.releasewritelock(__FUNCTION__, __LINE__);
+  zone_template->DeleteTransporterMaps();
+}
+
+void ZoneServer::LoadZoneTemplate() {
+  shared_ptr<ZoneTemplate> loaded;
+  if (!force_template_reload)
+    loaded = zone_templates.Get(GetZoneID());
+  force_template_reload = false;
+
+  // another instance of this zone already loaded everything, only the spawns need to be placed
+  if (loaded) {
+    LogWrite(ZONE__INFO, 0, "Zone", "Using the already loaded data of zone %u", GetZoneID());
+    zone_template = loaded;
+    spawn_locations_from_template = loaded->has_spawn_locations;
+    publish_template = false;
+    return;
+  }
+
+  zone_template = make_shared<ZoneTemplate>(GetZoneID());
+
+  // spawns look up their command lists while they load, every other table is loaded on its own database worker
+  LogWrite(COMMAND__DEBUG, 0, "Command", "-Loading Entity Commands...");
+  database.LoadEntityCommands(this);
+
+  vector<future<void>> loads;
+  loads.push_back(database.QueueWork(0, [this]() {
+    LogWrite(NPC__INFO, 0, "NPC", "-Loading NPC data...");
+    database.LoadNPCs(this);
+    LogWrite(NPC__INFO, 0, "NPC", "-Load NPC data complete!");
+  }));
+  loads.push_back(database.QueueWork(0, [this]() {
+    LogWrite(OBJECT__INFO, 0, "Object", "-Loading Object data...");
+    database.LoadObjects(this);
+    LogWrite(OBJECT__INFO, 0, "Object", "-Load Object data complete!");
+  }));
+  loads.push_back(database.QueueWork(0, [this]() {
+    LogWrite(SIGN__INFO, 0, "Sign", "-Loading Sign data...");
+    database.LoadSigns(this);
+    LogWrite(SIGN__INFO, 0, "Sign", "-Load Sign data complete!");
+  }));
+  loads.push_back(database.QueueWork(0, [this]() {
+    LogWrite(WIDGET__INFO, 0, "Widget", "-Loading Widget data...");
+    database.LoadWidgets(this);
+    LogWrite(WIDGET__INFO, 0, "Widget", "-Load Widget data complete!");
+  }));
+  loads.push_back(database.QueueWork(0, [this]() {
+    LogWrite(GROUNDSPAWN__INFO, 0, "GSpawn", "-Loading Groundspawn data...");
+    database.LoadGroundSpawns(this);
+    database.LoadGroundSpawnEntries(this);
+    LogWrite(GROUNDSPAWN__INFO, 0, "GSpawn", "-Load Groundspawn data complete!");
+  }));
+  loads.push_back(database.QueueWork(0, [this]() {
+    LogWrite(PET__INFO, 0, "Pet", "-Loading Pet data...");
+    database.GetPetNames(this);
+    LogWrite(PET__INFO, 0, "Pet", "-Load Pet data complete!");
+  }));
+  loads.push_back(database.QueueWork(0, [this]() {
+    LogWrite(LOOT__INFO, 0, "Loot", "-Loading Spawn loot data...");
+    database.LoadLoot(this);
+    LogWrite(LOOT__INFO, 0, "Loot", "-Loading Spawn loot data complete!");
+  }));
+  loads.push_back(database.QueueWork(0, [this]() {
+    LogWrite(TRANSPORT__INFO, 0, "Transport", "-Loading Transporters...");
+    database.LoadTransporters(this);
+    LogWrite(TRANSPORT__INFO, 0, "Transport", "-Loading Transporters complete!");
+  }));
+
+  // the loads use this zone, so all of them have to finish before a failed one is rethrown
+  for (auto& load : loads)
+    load.wait();
+  for (auto& load : loads)
+    load.get();
+
+  publish_template = true;
+}
+
+void ZoneServer::LoadSpawnData() {
+  MSpawnGroupAssociation.writelock(__FUNCTION__, __LINE__);
+  spawn_group_associations.clear();
+  MSpawnGroupAssociation.releasewritelock(__FUNCTION__, __LINE__);
+
+  MSpawnGroupLocations.writelock(__FUNCTION__, __LINE__);
+  spawn_group_locations.clear();
+  MSpawnGroupLocations.releasewritelock(__FUNCTION__, __LINE__);
+
+  MSpawnLocationGroups.writelock(__FUNCTION__, __LINE__);
+  spawn_location_groups.clear();
+  MSpawnLocationGroups.releasewritelock(__FUNCTION__, __LINE__);
+
+  MSpawnGroupChances.writelock(__FUNCTION__, __LINE__);
+  spawn_group_chances.clear();
+  MSpawnGroupChances.releasewritelock(__FUNCTION__, __LINE__);
+
+  DeleteTransporters();
+  ReloadTransporters();
+
+  if (spawn_locations_from_template) {
+    LoadTemplateSpawnLocations();
+    spawn_locations_from_template = false;
+  } else
+    database.LoadSpawns(this);
+
+  if (publish_template) {
+    StoreTemplateSpawnLocations();
+    zone_templates.Add(zone_template);
+    publish_template = false;
+  }
+
+  if (!revive_points)
+    revive_points = new vector<RevivePoint*>;
+  else {
+    while (!revive_points->empty()) {
+      safe_delete(revive_points->back());
+      revive_points->pop_back();
+    }
+  }
+  database.LoadRevivePoints(revive_points, GetZoneID());
+}
+
+void ZoneServer::StoreTemplateSpawnLocations() {
+  zone_template->DeleteSpawnLocations();
+
+  MSpawnLocationList.readlock(__FUNCTION__, __LINE__);
+  map<int32, SpawnLocation*>::iterator loc_itr;
+  for (loc_itr = spawn_location_list.begin(); loc_itr != spawn_location_list.end(); loc_itr++)
+    zone_template->spawn_location_list[loc_itr->first] = loc_itr->second->Copy();
+  MSpawnLocationList.releasereadlock(__FUNCTION__, __LINE__);
+
+  MSpawnGroupAssociation.readlock(__FUNCTION__, __LINE__);
+  map<int32, set<int32>*>::iterator assoc_itr;
+  for (assoc_itr = spawn_group_associations.begin(); assoc_itr != spawn_group_associations.end(); assoc_itr++)
+    zone_template->spawn_group_associations[assoc_itr->first] = *assoc_itr->second;
+  MSpawnGroupAssociation.releasereadlock(__FUNCTION__, __LINE__);
+
+  MSpawnGroupLocations.readlock(__FUNCTION__, __LINE__);
+  map<int32, map<int32, int32>*>::iterator group_loc_itr;
+  for (group_loc_itr = spawn_group_locations.begin(); group_loc_itr != spawn_group_locations.end(); group_loc_itr++)
+    zone_template->spawn_group_locations[group_loc_itr->first] = *group_loc_itr->second;
+  MSpawnGroupLocations.releasereadlock(__FUNCTION__, __LINE__);
+
+  MSpawnLocationGroups.readlock(__FUNCTION__, __LINE__);
+  map<int32, list<int32>*>::iterator loc_group_itr;
+  for (loc_group_itr = spawn_location_groups.begin(); loc_group_itr != spawn_location_groups.end(); loc_group_itr++)
+    zone_template->spawn_location_groups[loc_group_itr->first] = *loc_group_itr->second;
+  MSpawnLocationGroups.releasereadlock(__FUNCTION__, __LINE__);
+
+  MSpawnGroupChances.readlock(__FUNCTION__, __LINE__);
+  zone_template->spawn_group_chances = spawn_group_chances;
+  MSpawnGroupChances.releasereadlock(__FUNCTION__, __LINE__);
+
+  zone_template->has_spawn_locations = true;
+}
+
+void ZoneServer::LoadTemplateSpawnLocations() {
+  map<int32, SpawnLocation*>::iterator loc_itr;
+  for (loc_itr = zone_template->spawn_location_list.begin(); loc_itr != zone_template->spawn_location_list.end(); loc_itr++)
+    AddSpawnLocation(loc_itr->first, loc_itr->second->Copy());
+
+  MSpawnGroupAssociation.writelock(__FUNCTION__, __LINE__);
+  map<int32, set<int32>>::iterator assoc_itr;
+  for (assoc_itr = zone_template->spawn_group_associations.begin(); assoc_itr != zone_template->spawn_group_associations.end(); assoc_itr++)
+    spawn_group_associations[assoc_itr->first] = new set<int32>(assoc_itr->second);
+  MSpawnGroupAssociation.releasewritelock(__FUNCTION__, __LINE__);
+
+  MSpawnGroupLocations.writelock(__FUNCTION__, __LINE__);
+  map<int32, map<int32, int32>>::iterator group_loc_itr;
+  for (group_loc_itr = zone_template->spawn_group_locations.begin(); group_loc_itr != zone_template->spawn_group_locations.end(); group_loc_itr++)
+    spawn_group_locations[group_loc_itr->first] = new map<int32, int32>(group_loc_itr->second);
+  MSpawnGroupLocations.releasewritelock(__FUNCTION__, __LINE__);
+
+  MSpawnLocationGroups.writelock(__FUNCTION__, __LINE__);
+  map<int32, list<int32>>::iterator loc_group_itr;
+  for (loc_group_itr = zone_template->spawn_location_groups.begin(); loc_group_itr != zone_template->spawn_location_groups.end(); loc_group_itr++)
+    spawn_location_groups[loc_group_itr->first] = new list<int32>(loc_group_itr->second);
+  MSpawnLocationGroups.releasewritelock(__FUNCTION__, __LINE__);
+
+  MSpawnGroupChances.writelock(__FUNCTION__, __LINE__);
+  spawn_group_chances = zone_template->spawn_group_chances;
+  MSpawnGroupChances.releasewritelock(__FUNCTION__, __LINE__);
+
+  LogWrite(SPAWN__INFO, 0, "Spawn", "Copied %u spawn location(s) for zone '%s' (%u) from the loaded zone data", zone_template->spawn_location_list.size(), GetZoneName(), GetZoneID());
 }
 
 void ZoneServer::ReloadSpawns() {
@@ -6664,7 +7051,8 @@ void ZoneServer::ReloadSpawns() {
   reloading = true;
   // Let every one in the zone know what is happening
   HandleBroadcast("Reloading all spawns for this zone.");
-  DeleteGlobalSpawns();
+  // the zone's data is loaded fresh once the depop is done, other instances keep using the current copy
+  force_template_reload = true;
   Depop(false, true);
 }
 
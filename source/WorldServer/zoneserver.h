@@ -32,8 +32,10 @@
 #include "net.h"
 #include "Player.h"
 #include "Combat.h"
+#include <atomic>
 #include <list>
 #include <map>
+#include <future>
 #include <set>
 #include <shared_mutex>
 #include "MutexList.h"
@@ -44,6 +46,7 @@
 #include "Object.h"
 #include "GroundSpawn.h"
 #include "Sign.h"
+#include "Zone/ZoneTemplate.h"
 
 #include "Guilds/Guild.h"
 
@@ -154,6 +157,13 @@ struct TrackedSpawn {
   float distance;
 };
 
+// The spawns an npc could attack or be attacked by this aggro check, closest first
+struct AggroCandidates {
+  NPC* npc;
+  vector<pair<float, Spawn*>> attack_spawns;
+  vector<pair<float, Spawn*>> reverse_attack_spawns;
+};
+
 class Widget;
 class Client;
 class Sign;
@@ -167,9 +177,18 @@ struct ZoneLoot;
 struct TransportDestination;
 struct LocationTransportDestination;
 
-void ZoneLoop(ZoneServer* zs);
-void SpawnLoop(ZoneServer* zs);
-void UpdateLoop(ZoneServer* zs);
+// ms between runs of the zone tasks that have no rule for it
+#define ZONE_PROCESS_INTERVAL 50 // the spell process runs every 50ms, client packets wake the task sooner
+#define ZONE_SPAWN_INTERVAL 20
+#define ZONE_MOVEMENT_INTERVAL 20
+#define ZONE_VISIBILITY_INTERVAL 1000
+#define ZONE_SPAWN_UPDATE_INTERVAL 100
+#define ZONE_RESPAWN_INTERVAL 10000
+#define ZONE_TASK_MIN_INTERVAL 5
+
+// Zone tasks run by the zone scheduler, each returns the ms until it should run again, ZONE_TASK_SLEEP or -1 when done
+sint32 ZoneLoop(ZoneServer* zs);
+sint32 SpawnLoop(ZoneServer* zs);
 void SendInitialSpawns(shared_ptr<Client> client);
 
 using namespace std;
@@ -220,6 +239,7 @@ struct FlightPathLocation {
 };
 
 class SPGrid;
+struct ZoneTask;
 
 // need to attempt to clean this up and add xml comments, remove unused code, find a logical way to sort the functions maybe by get/set/process/add etc...
 class ZoneServer {
@@ -228,9 +248,15 @@ public:
   ~ZoneServer();
 
   void Init();
+  // Loads the zone's data, runs on a zone loader thread after Init()
+  void Boot();
+  bool IsBooting() { return booting; }
+  // Loads or reloads the spawn data while LoadingData is set, started by Process()
+  void LoadData();
   bool Process();
   bool SpawnProcess();
-  bool UpdateProcess();
+  // The delay ZoneLoop waits before the next Process()
+  sint32 GetProcessDelay();
 
   void LoadRevivePoints(vector<RevivePoint*>* revive_points);
   vector<RevivePoint*>* GetRevivePoints(const shared_ptr<Client>& client);
@@ -288,6 +314,7 @@ public:
   void SendZoneSpawns(const shared_ptr<Client>& client);
   void StartZoneInitialSpawnThread(shared_ptr<Client> client);
   void SendSpawnChanges(bool only_pos_changes = false, bool only_players = false);
+  int32 GetSpawnUpdateTick() { return spawn_update_tick; }
 
   void UpdateVitality(float amount);
 
@@ -337,6 +364,7 @@ public:
   volatile bool spawnthread_active;
   volatile bool combatthread_active;
   volatile int8 initial_spawn_threads_active;
+  volatile bool data_loader_active;
   volatile bool client_thread_active;
 
   void AddDamagedSpawn(Spawn* spawn);
@@ -503,7 +531,7 @@ public:
   void SetZoneMOTD(string z_motd) { zone_motd = z_motd; }
   string GetZoneMOTD() { return zone_motd; }
   bool isZoneShuttingDown() { return zoneShuttingDown; }
-  void Shutdown() { zoneShuttingDown = true; }
+  void Shutdown();
   int32 GetClientCount() { return clients.size(); }
   int32 GetDefaultLockoutTime() { return def_lockout_time; }
   int32 GetDefaultReenterTime() { return def_reenter_time; }
@@ -614,7 +642,8 @@ private:
   void CheckSendSpawnToClient();                                                                                                                                                                                                                                       // never used outside zone server
   void CheckSendSpawnToClient(const shared_ptr<Client>& client, bool initial_login = false);                                                                                                                                                                           // never used outside zone server
   void CheckRemoveSpawnFromClient(Spawn* spawn);                                                                                                                                                                                                                       // never used outside zone server
-  void SaveClient(const shared_ptr<Client>& client);                                                                                                                                                                                                                   // never used outside zone server
+  void CheckRemoveSpawnFromClient(const shared_ptr<Client>& client);                                                                                                                                                                                                   // never used outside zone server
+  void CheckRemoveSpawnFromClient(const shared_ptr<Client>& client, Spawn* spawn, PacketStruct* packet);                                                                                                                                                               // never used outside zone server
   void ProcessFaction(Spawn* spawn, const shared_ptr<Client>& client);                                                                                                                                                                                                 // never used outside zone server
   void RegenUpdate();                                                                                                                                                                                                                                                  // never used outside zone server
   void SendCalculatedXP(Player* player, Spawn* victim);                                                                                                                                                                                                                // never used outside zone server, might not be used at all any more
@@ -625,6 +654,7 @@ private:
   void AddSpawnExpireTimer(Spawn* spawn, int32 expire_time, int32 expire_offset = 0);                                                                                                                                                                                  // never used outside zone server
   void CheckSpawnRange(shared_ptr<Client> client, Spawn* spawn, bool initial_login = false);                                                                                                                                                                           // never used outside zone server
   void CheckSpawnRange(Spawn* spawn);                                                                                                                                                                                                                                  // never used outside zone server
+  void CheckSpawnRange(const shared_ptr<Client>& client);                                                                                                                                                                                                              // never used outside zone server
   void DeleteSpawnScriptTimers(Spawn* spawn, bool all = false);                                                                                                                                                                                                        // never used outside zone server
   void DeleteSpawnScriptTimers();                                                                                                                                                                                                                                      // never used outside zone server
   void CheckSpawnScriptTimers();                                                                                                                                                                                                                                       // never used outside zone server
@@ -634,7 +664,8 @@ private:
   void PrepareSpawnID(Player* player, Spawn* spawn);                                                                                                                                                                                                                   // never used outside zone server
   void RemoveMovementNPC(Spawn* spawn);                                                                                                                                                                                                                                // never used outside zone server
   bool CheckNPCAttacks(NPC* npc, Spawn* victim, shared_ptr<Client> client = 0);                                                                                                                                                                                        // never used outside zone server
-  bool CheckEnemyList(NPC* npc);                                                                                                                                                                                                                                       // never used outside zone server
+  void FindEnemies(AggroCandidates* candidates);                                                                                                                                                                                                                       // never used outside zone server
+  bool AttackEnemies(const AggroCandidates& candidates);                                                                                                                                                                                                               // never used outside zone server
   void RemovePlayerProximity(Spawn* spawn, bool all = false);                                                                                                                                                                                                          // never used outside zone server
   void RemovePlayerProximity(shared_ptr<Client> client);                                                                                                                                                                                                               // never used outside zone server
   void CheckPlayerProximity(Spawn* spawn, shared_ptr<Client> client);                                                                                                                                                                                                  // never used outside zone server
@@ -651,7 +682,7 @@ private:
   void ProcessTracking();                                                                                                                                                                                                                                              // never used outside zone server
   void ProcessTracking(const shared_ptr<Client>& client);                                                                                                                                                                                                              // never used outside zone server
   void SendEpicMobDeathToGuild(Player* killer, Spawn* victim);                                                                                                                                                                                                         // never used outside zone server
-  void ProcessAggroChecks(Spawn* spawn);                                                                                                                                                                                                                               // never used outside zone server
+  void ProcessAggroChecks(const vector<Spawn*>& spawns, vector<AggroCandidates>* candidates);                                                                                                                                                                          // never used outside zone server
   /// <summary>Checks to see if it is time to remove a spawn and removes it</summary>
   /// <param name='force_delete_all'>Forces all spawns scheduled to be removed regardless of time</param>
   void DelayedSpawnRemoval(bool force_delete_all); // never used outside zone server
@@ -674,6 +705,28 @@ private:
 
   shared_timed_mutex clients_mutex;
 
+  map<int32, future<void>> pending_saves; // int32 = character id
+  mutex pending_saves_mutex;
+
+  shared_ptr<ZoneTask> zone_task;
+  shared_ptr<ZoneTask> spawn_task;
+  shared_ptr<ZoneTask> movement_task;
+  shared_ptr<ZoneTask> aggro_task;
+  shared_ptr<ZoneTask> regen_task;
+  shared_ptr<ZoneTask> range_task;
+  shared_ptr<ZoneTask> visibility_task;
+  shared_ptr<ZoneTask> update_task;
+  shared_ptr<ZoneTask> respawn_task;
+  shared_ptr<ZoneTask> weather_task;
+  // Adds a subsystem that runs every interval ms while clients are in the zone, zone_lock holds MMasterZoneLock for it
+  shared_ptr<ZoneTask> AddZoneTask(const char* name, int32 interval, bool zone_lock, function<void()> work);
+  sint32 RunZoneTask(int32 interval, bool zone_lock, const function<void()>& work);
+  void MovementProcess();
+  void AggroProcess();
+  void SpawnUpdateProcess();
+  void CheckSpawnRanges(bool spawnRange, bool checkRemove);
+  void WakeTasks();
+
   list<LocationTransportDestination*> transporter_locations;
   set<SpawnScriptTimer*> spawn_script_timers;
   set<SpawnScriptTimer*> remove_spawn_script_timers_list;
@@ -765,24 +818,15 @@ private:
   TradeskillMgr* tradeskillMgr;
 
   /* Timers */
-  Timer aggro_timer;
   Timer charsheet_changes;
   Timer location_prox_timer;
   Timer location_grid_timer;
-  Timer movement_timer;
-  Timer regenTimer;
-  Timer respawn_timer;
   Timer shutdownTimer;
-  Timer spawn_check_add;
-  Timer spawn_check_remove;
   Timer spawn_expire_timer;
-  Timer spawn_range;
-  Timer spawn_update;
   Timer spawn_pos_update;
   Timer player_pos_update;
   Timer sync_game_time_timer;
   Timer tracking_timer;
-  Timer weatherTimer;
   Timer widget_timer;
 
   /* Enums */
@@ -849,52 +893,41 @@ private:
   bool weather_signaled;           // whether or not we told the client "it begins to rain"
 
   bool reloading;
-  map<int32, vector<EntityCommand*>*> entity_command_list;
-  map<int32, map<int32, int8>> npc_spell_list;
-  map<int32, map<int32, int16>> npc_skill_list;
-  map<int32, vector<int32>> npc_equipment_list;
-  map<int32, NPC*> npc_list;
-  map<int32, Object*> object_list;
-  map<int32, Sign*> sign_list;
-  map<int32, Widget*> widget_list;
-  map<int32, vector<GroundSpawnEntry*>> groundspawn_entries;
-  map<int32, vector<GroundSpawnEntryItem*>> groundspawn_items;
-  Mutex MGroundSpawnItems;
-  map<int32, GroundSpawn*> groundspawn_list;
-  map<int32, LootTable*> loot_tables;
-  map<int32, vector<LootDrop*>> loot_drops;
-  map<int32, vector<int32>> spawn_loot_list;
-  map<int8, vector<int32>> level_loot_list;
-  map<int16, vector<int32>> racial_loot_list;
-  map<int32, vector<ZoneLoot*>> zone_loot_list;
-  map<int32, vector<TransportDestination*>> transporters;
-  map<int32, MutexList<LocationTransportDestination*>*> location_transporters;
-  Mutex MTransporters;
-  Mutex MTransportMaps;
-  // Map <transport if, map name>
-  map<int32, string> m_transportMaps;
+  atomic<int32> spawn_update_tick; // bumped every SendSpawnChanges(), spawns rebuild their shared serialized data once per tick
+  // Spawn, loot and transport data shared with the other instances of this zone
+  shared_ptr<ZoneTemplate> zone_template;
+  bool force_template_reload;
+  bool publish_template;
+  bool spawn_locations_from_template;
+
+  atomic<bool> booting;
+  bool spawn_data_loaded;
+
+  void LoadZoneTemplate();
+  void LoadSpawnData();
+  void StoreTemplateSpawnLocations();
+  void LoadTemplateSpawnLocations();
 
 public:
   Spawn* GetSpawn(int32 id);
 
   /* Entity Commands */
-  map<int32, vector<EntityCommand*>*>* GetEntityCommandListAll() { return &entity_command_list; }
+  map<int32, vector<EntityCommand*>*>* GetEntityCommandListAll() { return &zone_template->entity_command_list; }
   vector<EntityCommand*>* GetEntityCommandList(int32 id);
   void SetEntityCommandList(int32 id, EntityCommand* command);
-  void ClearEntityCommands();
   EntityCommand* GetEntityCommand(int32 id, string name);
 
   /* NPC's */
   void AddNPC(int32 id, NPC* npc);
   NPC* GetNPC(int32 id, bool override_loading = false) {
-    if ((!reloading || override_loading) && npc_list.count(id) > 0)
-      return npc_list[id];
+    if ((!reloading || override_loading) && zone_template->npc_list.count(id) > 0)
+      return zone_template->npc_list[id];
     else
       return 0;
   }
   NPC* GetNewNPC(int32 id) {
-    if (!reloading && npc_list.count(id) > 0)
-      return new NPC(npc_list[id]);
+    if (!reloading && zone_template->npc_list.count(id) > 0)
+      return new NPC(zone_template->npc_list[id]);
     else
       return 0;
   }
@@ -912,31 +945,31 @@ public:
   void SetNPCEquipment(NPC* npc);
 
   /* Objects */
-  void AddObject(int32 id, Object* object) { object_list[id] = object; }
+  void AddObject(int32 id, Object* object) { zone_template->object_list[id] = object; }
   Object* GetObject(int32 id, bool override_loading = false) {
-    if ((!reloading || override_loading) && object_list.count(id) > 0)
-      return object_list[id];
+    if ((!reloading || override_loading) && zone_template->object_list.count(id) > 0)
+      return zone_template->object_list[id];
     else
       return 0;
   }
   Object* GetNewObject(int32 id) {
-    if (!reloading && object_list.count(id) > 0)
-      return object_list[id]->Copy();
+    if (!reloading && zone_template->object_list.count(id) > 0)
+      return zone_template->object_list[id]->Copy();
     else
       return 0;
   }
 
   /* Signs */
-  void AddSign(int32 id, Sign* sign) { sign_list[id] = sign; }
+  void AddSign(int32 id, Sign* sign) { zone_template->sign_list[id] = sign; }
   Sign* GetSign(int32 id, bool override_loading = false) {
-    if ((!reloading || override_loading) && sign_list.count(id) > 0)
-      return sign_list[id];
+    if ((!reloading || override_loading) && zone_template->sign_list.count(id) > 0)
+      return zone_template->sign_list[id];
     else
       return 0;
   }
   Sign* GetNewSign(int32 id) {
-    if (!reloading && sign_list.count(id) > 0)
-      return sign_list[id]->Copy();
+    if (!reloading && zone_template->sign_list.count(id) > 0)
+      return zone_template->sign_list[id]->Copy();
     else
       return 0;
   }
@@ -952,17 +985,14 @@ public:
   void AddGroundSpawnItem(int32 groundspawn_id, int32 item_id, int8 is_rare, int32 grid_id);
   vector<GroundSpawnEntry*>* GetGroundSpawnEntries(int32 id);
   vector<GroundSpawnEntryItem*>* GetGroundSpawnEntryItems(int32 id);
-  void LoadGroundSpawnEntries();
-  void LoadGroundSpawnItems();
-  //
-  void DeleteGroundSpawnItems();
 
   void AddGroundSpawn(int32 id, GroundSpawn* spawn);
   GroundSpawn* GetGroundSpawn(int32 id, bool override_loading = false);
   GroundSpawn* GetNewGroundSpawn(int32 id);
 
   /* Pet names */
-  vector<string> pet_names;
+  void AddPetName(string name) { zone_template->pet_names.push_back(name); }
+  vector<string>* GetPetNameList() { return &zone_template->pet_names; }
 
   /* Loot */
   void AddLootTable(int32 id, LootTable* table);
@@ -1000,8 +1030,6 @@ public:
   ///<summary>Clears the list of transporter maps</summary>
   void DeleteTransporterMaps();
 
-  void DeleteGlobalSpawns();
-
   void ReloadSpawns();
 
   void SendStateCommand(Spawn* spawn, int32 state);
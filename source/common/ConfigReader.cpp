@@ -19,37 +19,135 @@
 */
 #include "ConfigReader.h"
 #include "Log.h"
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Attributes kept for each element, the index is its bit in the cached attribute mask
+#define STRUCT_DEF_NAME 0
+#define STRUCT_DEF_CLIENT_VERSION 1
+#define STRUCT_DEF_OPCODE_NAME 2
+#define STRUCT_DEF_OPCODE_TYPE 3
+#define STRUCT_DEF_ELEMENT_NAME 4
+#define STRUCT_DEF_TYPE 5
+#define STRUCT_DEF_SIZE 6
+#define STRUCT_DEF_TYPE2 7
+#define STRUCT_DEF_ARRAY_SIZE_VARIABLE 8
+#define STRUCT_DEF_MAX_ARRAY_SIZE 9
+#define STRUCT_DEF_SUBSTRUCT 10
+#define STRUCT_DEF_DEFAULT_BYTE_VALUE 11
+#define STRUCT_DEF_OVERSIZED_VALUE 12
+#define STRUCT_DEF_OVERSIZED_BYTE 13
+#define STRUCT_DEF_IF_VARIABLE_SET 14
+#define STRUCT_DEF_IF_VARIABLE_NOT_SET 15
+#define STRUCT_DEF_IF_VARIABLE_EQUALS 16
+#define STRUCT_DEF_IF_VARIABLE_NOT_EQUALS 17
+
+static const char* struct_def_attributes[STRUCT_DEF_ATTRIBUTES] = {
+  "Name", "ClientVersion", "OpcodeName", "OpcodeType", "ElementName", "Type", "Size", "Type2", "ArraySizeVariable",
+  "MaxArraySize", "Substruct", "DefaultByteValue", "OversizedValue", "OversizedByte", "IfVariableSet",
+  "IfVariableNotSet", "IfVariableEquals", "IfVariableNotEquals"
+};
+
+// Layout of a cache file: the header, then every node in order as its attribute mask, child
+// count and one string offset per attribute, then the strings
+struct StructCacheHeader {
+  int32 magic;
+  int32 version;
+  int64 hash;
+  int32 node_count;
+  int32 node_size;
+  int32 string_size;
+};
+
+// Free copies of each template for the current thread. Keyed by template so a
+// reload simply stops handing out the old copies, templates are never freed before
+// shutdown so the keys stay unique.
+struct PacketStructPool {
+  map<PacketStruct*, vector<PacketStruct*>> free_lists;
+
+  ~PacketStructPool() {
+    for (auto& free_list : free_lists) {
+      for (auto packet : free_list.second)
+        safe_delete(packet);
+    }
+  }
+};
+static thread_local PacketStructPool packet_pool;
+
+ConfigReader::ConfigReader() {
+  struct_table = 0;
+}
 
 ConfigReader::~ConfigReader() {
   MStructs.lock();
   DestroyStructs();
+
+  for (auto& old_structs : retired_structs) {
+    structs.swap(old_structs);
+    DestroyStructs();
+  }
+  retired_structs.clear();
+
+  StructTable* table = struct_table.exchange(0);
+  safe_delete(table);
+  for (auto old_table : retired_tables)
+    safe_delete(old_table);
+  retired_tables.clear();
   MStructs.unlock();
 }
+const ConfigReader::StructTable* ConfigReader::GetStructTable() {
+  return struct_table.load(memory_order_acquire);
+}
 PacketStruct* ConfigReader::getStructByVersion(const char* name, int16 version) {
   PacketStruct* packet = 0;
   PacketStruct* newpacket = 0;
-  MStructs.lock();
-  vector<PacketStruct*>* struct_versions = structs[string(name)];
-  if (struct_versions) {
-    vector<PacketStruct*>::iterator iter;
-    for (iter = struct_versions->begin(); iter != struct_versions->end(); iter++) {
-      packet = *iter;
-      if (packet && packet->GetVersion() == version) {
-        newpacket = new PacketStruct(packet, version);
-        break;
+  const StructTable* table = GetStructTable();
+  if (table) {
+    auto itr = table->ids.find(name);
+    if (itr != table->ids.end()) {
+      vector<PacketStruct*>* struct_versions = table->versions[itr->second];
+      if (struct_versions) {
+        vector<PacketStruct*>::iterator iter;
+        for (iter = struct_versions->begin(); iter != struct_versions->end(); iter++) {
+          packet = *iter;
+          if (packet && packet->GetVersion() == version) {
+            newpacket = new PacketStruct(packet, version);
+            break;
+          }
+        }
       }
     }
   }
-  MStructs.unlock();
   if (!newpacket)
     LogWrite(PACKET__ERROR, 0, "Packet", "Could not find struct named '%s' with version: %i", name, version);
   return newpacket;
 }
 void ConfigReader::ReloadStructs() {
   MStructs.lock();
-  DestroyStructs();
-  for (int32 i = 0; i < load_files.size(); i++)
-    processXML_Elements(load_files[i].c_str());
+  vector<string> files = load_files;
+  MStructs.unlock();
+
+  // the files are read (and parsed if they changed) before taking the lock,
+  // the new templates are then swapped in as a whole by BuildStructTable()
+  vector<unique_ptr<StructDefFile>> file_defs;
+  for (auto& file : files) {
+    unique_ptr<StructDefFile> defs(new StructDefFile());
+    if (LoadStructDefs(file.c_str(), *defs))
+      file_defs.push_back(move(defs));
+  }
+
+  MStructs.lock();
+  // other threads may still be copying the current templates without a lock,
+  // so they are kept alive until shutdown instead of being destroyed here
+  retired_structs.push_back(map<string, vector<PacketStruct*>*>());
+  retired_structs.back().swap(structs);
+  for (auto& defs : file_defs)
+    AddStructs(*defs);
+  BuildStructTable();
   MStructs.unlock();
 }
 void ConfigReader::DestroyStructs() {
@@ -66,66 +164,426 @@ void ConfigReader::DestroyStructs() {
   }
   structs.clear();
 }
-PacketStruct* ConfigReader::getStruct(const char* name, int16 version) {
+PacketStruct* ConfigReader::FindLatestVersion(vector<PacketStruct*>* struct_versions, int16 version) {
   PacketStruct* latest_version = 0;
-  PacketStruct* new_latest_version = 0;
-  MStructs.lock();
-  vector<PacketStruct*>* struct_versions = structs[string(name)];
   if (struct_versions) {
     vector<PacketStruct*>::iterator iter;
     for (iter = struct_versions->begin(); iter != struct_versions->end(); iter++) {
       if (!latest_version || ((*iter)->GetVersion() > latest_version->GetVersion() && (*iter)->GetVersion() <= version))
         latest_version = *iter;
     }
-    if (latest_version)
-      new_latest_version = new PacketStruct(latest_version, version);
   }
-  MStructs.unlock();
-  if (!new_latest_version)
+  return latest_version;
+}
+PacketStruct* ConfigReader::FindStruct(const char* name, int16 version) {
+  map<string, vector<PacketStruct*>*>::iterator itr = structs.find(name);
+  if (itr == structs.end())
+    return 0;
+  return FindLatestVersion(itr->second, version);
+}
+void ConfigReader::BuildStructTable() {
+  StructTable* table = new StructTable();
+
+  map<int16, int32> distinct_versions;
+  map<string, vector<PacketStruct*>*>::iterator itr;
+  for (itr = structs.begin(); itr != structs.end(); itr++) {
+    if (itr->second) {
+      for (auto packet : *itr->second) {
+        distinct_versions[packet->GetVersion()] = 0;
+        packet->BuildFieldTable();
+      }
+    }
+  }
+
+  // bucket 0 holds the versions below the oldest struct
+  table->num_buckets = distinct_versions.size() + 1;
+  table->version_buckets.resize(65536);
+  vector<int16> bucket_versions;
+  bucket_versions.push_back(0);
+  for (auto& version : distinct_versions) {
+    version.second = bucket_versions.size();
+    bucket_versions.push_back(version.first);
+  }
+  int32 bucket = 0;
+  for (int32 version = 0; version < 65536; version++) {
+    auto next = distinct_versions.find(version);
+    if (next != distinct_versions.end())
+      bucket = next->second;
+    table->version_buckets[version] = bucket;
+  }
+
+  for (itr = structs.begin(); itr != structs.end(); itr++) {
+    if (struct_ids.count(itr->first) == 0) {
+      struct_ids[itr->first] = struct_names.size();
+      struct_names.push_back(itr->first);
+    }
+  }
+
+  table->versions.resize(struct_names.size(), 0);
+  table->templates.resize(struct_names.size() * table->num_buckets, 0);
+  for (itr = structs.begin(); itr != structs.end(); itr++) {
+    int32 id = struct_ids[itr->first];
+    table->ids[struct_names[id].c_str()] = id;
+    table->versions[id] = itr->second;
+
+    for (int32 i = 0; i < table->num_buckets; i++) {
+      // the oldest struct is returned for versions below every struct, as before
+      int16 version = i == 0 ? 0 : bucket_versions[i];
+      table->templates[id * table->num_buckets + i] = FindLatestVersion(itr->second, version);
+    }
+  }
+
+  StructTable* old_table = struct_table.exchange(table, memory_order_acq_rel);
+  if (old_table)
+    retired_tables.push_back(old_table);
+}
+int32 ConfigReader::GetStructID(const char* name) {
+  const StructTable* table = GetStructTable();
+  if (table) {
+    auto itr = table->ids.find(name);
+    if (itr != table->ids.end())
+      return itr->second;
+  }
+  LogWrite(PACKET__ERROR, 0, "Packet", "Could not find struct named '%s'", name);
+  return INVALID_STRUCT_ID;
+}
+PacketStruct* ConfigReader::getStructByID(int32 struct_id, int16 version) {
+  const StructTable* table = GetStructTable();
+  PacketStruct* latest_version = table ? table->Find(struct_id, version) : 0;
+  if (!latest_version) {
+    LogWrite(PACKET__ERROR, 0, "Packet", "Could not find struct with id %u", struct_id);
+    return 0;
+  }
+  return new PacketStruct(latest_version, version);
+}
+PacketStruct* ConfigReader::getStruct(const char* name, int16 version) {
+  PacketStruct* latest_version = 0;
+  const StructTable* table = GetStructTable();
+  if (table) {
+    auto itr = table->ids.find(name);
+    if (itr != table->ids.end())
+      latest_version = table->Find(itr->second, version);
+  }
+  if (!latest_version) {
+    LogWrite(PACKET__ERROR, 0, "Packet", "Could not find struct named '%s'", name);
+    return 0;
+  }
+  return new PacketStruct(latest_version, version);
+}
+PacketStruct* ConfigReader::AcquireStruct(const char* name, int16 version) {
+  PacketStruct* latest_version = 0;
+  const StructTable* table = GetStructTable();
+  if (table) {
+    auto itr = table->ids.find(name);
+    if (itr != table->ids.end())
+      latest_version = table->Find(itr->second, version);
+  }
+  if (!latest_version) {
     LogWrite(PACKET__ERROR, 0, "Packet", "Could not find struct named '%s'", name);
-  return new_latest_version;
+    return 0;
+  }
+  return AcquireStruct(latest_version, version);
+}
+PacketStruct* ConfigReader::AcquireStructByID(int32 struct_id, int16 version) {
+  const StructTable* table = GetStructTable();
+  PacketStruct* latest_version = table ? table->Find(struct_id, version) : 0;
+  if (!latest_version) {
+    LogWrite(PACKET__ERROR, 0, "Packet", "Could not find struct with id %u", struct_id);
+    return 0;
+  }
+  return AcquireStruct(latest_version, version);
+}
+PacketStruct* ConfigReader::AcquireStruct(PacketStruct* latest_version, int16 version) {
+  PacketStruct* packet = 0;
+  vector<PacketStruct*>& free_list = packet_pool.free_lists[latest_version];
+  if (free_list.size() > 0) {
+    packet = free_list.back();
+    free_list.pop_back();
+    packet->ResetData();
+    packet->RestoreDefaults();
+    packet->SetClientVersion(version);
+  } else
+    packet = new PacketStruct(latest_version, version);
+  packet->SetPoolTemplate(latest_version);
+  return packet;
+}
+void ConfigReader::ReleaseStruct(PacketStruct* packet) {
+  if (!packet)
+    return;
+  // copies whose arrays were resized no longer match the template, and anything
+  // that didn't come from AcquireStruct() is just deleted
+  PacketStruct* latest_version = packet->GetPoolTemplate();
+  if (latest_version && !packet->LayoutChanged()) {
+    vector<PacketStruct*>& free_list = packet_pool.free_lists[latest_version];
+    if (free_list.size() < PACKET_POOL_MAX_FREE) {
+      packet->TrackSerializedOffsets(false);
+      free_list.push_back(packet);
+      return;
+    }
+  }
+  safe_delete(packet);
 }
 int16 ConfigReader::GetStructVersion(const char* name, int16 version) {
-  MStructs.lock();
-  vector<PacketStruct*>* struct_versions = structs[string(name)];
-  int16 ret = 0;
-  if (struct_versions) {
-    vector<PacketStruct*>::iterator iter;
-    PacketStruct* latest_version = 0;
-    for (iter = struct_versions->begin(); iter != struct_versions->end(); iter++) {
-      if (!latest_version || ((*iter)->GetVersion() > latest_version->GetVersion() && (*iter)->GetVersion() <= version))
-        latest_version = *iter;
+  const StructTable* table = GetStructTable();
+  if (table) {
+    auto itr = table->ids.find(name);
+    if (itr != table->ids.end()) {
+      PacketStruct* latest_version = table->Find(itr->second, version);
+      if (latest_version)
+        return latest_version->GetVersion();
     }
-    if (latest_version)
-      ret = latest_version->GetVersion();
   }
-  MStructs.unlock();
-  return ret;
+  return 0;
 }
 void ConfigReader::addStruct(const char* name, int16 version, PacketStruct* new_struct) {
   string strname(name);
-  vector<PacketStruct*>* struct_versions = structs[strname];
-  if (struct_versions)
-    struct_versions->push_back(new_struct);
+  map<string, vector<PacketStruct*>*>::iterator itr = structs.find(strname);
+  if (itr != structs.end() && itr->second)
+    itr->second->push_back(new_struct);
   else {
-    struct_versions = new vector<PacketStruct*>;
+    vector<PacketStruct*>* struct_versions = new vector<PacketStruct*>;
     struct_versions->push_back(new_struct);
     structs[strname] = struct_versions;
   }
 }
 bool ConfigReader::LoadFile(const char* name) {
+  MStructs.lock();
   load_files.push_back(name);
-  return processXML_Elements(name);
+  bool ret = processXML_Elements(name);
+  BuildStructTable();
+  MStructs.unlock();
+  return ret;
 }
-bool ConfigReader::processXML_Elements(const char* fileName) {
+static int64 HashStructFile(const string& data) {
+  int64 hash = 14695981039346656037ull;
+  for (unsigned char ch : data)
+    hash = (hash ^ ch) * 1099511628211ull;
+  return hash;
+}
+
+static bool ReadStructFile(const char* fileName, string& data) {
+  FILE* f = fopen(fileName, "rb");
+  if (!f)
+    return false;
+
+  char buf[65536];
+  size_t len;
+  while ((len = fread(buf, 1, sizeof(buf), f)) > 0)
+    data.append(buf, len);
+
+  bool ret = ferror(f) == 0;
+  fclose(f);
+  return ret;
+}
+
+static bool WriteStructCache(const char* cache_name, const vector<char>& data) {
+  // written to a temp file first so a running server never maps a half written cache
+  string tmp_name = string(cache_name).append(".tmp");
+  FILE* f = fopen(tmp_name.c_str(), "wb");
+  if (!f)
+    return false;
+
+  bool ret = fwrite(data.data(), 1, data.size(), f) == data.size();
+  ret = fclose(f) == 0 && ret;
+#ifdef WIN32
+  if (ret)
+    remove(cache_name);
+#endif
+  if (ret)
+    ret = rename(tmp_name.c_str(), cache_name) == 0;
+  if (!ret)
+    remove(tmp_name.c_str());
+  return ret;
+}
+
+static void AppendCacheInt(vector<char>& data, int32 value) {
+  data.insert(data.end(), (char*)&value, (char*)&value + sizeof(value));
+}
+
+static void EncodeStructDef(XMLNode node, const char* child_tag, int child_count, vector<char>& nodes, int32& node_count, map<string, int32>& string_offsets, string& strings) {
+  int32 mask = 0;
+  vector<int32> offsets;
+
+  for (int32 i = 0; i < STRUCT_DEF_ATTRIBUTES; i++) {
+    const char* value = node.getAttribute(struct_def_attributes[i]);
+    if (!value)
+      continue;
+
+    auto itr = string_offsets.find(value);
+    if (itr == string_offsets.end()) {
+      itr = string_offsets.insert(make_pair(string(value), (int32)strings.size())).first;
+      strings.append(value).push_back('\0');
+    }
+
+    mask |= 1 << i;
+    offsets.push_back(itr->second);
+  }
+
+  AppendCacheInt(nodes, mask);
+  AppendCacheInt(nodes, child_count);
+  for (auto offset : offsets)
+    AppendCacheInt(nodes, offset);
+  node_count++;
+
+  // same walk as the struct loader did over the xml, every child is read as a Data element
+  for (int i = 0; i < child_count; i++) {
+    XMLNode child = node.getChildNode(child_tag, i);
+    EncodeStructDef(child, "Data", child.nChildNode(), nodes, node_count, string_offsets, strings);
+  }
+}
+
+void ConfigReader::StructDefFile::Clear() {
+  nodes.clear();
+  buffer.clear();
+#ifndef WIN32
+  if (mapping)
+    munmap(mapping, mapping_size);
+#endif
+  mapping = 0;
+  mapping_size = 0;
+}
+
+bool ConfigReader::ReadStructDefs(const char* data, size_t size, int64 hash, StructDefFile& defs) {
+  StructCacheHeader header;
+  if (size < sizeof(header))
+    return false;
+
+  memcpy(&header, data, sizeof(header));
+  if (header.magic != STRUCT_CACHE_MAGIC || header.version != STRUCT_CACHE_VERSION || header.hash != hash)
+    return false;
+  if (header.node_count == 0 || header.string_size == 0 || (size_t)header.node_size + header.string_size != size - sizeof(header))
+    return false;
+
+  const char* node_data = data + sizeof(header);
+  const char* strings = node_data + header.node_size;
+  if (strings[header.string_size - 1] != 0)
+    return false;
+
+  defs.nodes.resize(header.node_count);
+  size_t pos = 0;
+  for (auto& node : defs.nodes) {
+    int32 mask;
+    if (pos + sizeof(mask) + sizeof(node.child_count) > header.node_size)
+      return false;
+    memcpy(&mask, node_data + pos, sizeof(mask));
+    memcpy(&node.child_count, node_data + pos + sizeof(mask), sizeof(node.child_count));
+    pos += sizeof(mask) + sizeof(node.child_count);
+
+    for (int32 i = 0; i < STRUCT_DEF_ATTRIBUTES; i++) {
+      node.attributes[i] = 0;
+      if ((mask & (1 << i)) == 0)
+        continue;
+
+      int32 offset;
+      if (pos + sizeof(offset) > header.node_size)
+        return false;
+      memcpy(&offset, node_data + pos, sizeof(offset));
+      pos += sizeof(offset);
+      if (offset >= header.string_size)
+        return false;
+      node.attributes[i] = strings + offset;
+    }
+  }
+
+  // children come after their parent, so walking backwards every child's end is already known
+  for (int32 i = header.node_count; i-- > 0;) {
+    int32 end = i + 1;
+    for (int32 x = 0; x < defs.nodes[i].child_count; x++) {
+      if (end >= header.node_count)
+        return false;
+      end = defs.nodes[end].end;
+    }
+    defs.nodes[i].end = end;
+  }
+
+  return defs.nodes[0].end == header.node_count;
+}
+
+bool ConfigReader::MapStructCache(const char* cache_name, int64 hash, StructDefFile& defs) {
+  bool ret = false;
+#ifndef WIN32
+  int fd = open(cache_name, O_RDONLY);
+  if (fd < 0)
+    return false;
+
+  struct stat st;
+  if (fstat(fd, &st) == 0 && st.st_size >= (off_t)sizeof(StructCacheHeader)) {
+    void* mapping = mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping != MAP_FAILED) {
+      defs.mapping = mapping;
+      defs.mapping_size = st.st_size;
+      ret = ReadStructDefs((const char*)mapping, st.st_size, hash, defs);
+    }
+  }
+  close(fd);
+#else
+  string data;
+  if (ReadStructFile(cache_name, data)) {
+    defs.buffer.assign(data.begin(), data.end());
+    ret = ReadStructDefs(defs.buffer.data(), defs.buffer.size(), hash, defs);
+  }
+#endif
+  if (!ret)
+    defs.Clear();
+  return ret;
+}
+
+bool ConfigReader::LoadStructDefs(const char* fileName, StructDefFile& defs) {
+  string cache_name = string(fileName).append(".cache");
+  string xml;
+  bool hashed = ReadStructFile(fileName, xml);
+  int64 hash = hashed ? HashStructFile(xml) : 0;
+
+  if (hashed && MapStructCache(cache_name.c_str(), hash, defs)) {
+    LogWrite(PACKET__DEBUG, 0, "Packet", "Loaded '%s' from '%s'", fileName, cache_name.c_str());
+    return true;
+  }
+
   XMLNode xMainNode = XMLNode::openFileHelper(fileName, "EQ2Emulator");
   if (xMainNode.isEmpty())
     return false;
-  for (int i = 0; i < xMainNode.nChildNode("Struct"); i++) {
-    const char* struct_name = xMainNode.getChildNode("Struct", i).getAttribute("Name");
-    const char* str_version = xMainNode.getChildNode("Struct", i).getAttribute("ClientVersion");
-    const char* opcode_name = xMainNode.getChildNode("Struct", i).getAttribute("OpcodeName");
-    const char* opcode_type = xMainNode.getChildNode("Struct", i).getAttribute("OpcodeType");
+
+  vector<char> nodes;
+  map<string, int32> string_offsets;
+  string strings(1, '\0');
+  StructCacheHeader header;
+  header.node_count = 0;
+  EncodeStructDef(xMainNode, "Struct", xMainNode.nChildNode("Struct"), nodes, header.node_count, string_offsets, strings);
+
+  header.magic = STRUCT_CACHE_MAGIC;
+  header.version = STRUCT_CACHE_VERSION;
+  header.hash = hash;
+  header.node_size = nodes.size();
+  header.string_size = strings.size();
+
+  defs.buffer.reserve(sizeof(header) + nodes.size() + strings.size());
+  defs.buffer.insert(defs.buffer.end(), (char*)&header, (char*)&header + sizeof(header));
+  defs.buffer.insert(defs.buffer.end(), nodes.begin(), nodes.end());
+  defs.buffer.insert(defs.buffer.end(), strings.begin(), strings.end());
+  if (!ReadStructDefs(defs.buffer.data(), defs.buffer.size(), hash, defs))
+    return false;
+
+  if (hashed && !WriteStructCache(cache_name.c_str(), defs.buffer))
+    LogWrite(PACKET__WARNING, 0, "Packet", "Could not write the struct cache '%s'", cache_name.c_str());
+  return true;
+}
+
+bool ConfigReader::processXML_Elements(const char* fileName) {
+  StructDefFile defs;
+  if (!LoadStructDefs(fileName, defs))
+    return false;
+  AddStructs(defs);
+  return true;
+}
+
+void ConfigReader::AddStructs(const StructDefFile& defs) {
+  int32 index = 1;
+  for (int32 i = 0; i < defs.nodes[0].child_count; i++, index = defs.nodes[index].end) {
+    const char* const* attributes = defs.nodes[index].attributes;
+    const char* struct_name = attributes[STRUCT_DEF_NAME];
+    const char* str_version = attributes[STRUCT_DEF_CLIENT_VERSION];
+    const char* opcode_name = attributes[STRUCT_DEF_OPCODE_NAME];
+    const char* opcode_type = attributes[STRUCT_DEF_OPCODE_TYPE];
     if (!struct_name || !str_version) {
       LogWrite(MISC__WARNING, 0, "Misc", "Ignoring invalid struct, all structs must include at least a Name and ClientVersion!");
       continue;
@@ -148,27 +606,29 @@ bool ConfigReader::processXML_Elements(const char* fileName) {
       }
     }
     new_struct->SetVersion(version);
-    loadDataStruct(new_struct, xMainNode.getChildNode("Struct", i));
+    loadDataStruct(new_struct, defs, index);
     addStruct(struct_name, version, new_struct);
   }
-  return true;
 }
-void ConfigReader::loadDataStruct(PacketStruct* packet, XMLNode parentNode, bool array_packet) {
-  for (int x = 0; x < parentNode.nChildNode(); x++) {
-    const char* name = parentNode.getChildNode("Data", x).getAttribute("ElementName");
-    const char* type = parentNode.getChildNode("Data", x).getAttribute("Type");
-    const char* size = parentNode.getChildNode("Data", x).getAttribute("Size");
-    const char* type2 = parentNode.getChildNode("Data", x).getAttribute("Type2");
-    const char* array_size = parentNode.getChildNode("Data", x).getAttribute("ArraySizeVariable");
-    const char* max_array = parentNode.getChildNode("Data", x).getAttribute("MaxArraySize");
-    const char* substruct = parentNode.getChildNode("Data", x).getAttribute("Substruct");
-    const char* default_value = parentNode.getChildNode("Data", x).getAttribute("DefaultByteValue");
-    const char* oversized = parentNode.getChildNode("Data", x).getAttribute("OversizedValue");
-    const char* oversized_byte = parentNode.getChildNode("Data", x).getAttribute("OversizedByte");
-    const char* if_variable = parentNode.getChildNode("Data", x).getAttribute("IfVariableSet");
-    const char* if_not_variable = parentNode.getChildNode("Data", x).getAttribute("IfVariableNotSet");
-    const char* if_equals_variable = parentNode.getChildNode("Data", x).getAttribute("IfVariableEquals");
-    const char* if_not_equals_variable = parentNode.getChildNode("Data", x).getAttribute("IfVariableNotEquals");
+void ConfigReader::loadDataStruct(PacketStruct* packet, const StructDefFile& defs, int32 parent, bool array_packet) {
+  const StructDef& parent_node = defs.nodes[parent];
+  int32 child = parent + 1;
+  for (int32 x = 0; x < parent_node.child_count; x++, child = defs.nodes[child].end) {
+    const char* const* attributes = defs.nodes[child].attributes;
+    const char* name = attributes[STRUCT_DEF_ELEMENT_NAME];
+    const char* type = attributes[STRUCT_DEF_TYPE];
+    const char* size = attributes[STRUCT_DEF_SIZE];
+    const char* type2 = attributes[STRUCT_DEF_TYPE2];
+    const char* array_size = attributes[STRUCT_DEF_ARRAY_SIZE_VARIABLE];
+    const char* max_array = attributes[STRUCT_DEF_MAX_ARRAY_SIZE];
+    const char* substruct = attributes[STRUCT_DEF_SUBSTRUCT];
+    const char* default_value = attributes[STRUCT_DEF_DEFAULT_BYTE_VALUE];
+    const char* oversized = attributes[STRUCT_DEF_OVERSIZED_VALUE];
+    const char* oversized_byte = attributes[STRUCT_DEF_OVERSIZED_BYTE];
+    const char* if_variable = attributes[STRUCT_DEF_IF_VARIABLE_SET];
+    const char* if_not_variable = attributes[STRUCT_DEF_IF_VARIABLE_NOT_SET];
+    const char* if_equals_variable = attributes[STRUCT_DEF_IF_VARIABLE_EQUALS];
+    const char* if_not_equals_variable = attributes[STRUCT_DEF_IF_VARIABLE_NOT_EQUALS];
 
     //const char* type2criteria = parentNode.getChildNode("Data", x).getAttribute("Type2Criteria");	// JA: LE added to PacketAnalyzer for Items parsing - 12.2012
     //const char* criteria = parentNode.getChildNode("Data", x).getAttribute("Criteria");				// JA: LE added to PacketAnalyzer for Items parsing - 12.2012
@@ -193,7 +653,12 @@ void ConfigReader::loadDataStruct(PacketStruct* packet, XMLNode parentNode, bool
     } catch (...) {
     }
     if (substruct && name) {
-      PacketStruct* substruct_packet = getStruct(substruct, packet->GetVersion());
+      // the lookup table is only rebuilt once the whole file is loaded
+      PacketStruct* substruct_packet = FindStruct(substruct, packet->GetVersion());
+      if (substruct_packet)
+        substruct_packet = new PacketStruct(substruct_packet, (int16)packet->GetVersion());
+      else
+        LogWrite(PACKET__ERROR, 0, "Packet", "Could not find struct named '%s'", substruct);
       if (substruct_packet) {
         vector<DataStruct*>::iterator itr;
         vector<DataStruct*>* structs = substruct_packet->getStructs();
@@ -240,12 +705,12 @@ void ConfigReader::loadDataStruct(PacketStruct* packet, XMLNode parentNode, bool
       new_packet->SetName(name);
       new_packet->IsSubPacket(true);
       new_packet->SetVersion(packet->GetVersion());
-      loadDataStruct(new_packet, parentNode.getChildNode("Data", x), true);
+      loadDataStruct(new_packet, defs, child, true);
       packet->add(new_packet);
     }
     if (!name || !type) {
       LogWrite(MISC__WARNING, 0, "Misc", "Ignoring invalid Data Element, all elements must include at least an ElementName and Type!");
-      LogWrite(MISC__WARNING, 0, "Misc", "\tStruct: '%s', version: %i", parentNode.getAttribute("Name"), parentNode.getAttribute("ClientVersion"));
+      LogWrite(MISC__WARNING, 0, "Misc", "\tStruct: '%s', version: %s", parent_node.attributes[STRUCT_DEF_NAME], parent_node.attributes[STRUCT_DEF_CLIENT_VERSION]);
       continue;
     }
     DataStruct* ds = new DataStruct(name, type, num_size, type2);
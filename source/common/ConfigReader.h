@@ -21,22 +21,44 @@
 #define __CONFIG_READER__
 #include <stdio.h>
 #include "PacketStruct.h"
+#include <atomic>
+#include <deque>
 #include <map>
+#include <memory>
 #include <string>
+#include <string.h>
+#include <unordered_map>
 #include <vector>
 #include "xmlParser.h"
 #include "Mutex.h"
 
 using namespace std;
 
+#define INVALID_STRUCT_ID 0xFFFFFFFF
+// Each xml file is cached in binary next to it as <file>.cache, the cache is
+// rebuilt when the hash of the xml or STRUCT_CACHE_VERSION changes
+#define STRUCT_CACHE_MAGIC 0x53325145
+#define STRUCT_CACHE_VERSION 1
+#define STRUCT_DEF_ATTRIBUTES 18
+// free copies kept per template on each thread
+#define PACKET_POOL_MAX_FREE 16
+
 class ConfigReader {
 public:
+  ConfigReader();
   ~ConfigReader();
 
   void addStruct(const char* name, int16 version, PacketStruct* new_struct);
   PacketStruct* getStruct(const char* name, int16 version);
+  // Struct ids stay the same across /reload structs, so they can be cached by callers.
+  int32 GetStructID(const char* name);
+  PacketStruct* getStructByID(int32 struct_id, int16 version);
   PacketStruct* getStructByVersion(const char* name, int16 version);
-  void loadDataStruct(PacketStruct* packet, XMLNode parentNode, bool array_packet = false);
+  // Same as getStruct() but the copy comes from a per thread pool with its data reset.
+  // Give it back with ReleaseStruct() instead of deleting it.
+  PacketStruct* AcquireStruct(const char* name, int16 version);
+  PacketStruct* AcquireStructByID(int32 struct_id, int16 version);
+  void ReleaseStruct(PacketStruct* packet);
   bool processXML_Elements(const char* fileName);
   int16 GetStructVersion(const char* name, int16 version);
   void DestroyStructs();
@@ -44,9 +66,79 @@ public:
   bool LoadFile(const char* name);
 
 private:
+  struct CStringHash {
+    size_t operator()(const char* str) const {
+      size_t hash = 2166136261u;
+      for (; *str; str++)
+        hash = (hash ^ (unsigned char)*str) * 16777619u;
+      return hash;
+    }
+  };
+
+  struct CStringEqual {
+    bool operator()(const char* a, const char* b) const { return strcmp(a, b) == 0; }
+  };
+
+  // Immutable lookup table built after the xml files are loaded. Client versions
+  // are mapped to a bucket (the number of distinct struct versions <= version),
+  // and every (struct id, bucket) pair is resolved to its template up front.
+  struct StructTable {
+    unordered_map<const char*, int32, CStringHash, CStringEqual> ids;
+    vector<int32> version_buckets;
+    vector<vector<PacketStruct*>*> versions;
+    vector<PacketStruct*> templates;
+    int32 num_buckets;
+
+    PacketStruct* Find(int32 struct_id, int16 version) const {
+      if (struct_id >= versions.size())
+        return 0;
+      return templates[struct_id * num_buckets + version_buckets[version]];
+    }
+  };
+
+  // A <Struct> or <Data> element. Its children follow it in the node list, node 0 is the file's root
+  struct StructDef {
+    const char* attributes[STRUCT_DEF_ATTRIBUTES];
+    int32 child_count;
+    // index of the first node after this one and its children
+    int32 end;
+  };
+
+  // The elements of one struct file. The strings point into the cache data,
+  // which is either mapped from the cache file or held in buffer
+  struct StructDefFile {
+    StructDefFile() : mapping(0), mapping_size(0) {}
+    ~StructDefFile() { Clear(); }
+    void Clear();
+
+    vector<StructDef> nodes;
+    vector<char> buffer;
+    void* mapping;
+    size_t mapping_size;
+  };
+
+  bool LoadStructDefs(const char* fileName, StructDefFile& defs);
+  bool MapStructCache(const char* cache_name, int64 hash, StructDefFile& defs);
+  bool ReadStructDefs(const char* data, size_t size, int64 hash, StructDefFile& defs);
+  void AddStructs(const StructDefFile& defs);
+  void loadDataStruct(PacketStruct* packet, const StructDefFile& defs, int32 parent, bool array_packet = false);
+  PacketStruct* FindStruct(const char* name, int16 version);
+  PacketStruct* FindLatestVersion(vector<PacketStruct*>* struct_versions, int16 version);
+  const StructTable* GetStructTable();
+  PacketStruct* AcquireStruct(PacketStruct* latest_version, int16 version);
+  void BuildStructTable();
+
   Mutex MStructs;
   vector<string> load_files;
   map<string, vector<PacketStruct*>*> structs;
   //vector<PacketStruct*> structs;
+
+  atomic<StructTable*> struct_table;
+  // struct names in id order; deque so the table keys never move
+  deque<string> struct_names;
+  map<string, int32> struct_ids;
+  // replaced by /reload structs but possibly still in use by another thread
+  vector<StructTable*> retired_tables;
+  vector<map<string, vector<PacketStruct*>*>> retired_structs;
 };
 #endif
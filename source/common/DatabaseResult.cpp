@@ -33,6 +33,7 @@ DatabaseResult::DatabaseResult() {
   field_names = NULL;
   num_fields = 0;
   row = 0;
+  lengths = NULL;
 }
 
 DatabaseResult::~DatabaseResult() {
@@ -65,6 +66,8 @@ bool DatabaseResult::StoreResult(MYSQL_RES* res) {
 
   //store the new result
   result = res;
+  row = 0;
+  lengths = NULL;
   num_fields = mysql_num_fields(res);
 
   //allocate enough space for each field's name
@@ -99,6 +102,10 @@ bool DatabaseResult::StoreResult(MYSQL_RES* res) {
 }
 
 const char* DatabaseResult::GetFieldValue(unsigned int index) {
+  //unknown columns were already logged when their index was looked up
+  if (index == DATABASE_RESULT_NO_FIELD)
+    return NULL;
+
   if (index >= num_fields) {
     LogWrite(DATABASE__ERROR, 0, "Database Result", "Attempt to access field at index %u but there %s only %u field%s", index, num_fields == 1 ? "is" : "are", num_fields, num_fields == 1 ? "" : "s");
     return NULL;
@@ -119,7 +126,31 @@ const char* DatabaseResult::GetFieldValueStr(const char* field_name) {
   return NULL;
 }
 
+unsigned int DatabaseResult::GetFieldIndex(const char* field_name) {
+  unsigned int i;
+
+  for (i = 0; i < num_fields; i++) {
+    if (strncmp(field_name, field_names[i], FIELD_NAME_MAX) == 0)
+      return i;
+  }
+
+  LogWrite(DATABASE__ERROR, 0, "Database Result", "Unknown field name '%s'", field_name);
+  return DATABASE_RESULT_NO_FIELD;
+}
+
+unsigned long DatabaseResult::GetFieldLength(unsigned int index) {
+  if (GetFieldValue(index) == NULL)
+    return 0;
+
+  //only looked up once a row actually needs them
+  if (lengths == NULL && (lengths = mysql_fetch_lengths(result)) == NULL)
+    return 0;
+
+  return lengths[index];
+}
+
 bool DatabaseResult::Next() {
+  lengths = NULL;
   return (result != NULL && (row = mysql_fetch_row(result)) != NULL);
 }
 
@@ -254,6 +285,12 @@ const char* DatabaseResult::GetString(unsigned int index) {
   return value == NULL ? empty_str : value;
 }
 
+const char* DatabaseResult::GetString(unsigned int index, unsigned long* length) {
+  const char* value = GetFieldValue(index);
+  *length = value == NULL ? 0 : GetFieldLength(index);
+  return value == NULL ? empty_str : value;
+}
+
 const char* DatabaseResult::GetStringStr(const char* field_name) {
   const char* value = GetFieldValueStr(field_name);
   return value == NULL ? empty_str : value;
@@ -7,6 +7,9 @@
 #endif
 #include <mysql.h>
 
+//returned by GetFieldIndex for a column the result doesn't have
+#define DATABASE_RESULT_NO_FIELD 0xFFFFFFFF
+
 class DatabaseResult {
 public:
   DatabaseResult();
@@ -15,6 +18,12 @@ public:
   bool StoreResult(MYSQL_RES* res);
   bool Next();
 
+  //resolve a column name once and read every row through the index accessors below,
+  //instead of searching the column names on each Get*Str() call
+  unsigned int GetFieldIndex(const char* field_name);
+  //length of the field in the current row, NULL fields are 0
+  unsigned long GetFieldLength(unsigned int index);
+
   bool IsNull(unsigned int index);
   bool IsNullStr(const char* field_name);
   int8 GetInt8(unsigned int index);
@@ -38,6 +47,8 @@ public:
   char GetChar(unsigned int index);
   char GetCharStr(const char* field_name);
   const char* GetString(unsigned int index);
+  //the field is returned without copying it, its length comes from mysql_fetch_lengths
+  const char* GetString(unsigned int index, unsigned long* length);
   const char* GetStringStr(const char* field_name);
 
   unsigned int GetNumRows() { return result == NULL ? 0 : (unsigned int)mysql_num_rows(result); }
@@ -45,6 +56,7 @@ public:
 private:
   MYSQL_RES* result;
   MYSQL_ROW row;
+  unsigned long* lengths;
   char** field_names;
   unsigned int num_fields;
 
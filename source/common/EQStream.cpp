@@ -722,6 +722,8 @@ void EQStream::SequencedPush(EQProtocolPacket* p) {
   p->sequence = NextOutSeq;
   NextOutSeq++;
   MOutboundQueue.unlock();
+  if (Factory)
+    Factory->SignalWriter();
 }
 
 void EQStream::NonSequencedPush(EQProtocolPacket* p) {
@@ -729,6 +731,8 @@ void EQStream::NonSequencedPush(EQProtocolPacket* p) {
   MOutboundQueue.lock();
   NonSequencedQueue.push_back(p);
   MOutboundQueue.unlock();
+  if (Factory)
+    Factory->SignalWriter();
 }
 
 void EQStream::SendAck(uint16 seq) {
@@ -1051,6 +1055,14 @@ void EQStream::SendDisconnect(bool setstate) {
 void EQStream::InboundQueuePush(EQApplicationPacket* p) {
   MInboundQueue.lock();
   InboundQueue.push_back(p);
+  if (InboundCallback)
+    InboundCallback();
+  MInboundQueue.unlock();
+}
+
+void EQStream::SetInboundCallback(function<void()> callback) {
+  MInboundQueue.lock();
+  InboundCallback = callback;
   MInboundQueue.unlock();
 }
 
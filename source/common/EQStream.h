@@ -23,6 +23,7 @@
 #include <string>
 #include <vector>
 #include <deque>
+#include <functional>
 
 #include <map>
 #include <set>
@@ -170,6 +171,8 @@ protected:
   // Packes waiting to be processed
   deque<EQApplicationPacket*> InboundQueue;
   Mutex MInboundQueue;
+  // Called after a packet is queued for the owner, guarded by MInboundQueue
+  function<void()> InboundCallback;
 
   static uint16 MaxWindowSize;
 
@@ -277,6 +280,7 @@ public:
   bool Stale(uint32 now, uint32 timeout = 30) { return (LastPacket && (now - LastPacket) > timeout); }
 
   void InboundQueuePush(EQApplicationPacket* p);
+  void SetInboundCallback(function<void()> callback);
   EQApplicationPacket* PopPacket(); // InboundQueuePop
   void InboundQueueClear();
 
@@ -65,14 +65,6 @@ ThreadReturnType EQStreamFactoryWriterLoop(void* eqfs) {
   THREAD_RETURN(NULL);
 }
 
-ThreadReturnType EQStreamFactoryCombinePacketLoop(void* eqfs) {
-  if (eqfs) {
-    EQStreamFactory* fs = (EQStreamFactory*)eqfs;
-    fs->CombinePacketLoop();
-  }
-  THREAD_RETURN(NULL);
-}
-
 EQStreamFactory::EQStreamFactory(EQStreamType type, int port) {
   StreamType = type;
   Port = port;
@@ -93,7 +85,7 @@ void EQStreamFactory::Close() {
 bool EQStreamFactory::Open() {
   struct sockaddr_in address;
 #ifndef WIN32
-  pthread_t t1, t2, t3;
+  pthread_t t1, t2;
 #endif
   /* Setup internet address information.  
 	This is used with the bind() call */
@@ -125,20 +117,22 @@ bool EQStreamFactory::Open() {
 #else
   fcntl(sock, F_SETFL, O_NONBLOCK);
 #endif
+  if (!ReaderEvents.Open() || !WriterEvents.Open()) {
+    close(sock);
+    sock = -1;
+    return false;
+  }
   //moved these because on windows the output was delayed and causing the console window to look bad
   LogWrite(WORLD__DEBUG, 0, "World", "Starting factory Reader");
   LogWrite(WORLD__DEBUG, 0, "World", "Starting factory Writer");
 #ifdef WIN32
   _beginthread(EQStreamFactoryReaderLoop, 0, this);
   _beginthread(EQStreamFactoryWriterLoop, 0, this);
-  _beginthread(EQStreamFactoryCombinePacketLoop, 0, this);
 #else
   pthread_create(&t1, NULL, EQStreamFactoryReaderLoop, this);
   pthread_create(&t2, NULL, EQStreamFactoryWriterLoop, this);
-  pthread_create(&t3, NULL, EQStreamFactoryCombinePacketLoop, this);
   pthread_detach(t1);
   pthread_detach(t2);
-  pthread_detach(t3);
 #endif
   return true;
 }
@@ -164,78 +158,84 @@ void EQStreamFactory::Push(EQStream* s) {
   NewStreams.push(s);
   MNewStreams.unlock();
   //cout << "Push(): Unlocking MNewStreams" << endl;
+
+  if (NewStreamCallback)
+    NewStreamCallback();
 }
 
 void EQStreamFactory::ReaderLoop() {
-  fd_set readset;
-  map<string, EQStream*>::iterator stream_itr;
-  int num;
-  int length;
-  unsigned char buffer[2048];
-  sockaddr_in from;
-  int socklen = sizeof(sockaddr_in);
-  timeval sleep_time;
   ReaderRunning = true;
+  ReaderEvents.AddReader(sock, [this]() { ReadPackets(); });
   while (sock != -1) {
     MReaderRunning.lock();
-    if (!ReaderRunning)
+    if (!ReaderRunning) {
+      MReaderRunning.unlock();
       break;
+    }
     MReaderRunning.unlock();
 
-    FD_ZERO(&readset);
-    FD_SET(sock, &readset);
+    ReaderEvents.RunOnce();
+  }
+}
 
-    sleep_time.tv_sec = 30;
-    sleep_time.tv_usec = 0;
-    if ((num = select(sock + 1, &readset, NULL, NULL, &sleep_time)) < 0) {
-      // What do we wanna do?
-    } else if (num == 0)
-      continue;
+void EQStreamFactory::ReadPackets() {
+  map<string, EQStream*>::iterator stream_itr;
+  int length;
+  unsigned char buffer[2048];
+  sockaddr_in from;
+  int socklen;
+  int32 received = 0;
 
-    if (FD_ISSET(sock, &readset)) {
+  // the socket is non blocking, read until it is drained or the batch is full
+  while (sock != -1 && received < FACTORY_READ_BATCH) {
+    socklen = sizeof(sockaddr_in);
 #ifdef WIN32
-      if ((length = recvfrom(sock, (char*)buffer, sizeof(buffer), 0, (struct sockaddr*)&from, (int*)&socklen)) < 0)
+    if ((length = recvfrom(sock, (char*)buffer, sizeof(buffer), 0, (struct sockaddr*)&from, (int*)&socklen)) < 0)
 #else
-      if ((length = recvfrom(sock, buffer, 2048, 0, (struct sockaddr*)&from, (socklen_t*)&socklen)) < 0)
+    if ((length = recvfrom(sock, buffer, 2048, 0, (struct sockaddr*)&from, (socklen_t*)&socklen)) < 0)
 #endif
-      {
-        // What do we wanna do?
-      } else {
-        char temp[25];
-        sprintf(temp, "%u.%d", ntohl(from.sin_addr.s_addr), ntohs(from.sin_port));
-        MStreams.lock();
-        if ((stream_itr = Streams.find(temp)) == Streams.end() || buffer[1] == OP_SessionRequest) {
-          MStreams.unlock();
-          if (buffer[1] == OP_SessionRequest) {
-            if (stream_itr != Streams.end() && stream_itr->second)
-              stream_itr->second->SetState(CLOSED);
-            EQStream* s = new EQStream(from);
-            s->SetFactory(this);
-            s->SetStreamType(StreamType);
-            Streams[temp] = s;
-            WriterWork.Signal();
-            Push(s);
-            s->Process(buffer, length);
-            s->SetLastPacketTime(Timer::GetCurrentTime2());
-          }
-        } else {
-          EQStream* curstream = stream_itr->second;
-          //dont bother processing incoming packets for closed connections
-          if (curstream->CheckClosed())
-            curstream = NULL;
-          else
-            curstream->PutInUse();
-          MStreams.unlock();
-
-          if (curstream) {
-            curstream->Process(buffer, length);
-            curstream->SetLastPacketTime(Timer::GetCurrentTime2());
-            curstream->ReleaseFromUse();
-          }
-        }
+      break;
+
+    received++;
+    char temp[25];
+    sprintf(temp, "%u.%d", ntohl(from.sin_addr.s_addr), ntohs(from.sin_port));
+    MStreams.lock();
+    if ((stream_itr = Streams.find(temp)) == Streams.end() || buffer[1] == OP_SessionRequest) {
+      MStreams.unlock();
+      if (buffer[1] == OP_SessionRequest) {
+        if (stream_itr != Streams.end() && stream_itr->second)
+          stream_itr->second->SetState(CLOSED);
+        EQStream* s = new EQStream(from);
+        s->SetFactory(this);
+        s->SetStreamType(StreamType);
+        Streams[temp] = s;
+        Push(s);
+        s->Process(buffer, length);
+        s->SetLastPacketTime(Timer::GetCurrentTime2());
+      }
+    } else {
+      EQStream* curstream = stream_itr->second;
+      //dont bother processing incoming packets for closed connections
+      if (curstream->CheckClosed())
+        curstream = NULL;
+      else
+        curstream->PutInUse();
+      MStreams.unlock();
+
+      if (curstream) {
+        curstream->Process(buffer, length);
+        curstream->SetLastPacketTime(Timer::GetCurrentTime2());
+        curstream->ReleaseFromUse();
       }
     }
   }
+
+  if (received > 0) {
+    // acks and session responses are waiting to go out
+    WriterEvents.Wake();
+    if (PacketCallback)
+      PacketCallback();
+  }
 }
 
 void EQStreamFactory::CheckTimeout(bool remove_all) {
@@ -302,105 +302,118 @@ void EQStreamFactory::CheckTimeout(bool remove_all) {
   MStreams.unlock();
 }
 
-void EQStreamFactory::CombinePacketLoop() {
+bool EQStreamFactory::CombinePackets() {
   deque<EQStream*> combine_que;
-  CombinePacketRunning = true;
   bool packets_waiting = false;
-  while (sock != -1) {
-    if (!CombinePacketRunning)
-      break;
-    MStreams.lock();
-    map<string, EQStream*>::iterator stream_itr;
-    for (stream_itr = Streams.begin(); stream_itr != Streams.end(); stream_itr++) {
-      if (!stream_itr->second) {
-        continue;
-      }
-      if (stream_itr->second->combine_timer && stream_itr->second->combine_timer->Check())
-        combine_que.push_back(stream_itr->second);
+  MStreams.lock();
+  map<string, EQStream*>::iterator stream_itr;
+  for (stream_itr = Streams.begin(); stream_itr != Streams.end(); stream_itr++) {
+    if (!stream_itr->second) {
+      continue;
     }
-    EQStream* stream = 0;
-    packets_waiting = false;
-    while (combine_que.size()) {
-      stream = combine_que.front();
-      if (stream->CheckActive()) {
-        if (!stream->CheckCombineQueue())
-          packets_waiting = true;
-      }
-      combine_que.pop_front();
+    if (stream_itr->second->combine_timer && stream_itr->second->combine_timer->Check())
+      combine_que.push_back(stream_itr->second);
+  }
+  EQStream* stream = 0;
+  while (combine_que.size()) {
+    stream = combine_que.front();
+    if (stream->CheckActive()) {
+      if (!stream->CheckCombineQueue())
+        packets_waiting = true;
     }
-    MStreams.unlock();
-    if (!packets_waiting)
-      Sleep(50);
+    combine_que.pop_front();
   }
+  MStreams.unlock();
+  return packets_waiting;
 }
 
-void EQStreamFactory::WriterLoop() {
+void EQStreamFactory::WritePackets(bool decay) {
   map<string, EQStream*>::iterator stream_itr;
   vector<EQStream*> wants_write;
   vector<EQStream *>::iterator cur, end;
   deque<EQStream*> resend_que;
+
+  //copy streams into a seperate list so we dont have to keep
+  //MStreams locked while we are writting
+  MStreams.lock();
+  for (stream_itr = Streams.begin(); stream_itr != Streams.end(); stream_itr++) {
+    // If it's time to decay the bytes sent, then let's do it before we try to write
+    if (!stream_itr->second) {
+      Streams.erase(stream_itr);
+      break;
+    }
+    if (decay)
+      stream_itr->second->Decay();
+
+    if (stream_itr->second->HasOutgoingData()) {
+      stream_itr->second->PutInUse();
+      wants_write.push_back(stream_itr->second);
+    }
+    if (stream_itr->second->resend_que_timer->Check())
+      resend_que.push_back(stream_itr->second);
+  }
+  MStreams.unlock();
+
+  //do the actual writes
+  cur = wants_write.begin();
+  end = wants_write.end();
+  for (; cur != end; cur++) {
+    (*cur)->Write(sock);
+    (*cur)->ReleaseFromUse();
+  }
+  while (resend_que.size()) {
+    resend_que.front()->CheckResend(sock);
+    resend_que.pop_front();
+  }
+}
+
+void EQStreamFactory::WriterLoop() {
   bool decay = false;
+  bool combine = false;
+  bool packets_waiting = false;
+  bool timers_armed = true;
   uint32 stream_count;
 
-  Timer DecayTimer(20);
+  int32 decay_timer = WriterEvents.AddTimer(FACTORY_DECAY_INTERVAL, [&decay]() { decay = true; });
+  int32 combine_timer = WriterEvents.AddTimer(FACTORY_COMBINE_INTERVAL, [&combine]() { combine = true; });
 
   WriterRunning = true;
-  DecayTimer.Enable();
   while (sock != -1) {
-    Timer::SetCurrentTime();
-    //if (!havework) {
-    //WriterWork.Wait();
-    //}
     MWriterRunning.lock();
-    if (!WriterRunning)
+    if (!WriterRunning) {
+      MWriterRunning.unlock();
       break;
+    }
     MWriterRunning.unlock();
 
-    wants_write.clear();
-
-    decay = DecayTimer.Check();
-
-    //copy streams into a seperate list so we dont have to keep
-    //MStreams locked while we are writting
-    MStreams.lock();
-    for (stream_itr = Streams.begin(); stream_itr != Streams.end(); stream_itr++) {
-      // If it's time to decay the bytes sent, then let's do it before we try to write
-      if (!stream_itr->second) {
-        Streams.erase(stream_itr);
-        break;
-      }
-      if (decay)
-        stream_itr->second->Decay();
+    // queued packets and new streams wake us up, the timers cover decay, resends and combining
+    WriterEvents.RunOnce(packets_waiting ? 0 : -1);
+    Timer::SetCurrentTime();
 
-      if (stream_itr->second->HasOutgoingData()) {
-        stream_itr->second->PutInUse();
-        wants_write.push_back(stream_itr->second);
-      }
-      if (stream_itr->second->resend_que_timer->Check())
-        resend_que.push_back(stream_itr->second);
+    if (combine || packets_waiting) {
+      combine = false;
+      packets_waiting = CombinePackets();
     }
-    MStreams.unlock();
 
-    //do the actual writes
-    cur = wants_write.begin();
-    end = wants_write.end();
-    for (; cur != end; cur++) {
-      (*cur)->Write(sock);
-      (*cur)->ReleaseFromUse();
-    }
-    while (resend_que.size()) {
-      resend_que.front()->CheckResend(sock);
-      resend_que.pop_front();
-    }
-    Sleep(10);
+    WritePackets(decay);
+    decay = false;
 
     MStreams.lock();
     stream_count = Streams.size();
     MStreams.unlock();
-    if (!stream_count) {
-      //cout << "No streams, waiting on condition" << endl;
-      WriterWork.Wait();
-      //cout << "Awake from condition, must have a stream now" << endl;
+
+    //with no streams there is nothing to decay or resend, sleep until the reader creates one
+    if (!stream_count && timers_armed) {
+      WriterEvents.SetTimer(decay_timer, 0);
+      WriterEvents.SetTimer(combine_timer, 0);
+      timers_armed = false;
+    } else if (stream_count && !timers_armed) {
+      WriterEvents.SetTimer(decay_timer, FACTORY_DECAY_INTERVAL);
+      WriterEvents.SetTimer(combine_timer, FACTORY_COMBINE_INTERVAL);
+      timers_armed = true;
     }
   }
+
+  WriterEvents.RemoveTimer(decay_timer);
+  WriterEvents.RemoveTimer(combine_timer);
 }
@@ -23,12 +23,16 @@
 
 #include <queue>
 #include <map>
+#include <functional>
 #include "../common/EQStream.h"
-#include "../common/Condition.h"
+#include "../common/EventLoop.h"
 #include "../common/opcodemgr.h"
 #include "../common/timer.h"
 
 #define STREAM_TIMEOUT 45000 //in ms
+#define FACTORY_READ_BATCH 64 // datagrams read per wake up before other events get a turn
+#define FACTORY_DECAY_INTERVAL 20 //in ms
+#define FACTORY_COMBINE_INTERVAL 50 //in ms
 
 class EQStreamFactory {
 private:
@@ -39,10 +43,12 @@ private:
   Mutex MReaderRunning;
   bool WriterRunning;
   Mutex MWriterRunning;
-  bool CombinePacketRunning;
-  Mutex MCombinePacketRunning;
 
-  Condition WriterWork;
+  // the reader waits on the socket, the writer on outgoing packets and its decay/combine timers
+  EventLoop ReaderEvents;
+  EventLoop WriterEvents;
+  function<void()> PacketCallback;
+  function<void()> NewStreamCallback;
 
   EQStreamType StreamType;
 
@@ -54,6 +60,10 @@ private:
 
   Timer* DecayTimer;
 
+  void ReadPackets();
+  bool CombinePackets();
+  void WritePackets(bool decay);
+
 public:
   char* listen_ip_address;
   void CheckTimeout(bool remove_all = false);
@@ -61,6 +71,7 @@ public:
     ReaderRunning = false;
     WriterRunning = false;
     StreamType = type;
+    listen_ip_address = 0;
   }
   EQStreamFactory(EQStreamType type, int port);
   ~EQStreamFactory() {
@@ -69,6 +80,10 @@ public:
 
   EQStream* Pop();
   void Push(EQStream* s);
+  // Called on the reader thread after new packets have been handed to their streams
+  void SetPacketCallback(function<void()> callback) { PacketCallback = callback; }
+  // Called on the reader thread when a new stream is waiting to be popped
+  void SetNewStreamCallback(function<void()> callback) { NewStreamCallback = callback; }
 
   bool loadPublicKey();
   bool Open();
@@ -79,29 +94,23 @@ public:
   void Close();
   void ReaderLoop();
   void WriterLoop();
-  void CombinePacketLoop();
   void Stop() {
     StopReader();
     StopWriter();
-    StopCombinePacket();
   }
   void StopReader() {
     MReaderRunning.lock();
     ReaderRunning = false;
     MReaderRunning.unlock();
+    ReaderEvents.Wake();
   }
   void StopWriter() {
     MWriterRunning.lock();
     WriterRunning = false;
     MWriterRunning.unlock();
-    WriterWork.Signal();
-  }
-  void StopCombinePacket() {
-    MCombinePacketRunning.lock();
-    CombinePacketRunning = false;
-    MCombinePacketRunning.unlock();
+    WriterEvents.Wake();
   }
-  void SignalWriter() { WriterWork.Signal(); }
+  void SignalWriter() { WriterEvents.Wake(); }
 };
 
 #endif
@@ -0,0 +1,319 @@
+/*  
+    EQ2Emulator:  Everquest II Server Emulator
+    Copyright (C) 2007  EQ2EMulator Development Team (http://www.eq2emulator.net)
+
+    This file is part of EQ2Emulator.
+
+    EQ2Emulator is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    EQ2Emulator is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with EQ2Emulator.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "EventLoop.h"
+#include "Log.h"
+#include <chrono>
+#include <vector>
+
+#ifdef WIN32
+#include <WinSock2.h>
+#include <windows.h>
+#else
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#include <string.h>
+#endif
+
+#define EVENT_LOOP_MAX_EVENTS 64
+
+EventLoop::EventLoop() {
+  open = false;
+  epoll_fd = -1;
+  wake_fd = -1;
+  wake_pending = false;
+  next_timer_id = 0;
+}
+
+EventLoop::~EventLoop() {
+  Close();
+}
+
+int64 EventLoop::GetSteadyTime() {
+  return chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool EventLoop::Open() {
+  if (open)
+    return true;
+
+#ifndef WIN32
+  epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+  if (epoll_fd < 0) {
+    LogWrite(NET__ERROR, 0, "Net", "Unable to create epoll instance: %s", strerror(errno));
+    return false;
+  }
+
+  wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (wake_fd < 0) {
+    LogWrite(NET__ERROR, 0, "Net", "Unable to create wake eventfd: %s", strerror(errno));
+    close(epoll_fd);
+    epoll_fd = -1;
+    return false;
+  }
+
+  struct epoll_event ev;
+  memset(&ev, 0, sizeof(ev));
+  ev.events = EPOLLIN;
+  ev.data.fd = wake_fd;
+  epoll_ctl(epoll_fd, EPOLL_CTL_ADD, wake_fd, &ev);
+#endif
+
+  wake_pending = false;
+  open = true;
+  return true;
+}
+
+void EventLoop::Close() {
+  if (!open)
+    return;
+
+  lock_guard<mutex> guard(watchers_mutex);
+#ifndef WIN32
+  for (auto& itr : watchers) {
+    if (itr.second.is_timer)
+      close(itr.second.fd);
+  }
+  close(wake_fd);
+  close(epoll_fd);
+  wake_fd = -1;
+  epoll_fd = -1;
+#endif
+  watchers.clear();
+  open = false;
+}
+
+bool EventLoop::AddReader(int fd, function<void()> callback) {
+  if (!open || fd < 0)
+    return false;
+
+  lock_guard<mutex> guard(watchers_mutex);
+
+#ifndef WIN32
+  struct epoll_event ev;
+  memset(&ev, 0, sizeof(ev));
+  ev.events = EPOLLIN;
+  ev.data.u32 = fd;
+  if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+    LogWrite(NET__ERROR, 0, "Net", "Unable to watch socket %i: %s", fd, strerror(errno));
+    return false;
+  }
+#endif
+
+  Watcher& watcher = watchers[fd];
+  watcher.fd = fd;
+  watcher.is_timer = false;
+  watcher.interval = 0;
+  watcher.next_run = 0;
+  watcher.callback = callback;
+  return true;
+}
+
+void EventLoop::RemoveReader(int fd) {
+  lock_guard<mutex> guard(watchers_mutex);
+
+  if (watchers.erase(fd) == 0)
+    return;
+
+#ifndef WIN32
+  epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, NULL);
+#endif
+}
+
+int32 EventLoop::AddTimer(int32 interval, function<void()> callback) {
+  if (!open)
+    return 0;
+
+  lock_guard<mutex> guard(watchers_mutex);
+  int32 timer_id = (int32)(-(sint32)++next_timer_id);
+
+  Watcher watcher;
+  watcher.fd = -1;
+  watcher.is_timer = true;
+  watcher.interval = interval;
+  watcher.next_run = interval > 0 ? GetSteadyTime() + interval : 0;
+  watcher.callback = callback;
+
+#ifndef WIN32
+  watcher.fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+  if (watcher.fd < 0) {
+    LogWrite(NET__ERROR, 0, "Net", "Unable to create timerfd: %s", strerror(errno));
+    return 0;
+  }
+
+  struct itimerspec spec;
+  memset(&spec, 0, sizeof(spec));
+  spec.it_interval.tv_sec = interval / 1000;
+  spec.it_interval.tv_nsec = (interval % 1000) * 1000000;
+  spec.it_value = spec.it_interval;
+  timerfd_settime(watcher.fd, 0, &spec, NULL);
+
+  struct epoll_event ev;
+  memset(&ev, 0, sizeof(ev));
+  ev.events = EPOLLIN;
+  ev.data.u32 = timer_id;
+  epoll_ctl(epoll_fd, EPOLL_CTL_ADD, watcher.fd, &ev);
+#endif
+
+  watchers[timer_id] = watcher;
+  return timer_id;
+}
+
+void EventLoop::SetTimer(int32 timer_id, int32 interval) {
+  lock_guard<mutex> guard(watchers_mutex);
+
+  map<int32, Watcher>::iterator itr = watchers.find(timer_id);
+  if (itr == watchers.end() || !itr->second.is_timer)
+    return;
+
+  itr->second.interval = interval;
+  itr->second.next_run = interval > 0 ? GetSteadyTime() + interval : 0;
+
+#ifndef WIN32
+  struct itimerspec spec;
+  memset(&spec, 0, sizeof(spec));
+  spec.it_interval.tv_sec = interval / 1000;
+  spec.it_interval.tv_nsec = (interval % 1000) * 1000000;
+  spec.it_value = spec.it_interval;
+  timerfd_settime(itr->second.fd, 0, &spec, NULL);
+#endif
+}
+
+void EventLoop::RemoveTimer(int32 timer_id) {
+  lock_guard<mutex> guard(watchers_mutex);
+
+  map<int32, Watcher>::iterator itr = watchers.find(timer_id);
+  if (itr == watchers.end() || !itr->second.is_timer)
+    return;
+
+#ifndef WIN32
+  epoll_ctl(epoll_fd, EPOLL_CTL_DEL, itr->second.fd, NULL);
+  close(itr->second.fd);
+#endif
+  watchers.erase(itr);
+}
+
+void EventLoop::Wake() {
+  // only the first wake up since the loop last woke needs to touch the eventfd
+  if (!open || wake_pending.exchange(true))
+    return;
+
+#ifndef WIN32
+  int64 value = 1;
+  if (write(wake_fd, &value, sizeof(value)) < 0 && errno != EAGAIN)
+    LogWrite(NET__ERROR, 0, "Net", "Unable to wake event loop: %s", strerror(errno));
+#endif
+}
+
+void EventLoop::RunWatcher(int32 id) {
+  function<void()> callback;
+  {
+    lock_guard<mutex> guard(watchers_mutex);
+
+    // the watcher may have been removed by an earlier callback in this round
+    map<int32, Watcher>::iterator itr = watchers.find(id);
+    if (itr == watchers.end())
+      return;
+
+#ifndef WIN32
+    if (itr->second.is_timer) {
+      int64 expirations = 0;
+      if (read(itr->second.fd, &expirations, sizeof(expirations)) < 0)
+        return;
+    }
+#endif
+    callback = itr->second.callback;
+  }
+
+  if (callback)
+    callback();
+}
+
+void EventLoop::RunOnce(sint32 timeout) {
+  if (!open)
+    return;
+
+#ifndef WIN32
+  struct epoll_event events[EVENT_LOOP_MAX_EVENTS];
+  int count = epoll_wait(epoll_fd, events, EVENT_LOOP_MAX_EVENTS, timeout);
+
+  for (int i = 0; i < count; i++) {
+    if (events[i].data.fd == wake_fd) {
+      // clear the flag first so a Wake() racing with us writes the eventfd again
+      wake_pending = false;
+      int64 value;
+      while (read(wake_fd, &value, sizeof(value)) > 0)
+        ;
+      continue;
+    }
+    RunWatcher(events[i].data.u32);
+  }
+#else
+  vector<int32> due;
+  fd_set readset;
+  FD_ZERO(&readset);
+  int64 now = GetSteadyTime();
+  sint64 wait = EVENT_LOOP_POLL_INTERVAL;
+  if (timeout >= 0 && timeout < wait)
+    wait = timeout;
+
+  {
+    lock_guard<mutex> guard(watchers_mutex);
+    for (auto& itr : watchers) {
+      if (!itr.second.is_timer)
+        FD_SET(itr.second.fd, &readset);
+      else if (itr.second.interval > 0 && (sint64)(itr.second.next_run - now) < wait)
+        wait = itr.second.next_run > now ? itr.second.next_run - now : 0;
+    }
+  }
+
+  if (!wake_pending) {
+    if (readset.fd_count > 0) {
+      timeval tv;
+      tv.tv_sec = 0;
+      tv.tv_usec = (long)wait * 1000;
+      if (select(0, &readset, NULL, NULL, &tv) < 0)
+        FD_ZERO(&readset);
+    } else
+      Sleep((DWORD)wait);
+  } else
+    FD_ZERO(&readset);
+  wake_pending = false;
+
+  now = GetSteadyTime();
+  {
+    lock_guard<mutex> guard(watchers_mutex);
+    for (auto& itr : watchers) {
+      if (!itr.second.is_timer) {
+        if (FD_ISSET(itr.second.fd, &readset))
+          due.push_back(itr.first);
+      } else if (itr.second.interval > 0 && itr.second.next_run <= now) {
+        itr.second.next_run = now + itr.second.interval;
+        due.push_back(itr.first);
+      }
+    }
+  }
+
+  for (int32 id : due)
+    RunWatcher(id);
+#endif
+}
@@ -0,0 +1,83 @@
+/*  
+    EQ2Emulator:  Everquest II Server Emulator
+    Copyright (C) 2007  EQ2EMulator Development Team (http://www.eq2emulator.net)
+
+    This file is part of EQ2Emulator.
+
+    EQ2Emulator is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    EQ2Emulator is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with EQ2Emulator.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef EVENTLOOP_H
+#define EVENTLOOP_H
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <mutex>
+#include "types.h"
+
+using namespace std;
+
+// Windows has no epoll, readers are polled with select() and Wake() can take this long to be noticed
+#define EVENT_LOOP_POLL_INTERVAL 10
+
+// Waits on sockets, repeating timers and wake ups from other threads in a single call, using
+// epoll, timerfd and eventfd on linux. The callbacks run on the thread that calls RunOnce().
+class EventLoop {
+public:
+  EventLoop();
+  ~EventLoop();
+
+  bool Open();
+  void Close();
+  bool IsOpen() { return open; }
+
+  // Runs the callback whenever fd has data to read
+  bool AddReader(int fd, function<void()> callback);
+  void RemoveReader(int fd);
+
+  // Runs the callback every interval ms, returns 0 if the timer could not be created
+  int32 AddTimer(int32 interval, function<void()> callback);
+  // An interval of 0 disarms the timer until it is set again
+  void SetTimer(int32 timer_id, int32 interval);
+  void RemoveTimer(int32 timer_id);
+
+  // Makes RunOnce() return, safe to call from any thread
+  void Wake();
+
+  // Waits up to timeout ms (forever if negative) for something to happen and runs the callbacks that are due
+  void RunOnce(sint32 timeout = -1);
+
+private:
+  struct Watcher {
+    int fd;
+    bool is_timer;
+    int32 interval;
+    int64 next_run;
+    function<void()> callback;
+  };
+
+  void RunWatcher(int32 id);
+  static int64 GetSteadyTime();
+
+  bool open;
+  int epoll_fd;
+  int wake_fd;
+  atomic<bool> wake_pending;
+  int32 next_timer_id;
+  mutex watchers_mutex;
+  // readers are keyed by their fd, timers by negative ids
+  map<int32, Watcher> watchers;
+};
+
+#endif
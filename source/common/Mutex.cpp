@@ -20,11 +20,55 @@
 #include "../common/Log.h"
 #include "../common/debug.h"
 #include "../common/Mutex.h"
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <stdio.h>
+
+#define MUTEX_READER_MASK 0x000FFFFF
+#define MUTEX_WRITER_WAITING 0x00100000
+#define MUTEX_WAITING_MASK 0x3FF00000
+#define MUTEX_WRITE_LOCKED 0x40000000
+
+static int64 GetWaitTime() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Stats are shared by every mutex with the same name and live until the process exits
+static std::mutex wait_stats_mutex;
+
+static map<string, MutexWaitStats*>& GetWaitStatsList() {
+  static map<string, MutexWaitStats*>* wait_stats_list = new map<string, MutexWaitStats*>();
+  return *wait_stats_list;
+}
+
+static MutexWaitStats* GetWaitStats(const string& name) {
+  std::lock_guard<std::mutex> guard(wait_stats_mutex);
+  map<string, MutexWaitStats*>& wait_stats_list = GetWaitStatsList();
+  const string& key = name.length() > 0 ? name : "(unnamed)";
+
+  map<string, MutexWaitStats*>::iterator itr = wait_stats_list.find(key);
+  if (itr != wait_stats_list.end())
+    return itr->second;
+
+  MutexWaitStats* stats = new MutexWaitStats();
+  stats->name = key;
+  for (int32 i = 0; i < MUTEX_WAIT_BUCKETS; i++) {
+    stats->read_waits[i] = 0;
+    stats->write_waits[i] = 0;
+  }
+  stats->total_wait_us = 0;
+  stats->max_wait_us = 0;
+  stats->max_wait_line = 0;
+  wait_stats_list[key] = stats;
+
+  return stats;
+}
 
 Mutex::Mutex() {
-  readers = 0;
-  mlocked = false;
-  writing = false;
+  state = 0;
+  sleepers = 0;
+  wait_stats = 0;
   name = "";
 #ifdef DEBUG
   stack.clear();
@@ -41,29 +85,17 @@ Mutex::~Mutex() {
 }
 
 void Mutex::SetName(string in_name) {
-#ifdef DEBUG
   name = in_name;
-#endif
+  wait_stats = 0;
 }
 
 void Mutex::lock() {
-#ifdef DEBUG
-  int i = 0;
-#endif
-  if (name.length() > 0) {
-    while (mlocked) {
-#ifdef DEBUG
-      if (i > MUTEX_TIMEOUT_MILLISECONDS) {
-        LogWrite(MUTEX__ERROR, 0, "Mutex", "Possible deadlock attempt by '%s'!", name.c_str());
-        return;
-      }
-      i++;
-#endif
-      Sleep(1);
-    }
-  }
-  mlocked = true;
+  if (CSLock->trylock())
+    return;
+
+  int64 start = GetWaitTime();
   CSLock->lock();
+  RecordWait(true, start, 0, 0);
 }
 
 bool Mutex::trylock() {
@@ -72,53 +104,26 @@ bool Mutex::trylock() {
 
 void Mutex::unlock() {
   CSLock->unlock();
-  mlocked = false;
 }
 
 void Mutex::readlock(const char* function, int32 line) {
+  if (!TryAcquireRead())
+    WaitRead(function, line);
+
 #ifdef DEBUG
-  int32 i = 0;
-#endif
-  while (true) {
-    //Loop until there isn't a writer, then we can read!
-    CSRead.lock();
-    if (!writing) {
-      readers++;
-      CSRead.unlock();
-#ifdef DEBUG
-      CSStack.lock();
-      if (function)
-        stack[(string)function]++;
-      CSStack.unlock();
-#endif
-      return;
-    }
-    CSRead.unlock();
-#ifdef DEBUG
-    if (i > MUTEX_TIMEOUT_MILLISECONDS) {
-      LogWrite(MUTEX__ERROR, 0, "Mutex", "The mutex %s called from %s at line %u timed out waiting for a readlock!", name.c_str(), function ? function : "name_not_provided", line);
-      LogWrite(MUTEX__ERROR, 0, "Mutex", "The following functions had locks:");
-      map<string, int32>::iterator itr;
-      CSStack.lock();
-      for (itr = stack.begin(); itr != stack.end(); itr++) {
-        if (itr->second > 0 && itr->first.length() > 0)
-          LogWrite(MUTEX__ERROR, 0, "Mutex", "%s, number of locks = %u", itr->first.c_str(), itr->second);
-      }
-      CSStack.unlock();
-      return;
-    }
-    i++;
+  CSStack.lock();
+  if (function)
+    stack[(string)function]++;
+  CSStack.unlock();
 #endif
-    Sleep(1);
-  }
 }
 
 void Mutex::releasereadlock(const char* function, int32 line) {
-  //Wait for the readcount lock
-  CSRead.lock();
-  //Lower the readcount by one, when readcount is 0 writers may start writing
-  readers--;
-  CSRead.unlock();
+  //The last reader out lets a waiting writer in
+  int32 prev = state.fetch_sub(1);
+  if ((prev & MUTEX_READER_MASK) == 1 && sleepers.load() > 0)
+    WakeWaiters();
+
 #ifdef DEBUG
   CSStack.lock();
   if (function) {
@@ -135,14 +140,8 @@ void Mutex::releasereadlock(const char* function, int32 line) {
 
 bool Mutex::tryreadlock(const char* function) {
   //This returns true if able to instantly obtain a readlock, false if not
-  CSRead.lock();
-  if (!writing) {
-    readers++;
-    CSRead.unlock();
-  } else {
-    CSRead.unlock();
+  if (!TryAcquireRead())
     return false;
-  }
 
 #ifdef DEBUG
   CSStack.lock();
@@ -155,29 +154,10 @@ bool Mutex::tryreadlock(const char* function) {
 }
 
 void Mutex::writelock(const char* function, int32 line) {
-//Wait until the writer lock becomes available, then we can be the only writer!
-#ifdef DEBUG
-  int32 i = 0;
-#endif
-  while (!CSWrite.trylock()) {
-#ifdef DEBUG
-    if (i > MUTEX_TIMEOUT_MILLISECONDS) {
-      LogWrite(MUTEX__ERROR, 0, "Mutex", "The mutex %s called from %s at line %u timed out waiting on another writelock!", name.c_str(), function ? function : "name_not_provided", line);
-      LogWrite(MUTEX__ERROR, 0, "Mutex", "The following functions had locks:");
-      map<string, int32>::iterator itr;
-      CSStack.lock();
-      for (itr = stack.begin(); itr != stack.end(); itr++) {
-        if (itr->second > 0 && itr->first.length() > 0)
-          LogWrite(MUTEX__ERROR, 0, "Mutex", "%s, number of locks = %u", itr->first.c_str(), itr->second);
-      }
-      CSStack.unlock();
-      return;
-    }
-    i++;
-#endif
-    Sleep(1);
-  }
-  waitReaders(function, line);
+  int32 expected = 0;
+  if (!state.compare_exchange_strong(expected, MUTEX_WRITE_LOCKED, std::memory_order_acquire))
+    WaitWrite(function, line);
+
 #ifdef DEBUG
   CSStack.lock();
   if (function)
@@ -187,13 +167,10 @@ void Mutex::writelock(const char* function, int32 line) {
 }
 
 void Mutex::releasewritelock(const char* function, int32 line) {
-  //Wait for the readcount lock
-  CSRead.lock();
-  //Readers are aloud again
-  writing = false;
-  CSRead.unlock();
-  //Allow other writers to write
-  CSWrite.unlock();
+  state.fetch_sub(MUTEX_WRITE_LOCKED);
+  if (sleepers.load() > 0)
+    WakeWaiters();
+
 #ifdef DEBUG
   CSStack.lock();
   if (function) {
@@ -210,16 +187,8 @@ void Mutex::releasewritelock(const char* function, int32 line) {
 
 bool Mutex::trywritelock(const char* function) {
   //This returns true if able to instantly obtain a writelock, false if not
-  if (CSWrite.trylock()) {
-    CSRead.lock();
-    if (readers == 0)
-      writing = true;
-    CSRead.unlock();
-    if (!writing) {
-      CSWrite.unlock();
-      return false;
-    }
-  } else
+  int32 expected = 0;
+  if (!state.compare_exchange_strong(expected, MUTEX_WRITE_LOCKED, std::memory_order_acquire))
     return false;
 
 #ifdef DEBUG
@@ -232,37 +201,158 @@ bool Mutex::trywritelock(const char* function) {
   return true;
 }
 
-void Mutex::waitReaders(const char* function, int32 line) {
-//Wait for all current readers to stop, then we can write!
+bool Mutex::TryAcquireRead() {
+  //Readers may share the lock as long as no writer holds it or is waiting for it
+  int32 current = state.load(std::memory_order_relaxed);
+  while ((current & (MUTEX_WRITE_LOCKED | MUTEX_WAITING_MASK)) == 0) {
+    if (state.compare_exchange_weak(current, current + 1, std::memory_order_acquire, std::memory_order_relaxed))
+      return true;
+  }
+
+  return false;
+}
+
+void Mutex::WaitRead(const char* function, int32 line) {
+  int64 start = GetWaitTime();
+
+  while (!TryAcquireRead()) {
+    std::unique_lock<std::mutex> lock(wait_mutex);
+    sleepers++;
 #ifdef DEBUG
-  int32 i = 0;
+    if (!wait_cv.wait_for(lock, std::chrono::milliseconds(MUTEX_TIMEOUT_MILLISECONDS), [this]() { return (state.load() & (MUTEX_WRITE_LOCKED | MUTEX_WAITING_MASK)) == 0; }))
+      LogLockHolders(function, line);
+#else
+    wait_cv.wait(lock, [this]() { return (state.load() & (MUTEX_WRITE_LOCKED | MUTEX_WAITING_MASK)) == 0; });
 #endif
-  CSRead.lock();
-  writing = true;
-  CSRead.unlock();
+    sleepers--;
+  }
+
+  RecordWait(false, start, function, line);
+}
+
+void Mutex::WaitWrite(const char* function, int32 line) {
+  int64 start = GetWaitTime();
+
+  //Announce the writer so no new readers get in, then wait for the current holders to leave
+  state.fetch_add(MUTEX_WRITER_WAITING);
   while (true) {
-    CSRead.lock();
-    if (readers == 0) {
-      CSRead.unlock();
-      break;
+    int32 current = state.load();
+    if ((current & (MUTEX_WRITE_LOCKED | MUTEX_READER_MASK)) == 0) {
+      if (state.compare_exchange_weak(current, current - MUTEX_WRITER_WAITING + MUTEX_WRITE_LOCKED, std::memory_order_acquire))
+        break;
+      continue;
     }
-    CSRead.unlock();
+
+    std::unique_lock<std::mutex> lock(wait_mutex);
+    sleepers++;
 #ifdef DEBUG
-    if (i > MUTEX_TIMEOUT_MILLISECONDS) {
-      LogWrite(MUTEX__ERROR, 0, "Mutex", "The mutex %s called from %s at line %u timed out while waiting on readers!", name.c_str(), function ? function : "name_not_provided", line);
-      LogWrite(MUTEX__ERROR, 0, "Mutex", "The following functions had locks:");
-      map<string, int32>::iterator itr;
-      CSStack.lock();
-      for (itr = stack.begin(); itr != stack.end(); itr++) {
-        if (itr->second > 0 && itr->first.length() > 0)
-          LogWrite(MUTEX__ERROR, 0, "Mutex", "%s, number of locks = %u", itr->first.c_str(), itr->second);
-      }
-      CSStack.unlock();
-      return;
+    if (!wait_cv.wait_for(lock, std::chrono::milliseconds(MUTEX_TIMEOUT_MILLISECONDS), [this]() { return (state.load() & (MUTEX_WRITE_LOCKED | MUTEX_READER_MASK)) == 0; }))
+      LogLockHolders(function, line);
+#else
+    wait_cv.wait(lock, [this]() { return (state.load() & (MUTEX_WRITE_LOCKED | MUTEX_READER_MASK)) == 0; });
+#endif
+    sleepers--;
+  }
+
+  RecordWait(true, start, function, line);
+}
+
+void Mutex::WakeWaiters() {
+  //Taking wait_mutex makes sure a waiter that saw the old state is asleep before it is notified
+  {
+    std::lock_guard<std::mutex> guard(wait_mutex);
+  }
+  wait_cv.notify_all();
+}
+
+void Mutex::RecordWait(bool write, int64 start, const char* function, int32 line) {
+  int64 wait_us = GetWaitTime() - start;
+  MutexWaitStats* stats = wait_stats.load();
+
+  if (!stats) {
+    stats = GetWaitStats(name);
+    wait_stats = stats;
+  }
+
+  int32 bucket = 0;
+  for (int64 limit = 10; wait_us >= limit && bucket < MUTEX_WAIT_BUCKETS - 1; limit *= 10)
+    bucket++;
+
+  if (write)
+    stats->write_waits[bucket]++;
+  else
+    stats->read_waits[bucket]++;
+  stats->total_wait_us += wait_us;
+
+  if (wait_us > stats->max_wait_us.load()) {
+    std::lock_guard<std::mutex> guard(stats->max_wait_mutex);
+    if (wait_us > stats->max_wait_us.load()) {
+      stats->max_wait_us = wait_us;
+      stats->max_wait_function = function ? function : "name_not_provided";
+      stats->max_wait_line = line;
     }
-    i++;
+  }
+}
+
+#ifdef DEBUG
+void Mutex::LogLockHolders(const char* function, int32 line) {
+  LogWrite(MUTEX__ERROR, 0, "Mutex", "The mutex %s called from %s at line %u has been waiting over %u ms!", name.c_str(), function ? function : "name_not_provided", line, MUTEX_TIMEOUT_MILLISECONDS);
+  LogWrite(MUTEX__ERROR, 0, "Mutex", "The following functions had locks:");
+  map<string, int32>::iterator itr;
+  CSStack.lock();
+  for (itr = stack.begin(); itr != stack.end(); itr++) {
+    if (itr->second > 0 && itr->first.length() > 0)
+      LogWrite(MUTEX__ERROR, 0, "Mutex", "%s, number of locks = %u", itr->first.c_str(), itr->second);
+  }
+  CSStack.unlock();
+}
 #endif
-    Sleep(1);
+
+void Mutex::PrintWaitStats() {
+  vector<MutexWaitStats*> list;
+  {
+    std::lock_guard<std::mutex> guard(wait_stats_mutex);
+    map<string, MutexWaitStats*>& wait_stats_list = GetWaitStatsList();
+    for (map<string, MutexWaitStats*>::iterator itr = wait_stats_list.begin(); itr != wait_stats_list.end(); itr++)
+      list.push_back(itr->second);
+  }
+
+  sort(list.begin(), list.end(), [](MutexWaitStats* a, MutexWaitStats* b) { return a->total_wait_us.load() > b->total_wait_us.load(); });
+
+  printf("Blocked lock waits per mutex, read/write counts by wait time:\n");
+  printf("=======================================================================================================================\n");
+  printf("| %-40s | %9s | %9s | %9s | %9s | %9s | %9s | %9s | %10s |\n", "Mutex", "<10us", "<100us", "<1ms", "<10ms", "<100ms", "<1s", ">=1s", "Total ms");
+  printf("=======================================================================================================================\n");
+  for (MutexWaitStats* stats : list) {
+    char buckets[MUTEX_WAIT_BUCKETS][32];
+    for (int32 i = 0; i < MUTEX_WAIT_BUCKETS; i++)
+      snprintf(buckets[i], sizeof(buckets[i]), "%llu/%llu", (unsigned long long)stats->read_waits[i].load(), (unsigned long long)stats->write_waits[i].load());
+
+    printf("| %-40.40s | %9s | %9s | %9s | %9s | %9s | %9s | %9s | %10llu |\n", stats->name.c_str(), buckets[0], buckets[1], buckets[2], buckets[3], buckets[4], buckets[5], buckets[6], (unsigned long long)(stats->total_wait_us.load() / 1000));
+
+    std::lock_guard<std::mutex> guard(stats->max_wait_mutex);
+    if (stats->max_wait_us.load() > 0)
+      printf("|   longest wait %llu us in %s at line %u\n", (unsigned long long)stats->max_wait_us.load(), stats->max_wait_function.c_str(), stats->max_wait_line);
+  }
+  printf("=======================================================================================================================\n");
+}
+
+void Mutex::ResetWaitStats() {
+  std::lock_guard<std::mutex> guard(wait_stats_mutex);
+  map<string, MutexWaitStats*>& wait_stats_list = GetWaitStatsList();
+
+  for (map<string, MutexWaitStats*>::iterator itr = wait_stats_list.begin(); itr != wait_stats_list.end(); itr++) {
+    MutexWaitStats* stats = itr->second;
+    for (int32 i = 0; i < MUTEX_WAIT_BUCKETS; i++) {
+      stats->read_waits[i] = 0;
+      stats->write_waits[i] = 0;
+    }
+    stats->total_wait_us = 0;
+
+    std::lock_guard<std::mutex> max_guard(stats->max_wait_mutex);
+    stats->max_wait_us = 0;
+    stats->max_wait_function.clear();
+    stats->max_wait_line = 0;
   }
 }
 
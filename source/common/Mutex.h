@@ -29,12 +29,18 @@
 #include "../common/types.h"
 #include <string>
 #include <map>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
 
 #define MUTEX_ATTRIBUTE_FAST 1
 #define MUTEX_ATTRIBUTE_RECURSIVE 2
 #define MUTEX_ATTRIBUTE_ERRORCHK 3
 #define MUTEX_TIMEOUT_MILLISECONDS 10000
 
+// Wait times are bucketed by powers of ten starting below 10us, the last bucket holds everything from 1s up
+#define MUTEX_WAIT_BUCKETS 7
+
 class CriticalSection {
 public:
   CriticalSection(int attribute = MUTEX_ATTRIBUTE_FAST);
@@ -52,6 +58,23 @@ private:
 #endif
 };
 
+// How long the lock calls on every mutex sharing a name had to wait, only waits that
+// actually blocked are counted so an uncontended lock costs nothing extra
+struct MutexWaitStats {
+  string name;
+  std::atomic<int64> read_waits[MUTEX_WAIT_BUCKETS];
+  std::atomic<int64> write_waits[MUTEX_WAIT_BUCKETS];
+  std::atomic<int64> total_wait_us;
+  std::atomic<int64> max_wait_us;
+  std::mutex max_wait_mutex;
+  string max_wait_function;
+  int32 max_wait_line;
+};
+
+// Writer preferring reader/writer lock. Locks that are free are taken with a single atomic
+// operation, otherwise the caller sleeps until the lock is released. Once a writer is
+// waiting new readers wait behind it, so a readlock must not be taken again by a thread
+// that already holds one.
 class Mutex {
 public:
   Mutex();
@@ -69,13 +92,22 @@ public:
   void releasewritelock(const char* function = 0, int32 line = 0);
   bool trywritelock(const char* function = 0);
 
-  void waitReaders(const char* function = 0, int32 line = 0);
-
   void SetName(string in_name);
 
+  // Prints the wait time histograms of every mutex name that has had to wait, longest total wait first
+  static void PrintWaitStats();
+  static void ResetWaitStats();
+
 private:
-  CriticalSection CSRead;
-  CriticalSection CSWrite;
+  bool TryAcquireRead();
+  void WaitRead(const char* function, int32 line);
+  void WaitWrite(const char* function, int32 line);
+  void WakeWaiters();
+  void RecordWait(bool write, int64 start, const char* function, int32 line);
+#ifdef DEBUG
+  void LogLockHolders(const char* function, int32 line);
+#endif
+
   CriticalSection* CSLock;
 
 #ifdef DEBUG //Used for debugging only
@@ -83,9 +115,12 @@ private:
   map<string, int32> stack;
 #endif
 
-  int readers;
-  bool writing;
-  volatile bool mlocked;
+  // reader count, waiting writer count and the write bit packed together
+  std::atomic<int32> state;
+  std::atomic<int32> sleepers;
+  std::mutex wait_mutex;
+  std::condition_variable wait_cv;
+  std::atomic<MutexWaitStats*> wait_stats;
   string name;
 };
 
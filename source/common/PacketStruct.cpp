@@ -336,6 +336,51 @@ int32 DataStruct::GetDataSizeInBytes() {
   return ret;
 }
 
+// registration only happens during static initialization, before any struct is loaded
+static vector<const char*>& GetRegisteredPacketFields() {
+  static vector<const char*> fields;
+  return fields;
+}
+
+PacketField::PacketField(const char* name) {
+  this->name = name;
+  id = GetRegisteredPacketFields().size();
+  GetRegisteredPacketFields().push_back(name);
+}
+
+PacketFieldTable::PacketFieldTable(vector<DataStruct*>* structs) {
+  // reserved up front so the keys can point into names
+  names.reserve(structs->size());
+  fields.reserve(structs->size());
+  for (int32 i = 0; i < structs->size(); i++) {
+    names.push_back(structs->at(i)->GetStringName());
+    fields[names.back().c_str()] = i;
+  }
+
+  vector<const char*>& registered_fields = GetRegisteredPacketFields();
+  registered.reserve(registered_fields.size());
+  for (const char* name : registered_fields)
+    registered.push_back(Find(name));
+}
+int32 PacketFieldTable::Find(const char* name) const {
+  unordered_map<const char*, int32, NameHash, NameEqual>::const_iterator itr = fields.find(name);
+  return itr != fields.end() ? itr->second : INVALID_FIELD_HANDLE;
+}
+int32 PacketFieldTable::Find(const PacketField& field) const {
+  if (field.GetID() < registered.size())
+    return registered[field.GetID()];
+  return Find(field.GetName());
+}
+size_t PacketFieldTable::NameHash::operator()(const char* name) const {
+  size_t hash = 2166136261u;
+  for (; *name; name++)
+    hash = (hash ^ (unsigned char)*name) * 16777619u;
+  return hash;
+}
+bool PacketFieldTable::NameEqual::operator()(const char* name1, const char* name2) const {
+  return strcmp(name1, name2) == 0;
+}
+
 PacketStruct::PacketStruct(PacketStruct* packet, int16 in_client_version) {
   parent = packet->parent;
   client_version = in_client_version;
@@ -351,13 +396,22 @@ PacketStruct::PacketStruct(PacketStruct* packet, int16 in_client_version) {
   version = packet->version;
   opcode_type = packet->opcode_type;
   sub_packet_size = 1;
+  track_offsets = false;
+
+  pool_template = 0;
+  layout_changed = false;
 
   addPacketArrays(packet);
+  // the copy has the same top level layout as the template
+  field_table = packet->field_table;
 }
 
 PacketStruct::PacketStruct() {
   parent = 0;
   opcode = OP_Unknown;
+  track_offsets = false;
+  pool_template = 0;
+  layout_changed = false;
 }
 
 PacketStruct::PacketStruct(PacketStruct* packet, bool sub) {
@@ -373,6 +427,9 @@ PacketStruct::PacketStruct(PacketStruct* packet, bool sub) {
   name = packet->name;
   sub_packet_size = 0;
   parent = 0;
+  track_offsets = false;
+  pool_template = 0;
+  layout_changed = false;
 }
 PacketStruct::~PacketStruct() {
   deleteDataStructs(&structs);
@@ -690,6 +747,7 @@ void PacketStruct::setData(DataStruct* data_struct, EQ2_32BitString* input_strin
   }
 }
 void PacketStruct::add(DataStruct* data) {
+  field_table.reset();
   structs.push_back(data);
   struct_map[data->GetStringName()] = data;
   switch (data->GetType()) {
@@ -889,6 +947,7 @@ void PacketStruct::add(DataStruct* data) {
   }
 }
 void PacketStruct::remove(DataStruct* data) {
+  field_table.reset();
   vector<DataStruct*>::iterator itr;
   for (itr = structs.begin(); itr != structs.end(); itr++) {
     if (data == (*itr)) {
@@ -903,25 +962,19 @@ DataStruct* PacketStruct::findStruct(const char* name, int32 index) {
 }
 
 DataStruct* PacketStruct::findStruct(const char* name, int32 index1, int32 index2) {
-  DataStruct* data = 0;
-
-  if (struct_map.count(string(name)) > 0) {
-    data = struct_map[string(name)];
-    if (data && index2 < data->GetLength())
-      return data;
-  }
-  vector<DataStruct*>::iterator itr;
+  DataStruct* data = findTopLevelStruct(name);
+  if (data && index2 < data->GetLength())
+    return data;
 
   PacketStruct* packet = 0;
   vector<PacketStruct*>::iterator itr2;
-  string name2 = string(name);
   if (index1 < 0xFFFF) {
-    char blah[10] = {0};
-    sprintf(blah, "_%u", index1);
-    name2.append(blah);
-  }
-  if (struct_map.count(name2) > 0) {
-    data = struct_map[name2];
+    char name2[128];
+    int length = snprintf(name2, sizeof(name2), "%s_%u", name, index1);
+    if (length > 0 && length < (int)sizeof(name2))
+      data = findTopLevelStruct(name2);
+    else
+      data = findTopLevelStruct(string(name).append("_").append(to_string(index1)).c_str());
     if (data && index2 < data->GetLength())
       return data;
   }
@@ -933,7 +986,29 @@ DataStruct* PacketStruct::findStruct(const char* name, int32 index1, int32 index
   }
   return 0;
 }
+DataStruct* PacketStruct::findTopLevelStruct(const char* name) {
+  if (field_table) {
+    int32 handle = field_table->Find(name);
+    return handle < structs.size() ? structs[handle] : 0;
+  }
+  map<string, DataStruct*>::iterator itr = struct_map.find(name);
+  return itr != struct_map.end() ? itr->second : 0;
+}
+DataStruct* PacketStruct::findStruct(const PacketField& field, int32 index) {
+  if (field_table) {
+    int32 position = field_table->Find(field);
+    if (position < structs.size() && index < structs[position]->GetLength())
+      return structs[position];
+  }
+  // split strings (name_1, name_2...), array fields and packets without a table
+  return findStruct(field.GetName(), index);
+}
+void PacketStruct::BuildFieldTable() {
+  if (!field_table)
+    field_table = make_shared<PacketFieldTable>(&structs);
+}
 void PacketStruct::remove(const char* name) {
+  field_table.reset();
   DataStruct* data = 0;
   vector<DataStruct*>::iterator itr;
   for (itr = structs.begin(); itr != structs.end(); itr++) {
@@ -949,6 +1024,21 @@ string* PacketStruct::serializeString() {
   serializePacket();
   return getDataString();
 }
+
+void PacketStruct::TrackSerializedOffsets(bool val) {
+  track_offsets = val;
+  if (!track_offsets)
+    serialized_offsets.clear();
+}
+
+bool PacketStruct::GetSerializedOffset(const char* name, int32* offset, int32* length) {
+  map<string, pair<int32, int32>>::iterator itr = serialized_offsets.find(name);
+  if (itr == serialized_offsets.end())
+    return false;
+  *offset = itr->second.first;
+  *length = itr->second.second;
+  return true;
+}
 void PacketStruct::setSmallString(DataStruct* data_struct, const char* text, int32 index) {
   EQ2_8BitString* string_data = new EQ2_8BitString;
   string_data->data = string(text);
@@ -1326,6 +1416,11 @@ void PacketStruct::reAddAll(int32 length) {
   DataStruct* ds = 0;
   PacketStruct* ps = 0;
   vector<PacketStruct*>::iterator packet_itr;
+  field_table.reset();
+  PacketStruct* root = this;
+  while (root->IsSubPacket() && root->parent)
+    root = root->parent;
+  root->layout_changed = true;
   if (orig_structs.size() == 0)
     orig_structs = structs;
   else
@@ -1441,12 +1536,10 @@ int32 PacketStruct::GetArraySizeByName(const char* name, int32 index) {
 void PacketStruct::serializePacket(bool clear) {
   if (clear)
     Clear();
-  bool client_cmd = false;
+  bool client_cmd = IsClientCmd();
   string client_data;
-#ifndef LOGIN
-  if (GetOpcode() == OP_ClientCmdMsg && strlen(GetOpcodeType()) > 0 && !IsSubPacket())
-    client_cmd = true;
-#endif
+  if (track_offsets)
+    serialized_offsets.clear();
   DataStruct* data = 0;
   vector<DataStruct*>::iterator itr;
   for (itr = structs.begin(); itr != structs.end(); itr++) {
@@ -1569,9 +1662,18 @@ void PacketStruct::serializePacket(bool clear) {
         if (value != 1)
           continue;
       }
-      if (client_cmd)
-        AddSerializedData(data, 0, &client_data);
-      else
+      if (client_cmd) {
+        if (track_offsets) {
+          int32 offset = client_data.length();
+          AddSerializedData(data, 0, &client_data);
+          serialized_offsets[data->GetStringName()] = make_pair(offset, client_data.length() - offset);
+        } else
+          AddSerializedData(data, 0, &client_data);
+      } else if (track_offsets) {
+        int32 offset = getDataSize();
+        AddSerializedData(data);
+        serialized_offsets[data->GetStringName()] = make_pair(offset, getDataSize() - offset);
+      } else
         AddSerializedData(data);
     }
   }
@@ -1599,9 +1701,24 @@ void PacketStruct::serializePacket(bool clear) {
     StructAddData(oversized, sizeof(int8), 0);
     StructAddData(opcode_val, sizeof(int16), 0);
     AddData(client_data);
+
+    // the offsets were taken before the size and opcode header was added
+    if (track_offsets) {
+      int32 header_size = getDataSize() - client_data.length();
+      for (auto& kv : serialized_offsets)
+        kv.second.first += header_size;
+    }
   }
 #endif
 }
+
+bool PacketStruct::IsClientCmd() {
+#ifndef LOGIN
+  return GetOpcode() == OP_ClientCmdMsg && strlen(GetOpcodeType()) > 0 && !IsSubPacket();
+#else
+  return false;
+#endif
+}
 int32 PacketStruct::GetTotalPacketSize() {
   int32 retSize = 0;
   DataStruct* data = 0;
@@ -2457,4 +2574,39 @@ void PacketStruct::ResetData() {
   for (itr2 = arrays.begin(); itr2 != arrays.end(); itr2++)
     (*itr2)->ResetData();
 }
+void PacketStruct::RestoreDefaults() {
+  vector<DataStruct*>::iterator itr;
+  for (itr = structs.begin(); itr != structs.end(); itr++) {
+    DataStruct* ds = *itr;
+    ds->SetIsSet(false);
+    ds->SetAddToStruct(true);
+    ds->SetAddType(ds->GetType());
+    if (ds->GetLength() <= 1)
+      continue;
+    // same as add(), multi value unsigned fields start out filled with the default
+    int8 default_val = ds->GetDefaultValue();
+    if (default_val == 0)
+      continue;
+    void* ptr = GetStructPointer(ds);
+    if (!ptr)
+      continue;
+    switch (ds->GetType()) {
+    case DATA_STRUCT_INT8:
+      memset(ptr, default_val, sizeof(int8) * ds->GetLength());
+      break;
+    case DATA_STRUCT_INT16:
+      memset(ptr, default_val, sizeof(int16) * ds->GetLength());
+      break;
+    case DATA_STRUCT_INT32:
+      memset(ptr, default_val, sizeof(int32) * ds->GetLength());
+      break;
+    case DATA_STRUCT_INT64:
+      memset(ptr, default_val, sizeof(int64) * ds->GetLength());
+      break;
+    }
+  }
+  vector<PacketStruct*>::iterator itr2;
+  for (itr2 = arrays.begin(); itr2 != arrays.end(); itr2++)
+    (*itr2)->RestoreDefaults();
+}
 #endif
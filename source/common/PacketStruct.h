@@ -25,6 +25,8 @@
 
 #include <vector>
 #include <map>
+#include <unordered_map>
+#include <memory>
 #ifdef WORLD
 class Item;
 class Player;
@@ -52,6 +54,8 @@ using namespace std;
 #define DATA_STRUCT_ITEM 17
 #define DATA_STRUCT_SINT64 18
 
+#define INVALID_FIELD_HANDLE 0xFFFFFFFF
+
 class DataStruct {
 public:
   DataStruct();
@@ -129,6 +133,41 @@ private:
   int32 length;
   int32 item_size;
 };
+// A top level field name written on hot paths. Must be defined at namespace scope so
+// it is registered before any struct is loaded; every struct table then resolves it
+// once and writes through it skip the name lookup.
+class PacketField {
+public:
+  explicit PacketField(const char* name);
+  const char* GetName() const { return name; }
+  int32 GetID() const { return id; }
+
+private:
+  const char* name;
+  int32 id;
+};
+// Name -> position lookup for the top level fields of a loaded struct. Built once on
+// the template and shared by every copy made from it, so a position found on one
+// copy is valid for all copies of the same struct version.
+class PacketFieldTable {
+public:
+  PacketFieldTable(vector<DataStruct*>* structs);
+  int32 Find(const char* name) const;
+  int32 Find(const PacketField& field) const;
+  int32 GetFieldCount() const { return names.size(); }
+
+private:
+  struct NameHash {
+    size_t operator()(const char* name) const;
+  };
+  struct NameEqual {
+    bool operator()(const char* name1, const char* name2) const;
+  };
+  vector<string> names;
+  unordered_map<const char*, int32, NameHash, NameEqual> fields;
+  // positions of every registered PacketField, by id
+  vector<int32> registered;
+};
 class PacketStruct : public DataBuffer {
 public:
   PacketStruct();
@@ -192,6 +231,15 @@ public:
     setData(findStruct(name, index), data, index, use_second_type);
   }
   template <class Data>
+  void setDataByName(const PacketField& field, Data data, int32 index = 0, bool use_second_type = false) {
+    setData(findStruct(field, index), data, index, use_second_type);
+  }
+  template <class Data>
+  void setDataByName(const PacketField& field, Data* data, int32 index = 0, bool use_second_type = false) {
+    setData(findStruct(field, index), data, index, use_second_type);
+  }
+  void BuildFieldTable();
+  template <class Data>
   void setSubArrayDataByName(const char* name, Data data, int32 index1 = 0, int32 index2 = 0, int32 index3 = 0) {
     char tmp[20] = {0};
     sprintf(tmp, "%u_%u", index1, index2);
@@ -226,6 +274,8 @@ public:
   const char* GetOpcodeType();
   bool IsSubPacket();
   void IsSubPacket(bool new_val);
+  // ClientCmdMsg packets are serialized behind a size and sub opcode header
+  bool IsClientCmd();
   int32 GetSubPacketSize();
   void SetSubPacketSize(int32 new_size);
   void SetOpcodeType(const char* opcodeType);
@@ -413,6 +463,13 @@ public:
   void setColorByName(const char* name, int8 red, int8 green, int8 blue, int32 index = 0) {
     setColor(findStruct(name, index), red, green, blue, index);
   }
+  void setColorByName(const PacketField& field, EQ2_Color* data, int32 index = 0) {
+    if (data)
+      setColor(findStruct(field, index), data->red, data->green, data->blue, index);
+  }
+  void setColorByName(const PacketField& field, EQ2_Color data, int32 index = 0) {
+    setColor(findStruct(field, index), data.red, data.green, data.blue, index);
+  }
   void setColor(DataStruct* data, int8 red, int8 green, int8 blue, int32 index);
   void setEquipmentByName(DataStruct* data_struct, EQ2_EquipmentItem data, int32 index = 0) {
     if (data_struct) {
@@ -443,6 +500,7 @@ public:
   vector<DataStruct*>* getStructs() { return &structs; }
   DataStruct* findStruct(const char* name, int32 index);
   DataStruct* findStruct(const char* name, int32 index1, int32 index2);
+  DataStruct* findStruct(const PacketField& field, int32 index);
   void remove(const char* name);
   void remove(int32 position);
   void serializePacket(bool clear = true);
@@ -451,6 +509,10 @@ public:
   EQ2Packet* serialize();
   EQ2Packet* serializeCountPacket(int16 version, int8 offset = 0, uchar* orig_packet = 0, uchar* xor_packet = 0);
   string* serializeString();
+  // While enabled serializePacket() records where each top level field was written so
+  // a copy of the serialized data can later be patched one field at a time
+  void TrackSerializedOffsets(bool val);
+  bool GetSerializedOffset(const char* name, int32* offset, int32* length);
   int32 GetVersion() { return version; }
   void SetVersion(int32 in_version) { version = in_version; }
   bool SetOpcode(const char* new_opcode);
@@ -468,6 +530,14 @@ public:
   vector<DataStruct*> GetDataStructs();
   void AddPackedData();
   void ResetData();
+  // Puts the is set/add flags and array default values back the way a fresh copy has them
+  void RestoreDefaults();
+  void SetClientVersion(int16 in_client_version) { client_version = in_client_version; }
+  // Template a pooled copy was made from, see ConfigReader::AcquireStruct()
+  PacketStruct* GetPoolTemplate() { return pool_template; }
+  void SetPoolTemplate(PacketStruct* packet) { pool_template = packet; }
+  // True once an array in the packet has been resized, the layout no longer matches the template
+  bool LayoutChanged() { return layout_changed; }
 
 private:
   PacketStruct* parent;
@@ -480,11 +550,17 @@ private:
   int16 version;
   int16 client_version;
   vector<PacketStruct*> arrays;
-  map<DataStruct*, void*> struct_data;
+  unordered_map<DataStruct*, void*> struct_data;
   map<int8, string> packed_data;
   map<string, DataStruct*> struct_map;
   vector<DataStruct*> structs;
   vector<DataStruct*> orig_structs;
   vector<PacketStruct*> orig_packets;
+  bool track_offsets;
+  map<string, pair<int32, int32>> serialized_offsets;
+  shared_ptr<PacketFieldTable> field_table;
+  PacketStruct* pool_template;
+  bool layout_changed;
+  DataStruct* findTopLevelStruct(const char* name);
 };
 #endif
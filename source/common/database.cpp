@@ -153,6 +153,111 @@ void Database::InitVars() {
 
 Database::~Database() {
 }
+// keeps a merged insert well below the default max_allowed_packet
+#define QUERY_BATCH_MAX_LENGTH 262144
+
+static string FormatQueryString(const char* format, va_list args) {
+  char* buffer;
+  int buf_len;
+  va_list argcopy;
+  va_copy(argcopy, args);
+  buf_len = vsnprintf(NULL, 0, format, argcopy) + 1;
+  va_end(argcopy);
+
+  buffer = new char[buf_len];
+  vsnprintf(buffer, buf_len, format, args);
+  string ret = string(buffer);
+  safe_delete_array(buffer);
+
+  return ret;
+}
+
+QueryBatch::QueryBatch() {
+  pending_rows = 0;
+  row_count = 0;
+}
+
+void QueryBatch::AddQuery(const char* format, ...) {
+  FlushRows();
+
+  va_list args;
+  va_start(args, format);
+  queries.push_back(FormatQueryString(format, args));
+  va_end(args);
+  row_count++;
+}
+
+bool QueryBatch::AddQueryIfChanged(string& last, const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  string query = FormatQueryString(format, args);
+  va_end(args);
+
+  if (query == last)
+    return false;
+
+  FlushRows();
+  queries.push_back(query);
+  last = query;
+  row_count++;
+
+  return true;
+}
+
+void QueryBatch::AddRow(const char* table, const char* columns, const char* update, const char* format, ...) {
+  string insert = string("INSERT INTO ") + table + " (" + columns + ") VALUES ";
+  if (!update)
+    update = "";
+
+  if (pending_rows > 0 && (insert != pending_insert || pending_update != update || pending_values.length() > QUERY_BATCH_MAX_LENGTH))
+    FlushRows();
+
+  if (pending_rows == 0) {
+    pending_insert = insert;
+    pending_update = update;
+    pending_values.clear();
+  } else
+    pending_values.append(",");
+
+  va_list args;
+  va_start(args, format);
+  pending_values.append("(").append(FormatQueryString(format, args)).append(")");
+  va_end(args);
+  pending_rows++;
+  row_count++;
+}
+
+void QueryBatch::FlushRows() {
+  if (pending_rows == 0)
+    return;
+
+  if (pending_update.length() > 0)
+    queries.push_back(pending_insert + pending_values + " ON DUPLICATE KEY UPDATE " + pending_update);
+  else
+    queries.push_back(pending_insert + pending_values);
+  pending_values.clear();
+  pending_rows = 0;
+}
+
+void QueryBatch::OnFailure(function<void()> handler) {
+  failure_handlers.push_back(handler);
+}
+
+bool QueryBatch::Execute(char* errbuf) {
+  FlushRows();
+
+  bool ret = database.RunTransaction(queries, errbuf);
+  queries.clear();
+
+  if (!ret) {
+    for (auto& handler : failure_handlers)
+      handler();
+  }
+  failure_handlers.clear();
+
+  return ret;
+}
+
 MYSQL_RES* Query::RunQuery2(QUERY_TYPE type, const char* format, ...) {
   va_list args;
   va_start(args, format);
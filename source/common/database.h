@@ -32,6 +32,7 @@
 #include "EQStream.h"
 #include "MiscFunctions.h"
 #include "Mutex.h"
+#include <functional>
 #include <string>
 #include <vector>
 #include <map>
@@ -120,4 +121,33 @@ private:
   MYSQL_ROW* row;
   MYSQL mysql;
 };
+
+// Collects write statements so they can be sent in a single transaction.
+// Consecutive rows for the same table and columns are merged into one
+// multi-row INSERT (... ON DUPLICATE KEY UPDATE when update is given) statement.
+class QueryBatch {
+public:
+  QueryBatch();
+  void AddQuery(const char* format, ...);
+  // Only adds the query when it differs from last, which is then updated.
+  bool AddQueryIfChanged(string& last, const char* format, ...);
+  void AddRow(const char* table, const char* columns, const char* update, const char* format, ...);
+  // Runs if Execute() fails, so collectors can mark the rows they cleared as needing a save again
+  void OnFailure(function<void()> handler);
+  bool Execute(char* errbuf = 0);
+  bool IsEmpty() { return queries.empty() && pending_rows == 0; }
+  int32 GetRowCount() { return row_count; }
+  int32 GetStatementCount() { return queries.size() + (pending_rows > 0 ? 1 : 0); }
+
+private:
+  void FlushRows();
+
+  vector<string> queries;
+  vector<function<void()>> failure_handlers;
+  string pending_insert;
+  string pending_update;
+  string pending_values;
+  int32 pending_rows;
+  int32 row_count;
+};
 #endif
@@ -48,8 +48,10 @@ using namespace std;
 #define DEBUG_MYSQL_QUERIES 0
 #endif
 
+thread_local DBcore* DBcore::reserved_by = nullptr;
+thread_local DBcore::Connection* DBcore::reserved_connection = nullptr;
+
 DBcore::DBcore() {
-  mysql_init(&mysql);
   pHost = 0;
   pPort = 0;
   pUser = 0;
@@ -58,11 +60,27 @@ DBcore::DBcore() {
   pCompress = false;
   pSSL = false;
   pStatus = Closed;
+  pConnections = DB_DEFAULT_CONNECTIONS;
+  escape_connection = nullptr;
+  workers_stopping = false;
 }
 
 DBcore::~DBcore() {
+  StopWorkers();
   pStatus = Closed;
-  mysql_close(&mysql);
+
+  for (auto connection : connections) {
+    mysql_close(&connection->mysql);
+    safe_delete(connection);
+  }
+  connections.clear();
+  idle_connections.clear();
+
+  if (escape_connection) {
+    mysql_close(&escape_connection->mysql);
+    safe_delete(escape_connection);
+  }
+
 #if MYSQL_VERSION_ID >= 50003
   mysql_library_end();
 #else
@@ -126,6 +144,10 @@ bool DBcore::ReadDBINI(char* host, char* user, char* passwd, char* database, int
           items[5] = true;
           LogWrite(DATABASE__INFO, 0, "DBCore", "DB Compression on.");
         }
+      } else if (strcasecmp(key, "connections") == 0) {
+        pConnections = atoi(val);
+        if (pConnections < 1)
+          pConnections = 1;
       }
     }
   }
@@ -140,60 +162,155 @@ bool DBcore::ReadDBINI(char* host, char* user, char* passwd, char* database, int
   return true;
 }
 
-// Sends the MySQL server a keepalive
+// Sends the MySQL server a keepalive on every connection nobody is using
 void DBcore::ping() {
-  if (!MDatabase.trylock()) {
-    // well, if's it's locked, someone's using it. If someone's using it, it doesnt need a keepalive
-    return;
+  vector<Connection*> idle;
+
+  {
+    lock_guard<mutex> guard(connections_mutex);
+    idle.swap(idle_connections);
   }
-  mysql_ping(&mysql);
-  MDatabase.unlock();
+
+  for (auto connection : idle)
+    mysql_ping(&connection->mysql);
+
+  {
+    lock_guard<mutex> guard(connections_mutex);
+    idle_connections.insert(idle_connections.end(), idle.begin(), idle.end());
+  }
+  connections_cv.notify_all();
+}
+
+DBcore::Connection* DBcore::AcquireConnection() {
+  unique_lock<mutex> guard(connections_mutex);
+  connections_cv.wait(guard, [this]() { return !idle_connections.empty(); });
+
+  Connection* connection = idle_connections.back();
+  idle_connections.pop_back();
+
+  return connection;
+}
+
+void DBcore::ReleaseConnection(Connection* connection) {
+  {
+    lock_guard<mutex> guard(connections_mutex);
+    idle_connections.push_back(connection);
+  }
+  connections_cv.notify_one();
+}
+
+void DBcore::ReserveConnection() {
+  if (reserved_by == this || connections.empty())
+    return;
+
+  reserved_connection = AcquireConnection();
+  reserved_by = this;
+}
+
+void DBcore::ReleaseReservedConnection() {
+  if (reserved_by != this)
+    return;
+
+  Connection* connection = reserved_connection;
+  reserved_connection = nullptr;
+  reserved_by = nullptr;
+  ReleaseConnection(connection);
 }
 
 bool DBcore::RunQuery(const char* query, int32 querylen, char* errbuf, MYSQL_RES** result, int32* affected_rows, int32* last_insert_id, int32* errnum, bool retry) {
+  if (connections.empty()) {
+    if (errnum)
+      *errnum = CR_SERVER_GONE_ERROR;
+    if (errbuf)
+      snprintf(errbuf, MYSQL_ERRMSG_SIZE, "#%i: Database is not open", CR_SERVER_GONE_ERROR);
+    return false;
+  }
+
+  if (reserved_by == this)
+    return RunQuery(reserved_connection, query, querylen, errbuf, result, affected_rows, last_insert_id, errnum, retry);
+
+  Connection* connection = AcquireConnection();
+  bool ret = RunQuery(connection, query, querylen, errbuf, result, affected_rows, last_insert_id, errnum, retry);
+  ReleaseConnection(connection);
+
+  return ret;
+}
+
+bool DBcore::RunTransaction(const vector<string>& queries, char* errbuf, int32* errnum) {
+  if (queries.empty())
+    return true;
+
+  if (connections.empty()) {
+    if (errnum)
+      *errnum = CR_SERVER_GONE_ERROR;
+    if (errbuf)
+      snprintf(errbuf, MYSQL_ERRMSG_SIZE, "#%i: Database is not open", CR_SERVER_GONE_ERROR);
+    return false;
+  }
+
+  bool reserved = (reserved_by == this);
+  Connection* connection = reserved ? reserved_connection : AcquireConnection();
+
+  // only the first statement may retry, a reconnect mid-transaction loses the earlier work
+  bool ret = RunQuery(connection, "START TRANSACTION", 17, errbuf, 0, 0, 0, errnum, true);
+  for (size_t i = 0; ret && i < queries.size(); i++)
+    ret = RunQuery(connection, queries[i].c_str(), queries[i].length(), errbuf, 0, 0, 0, errnum, false);
+
+  if (ret)
+    ret = RunQuery(connection, "COMMIT", 6, errbuf, 0, 0, 0, errnum, false);
+  else if (connection->status == Connected)
+    RunQuery(connection, "ROLLBACK", 8, 0, 0, 0, 0, 0, false);
+
+  if (!reserved)
+    ReleaseConnection(connection);
+
+  return ret;
+}
+
+bool DBcore::RunQuery(Connection* connection, const char* query, int32 querylen, char* errbuf, MYSQL_RES** result, int32* affected_rows, int32* last_insert_id, int32* errnum, bool retry) {
   if (errnum)
     *errnum = 0;
   if (errbuf)
     errbuf[0] = 0;
   bool ret = false;
-  LockMutex lock(&MDatabase);
-  if (pStatus != Connected)
-    Open();
+  MYSQL* mysql = &connection->mysql;
+  if (connection->status != Connected)
+    Open(connection);
 
   LogWrite(DATABASE__QUERY, 0, "DBCore", query);
-  if (mysql_real_query(&mysql, query, querylen)) {
-    if (mysql_errno(&mysql) == CR_SERVER_GONE_ERROR)
-      pStatus = Error;
-    if (mysql_errno(&mysql) == CR_SERVER_LOST || mysql_errno(&mysql) == CR_SERVER_GONE_ERROR) {
+  if (mysql_real_query(mysql, query, querylen)) {
+    if (mysql_errno(mysql) == CR_SERVER_GONE_ERROR)
+      connection->status = Error;
+    if (mysql_errno(mysql) == CR_SERVER_LOST || mysql_errno(mysql) == CR_SERVER_GONE_ERROR) {
       if (retry) {
         LogWrite(DATABASE__ERROR, 0, "DBCore", "Lost connection, attempting to recover...");
-        ret = RunQuery(query, querylen, errbuf, result, affected_rows, last_insert_id, errnum, false);
+        ret = RunQuery(connection, query, querylen, errbuf, result, affected_rows, last_insert_id, errnum, false);
       } else {
-        pStatus = Error;
+        connection->status = Error;
         if (errnum)
-          *errnum = mysql_errno(&mysql);
+          *errnum = mysql_errno(mysql);
         if (errbuf)
-          snprintf(errbuf, MYSQL_ERRMSG_SIZE, "#%i: %s", mysql_errno(&mysql), mysql_error(&mysql));
-        LogWrite(DATABASE__ERROR, 0, "DBCore", "#%i: %s\nQuery:\n%s", mysql_errno(&mysql), mysql_error(&mysql), query);
+          snprintf(errbuf, MYSQL_ERRMSG_SIZE, "#%i: %s", mysql_errno(mysql), mysql_error(mysql));
+        LogWrite(DATABASE__ERROR, 0, "DBCore", "#%i: %s\nQuery:\n%s", mysql_errno(mysql), mysql_error(mysql), query);
         ret = false;
       }
     } else {
       if (errnum)
-        *errnum = mysql_errno(&mysql);
+        *errnum = mysql_errno(mysql);
       if (errbuf)
-        snprintf(errbuf, MYSQL_ERRMSG_SIZE, "#%i: %s", mysql_errno(&mysql), mysql_error(&mysql));
-      LogWrite(DATABASE__ERROR, 0, "DBCore", "#%i: %s\nQuery:\n%s", mysql_errno(&mysql), mysql_error(&mysql), query);
+        snprintf(errbuf, MYSQL_ERRMSG_SIZE, "#%i: %s", mysql_errno(mysql), mysql_error(mysql));
+      LogWrite(DATABASE__ERROR, 0, "DBCore", "#%i: %s\nQuery:\n%s", mysql_errno(mysql), mysql_error(mysql), query);
       ret = false;
     }
   } else {
-    if (result && mysql_field_count(&mysql)) {
-      *result = mysql_store_result(&mysql);
+    if (result && mysql_field_count(mysql)) {
+      *result = mysql_store_result(mysql);
     } else if (result)
       *result = 0;
     if (affected_rows)
-      *affected_rows = mysql_affected_rows(&mysql);
+      *affected_rows = mysql_affected_rows(mysql);
     if (last_insert_id)
-      *last_insert_id = mysql_insert_id(&mysql);
+      *last_insert_id = mysql_insert_id(mysql);
     if (result) {
       if (*result) {
         ret = true;
@@ -227,8 +344,13 @@ bool DBcore::RunQuery(const char* query, int32 querylen, char* errbuf, MYSQL_RES
 }
 
 int32 DBcore::DoEscapeString(char* tobuf, const char* frombuf, int32 fromlen) {
-  LockMutex lock(&MDatabase);
-  return mysql_real_escape_string(&mysql, tobuf, frombuf, fromlen);
+  // escaping only reads the handle's character set, it never talks to the server
+  lock_guard<mutex> guard(escape_mutex);
+
+  if (!escape_connection)
+    return mysql_escape_string(tobuf, frombuf, fromlen);
+
+  return mysql_real_escape_string(&escape_connection->mysql, tobuf, frombuf, fromlen);
 }
 
 bool DBcore::Open(const char* iHost, const char* iUser, const char* iPassword, const char* iDatabase, int32 iPort, int32* errnum, char* errbuf, bool iCompress, bool iSSL) {
@@ -257,10 +379,66 @@ bool DBcore::Open(int32* errnum, char* errbuf) {
   LockMutex lock(&MDatabase);
   if (GetStatus() == Connected)
     return true;
-  if (GetStatus() == Error)
-    mysql_close(&mysql);
   if (!pHost)
     return false;
+
+  // connections are only created once; a later Open() just reconnects the
+  // ones that dropped while nobody was holding them
+  if (connections.empty()) {
+    for (int32 i = 0; i < pConnections; i++) {
+      Connection* connection = new Connection;
+      mysql_init(&connection->mysql);
+      connection->status = Closed;
+      connections.push_back(connection);
+    }
+
+    escape_connection = new Connection;
+    mysql_init(&escape_connection->mysql);
+    escape_connection->status = Closed;
+  }
+
+  // connected so it picks up the server's character set, like the pooled connections
+  if (escape_connection->status != Connected) {
+    lock_guard<mutex> guard(escape_mutex);
+    Open(escape_connection);
+  }
+
+  vector<Connection*> idle;
+  {
+    lock_guard<mutex> guard(connections_mutex);
+    idle.swap(idle_connections);
+  }
+  if (idle.empty())
+    idle = connections;
+
+  bool ret = true;
+  for (auto connection : idle) {
+    if (!Open(connection, errnum, errbuf))
+      ret = false;
+  }
+
+  {
+    lock_guard<mutex> guard(connections_mutex);
+    idle_connections.insert(idle_connections.end(), idle.begin(), idle.end());
+  }
+  connections_cv.notify_all();
+
+  pStatus = ret ? Connected : Error;
+  if (ret) {
+    LogWrite(DATABASE__INFO, 0, "DBCore", "Opened %u database connection(s)", (int32)connections.size());
+    StartWorkers();
+  }
+
+  return ret;
+}
+
+bool DBcore::Open(Connection* connection, int32* errnum, char* errbuf) {
+  if (connection->status == Connected)
+    return true;
+  if (connection->status == Error) {
+    mysql_close(&connection->mysql);
+    mysql_init(&connection->mysql);
+  }
   /*
 	Quagmire - added CLIENT_FOUND_ROWS flag to the connect
 	otherwise DB update calls would say 0 rows affected when the value already equalled
@@ -271,19 +449,127 @@ bool DBcore::Open(int32* errnum, char* errbuf) {
     flags |= CLIENT_COMPRESS;
   if (pSSL)
     flags |= CLIENT_SSL;
-  if (mysql_real_connect(&mysql, pHost, pUser, pPassword, pDatabase, pPort, 0, flags)) {
-    pStatus = Connected;
+  if (mysql_real_connect(&connection->mysql, pHost, pUser, pPassword, pDatabase, pPort, 0, flags)) {
+    connection->status = Connected;
     return true;
   } else {
     if (errnum)
-      *errnum = mysql_errno(&mysql);
+      *errnum = mysql_errno(&connection->mysql);
     if (errbuf)
-      snprintf(errbuf, MYSQL_ERRMSG_SIZE, "#%i: %s", mysql_errno(&mysql), mysql_error(&mysql));
-    pStatus = Error;
+      snprintf(errbuf, MYSQL_ERRMSG_SIZE, "#%i: %s", mysql_errno(&connection->mysql), mysql_error(&connection->mysql));
+    connection->status = Error;
     return false;
   }
 }
 
+void DBcore::StartWorkers() {
+  lock_guard<mutex> guard(work_mutex);
+  if (!workers.empty())
+    return;
+
+  workers_stopping = false;
+  for (int32 i = 0; i < pConnections; i++)
+    workers.push_back(thread(&DBcore::WorkerThread, this));
+}
+
+void DBcore::StopWorkers() {
+  {
+    lock_guard<mutex> guard(work_mutex);
+    workers_stopping = true;
+  }
+  work_cv.notify_all();
+
+  // workers drain the queue before exiting so pending saves are not lost
+  for (auto& worker : workers) {
+    if (worker.joinable())
+      worker.join();
+  }
+  workers.clear();
+}
+
+void DBcore::WorkerThread() {
+  mysql_thread_init();
+  unique_lock<mutex> guard(work_mutex);
+
+  while (true) {
+    auto itr = work_queue.end();
+    work_cv.wait(guard, [this, &itr]() {
+      for (itr = work_queue.begin(); itr != work_queue.end(); itr++) {
+        if (itr->key == 0 || busy_keys.count(itr->key) == 0)
+          return true;
+      }
+      return workers_stopping && work_queue.empty();
+    });
+
+    if (itr == work_queue.end())
+      break;
+
+    int32 key = itr->key;
+    packaged_task<void()> task = move(itr->task);
+    work_queue.erase(itr);
+    if (key > 0)
+      busy_keys.insert(key);
+
+    guard.unlock();
+    task();
+    guard.lock();
+
+    if (key > 0)
+      busy_keys.erase(key);
+    work_cv.notify_all();
+  }
+
+  guard.unlock();
+  mysql_thread_end();
+}
+
+future<void> DBcore::QueueWork(int32 key, function<void()> work) {
+  packaged_task<void()> task(work);
+  future<void> ret = task.get_future();
+
+  unique_lock<mutex> guard(work_mutex);
+
+  // nothing to hand the work to (not opened yet or shutting down), so run it here
+  if (workers.empty() || workers_stopping) {
+    guard.unlock();
+    task();
+    return ret;
+  }
+
+  work_queue.push_back(QueuedWork{key, move(task)});
+  guard.unlock();
+  work_cv.notify_all();
+
+  return ret;
+}
+
+future<bool> DBcore::QueueQueries(int32 key, vector<string> queries) {
+  shared_ptr<promise<bool>> result = make_shared<promise<bool>>();
+  future<bool> ret = result->get_future();
+
+  QueueWork(key, [this, result, queries]() {
+    bool success = true;
+    char errbuf[MYSQL_ERRMSG_SIZE];
+
+    for (const auto& query : queries) {
+      if (!RunQuery(query.c_str(), query.length(), errbuf)) {
+        LogWrite(DATABASE__ERROR, 0, "DBCore", "Queued query failed: %s", errbuf);
+        success = false;
+        break;
+      }
+    }
+
+    result->set_value(success);
+  });
+
+  return ret;
+}
+
+int32 DBcore::GetQueuedWorkCount() {
+  lock_guard<mutex> guard(work_mutex);
+  return work_queue.size() + busy_keys.size();
+}
+
 char* DBcore::getEscapeString(const char* from_string) {
   if (!from_string)
     from_string = "";
@@ -32,6 +32,14 @@
 #include "../common/queue.h"
 #include "../common/timer.h"
 #include "../common/Condition.h"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
 #ifdef LOGIN
 #define DB_INI_FILE "login_db.ini"
 #endif
@@ -44,6 +52,8 @@
 #ifdef PATCHER
 #define DB_INI_FILE "patcher_db.ini"
 #endif
+// number of connections opened when the ini does not specify "connections"
+#define DB_DEFAULT_CONNECTIONS 4
 class DBcore {
 public:
   enum eStatus { Closed,
@@ -53,22 +63,68 @@ public:
   ~DBcore();
   eStatus GetStatus() { return pStatus; }
   bool RunQuery(const char* query, int32 querylen, char* errbuf = 0, MYSQL_RES** result = 0, int32* affected_rows = 0, int32* last_insert_id = 0, int32* errnum = 0, bool retry = true);
+  // Runs every query on one connection inside a transaction, rolling back on the first error.
+  bool RunTransaction(const vector<string>& queries, char* errbuf = 0, int32* errnum = 0);
+  // Keeps one connection for the calling thread until ReleaseReservedConnection(), so
+  // session settings (SET ...) apply to every query the thread runs in between
+  void ReserveConnection();
+  void ReleaseReservedConnection();
   int32 DoEscapeString(char* tobuf, const char* frombuf, int32 fromlen);
   void ping();
   char* getEscapeString(const char* from_string);
   string getSafeEscapeString(const char* from_string);
   string getSafeEscapeString(string* from_string);
 
+  // Runs work on a database worker thread. Work queued with the same non-zero
+  // key runs in submission order (e.g. all saves for one character id).
+  std::future<void> QueueWork(int32 key, std::function<void()> work);
+  // Runs the queries in order on a worker thread, stopping at the first error.
+  std::future<bool> QueueQueries(int32 key, vector<string> queries);
+  int32 GetQueuedWorkCount();
+
 protected:
   bool Open(const char* iHost, const char* iUser, const char* iPassword, const char* iDatabase, int32 iPort, int32* errnum = 0, char* errbuf = 0, bool iCompress = false, bool iSSL = false);
   bool ReadDBINI(char* host, char* user, char* pass, char* db, int32& port, bool& compress, bool* items);
 
 private:
+  struct Connection {
+    MYSQL mysql;
+    eStatus status;
+  };
+
+  struct QueuedWork {
+    int32 key;
+    std::packaged_task<void()> task;
+  };
+
   bool Open(int32* errnum = 0, char* errbuf = 0);
+  bool Open(Connection* connection, int32* errnum = 0, char* errbuf = 0);
+  bool RunQuery(Connection* connection, const char* query, int32 querylen, char* errbuf, MYSQL_RES** result, int32* affected_rows, int32* last_insert_id, int32* errnum, bool retry);
+  Connection* AcquireConnection();
+  void ReleaseConnection(Connection* connection);
+  void StartWorkers();
+  void StopWorkers();
+  void WorkerThread();
 
-  MYSQL mysql;
+  vector<Connection*> connections;
+  vector<Connection*> idle_connections;
+  std::mutex connections_mutex;
+  std::condition_variable connections_cv;
+  static thread_local DBcore* reserved_by;
+  static thread_local Connection* reserved_connection;
+  // only used for escaping, so building a query never waits on the pool
+  Connection* escape_connection;
+  std::mutex escape_mutex;
   Mutex MDatabase;
   eStatus pStatus;
+  int32 pConnections;
+
+  std::deque<QueuedWork> work_queue;
+  std::set<int32> busy_keys;
+  std::vector<std::thread> workers;
+  std::mutex work_mutex;
+  std::condition_variable work_cv;
+  bool workers_stopping;
 
   char* pHost;
   char* pUser;